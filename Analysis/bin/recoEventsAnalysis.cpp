@@ -1,12 +1,15 @@
 #include <TCanvas.h>
 #include <TFile.h>
 #include <TLatex.h>
+#include <TROOT.h>
 #include <TString.h>
 #include <TTree.h>
 #include <TTreeIndex.h>
 #include <boost/program_options.hpp>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include <TFile.h>
@@ -51,7 +54,8 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
 		      const  double & alphaMinCut, // [mm]
 		      const  double & alphaMaxCut, // [mm]
 		      const  double & carbonMinCut, // [mm]
-		      const  double & carbonMaxCut); // [mm]
+		      const  double & carbonMaxCut, // [mm]
+		      unsigned int nThreads); // number of worker threads, 0 = number of CPU cores
 
 std::istream& operator>>(std::istream& in, BeamDirection& direction){
   std::string token;
@@ -106,11 +110,12 @@ int main(int argc, char **argv){
   auto alphaOffsetCorr = tree.get<float>("alphaOffsetCorr");
   auto carbonScaleCorr = tree.get<float>("carbonScaleCorr");
   auto carbonOffsetCorr = tree.get<float>("carbonOffsetCorr");
+  auto nThreads = tree.get<unsigned int>("threads", 1);
 
   analyzeRecoEvents(geometryFileName, dataFileName, beamEnergy, beamDir, beamOffset, beamSlope, beamDiameter, pressure, temperature,
 		    makeTreeFlag, nominalBoostFlag,
 		    alphaScaleCorr, alphaOffsetCorr, carbonScaleCorr, carbonOffsetCorr,
-		    alphaMinCut, alphaMaxCut, carbonMinCut, carbonMaxCut);
+		    alphaMinCut, alphaMaxCut, carbonMinCut, carbonMaxCut, nThreads);
 
   return 0;
 }
@@ -139,7 +144,10 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
 		      const  double & alphaMinCut, // [mm]
 		      const  double & alphaMaxCut, // [mm]
 		      const  double & carbonMinCut, // [mm]
-		      const  double & carbonMaxCut){ // [mm]
+		      const  double & carbonMaxCut, // [mm]
+		      unsigned int nThreads){ // number of worker threads, 0 = number of CPU cores
+
+  if(nThreads==0) nThreads=std::max(1U, std::thread::hardware_concurrency());
 
   std::cout << __FUNCTION__ << ": Input parameters:" << std::endl
 	    << "* geometry file: " << geometryFileName << std::endl
@@ -151,7 +159,8 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
 	    << "* ALPHA length correction: scale="<<alphaScaleCorr<<" / offset="<<alphaOffsetCorr<<" mm"<<std::endl
 	    << "* C-12 length correction: scale="<<carbonScaleCorr<<" / offset="<<carbonOffsetCorr<<" mm"<<std::endl
 	    << "* O-16 identification cuts: ALPHA length=["<<alphaMinCut<<", "<<alphaMaxCut<<"] mm / C-12 length=["<<carbonMinCut<<", "<<carbonMaxCut<<"] mm"<<std::endl
-	    << "* use nominal LAB gamma beam energy for LAB<->CMS boost: "<<nominalBoostFlag<<std::endl;
+	    << "* use nominal LAB gamma beam energy for LAB<->CMS boost: "<<nominalBoostFlag<<std::endl
+	    << "* number of analysis threads: "<<nThreads<<std::endl;
 
   TFile *aFile = new TFile(dataFileName.c_str());
   if(!aFile || !aFile->IsOpen()){
@@ -286,18 +295,81 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
   std::cout << __FUNCTION__ << ": Starting to loop " << aTree->GetEntries() << " events with sorting by {runId, eventId}" << std::endl;
   aTree->BuildIndex("runId", "eventId");
   auto index =static_cast<TTreeIndex*>(aTree->GetTreeIndex())->GetIndex();
+  const Long64_t nEntries = aTree->GetEntries();
 
-  for(unsigned int iEntry=0;iEntry<aTree->GetEntries();++iEntry){
-    aTree->GetEntry(index[iEntry]);
+  if(nThreads<2 || nEntries<2) {
+    for(Long64_t iEntry=0;iEntry<nEntries;++iEntry){
+      aTree->GetEntry(index[iEntry]);
 
-    for (auto & aSegment: aTrack->getSegments())  aSegment.setGeometry(aGeometry); // need TPC geometry for track projections
+      for (auto & aSegment: aTrack->getSegments())  aSegment.setGeometry(aGeometry); // need TPC geometry for track projections
     
-    if(!cuts(aTrack)){
-      continue;
+      if(!cuts(aTrack)){
+	continue;
+      }
+
+      myAnalysis.fillHistos(aTrack);
+      if(makeTreeFlag) myTreesAnalysis->fillTrees(aTrack, aEventInfo);
     }
+    return 0;
+  }
+
+  // MULTI-THREADED MODE:
+  // sorted entry list is split into nThreads contiguous ranges, each worker reads its range
+  // through its own TFile/TTree and fills its own set of histograms, which are merged
+  // in the order of ranges, so the result does not depend on thread scheduling.
+  // Trees are filled afterwards by this thread from the list of accepted entries,
+  // in the same {runId, eventId} order as in single-threaded mode.
+  ROOT::EnableThreadSafety();
+  nThreads = std::min<Long64_t>(nThreads, nEntries);
+  std::vector<Long64_t> sortedEntries(index, index+nEntries);
+  std::vector<std::unique_ptr<HIGGS_analysis> > workerAnalysis;
+  for(auto iThread=0U; iThread<nThreads; ++iThread) {
+    workerAnalysis.push_back(std::make_unique<HIGGS_analysis>(aGeometry, beamEnergy, beamDir_DET, ionRangeCalculator, coordinateConverter, nominalBoostFlag, ""));
+  }
+  std::vector<std::vector<Long64_t> > acceptedEntries(nThreads);
+  std::vector<std::thread> workers;
+  for(auto iThread=0U; iThread<nThreads; ++iThread) {
+    workers.emplace_back([&, iThread]() {
+	TFile workerFile(dataFileName.c_str());
+	auto workerTree = (TTree*)workerFile.Get("TPCRecoData");
+	auto workerBranch = workerTree ? workerTree->GetBranch("RecoEvent") : nullptr;
+	if(!workerBranch) {
+	  std::cerr<<KRED<<"ERROR: Cannot read 'RecoEvent' branch in worker thread "<<iThread<<RST<<std::endl;
+	  return;
+	}
+	auto *workerTrack = new Track3D();
+	workerBranch->SetAddress(&workerTrack);
+	auto workerCuts = cuts;
+	const Long64_t first = nEntries*iThread/nThreads;
+	const Long64_t last = nEntries*(iThread+1)/nThreads;
+	for(auto iEntry=first; iEntry<last; ++iEntry) {
+	  workerBranch->GetEntry(sortedEntries[iEntry]);
+
+	  for (auto & aSegment: workerTrack->getSegments())  aSegment.setGeometry(aGeometry); // need TPC geometry for track projections
 
-    myAnalysis.fillHistos(aTrack);
-    if(makeTreeFlag) myTreesAnalysis->fillTrees(aTrack, aEventInfo);
+	  if(!workerCuts(workerTrack)){
+	    continue;
+	  }
+
+	  workerAnalysis[iThread]->fillHistos(workerTrack);
+	  if(makeTreeFlag) acceptedEntries[iThread].push_back(sortedEntries[iEntry]);
+	}
+	workerBranch->ResetAddress();
+	delete workerTrack;
+      });
+  }
+  for(auto & worker: workers) worker.join();
+
+  for(auto & aWorkerAnalysis: workerAnalysis) myAnalysis.merge(*aWorkerAnalysis);
+
+  if(makeTreeFlag) {
+    for(auto & entries: acceptedEntries) {
+      for(auto entry: entries) {
+	aTree->GetEntry(entry);
+	for (auto & aSegment: aTrack->getSegments())  aSegment.setGeometry(aGeometry);
+	myTreesAnalysis->fillTrees(aTrack, aEventInfo);
+      }
+    }
   }
 
   return 0;
@@ -22,6 +22,8 @@ parseCmdLineArgs(int argc, char **argv) {
   cmdLineOptDesc.add_options()("help", "produce help message")(
       "verbose,v", "prints message for every duplicate")(
       "dry-run", "testing without modyfing files")(
+      "use-index", "random access via TTreeIndex instead of sequential "
+                   "reading,\nentries are written in reversed order")(
       "inplace", "overwrites the input file,\nmutally exclusive "
                  "with 'output'")(
       "input,i", boost::program_options::value<std::string>()->required(),
@@ -41,7 +43,8 @@ parseCmdLineArgs(int argc, char **argv) {
             .run(),
         varMap);
     if (varMap.count("help")) {
-      std::cout << "recoEventsClean [--help] [--verbose] [--dry-run] <input> "
+      std::cout << "recoEventsClean [--help] [--verbose] [--dry-run] "
+                   "[--use-index] <input> "
                    "[--inplace | output]"
                 << "\nRemove duplicated entries from reco TTrees\n"
                 << cmdLineOptDesc << '\n';
@@ -80,16 +83,22 @@ int main(int argc, char **argv) {
   }
   auto primaryKey = "EventInfo.runId";
   auto secondaryKey = "EventInfo.eventId";
-  auto values = inputTree->BuildIndex(primaryKey, secondaryKey);
-  if (values != inputTree->GetEntries()) {
-    std::cerr << "Can't build index on input tree using " << primaryKey
-              << " and " << secondaryKey << '\n';
-    return 1;
+  auto useIndex = varMap->count("use-index");
+  if (useIndex) {
+    auto values = inputTree->BuildIndex(primaryKey, secondaryKey);
+    if (values != inputTree->GetEntries()) {
+      std::cerr << "Can't build index on input tree using " << primaryKey
+                << " and " << secondaryKey << '\n';
+      return 1;
+    }
   }
 
   if (varMap->count("dry-run")) {
-    auto count = boost::size(tpcreco::utilities::filterDuplicates(
-        inputTree, varMap->count("verbose")));
+    auto count = useIndex ? boost::size(tpcreco::utilities::filterDuplicates(
+                                inputTree, varMap->count("verbose")))
+                          : tpcreco::utilities::countUnique(
+                                tpcreco::utilities::readEntryKeys(
+                                    inputTree, primaryKey, secondaryKey));
     std::cout << "Removed " << inputTree->GetEntries() - count
               << " duplicated entries keeping the younger (dry run)\n";
     inputFile->Close();
@@ -104,8 +113,12 @@ int main(int argc, char **argv) {
     std::cerr << "Can't open output file " << outputName << '\n';
     return 1;
   }
-  auto *outputTree = tpcreco::utilities::cloneUnique(inputTree, outputFile,
-                                                     varMap->count("verbose"));
+  auto *outputTree =
+      useIndex ? tpcreco::utilities::cloneUnique(inputTree, outputFile,
+                                                 varMap->count("verbose"))
+               : tpcreco::utilities::cloneUniqueSorted(
+                     inputTree, outputFile, primaryKey, secondaryKey,
+                     varMap->count("verbose"));
   if (!outputTree) {
     std::cerr << "Clonning TTree failed\n";
     return 1;
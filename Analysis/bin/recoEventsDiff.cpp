@@ -9,7 +9,8 @@ int main(int argc, char **argv) {
   boost::property_tree::ptree tree = cm.getConfig(argc,argv);
   auto inputName = tree.get("input","");
   auto referenceName = tree.get("reference","");
-  auto analysis = tpcreco::analysis::diff::Analysis(inputName, referenceName);
+  auto analysis = tpcreco::analysis::diff::Analysis(inputName, referenceName,
+                                                    tree.count("use-index"));
 
   if (!(tree.count("no-segments"))) {
     analysis.getDetailSink()->addCheck(
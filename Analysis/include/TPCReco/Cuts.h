@@ -1,23 +1,35 @@
 #ifndef TPCRECO_ANALYSIS_CUTS_H_
 #define TPCRECO_ANALYSIS_CUTS_H_
 #include "TPCReco/CommonDefinitions.h"
+#include "TPCReco/PolygonGridIndex.h"
+#include "TPCReco/TrackColumns.h"
 #include <TGraph.h>
-#include <TH2Poly.h>
 #include <TVector3.h>
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <stdexcept>
 /////// DEBUG
 #include <iostream> // for DEBUG std::cout
 /////// DEBUG
 namespace tpcreco {
 namespace cuts {
 
+// NOTE: Every cut can be also evaluated in batch mode for all events stored
+//       in TrackColumns at once, see BatchRequirementsCollection.
+//       Batch versions must give the same result as per-event versions.
+
 // cut: reject empty events
 struct NonEmpty {
   template <class Track> bool operator()(Track *track) {
     return (track != nullptr) && (track->getSegments().size() != 0);
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    result.resize(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+      result[i] = columns.firstSegment[i + 1] != columns.firstSegment[i];
+    }
+  }
 };
 using Cut1 = NonEmpty;
 
@@ -32,6 +44,14 @@ public:
     return std::abs(vertexPos.Y() - (beamOffset + beamSlope * vertexPos.X())) <=
            0.5 * beamDiameter;
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    result.resize(columns.size());
+    const auto *x = columns.vertexX.data();
+    const auto *y = columns.vertexY.data();
+    for (size_t i = 0; i < columns.size(); ++i) {
+      result[i] = std::abs(y[i] - (beamOffset + beamSlope * x[i])) <= 0.5 * beamDiameter;
+    }
+  }
 
 private:
   double beamOffset = 0.;
@@ -47,8 +67,9 @@ class DistanceToBorder {
 public:
   template <class Geometry>
   DistanceToBorder(Geometry *geometry, double margin_mm) {
-    auto *hull = new TGraph(geometry->GetActiveAreaConvexHull(margin_mm));
-    bin = std::make_shared<TH2PolyBin>(hull, 1);
+    index = std::make_shared<PolygonGridIndex>();
+    index->AddConvexPolygon(geometry->GetActiveAreaConvexHull(margin_mm), 1);
+    index->Build(25, 25);
   }
   template <class Track> bool operator()(Track *track) {
     const auto &segments = track->getSegments();
@@ -63,10 +84,22 @@ public:
                                 this->isInside(segment.getEnd());
                        });
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    auto nSegments = columns.getNsegments();
+    std::vector<int> startBin(nSegments), endBin(nSegments);
+    index->FindBins(nSegments, columns.startX.data(), columns.startY.data(), startBin.data());
+    index->FindBins(nSegments, columns.endX.data(), columns.endY.data(), endBin.data());
+    TrackColumns::Flags isInside(nSegments);
+    for (size_t i = 0; i < nSegments; ++i) {
+      isInside[i] = startBin[i] != PolygonGridIndex::notFound &&
+                    endBin[i] != PolygonGridIndex::notFound;
+    }
+    columns.allSegments(isInside, result);
+  }
 
 private:
-  bool isInside(TVector3 v) const { return bin->IsInside(v.X(), v.Y()); }
-  std::shared_ptr<TH2PolyBin> bin;
+  bool isInside(TVector3 v) const { return index->IsInside(v.X(), v.Y()); }
+  std::shared_ptr<PolygonGridIndex> index; // precomputed convex hull with excluded margin
 };
 using Cut3 = DistanceToBorder;
 
@@ -93,6 +126,17 @@ public:
                                 stop.Y() < maxY && stop.Y() > minY;
                        });
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    auto nSegments = columns.getNsegments();
+    TrackColumns::Flags isInside(nSegments);
+    for (size_t i = 0; i < nSegments; ++i) {
+      isInside[i] = columns.startX[i] < maxX && columns.startX[i] > minX &&
+                    columns.startY[i] < maxY && columns.startY[i] > minY &&
+                    columns.endX[i] < maxX && columns.endX[i] > minX &&
+                    columns.endY[i] < maxY && columns.endY[i] > minY;
+    }
+    columns.allSegments(isInside, result);
+  }
 
 private:
   double minX;
@@ -141,6 +185,12 @@ public:
     }
     return isInside(zmin, zmax);
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    result.resize(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+      result[i] = isInside(columns.zMin[i], columns.zMax[i]);
+    }
+  }
 
 private:
   bool isInside(double z1, double z2) const noexcept {
@@ -188,6 +238,18 @@ public:
                                 0.5 * (driftCageLength - beamDiameter);
                        });
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    auto nSegments = columns.getNsegments();
+    TrackColumns::Flags isInside(nSegments);
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto vertexZ = columns.vertexZ[i];
+      for (auto j = columns.firstSegment[i]; j < columns.firstSegment[i + 1]; ++j) {
+        isInside[j] = std::abs(columns.endZ[j] - vertexZ) <=
+                      0.5 * (driftCageLength - beamDiameter);
+      }
+    }
+    columns.allSegments(isInside, result);
+  }
 
 private:
   double driftCageLength;
@@ -245,6 +307,22 @@ public:
       //           track->getIntegratedCharge(track->getLength()) >= charge;
       ///// DEBUG
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    if (!columns.hasFitQuality()) {
+      throw std::runtime_error(
+          "ReconstructionQuality2Prong requires TrackColumns with fit quality");
+    }
+    result.resize(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto front = columns.longestSegment[i];
+      auto back = columns.shortestSegment[i];
+      result[i] = front < 0 ||
+                  (columns.pid[front] == firstPID && columns.pid[back] == secondPID &&
+                   columns.chi2[i] <= chi2 &&
+                   columns.hypothesisChi2[i] <= hypothesisChi2 &&
+                   columns.length[i] >= length);
+    }
+  }
 
 private:
   pid_type firstPID;
@@ -294,6 +372,20 @@ public:
       segments.back().getLength()>secondLengthMin &&
       segments.back().getLength()<secondLengthMax;
   }
+  void operator()(const TrackColumns &columns, TrackColumns::Flags &result) const {
+    result.resize(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto front = columns.longestSegment[i];
+      auto back = columns.shortestSegment[i];
+      result[i] = front < 0 ||
+                  ((!enablePIDcheck ||
+                    (columns.pid[front] == firstPID && columns.pid[back] == secondPID)) &&
+                   columns.segmentLength[front] > firstLengthMin &&
+                   columns.segmentLength[front] < firstLengthMax &&
+                   columns.segmentLength[back] > secondLengthMin &&
+                   columns.segmentLength[back] < secondLengthMax);
+    }
+  }
 
 private:
   bool enablePIDcheck;
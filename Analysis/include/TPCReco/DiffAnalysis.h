@@ -5,6 +5,7 @@
 #include "TPCReco/Track3D.h"
 #include <TFile.h>
 #include <TTree.h>
+#include <boost/filesystem.hpp>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -42,14 +43,21 @@ public:
   DetailSink(TTree *inputTree, TTree *referenceTree,
              const std::string &recoEventBranch,
              const std::string &eventInfoBranch)
+      : DetailSink(inputTree, referenceTree, inputTree, referenceTree,
+                   recoEventBranch, eventInfoBranch) {}
+  // reads inputTree and referenceTree, reports names of the source trees
+  // (e.g. when reading sorted copies of the source trees)
+  DetailSink(TTree *inputTree, TTree *referenceTree, TTree *inputSource,
+             TTree *referenceSource, const std::string &recoEventBranch,
+             const std::string &eventInfoBranch)
       : inputTree(inputTree), referenceTree(referenceTree) {
     inputTree->SetBranchAddress(recoEventBranch.c_str(), &inputTrack);
     referenceTree->SetBranchAddress(recoEventBranch.c_str(), &referenceTrack);
     inputTree->SetBranchAddress(eventInfoBranch.c_str(), &inputInfo);
     referenceTree->SetBranchAddress(eventInfoBranch.c_str(), &referenceInfo);
-    treeInfo = std::string() + "\t(" + inputTree->GetDirectory()->GetName() +
-               " vs " + referenceTree->GetDirectory()->GetName() + " / " +
-               referenceTree->GetName() + ')';
+    treeInfo = std::string() + "\t(" + inputSource->GetDirectory()->GetName() +
+               " vs " + referenceSource->GetDirectory()->GetName() + " / " +
+               referenceSource->GetName() + ')';
   }
   template <class T> void operator()(const T &lhs, const T &rhs) {
     auto entryIndex = boost::get<1>(lhs);
@@ -119,21 +127,72 @@ private:
   bool disabled = false;
 };
 
+// temporary ROOT file, removed on destruction
+class TemporaryFile {
+public:
+  TemporaryFile()
+      : path(boost::filesystem::temp_directory_path() /
+             boost::filesystem::unique_path("tpcreco-diff-%%%%-%%%%-%%%%.root")),
+        file(TFile::Open(path.c_str(), "RECREATE")) {
+    if (!file) {
+      throw std::logic_error("Can't create temporary file " + path.string());
+    }
+  }
+  ~TemporaryFile() {
+    file->Close();
+    delete file;
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+  }
+  TFile *get() const { return file; }
+
+private:
+  boost::filesystem::path path;
+  TFile *file;
+};
+
+// Entries of both trees are matched by (runId, eventId).
+// By default both trees are read sequentially, each of them once: trees which
+// are not sorted by (runId, eventId) are copied in this order into a temporary
+// file first (external merge sort). With useIndex=true TTreeIndex is built
+// instead and entries are read in random order.
 class Analysis {
 public:
-  Analysis(std::string inputName, std::string referenceName)
+  Analysis(std::string inputName, std::string referenceName,
+           bool useIndex = false)
       : inputFile(openFile(inputName)), referenceFile(openFile(referenceName)) {
     std::string treeName = "TPCRecoData";
     inputTree = openTree(inputFile, treeName.c_str());
     referenceTree = openTree(referenceFile, treeName.c_str());
     extras = std::make_unique<ExtraSink>(inputTree);
-    details = std::make_unique<DetailSink>(inputTree, referenceTree,
+    if (useIndex) {
+      buildIndex(inputTree);
+      buildIndex(referenceTree);
+      details = std::make_unique<DetailSink>(inputTree, referenceTree,
+                                             "RecoEvent", "EventInfo");
+      return;
+    }
+    auto inputSorted = sortTree(inputTree, inputKeys);
+    auto referenceSorted = sortTree(referenceTree, referenceKeys);
+    details = std::make_unique<DetailSink>(inputSorted, referenceSorted,
+                                           inputTree, referenceTree,
                                            "RecoEvent", "EventInfo");
   }
 
   void run() {
-    auto inputRange = tpcreco::utilities::getTreeIndexRange(inputTree);
-    auto referenceRange = tpcreco::utilities::getTreeIndexRange(referenceTree);
+    if (inputKeys) {
+      dispatch(inputKeys->range(), referenceKeys->range());
+    } else {
+      dispatch(tpcreco::utilities::getTreeIndexRange(inputTree),
+               tpcreco::utilities::getTreeIndexRange(referenceTree));
+    }
+  }
+
+  ExtraSink *getExtraSink() { return extras.get(); }
+  DetailSink *getDetailSink() { return details.get(); }
+
+private:
+  template <class Range> void dispatch(Range inputRange, Range referenceRange) {
     tpcreco::utilities::diffDispatcher(
         inputRange, referenceRange,
         [](const auto &lhs, const auto &rhs) {
@@ -144,11 +203,6 @@ public:
         },
         *details, *extras);
   }
-
-  ExtraSink *getExtraSink() { return extras.get(); }
-  DetailSink *getDetailSink() { return details.get(); }
-
-private:
   TFile *openFile(std::string name) {
     auto *file = TFile::Open(name.c_str(), "READ");
     if (!file) {
@@ -162,8 +216,9 @@ private:
       throw std::logic_error("No valid TTree " + name + " in file " +
                              file->GetName() + "\n");
     }
-    std::string majorIndex = "EventInfo.runId";
-    std::string minorIndex = "EventInfo.eventId";
+    return tree;
+  }
+  void buildIndex(TTree *tree) {
     auto ret = tree->BuildIndex(majorIndex.c_str(), minorIndex.c_str());
     if (ret != tree->GetEntries()) {
       throw std::logic_error("Can't build index: \"" + majorIndex + "\",\"" +
@@ -171,14 +226,32 @@ private:
                              " in file " + tree->GetDirectory()->GetName() +
                              "\n");
     }
+  }
+  // returns tree sorted by (runId, eventId), either the tree itself or its copy
+  TTree *sortTree(TTree *tree,
+                  std::unique_ptr<tpcreco::utilities::SortedKeyRange> &range) {
+    auto keys = tpcreco::utilities::readEntryKeys(tree, majorIndex, minorIndex);
+    if (!tpcreco::utilities::isSorted(keys)) {
+      temporaryFiles.push_back(std::make_unique<TemporaryFile>());
+      temporaryFiles.back()->get()->cd();
+      auto sortedTree = tree->CloneTree(0);
+      keys = tpcreco::utilities::fillSorted(tree, sortedTree, keys);
+      tree = sortedTree;
+    }
+    range = std::make_unique<tpcreco::utilities::SortedKeyRange>(keys);
     return tree;
   }
+  const std::string majorIndex = "EventInfo.runId";
+  const std::string minorIndex = "EventInfo.eventId";
   TFile *inputFile;
   TFile *referenceFile;
   TTree *inputTree;
   TTree *referenceTree;
   std::unique_ptr<ExtraSink> extras;
   std::unique_ptr<DetailSink> details;
+  std::unique_ptr<tpcreco::utilities::SortedKeyRange> inputKeys;
+  std::unique_ptr<tpcreco::utilities::SortedKeyRange> referenceKeys;
+  std::vector<std::unique_ptr<TemporaryFile>> temporaryFiles;
 };
 
 } // namespace diff
@@ -17,6 +17,8 @@
 #include "TPCReco/RequirementsCollection.h"
 #include "TPCReco/Track3D.h"
 #include "TPCReco/CoordinateConverter.h"
+#include "TPCReco/HistogramRegistry.h"
+#include "TPCReco/HIGGS_analysis_histos.h"
 
 class TH1F;
 class TH2F;
@@ -30,14 +32,25 @@ class HIGGS_analysis{
 		 TVector3 beamDir,   // nominal gamma beam direction in detector LAB frame
 		 IonRangeCalculator ionRangeCalculator,
 		 CoordinateConverter coordinateConverter,
-		 bool nominalBoostFlag); // forces to use nominal gamma beam energy for LAB<->CMS boost
+		 bool nominalBoostFlag, // forces to use nominal gamma beam energy for LAB<->CMS boost
+		 const std::string & outputFileName="Histos.root"); // empty name = histograms kept in memory only, e.g. for parallel workers
 
   ~HIGGS_analysis();
 
   void fillHistos(Track3D *aTrack);
+
+  // adds histograms of another instance booked with the same settings (TH1::Merge)
+  void merge(const HIGGS_analysis & other);
   
  private:
 
+  // compile-time handles of filled histograms, enumerator = histogram name
+#define HIGGS_ANALYSIS_HANDLE(name) name,
+  enum Histo1DHandle { HIGGS_ANALYSIS_HISTOS1D(HIGGS_ANALYSIS_HANDLE) nHistos1D };
+  enum Histo2DHandle { HIGGS_ANALYSIS_HISTOS2D(HIGGS_ANALYSIS_HANDLE) nHistos2D };
+  enum Profile1DHandle { HIGGS_ANALYSIS_PROFILES1D(HIGGS_ANALYSIS_HANDLE) nProfiles1D };
+#undef HIGGS_ANALYSIS_HANDLE
+
   void bookHistos();
 
   void finalize();
@@ -48,10 +61,10 @@ class HIGGS_analysis{
   TVector3 getBetaVectorOfCMS(double nucleusMassInMeV); // dimensionless speed (c=1) of gamma-nucleus CMS reference frame wrt LAB reference frame in detector coordinate system
   double getBetaOfCMS(double nucleusMassInMeV); // dimensionless speed (c=1) of gamma-nucleus CMS reference frame wrt LAB reference frame in detector coordinate system
 
-  TFile *outputFile;
-  std::map<std::string, TH1F*> histos1D;
-  std::map<std::string, TH2F*> histos2D;
-  std::map<std::string, TProfile*> profiles1D;
+  TFile *outputFile{nullptr}; // NULL = histograms are owned by this object
+  HistogramRegistry<TH1F> histos1D;
+  HistogramRegistry<TH2F> histos2D;
+  HistogramRegistry<TProfile> profiles1D;
   std::shared_ptr<GeometryTPC> myGeometryPtr; //! transient data member
   IonRangeCalculator myRangeCalculator;
   CoordinateConverter coordinateConverter;
@@ -0,0 +1,406 @@
+#ifndef _HIGGS_analysis_histos_H_
+#define _HIGGS_analysis_histos_H_
+
+// Names of histograms filled by HIGGS_analysis::fillHistos, one X(name) entry per histogram.
+// HIGGS_analysis turns each list into an enumeration, whose values are the handles of
+// the corresponding histograms in the registry (see HistogramRegistry.h).
+// NOTE: per-track histograms of 3-prong events (alpha1, alpha2, alpha3) and per-pair
+//       histograms (alpha1_alpha2, alpha1_alpha3, alpha2_alpha3) must stay consecutive,
+//       they are addressed as (first handle + track/pair index).
+
+// 1D histograms (TH1F)
+#define HIGGS_ANALYSIS_HISTOS1D(X) \
+  X(h_ntracks) \
+  X(h_all_vertexX) \
+  X(h_all_vertexY) \
+  X(h_all_vertexZ) \
+  X(h_all_vertexXBEAM) \
+  X(h_all_vertexYBEAM) \
+  X(h_all_vertexZBEAM) \
+  X(h_all_len) \
+  X(h_all_deltaX) \
+  X(h_all_deltaY) \
+  X(h_all_deltaZ) \
+  X(h_all_endX) \
+  X(h_all_endY) \
+  X(h_all_endZ) \
+  X(h_all_phiDET) \
+  X(h_all_thetaDET) \
+  X(h_all_cosThetaDET) \
+  X(h_all_phiBEAM_LAB) \
+  X(h_all_thetaBEAM_LAB) \
+  X(h_all_cosThetaBEAM_LAB) \
+  X(h_1prong_vertexX) \
+  X(h_1prong_vertexY) \
+  X(h_1prong_vertexZ) \
+  X(h_1prong_vertexXBEAM) \
+  X(h_1prong_vertexYBEAM) \
+  X(h_1prong_vertexZBEAM) \
+  X(h_1prong_alpha_len) \
+  X(h_1prong_alpha_deltaX) \
+  X(h_1prong_alpha_deltaY) \
+  X(h_1prong_alpha_deltaZ) \
+  X(h_1prong_alpha_endX) \
+  X(h_1prong_alpha_endY) \
+  X(h_1prong_alpha_endZ) \
+  X(h_1prong_alpha_phiDET) \
+  X(h_1prong_alpha_thetaDET) \
+  X(h_1prong_alpha_cosThetaDET) \
+  X(h_1prong_alpha_phiBEAM_LAB) \
+  X(h_1prong_alpha_thetaBEAM_LAB) \
+  X(h_1prong_alpha_cosThetaBEAM_LAB) \
+  X(h_1prong_alpha_E_LAB) \
+  X(h_2prong_vertexX) \
+  X(h_2prong_vertexY) \
+  X(h_2prong_vertexZ) \
+  X(h_2prong_vertexXBEAM) \
+  X(h_2prong_vertexYBEAM) \
+  X(h_2prong_vertexZBEAM) \
+  X(h_2prong_alpha_len) \
+  X(h_2prong_lenSum) \
+  X(h_2prong_alpha_deltaX) \
+  X(h_2prong_alpha_deltaY) \
+  X(h_2prong_alpha_deltaZ) \
+  X(h_2prong_alpha_endX) \
+  X(h_2prong_alpha_endY) \
+  X(h_2prong_alpha_endZ) \
+  X(h_2prong_alpha_phiDET) \
+  X(h_2prong_alpha_thetaDET) \
+  X(h_2prong_alpha_cosThetaDET) \
+  X(h_2prong_carbon_len) \
+  X(h_2prong_carbon_deltaX) \
+  X(h_2prong_carbon_deltaY) \
+  X(h_2prong_carbon_deltaZ) \
+  X(h_2prong_carbon_endX) \
+  X(h_2prong_carbon_endY) \
+  X(h_2prong_carbon_endZ) \
+  X(h_2prong_carbon_phiDET) \
+  X(h_2prong_carbon_thetaDET) \
+  X(h_2prong_carbon_cosThetaDET) \
+  X(h_2prong_alpha_carbon_delta_LAB) \
+  X(h_2prong_alpha_carbon_cosDelta_LAB) \
+  X(h_2prong_alpha_phiBEAM_LAB) \
+  X(h_2prong_alpha_thetaBEAM_LAB) \
+  X(h_2prong_alpha_cosThetaBEAM_LAB) \
+  X(h_2prong_carbon_phiBEAM_LAB) \
+  X(h_2prong_carbon_thetaBEAM_LAB) \
+  X(h_2prong_carbon_cosThetaBEAM_LAB) \
+  X(h_2prong_alpha_E_LAB) \
+  X(h_2prong_carbon_E_LAB) \
+  X(h_2prong_alpha_E_CMS) \
+  X(h_2prong_carbon_E_CMS) \
+  X(h_2prong_total_PxBEAM_CMS) \
+  X(h_2prong_total_PyBEAM_CMS) \
+  X(h_2prong_total_PzBEAM_CMS) \
+  X(h_2prong_total_PxBEAM_LAB) \
+  X(h_2prong_total_PyBEAM_LAB) \
+  X(h_2prong_total_PzBEAM_LAB) \
+  X(h_2prong_total_E_CMS) \
+  X(h_2prong_excitation_E_CMS) \
+  X(h_2prong_Qvalue_CMS) \
+  X(h_2prong_gamma_E_LAB) \
+  X(h_2prong_E_CMS) \
+  X(h_2prong_E_LAB) \
+  X(h_2prong_alpha_phiBEAM_CMS) \
+  X(h_2prong_alpha_thetaBEAM_CMS) \
+  X(h_2prong_alpha_cosThetaBEAM_CMS) \
+  X(h_2prong_carbon_phiBEAM_CMS) \
+  X(h_2prong_carbon_thetaBEAM_CMS) \
+  X(h_2prong_carbon_cosThetaBEAM_CMS) \
+  X(h_2prong_alpha_carbon_delta_CMS) \
+  X(h_2prong_alpha_carbon_cosDelta_CMS) \
+  X(h_3prong_vertexX) \
+  X(h_3prong_vertexY) \
+  X(h_3prong_vertexZ) \
+  X(h_3prong_vertexXBEAM) \
+  X(h_3prong_vertexYBEAM) \
+  X(h_3prong_vertexZBEAM) \
+  X(h_3prong_alpha1_len) \
+  X(h_3prong_alpha2_len) \
+  X(h_3prong_alpha3_len) \
+  X(h_3prong_alpha1_deltaX) \
+  X(h_3prong_alpha2_deltaX) \
+  X(h_3prong_alpha3_deltaX) \
+  X(h_3prong_alpha1_deltaY) \
+  X(h_3prong_alpha2_deltaY) \
+  X(h_3prong_alpha3_deltaY) \
+  X(h_3prong_alpha1_deltaZ) \
+  X(h_3prong_alpha2_deltaZ) \
+  X(h_3prong_alpha3_deltaZ) \
+  X(h_3prong_alpha1_endX) \
+  X(h_3prong_alpha2_endX) \
+  X(h_3prong_alpha3_endX) \
+  X(h_3prong_alpha1_endY) \
+  X(h_3prong_alpha2_endY) \
+  X(h_3prong_alpha3_endY) \
+  X(h_3prong_alpha1_endZ) \
+  X(h_3prong_alpha2_endZ) \
+  X(h_3prong_alpha3_endZ) \
+  X(h_3prong_alpha1_phiDET) \
+  X(h_3prong_alpha2_phiDET) \
+  X(h_3prong_alpha3_phiDET) \
+  X(h_3prong_alpha1_thetaDET) \
+  X(h_3prong_alpha2_thetaDET) \
+  X(h_3prong_alpha3_thetaDET) \
+  X(h_3prong_alpha1_cosThetaDET) \
+  X(h_3prong_alpha2_cosThetaDET) \
+  X(h_3prong_alpha3_cosThetaDET) \
+  X(h_3prong_alpha1_phiBEAM_LAB) \
+  X(h_3prong_alpha2_phiBEAM_LAB) \
+  X(h_3prong_alpha3_phiBEAM_LAB) \
+  X(h_3prong_alpha1_thetaBEAM_LAB) \
+  X(h_3prong_alpha2_thetaBEAM_LAB) \
+  X(h_3prong_alpha3_thetaBEAM_LAB) \
+  X(h_3prong_alpha1_cosThetaBEAM_LAB) \
+  X(h_3prong_alpha2_cosThetaBEAM_LAB) \
+  X(h_3prong_alpha3_cosThetaBEAM_LAB) \
+  X(h_3prong_alpha1_E_LAB) \
+  X(h_3prong_alpha2_E_LAB) \
+  X(h_3prong_alpha3_E_LAB) \
+  X(h_3prong_alpha1_phiBEAM_CMS) \
+  X(h_3prong_alpha2_phiBEAM_CMS) \
+  X(h_3prong_alpha3_phiBEAM_CMS) \
+  X(h_3prong_alpha1_thetaBEAM_CMS) \
+  X(h_3prong_alpha2_thetaBEAM_CMS) \
+  X(h_3prong_alpha3_thetaBEAM_CMS) \
+  X(h_3prong_alpha1_cosThetaBEAM_CMS) \
+  X(h_3prong_alpha2_cosThetaBEAM_CMS) \
+  X(h_3prong_alpha3_cosThetaBEAM_CMS) \
+  X(h_3prong_alpha1_E_CMS) \
+  X(h_3prong_alpha2_E_CMS) \
+  X(h_3prong_alpha3_E_CMS) \
+  X(h_3prong_alpha1_alpha2_delta_LAB) \
+  X(h_3prong_alpha1_alpha3_delta_LAB) \
+  X(h_3prong_alpha2_alpha3_delta_LAB) \
+  X(h_3prong_alpha1_alpha2_cosDelta_LAB) \
+  X(h_3prong_alpha1_alpha3_cosDelta_LAB) \
+  X(h_3prong_alpha2_alpha3_cosDelta_LAB) \
+  X(h_3prong_alpha1_alpha2_delta_CMS) \
+  X(h_3prong_alpha1_alpha3_delta_CMS) \
+  X(h_3prong_alpha2_alpha3_delta_CMS) \
+  X(h_3prong_alpha1_alpha2_cosDelta_CMS) \
+  X(h_3prong_alpha1_alpha3_cosDelta_CMS) \
+  X(h_3prong_alpha2_alpha3_cosDelta_CMS) \
+  X(h_3prong_lenSum) \
+  X(h_3prong_total_PxBEAM_CMS) \
+  X(h_3prong_total_PyBEAM_CMS) \
+  X(h_3prong_total_PzBEAM_CMS) \
+  X(h_3prong_total_PxBEAM_LAB) \
+  X(h_3prong_total_PyBEAM_LAB) \
+  X(h_3prong_total_PzBEAM_LAB) \
+  X(h_3prong_total_E_CMS) \
+  X(h_3prong_excitation_E_CMS) \
+  X(h_3prong_Qvalue_CMS) \
+  X(h_3prong_gamma_E_LAB) \
+  X(h_3prong_E_CMS) \
+  X(h_3prong_E_LAB)
+
+// 2D histograms (TH2F)
+#define HIGGS_ANALYSIS_HISTOS2D(X) \
+  X(h_all_vertexXY) \
+  X(h_all_vertexYZ) \
+  X(h_all_vertexZXBEAM) \
+  X(h_all_vertexXYBEAM) \
+  X(h_all_deltaXY) \
+  X(h_all_deltaXZ) \
+  X(h_all_deltaYZ) \
+  X(h_all_endXY) \
+  X(h_all_cosThetaBEAM_len_LAB) \
+  X(h_1prong_vertexXY) \
+  X(h_1prong_vertexYZ) \
+  X(h_1prong_vertexZXBEAM) \
+  X(h_1prong_vertexXYBEAM) \
+  X(h_1prong_alpha_deltaXY) \
+  X(h_1prong_alpha_deltaXZ) \
+  X(h_1prong_alpha_deltaYZ) \
+  X(h_1prong_alpha_endXY) \
+  X(h_1prong_alpha_cosThetaBEAM_len_LAB) \
+  X(h_1prong_alpha_cosThetaBEAM_E_LAB) \
+  X(h_2prong_vertexXY) \
+  X(h_2prong_vertexYZ) \
+  X(h_2prong_vertexZXBEAM) \
+  X(h_2prong_vertexXYBEAM) \
+  X(h_2prong_alpha_len_carbon_len) \
+  X(h_2prong_alpha_deltaXY) \
+  X(h_2prong_alpha_deltaXZ) \
+  X(h_2prong_alpha_deltaYZ) \
+  X(h_2prong_alpha_endXY) \
+  X(h_2prong_carbon_deltaXY) \
+  X(h_2prong_carbon_deltaXZ) \
+  X(h_2prong_carbon_deltaYZ) \
+  X(h_2prong_carbon_endXY) \
+  X(h_2prong_alpha_cosThetaBEAM_len_LAB) \
+  X(h_2prong_carbon_cosThetaBEAM_len_LAB) \
+  X(h_2prong_alpha_cosThetaBEAM_E_CMS) \
+  X(h_2prong_alpha_cosThetaBEAM_E_LAB) \
+  X(h_2prong_carbon_cosThetaBEAM_E_CMS) \
+  X(h_2prong_carbon_cosThetaBEAM_E_LAB) \
+  X(h_2prong_alpha_E_carbon_E_CMS) \
+  X(h_2prong_alpha_E_carbon_E_LAB) \
+  X(h_2prong_vertexX_lenSum) \
+  X(h_2prong_vertexY_lenSum) \
+  X(h_2prong_vertexZ_lenSum) \
+  X(h_2prong_vertexY_alpha_len) \
+  X(h_2prong_vertexY_carbon_len) \
+  X(h_2prong_vertexY_alpha_E_LAB) \
+  X(h_2prong_vertexY_carbon_E_LAB) \
+  X(h_2prong_vertexY_alpha_E_CMS) \
+  X(h_2prong_vertexY_carbon_E_CMS) \
+  X(h_2prong_vertexY_alpha_cosThetaBEAM_LAB) \
+  X(h_2prong_vertexY_carbon_cosThetaBEAM_LAB) \
+  X(h_2prong_vertexY_alpha_cosThetaBEAM_CMS) \
+  X(h_2prong_vertexY_carbon_cosThetaBEAM_CMS) \
+  X(h_2prong_vertexY_gamma_E_LAB) \
+  X(h_2prong_vertexY_Qvalue_CMS) \
+  X(h_2prong_vertexXBEAM_alpha_E_LAB) \
+  X(h_2prong_vertexXBEAM_carbon_E_LAB) \
+  X(h_2prong_vertexXBEAM_alpha_E_CMS) \
+  X(h_2prong_vertexXBEAM_carbon_E_CMS) \
+  X(h_2prong_vertexXBEAM_alpha_cosThetaBEAM_LAB) \
+  X(h_2prong_vertexXBEAM_carbon_cosThetaBEAM_LAB) \
+  X(h_2prong_vertexXBEAM_alpha_cosThetaBEAM_CMS) \
+  X(h_2prong_vertexXBEAM_carbon_cosThetaBEAM_CMS) \
+  X(h_2prong_vertexXBEAM_gamma_E_LAB) \
+  X(h_2prong_vertexXBEAM_Qvalue_CMS) \
+  X(h_3prong_vertexXY) \
+  X(h_3prong_vertexYZ) \
+  X(h_3prong_vertexZXBEAM) \
+  X(h_3prong_vertexXYBEAM) \
+  X(h_3prong_alpha1_deltaXY) \
+  X(h_3prong_alpha2_deltaXY) \
+  X(h_3prong_alpha3_deltaXY) \
+  X(h_3prong_alpha1_deltaXZ) \
+  X(h_3prong_alpha2_deltaXZ) \
+  X(h_3prong_alpha3_deltaXZ) \
+  X(h_3prong_alpha1_deltaYZ) \
+  X(h_3prong_alpha2_deltaYZ) \
+  X(h_3prong_alpha3_deltaYZ) \
+  X(h_3prong_alpha1_endXY) \
+  X(h_3prong_alpha2_endXY) \
+  X(h_3prong_alpha3_endXY) \
+  X(h_3prong_alpha1_cosThetaBEAM_len_LAB) \
+  X(h_3prong_alpha2_cosThetaBEAM_len_LAB) \
+  X(h_3prong_alpha3_cosThetaBEAM_len_LAB) \
+  X(h_3prong_alpha1_cosThetaBEAM_E_LAB) \
+  X(h_3prong_alpha2_cosThetaBEAM_E_LAB) \
+  X(h_3prong_alpha3_cosThetaBEAM_E_LAB) \
+  X(h_3prong_alpha1_cosThetaBEAM_E_CMS) \
+  X(h_3prong_alpha2_cosThetaBEAM_E_CMS) \
+  X(h_3prong_alpha3_cosThetaBEAM_E_CMS) \
+  X(h_3prong_vertexY_alpha1_E_LAB) \
+  X(h_3prong_vertexY_alpha2_E_LAB) \
+  X(h_3prong_vertexY_alpha3_E_LAB) \
+  X(h_3prong_vertexY_alpha1_E_CMS) \
+  X(h_3prong_vertexY_alpha2_E_CMS) \
+  X(h_3prong_vertexY_alpha3_E_CMS) \
+  X(h_3prong_vertexY_alpha1_len) \
+  X(h_3prong_vertexY_alpha2_len) \
+  X(h_3prong_vertexY_alpha3_len) \
+  X(h_3prong_vertexY_alpha1_cosThetaBEAM_LAB) \
+  X(h_3prong_vertexY_alpha2_cosThetaBEAM_LAB) \
+  X(h_3prong_vertexY_alpha3_cosThetaBEAM_LAB) \
+  X(h_3prong_vertexY_alpha1_cosThetaBEAM_CMS) \
+  X(h_3prong_vertexY_alpha2_cosThetaBEAM_CMS) \
+  X(h_3prong_vertexY_alpha3_cosThetaBEAM_CMS) \
+  X(h_3prong_vertexXBEAM_alpha1_E_LAB) \
+  X(h_3prong_vertexXBEAM_alpha2_E_LAB) \
+  X(h_3prong_vertexXBEAM_alpha3_E_LAB) \
+  X(h_3prong_vertexXBEAM_alpha1_E_CMS) \
+  X(h_3prong_vertexXBEAM_alpha2_E_CMS) \
+  X(h_3prong_vertexXBEAM_alpha3_E_CMS) \
+  X(h_3prong_vertexXBEAM_alpha1_cosThetaBEAM_LAB) \
+  X(h_3prong_vertexXBEAM_alpha2_cosThetaBEAM_LAB) \
+  X(h_3prong_vertexXBEAM_alpha3_cosThetaBEAM_LAB) \
+  X(h_3prong_vertexXBEAM_alpha1_cosThetaBEAM_CMS) \
+  X(h_3prong_vertexXBEAM_alpha2_cosThetaBEAM_CMS) \
+  X(h_3prong_vertexXBEAM_alpha3_cosThetaBEAM_CMS) \
+  X(h_3prong_alpha1_len_alpha2_len) \
+  X(h_3prong_alpha1_len_alpha3_len) \
+  X(h_3prong_alpha2_len_alpha3_len) \
+  X(h_3prong_alpha1_E_alpha2_E_LAB) \
+  X(h_3prong_alpha1_E_alpha3_E_LAB) \
+  X(h_3prong_alpha2_E_alpha3_E_LAB) \
+  X(h_3prong_alpha1_E_alpha2_E_CMS) \
+  X(h_3prong_alpha1_E_alpha3_E_CMS) \
+  X(h_3prong_alpha2_E_alpha3_E_CMS) \
+  X(h_3prong_vertexX_lenSum) \
+  X(h_3prong_vertexY_lenSum) \
+  X(h_3prong_vertexZ_lenSum) \
+  X(h_3prong_vertexY_gamma_E_LAB) \
+  X(h_3prong_vertexY_Qvalue_CMS) \
+  X(h_3prong_vertexXBEAM_gamma_E_LAB) \
+  X(h_3prong_vertexXBEAM_Qvalue_CMS) \
+  X(h_3prong_Dalitz3_CMS) \
+  X(h_3prong_Dalitz4_CMS) \
+  X(h_3prong_Dalitz1_CMS) \
+  X(h_3prong_Dalitz2_CMS)
+
+// 1D profiles (TProfile)
+#define HIGGS_ANALYSIS_PROFILES1D(X) \
+  X(h_all_vertexXY_prof) \
+  X(h_all_vertexZXBEAM_prof) \
+  X(h_all_cosThetaBEAM_len_LAB_prof) \
+  X(h_1prong_vertexXY_prof) \
+  X(h_1prong_vertexZXBEAM_prof) \
+  X(h_1prong_alpha_cosThetaBEAM_len_LAB_prof) \
+  X(h_1prong_alpha_cosThetaBEAM_E_LAB_prof) \
+  X(h_2prong_vertexXY_prof) \
+  X(h_2prong_vertexZXBEAM_prof) \
+  X(h_2prong_alpha_cosThetaBEAM_len_LAB_prof) \
+  X(h_2prong_carbon_cosThetaBEAM_len_LAB_prof) \
+  X(h_2prong_alpha_cosThetaBEAM_E_CMS_prof) \
+  X(h_2prong_alpha_cosThetaBEAM_E_LAB_prof) \
+  X(h_2prong_carbon_cosThetaBEAM_E_CMS_prof) \
+  X(h_2prong_carbon_cosThetaBEAM_E_LAB_prof) \
+  X(h_2prong_vertexX_lenSum_prof) \
+  X(h_2prong_vertexY_lenSum_prof) \
+  X(h_2prong_vertexZ_lenSum_prof) \
+  X(h_2prong_vertexY_alpha_len_prof) \
+  X(h_2prong_vertexY_carbon_len_prof) \
+  X(h_2prong_vertexY_alpha_E_LAB_prof) \
+  X(h_2prong_vertexY_carbon_E_LAB_prof) \
+  X(h_2prong_vertexY_alpha_E_CMS_prof) \
+  X(h_2prong_vertexY_carbon_E_CMS_prof) \
+  X(h_2prong_vertexY_gamma_E_LAB_prof) \
+  X(h_2prong_vertexY_Qvalue_CMS_prof) \
+  X(h_2prong_vertexXBEAM_alpha_E_LAB_prof) \
+  X(h_2prong_vertexXBEAM_carbon_E_LAB_prof) \
+  X(h_2prong_vertexXBEAM_alpha_E_CMS_prof) \
+  X(h_2prong_vertexXBEAM_carbon_E_CMS_prof) \
+  X(h_2prong_vertexXBEAM_gamma_E_LAB_prof) \
+  X(h_2prong_vertexXBEAM_Qvalue_CMS_prof) \
+  X(h_3prong_vertexXY_prof) \
+  X(h_3prong_vertexZXBEAM_prof) \
+  X(h_3prong_alpha1_cosThetaBEAM_len_LAB_prof) \
+  X(h_3prong_alpha2_cosThetaBEAM_len_LAB_prof) \
+  X(h_3prong_alpha3_cosThetaBEAM_len_LAB_prof) \
+  X(h_3prong_alpha1_cosThetaBEAM_E_LAB_prof) \
+  X(h_3prong_alpha2_cosThetaBEAM_E_LAB_prof) \
+  X(h_3prong_alpha3_cosThetaBEAM_E_LAB_prof) \
+  X(h_3prong_alpha1_cosThetaBEAM_E_CMS_prof) \
+  X(h_3prong_alpha2_cosThetaBEAM_E_CMS_prof) \
+  X(h_3prong_alpha3_cosThetaBEAM_E_CMS_prof) \
+  X(h_3prong_vertexY_alpha1_E_LAB_prof) \
+  X(h_3prong_vertexY_alpha2_E_LAB_prof) \
+  X(h_3prong_vertexY_alpha3_E_LAB_prof) \
+  X(h_3prong_vertexY_alpha1_E_CMS_prof) \
+  X(h_3prong_vertexY_alpha2_E_CMS_prof) \
+  X(h_3prong_vertexY_alpha3_E_CMS_prof) \
+  X(h_3prong_vertexY_alpha1_len_prof) \
+  X(h_3prong_vertexY_alpha2_len_prof) \
+  X(h_3prong_vertexY_alpha3_len_prof) \
+  X(h_3prong_vertexXBEAM_alpha1_E_LAB_prof) \
+  X(h_3prong_vertexXBEAM_alpha2_E_LAB_prof) \
+  X(h_3prong_vertexXBEAM_alpha3_E_LAB_prof) \
+  X(h_3prong_vertexXBEAM_alpha1_E_CMS_prof) \
+  X(h_3prong_vertexXBEAM_alpha2_E_CMS_prof) \
+  X(h_3prong_vertexXBEAM_alpha3_E_CMS_prof) \
+  X(h_3prong_vertexX_lenSum_prof) \
+  X(h_3prong_vertexY_lenSum_prof) \
+  X(h_3prong_vertexZ_lenSum_prof) \
+  X(h_3prong_vertexY_gamma_E_LAB_prof) \
+  X(h_3prong_vertexY_Qvalue_CMS_prof) \
+  X(h_3prong_vertexXBEAM_gamma_E_LAB_prof) \
+  X(h_3prong_vertexXBEAM_Qvalue_CMS_prof)
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef TPCRECO_ANALYSIS_TRACK_COLUMNS_H_
+#define TPCRECO_ANALYSIS_TRACK_COLUMNS_H_
+#include "TPCReco/CommonDefinitions.h"
+#include <TVector3.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+namespace tpcreco {
+namespace cuts {
+
+// Columnar (structure of arrays) copy of reconstructed events, holds only
+// the features used by the cuts from Cuts.h, for batch evaluation with
+// BatchRequirementsCollection.
+// Derived per-event quantities are computed once, when an event is added:
+// - vertex position and global Z-span are NaN for empty events, hence every
+//   comparison involving them fails, like Cut1 does
+// - for 2-prong events the longest and the shortest segment are resolved
+//   with the same tie-breaking as std::sort used by Cut6 and Cut7
+// Track fit quality (chi2 etc.) is expensive to compute and it is stored
+// only on request (needed by Cut6).
+struct TrackColumns {
+  using Flags = std::vector<unsigned char>;
+
+  explicit TrackColumns(bool withFitQuality = false)
+      : withFitQuality(withFitQuality) {}
+
+  template <class Track> void push_back(Track *track) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto first = startX.size();
+    auto zmin = nan;
+    auto zmax = nan;
+    TVector3 vertex(nan, nan, nan);
+    int longest = -1;
+    int shortest = -1;
+    if (track != nullptr) {
+      const auto &segments = track->getSegments();
+      for (const auto &segment : segments) {
+        auto start = segment.getStart();
+        auto end = segment.getEnd();
+        startX.push_back(start.X());
+        startY.push_back(start.Y());
+        startZ.push_back(start.Z());
+        endX.push_back(end.X());
+        endY.push_back(end.Y());
+        endZ.push_back(end.Z());
+        segmentLength.push_back(segment.getLength());
+        pid.push_back(segment.getPID());
+        if (startX.size() == first + 1) {
+          vertex = start;
+          zmin = zmax = start.Z();
+        }
+        zmin = std::min(zmin, std::min(start.Z(), end.Z()));
+        zmax = std::max(zmax, std::max(start.Z(), end.Z()));
+      }
+      if (segments.size() == 2) {
+        longest = segmentLength[first + 1] > segmentLength[first] ? 1 : 0;
+        shortest = 1 - longest;
+      }
+    }
+    firstSegment.push_back(startX.size());
+    vertexX.push_back(vertex.X());
+    vertexY.push_back(vertex.Y());
+    vertexZ.push_back(vertex.Z());
+    zMin.push_back(zmin);
+    zMax.push_back(zmax);
+    longestSegment.push_back(longest < 0 ? -1 : static_cast<long>(first) + longest);
+    shortestSegment.push_back(shortest < 0 ? -1 : static_cast<long>(first) + shortest);
+    if (withFitQuality) {
+      auto isFilled = track != nullptr && longest >= 0; // 2-prong only
+      chi2.push_back(isFilled ? track->getChi2() : nan);
+      hypothesisChi2.push_back(isFilled ? track->getHypothesisFitChi2() : nan);
+      length.push_back(isFilled ? track->getLength() : nan);
+    }
+  }
+
+  void reserve(size_t nEvents, size_t nSegments) {
+    for (auto column : {&vertexX, &vertexY, &vertexZ, &zMin, &zMax}) {
+      column->reserve(nEvents);
+    }
+    firstSegment.reserve(nEvents + 1);
+    longestSegment.reserve(nEvents);
+    shortestSegment.reserve(nEvents);
+    for (auto column : {&startX, &startY, &startZ, &endX, &endY, &endZ, &segmentLength}) {
+      column->reserve(nSegments);
+    }
+    pid.reserve(nSegments);
+  }
+
+  void clear() {
+    for (auto column : {&vertexX, &vertexY, &vertexZ, &zMin, &zMax, &chi2,
+                        &hypothesisChi2, &length, &startX, &startY, &startZ,
+                        &endX, &endY, &endZ, &segmentLength}) {
+      column->clear();
+    }
+    firstSegment.assign(1, 0);
+    longestSegment.clear();
+    shortestSegment.clear();
+    pid.clear();
+  }
+
+  size_t size() const noexcept { return vertexX.size(); }
+  size_t getNsegments() const noexcept { return startX.size(); }
+  bool hasFitQuality() const noexcept { return withFitQuality; }
+
+  // per-segment flags -> per-event flags, event passes if all its segments
+  // pass (empty events pass, like std::all_of)
+  void allSegments(const Flags &segmentFlags, Flags &eventFlags) const {
+    eventFlags.resize(size());
+    for (size_t i = 0; i < size(); ++i) {
+      eventFlags[i] = std::all_of(segmentFlags.begin() + firstSegment[i],
+                                  segmentFlags.begin() + firstSegment[i + 1],
+                                  [](unsigned char f) { return f != 0; });
+    }
+  }
+
+  // per event
+  std::vector<size_t> firstSegment{0}; // segments of event i: [firstSegment[i], firstSegment[i+1])
+  std::vector<double> vertexX, vertexY, vertexZ; // start of the first segment [mm]
+  std::vector<double> zMin, zMax; // global Z-span of all segments [mm]
+  std::vector<long> longestSegment, shortestSegment; // 2-prong events only, -1 otherwise
+  std::vector<double> chi2, hypothesisChi2, length; // with fit quality, 2-prong events only
+
+  // per segment
+  std::vector<double> startX, startY, startZ, endX, endY, endZ; // [mm]
+  std::vector<double> segmentLength; // [mm]
+  std::vector<pid_type> pid;
+
+private:
+  bool withFitQuality;
+};
+
+} // namespace cuts
+} // namespace tpcreco
+
+#endif // TPCRECO_ANALYSIS_TRACK_COLUMNS_H_
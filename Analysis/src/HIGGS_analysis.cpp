@@ -6,6 +6,7 @@
 #include <TH2F.h>
 #include <TProfile.h>
 #include <TFile.h>
+#include <TList.h>
 #include <TVector3.h>
 #include <TLorentzVector.h>
 
@@ -17,6 +18,15 @@
 #include "TPCReco/Cuts.h"
 #include "TPCReco/UtilsMath.h"
 
+namespace {
+  // histogram names in the order of compile-time handles, see HIGGS_analysis_histos.h
+#define HIGGS_ANALYSIS_NAME(name) #name,
+  const std::vector<std::string> histos1DNames{ HIGGS_ANALYSIS_HISTOS1D(HIGGS_ANALYSIS_NAME) };
+  const std::vector<std::string> histos2DNames{ HIGGS_ANALYSIS_HISTOS2D(HIGGS_ANALYSIS_NAME) };
+  const std::vector<std::string> profiles1DNames{ HIGGS_ANALYSIS_PROFILES1D(HIGGS_ANALYSIS_NAME) };
+#undef HIGGS_ANALYSIS_NAME
+}
+
 ///////////////////////////////
 ///////////////////////////////
 HIGGS_analysis::HIGGS_analysis(std::shared_ptr<GeometryTPC> aGeometryPtr, // definition of LAB detector coordinates
@@ -24,20 +34,31 @@ HIGGS_analysis::HIGGS_analysis(std::shared_ptr<GeometryTPC> aGeometryPtr, // def
 			       TVector3 beamDir,   // nominal gamma beam direction in detector LAB frame
 			       IonRangeCalculator ionRangeCalculator,
 			       CoordinateConverter coordinateConverter,
-			       bool nominalBoostFlag)
-  : myRangeCalculator(ionRangeCalculator),
+			       bool nominalBoostFlag,
+			       const std::string & outputFileName)
+  : histos1D(histos1DNames),
+    histos2D(histos2DNames),
+    profiles1D(profiles1DNames),
+    myRangeCalculator(ionRangeCalculator),
     coordinateConverter(coordinateConverter),
     useNominalPhotonEnergyForBoost(nominalBoostFlag) {
   setGeometry(aGeometryPtr);
   setBeamProperties(beamEnergy, beamDir);
+  if(outputFileName.size()) outputFile = new TFile(outputFileName.c_str(),"RECREATE");
   bookHistos();
 }
 ///////////////////////////////
 ///////////////////////////////
 HIGGS_analysis::~HIGGS_analysis(){
 
-  finalize();
-  delete outputFile;
+  if(outputFile) {
+    finalize();
+    delete outputFile;
+    return;
+  }
+  for (auto h : histos1D) delete h;
+  for (auto h : histos2D) delete h;
+  for (auto p : profiles1D) delete p;
 }
 
 ///////////////////////////////
@@ -77,8 +98,9 @@ void HIGGS_analysis::bookHistos(){
   categoryPIDlatex[3].push_back("#alpha_{2}"); // 3-prong 2nd alpha
   categoryPIDlatex[3].push_back("#alpha_{3}"); // 3-prong 3rd alpha
   
-  std::string outputFileName = "Histos.root";
-  outputFile = new TFile(outputFileName.c_str(),"RECREATE");
+  // without output file histograms are not attached to any directory
+  const bool addDirectoryStatus=TH1::AddDirectoryStatus();
+  if(!outputFile) TH1::AddDirectory(false);
 
   const float binSizeMM = 0.5; // [mm]
   //  const float binSizeMM_2d = 3.0; // [mm]
@@ -102,8 +124,8 @@ void HIGGS_analysis::bookHistos(){
   // GLOBAL HISTOGRAMS
   //
   // NTRACKS : ALL event categories
-  histos1D["h_ntracks"]=
-    new TH1F("h_ntracks","Number of tracks;Tracks per event;Event count", 5, 0, 5);
+  histos1D.add(
+    new TH1F("h_ntracks","Number of tracks;Tracks per event;Event count", 5, 0, 5));
 
   // HISTOGRAMS PER CATEGORY
   //
@@ -114,211 +136,211 @@ void HIGGS_analysis::bookHistos(){
     auto perTrackTitle=(c==0 ? "Track count / bin" : perEventTitle );
 
     // VERTEX : per category
-    histos1D[(prefix+"_vertexX").c_str()]=
+    histos1D.add(
       new TH1F((prefix+"_vertexX").c_str(),
 	       Form("%s;Vertex position X_{DET} [mm];%s", info, perEventTitle),
-	       (xmax-xmin)/binSizeMM, xmin, xmax);
-    histos1D[(prefix+"_vertexY").c_str()]=
+	       (xmax-xmin)/binSizeMM, xmin, xmax));
+    histos1D.add(
       new TH1F((prefix+"_vertexY").c_str(),
 	       Form("%s;Vertex position Y_{DET} [mm];%s", info, perEventTitle),
-	       (ymax-ymin)/binSizeMM, ymin, ymax);
-    histos1D[(prefix+"_vertexZ").c_str()]=
+	       (ymax-ymin)/binSizeMM, ymin, ymax));
+    histos1D.add(
       new TH1F((prefix+"_vertexZ").c_str(),
 	       Form("%s;Vertex position Z_{DET} [mm];%s", info, perEventTitle),
-	       (zmax-zmin)/binSizeMM, zmin, zmax);
-    histos2D[(prefix+"_vertexXY").c_str()]=
+	       (zmax-zmin)/binSizeMM, zmin, zmax));
+    histos2D.add(
       new TH2F((prefix+"_vertexXY").c_str(),
 	       Form("%s;Vertex position X_{DET} [mm];Vertex position Y_{DET} [mm];%s", info, perEventTitle),
-	       (xmax-xmin)/binSizeMM_2dXY, xmin, xmax, (ymax-ymin)/binSizeMM_2dXY, ymin, ymax);
-    histos2D[(prefix+"_vertexYZ").c_str()]=
+	       (xmax-xmin)/binSizeMM_2dXY, xmin, xmax, (ymax-ymin)/binSizeMM_2dXY, ymin, ymax));
+    histos2D.add(
       new TH2F((prefix+"_vertexYZ").c_str(),
 	       Form("%s;Vertex position Y_{DET} [mm];Vertex position Z_{DET} [mm];%s", info, perEventTitle),
-	       (ymax-ymin)/binSizeMM_2dYZ, ymin, ymax, (zmax-zmin)/binSizeMM_2dYZ, zmin, zmax);
-    profiles1D[(prefix+"_vertexXY_prof").c_str()]=
+	       (ymax-ymin)/binSizeMM_2dYZ, ymin, ymax, (zmax-zmin)/binSizeMM_2dYZ, zmin, zmax));
+    profiles1D.add(
       new TProfile((prefix+"_vertexXY_prof").c_str(),
 		   Form("%s;Vertex position X_{DET} [mm];Average vertex position Y_{DET} [mm];%s", info, perEventTitle),
-		   (xmax-xmin)/binSizeMM_prof, xmin, xmax, ymin, ymax);
-    histos1D[(prefix+"_vertexXBEAM").c_str()]=
+		   (xmax-xmin)/binSizeMM_prof, xmin, xmax, ymin, ymax));
+    histos1D.add(
       new TH1F((prefix+"_vertexXBEAM").c_str(),
 	       Form("%s;Vertex position X_{BEAM} [mm];%s", info, perEventTitle),
-	       (ymax-ymin)/binSizeMM, ymin, ymax); // X_BEAM -> Y_DET
-    histos1D[(prefix+"_vertexYBEAM").c_str()]=
+	       (ymax-ymin)/binSizeMM, ymin, ymax)); // X_BEAM -> Y_DET
+    histos1D.add(
       new TH1F((prefix+"_vertexYBEAM").c_str(),
 	       Form("%s;Vertex position Y_{BEAM} [mm];%s", info, perEventTitle),
-	       (zmax-zmin)/binSizeMM, zmin, zmax); // Y_BEAM -> -Z_DET
-    histos1D[(prefix+"_vertexZBEAM").c_str()]=
+	       (zmax-zmin)/binSizeMM, zmin, zmax)); // Y_BEAM -> -Z_DET
+    histos1D.add(
       new TH1F((prefix+"_vertexZBEAM").c_str(),
 	       Form("%s;Vertex position Z_{BEAM} [mm];%s", info, perEventTitle),
-	       (xmax-xmin)/binSizeMM, xmin, xmax); // Z_BEAM -> -X_DET
-    histos2D[(prefix+"_vertexZXBEAM").c_str()]=
+	       (xmax-xmin)/binSizeMM, xmin, xmax)); // Z_BEAM -> -X_DET
+    histos2D.add(
       new TH2F((prefix+"_vertexZXBEAM").c_str(),
 	       Form("%s;Vertex position Z_{BEAM} [mm];Vertex position X_{BEAM} [mm];%s", info, perEventTitle),
-	       (xmax-xmin)/binSizeMM_2dXY, xmin, xmax, (ymax-ymin)/binSizeMM_2dXY, ymin, ymax); // ZX_BEAM -> XY_DET
-    histos2D[(prefix+"_vertexXYBEAM").c_str()]=
+	       (xmax-xmin)/binSizeMM_2dXY, xmin, xmax, (ymax-ymin)/binSizeMM_2dXY, ymin, ymax)); // ZX_BEAM -> XY_DET
+    histos2D.add(
       new TH2F((prefix+"_vertexXYBEAM").c_str(),
 	       Form("%s;Vertex position X_{BEAM} [mm];Vertex position Y_{BEAM} [mm];%s", info, perEventTitle),
-	       (ymax-ymin)/binSizeMM_2dYZ, ymin, ymax, (zmax-zmin)/binSizeMM_2dYZ, zmin, zmax); // XY_BEAM -> YZ_DET
-    profiles1D[(prefix+"_vertexZXBEAM_prof").c_str()]=
+	       (ymax-ymin)/binSizeMM_2dYZ, ymin, ymax, (zmax-zmin)/binSizeMM_2dYZ, zmin, zmax)); // XY_BEAM -> YZ_DET
+    profiles1D.add(
       new TProfile((prefix+"_vertexZXBEAM_prof").c_str(),
 		   Form("%s;Vertex position Z_{BEAM} [mm];Average vertex position X_{BEAM} [mm];%s", info, perEventTitle),
-		   (xmax-xmin)/binSizeMM_prof, xmin, xmax, ymin, ymax); // ZX_BEAM -> XY_DET
+		   (xmax-xmin)/binSizeMM_prof, xmin, xmax, ymin, ymax)); // ZX_BEAM -> XY_DET
     
     // TOTAL OBSERVABLE : per category
     switch(categoryPID[c].size()) {
     case 3: // DALITZ PLOTS FOR 3-BODY DECAY OF CARBON IN CMS FRAME : symmetrized track pairs, 3-prong only
-      histos2D[(prefix+"_Dalitz1_CMS").c_str()]=
+      histos2D.add(
 	new TH2F((prefix+"_Dalitz1_CMS").c_str(),
 		 Form("%s - Dalitz plot;#it{m_{i,j}} [MeV/c^{2}];#it{m_{i,k}} [MeV/c^{2}];Probability [arb.u.]", info),
 		 100, 2*myRangeCalculator.getIonMassMeV(ALPHA),
 		 myRangeCalculator.getIonMassMeV(CARBON_12)-myRangeCalculator.getIonMassMeV(ALPHA),
 		 100, 2*myRangeCalculator.getIonMassMeV(ALPHA),
-		 myRangeCalculator.getIonMassMeV(CARBON_12)-myRangeCalculator.getIonMassMeV(ALPHA) );
+		 myRangeCalculator.getIonMassMeV(CARBON_12)-myRangeCalculator.getIonMassMeV(ALPHA) ));
       // Special version of Dalitz plot for identical masses, centered at (chi=0, psi=0):
       // abscissa : chi = (eps1+2*eps2-1)/sqrt(3) = (T2-T3)/sqrt(3)/Q
       // ordinate : psi = eps1-1/3 = (2*T1-T2-T3)/3/Q
       // where: eps_i=T_i/Q, Q=T1+T2+T3
       // Reference: K.L.Laursen et al., Eur. Phys. J. A 62 (2016) 271.
-      histos2D[(prefix+"_Dalitz2_CMS").c_str()]=
+      histos2D.add(
 	new TH2F((prefix+"_Dalitz2_CMS").c_str(),
 		 Form("%s - Dalitz plot;#chi;#psi;Probability [arb.u.]", info),
-		 200, -0.50, 0.50, 200, -0.50, 0.50);
+		 200, -0.50, 0.50, 200, -0.50, 0.50));
       // PLOTS FOR TRIPLE-ALPHA BREAKUP OF CARBON IN CMS FRAME : three entries per horizontal line
       // Reference: C.Au.Diget at al., Phys. Rev. C 80 (2009) 034316.
-      histos2D[(prefix+"_Dalitz3_CMS").c_str()]=
+      histos2D.add(
 	new TH2F((prefix+"_Dalitz3_CMS").c_str(),
 		 Form("%s - Dalitz plot;#alpha kinetic energy in CMS [MeV];^{12}C excitation energy above g.s. in CMS [MeV];Probability [arb.u.]", info),
 		 200, 0, maxKineticEnergyMeV,
-		 300, 0, maxKineticEnergyMeV*3);
-      histos2D[(prefix+"_Dalitz4_CMS").c_str()]=
+		 300, 0, maxKineticEnergyMeV*3));
+      histos2D.add(
 	new TH2F((prefix+"_Dalitz4_CMS").c_str(),
 		 Form("%s - Dalitz plot;#alpha kinetic energy in CMS [MeV];Kinetic energy sum in CMS [MeV];Probability [arb.u.]", info),
 		 200, 0, maxKineticEnergyMeV,
-		 200, 0, maxKineticEnergyMeV*2);
+		 200, 0, maxKineticEnergyMeV*2));
     case 2: // VALID FOR 2-prongs and 3-prongs
-      histos1D[(prefix+"_lenSum").c_str()]=
+      histos1D.add(
 	new TH1F((prefix+"_lenSum").c_str(),
 		 Form("%s;Sum of track lengths [mm];%s", info, perTrackTitle),
-		 maxLengthMM/binSizeMM, 0, maxLengthMM);
-      histos1D[(prefix+"_total_PxBEAM_CMS").c_str()]=
+		 maxLengthMM/binSizeMM, 0, maxLengthMM));
+      histos1D.add(
 	new TH1F((prefix+"_total_PxBEAM_CMS").c_str(),
 		 Form("%s;Total momentum X_{BEAM} in CMS [MeV/c];%s", info, perEventTitle),
-		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV);
-      histos1D[(prefix+"_total_PyBEAM_CMS").c_str()]=
+		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV));
+      histos1D.add(
 	new TH1F((prefix+"_total_PyBEAM_CMS").c_str(),
 		 Form("%s;Total momentum Y_{BEAM} in CMS [MeV/c];%s", info, perEventTitle),
-		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV);
-      histos1D[(prefix+"_total_PzBEAM_CMS").c_str()]=
+		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV));
+      histos1D.add(
 	new TH1F((prefix+"_total_PzBEAM_CMS").c_str(),
 		 Form("%s;Total momentum Z_{BEAM} in CMS [MeV/c];%s", info, perEventTitle),
-		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV);
-      histos1D[(prefix+"_total_PxBEAM_LAB").c_str()]=
+		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV));
+      histos1D.add(
 	new TH1F((prefix+"_total_PxBEAM_LAB").c_str(),
 		 Form("%s;Total momentum X_{BEAM} in LAB [MeV/c];%s", info, perEventTitle),
-		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV);
-      histos1D[(prefix+"_total_PyBEAM_LAB").c_str()]=
+		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV));
+      histos1D.add(
 	new TH1F((prefix+"_total_PyBEAM_LAB").c_str(),
 		 Form("%s;Total momentum Y_{BEAM} in LAB [MeV/c];%s", info, perEventTitle),
-		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV);
-      histos1D[(prefix+"_total_PzBEAM_LAB").c_str()]=
+		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV));
+      histos1D.add(
 	new TH1F((prefix+"_total_PzBEAM_LAB").c_str(),
 		 Form("%s;Total momentum Z_{BEAM} in LAB [MeV/c];%s", info, perEventTitle),
-		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV);
-      histos1D[(prefix+"_total_E_CMS").c_str()]=
+		 100, -maxDeltaMomentumMeV, maxDeltaMomentumMeV));
+      histos1D.add(
 	new TH1F((prefix+"_total_E_CMS").c_str(),
 		 Form("%s;Total energy in CMS [MeV];%s", info, perEventTitle),
-		 (int)(maxTotalEnergyMeV-minTotalEnergyMeV), minTotalEnergyMeV, maxTotalEnergyMeV);
-      histos1D[(prefix+"_excitation_E_CMS").c_str()]=
+		 (int)(maxTotalEnergyMeV-minTotalEnergyMeV), minTotalEnergyMeV, maxTotalEnergyMeV));
+      histos1D.add(
 	new TH1F((prefix+"_excitation_E_CMS").c_str(),
 		 Form("%s;Excitation energy above g.s. in CMS [MeV];%s", info, perEventTitle),
-		 maxKineticEnergyMeV*3/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV*3); // 300, 0, maxKineticEnergyMeV*3);
-      histos1D[(prefix+"_Qvalue_CMS").c_str()]=
+		 maxKineticEnergyMeV*3/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV*3)); // 300, 0, maxKineticEnergyMeV*3);
+      histos1D.add(
 	new TH1F((prefix+"_Qvalue_CMS").c_str(),
 		 Form("%s;Q value in CMS [MeV];%s", info, perEventTitle),
-		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-      histos1D[(prefix+"_gamma_E_LAB").c_str()]=
+		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+      histos1D.add(
 	new TH1F((prefix+"_gamma_E_LAB").c_str(),
 		 Form("%s;Gamma beam energy in LAB [MeV];%s", info, perEventTitle),
-		 (maxBeamEnergyMeV-minBeamEnergyMeV)/binSizeMeV_beamEnergy, minBeamEnergyMeV, maxBeamEnergyMeV); // 100, minBeamEnergyMeV, maxBeamEnergyMeV);
-      histos1D[(prefix+"_E_CMS").c_str()]=
+		 (maxBeamEnergyMeV-minBeamEnergyMeV)/binSizeMeV_beamEnergy, minBeamEnergyMeV, maxBeamEnergyMeV)); // 100, minBeamEnergyMeV, maxBeamEnergyMeV);
+      histos1D.add(
 	new TH1F((prefix+"_E_CMS").c_str(),
 		 Form("%s;Kinetic energy sum in CMS [MeV];%s", info, perEventTitle),
-		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-      histos1D[(prefix+"_E_LAB").c_str()]=
+		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+      histos1D.add(
 	new TH1F((prefix+"_E_LAB").c_str(),
 		 Form("%s;Kinetic energy sum in LAB [MeV];%s", info, perEventTitle),
-		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
+		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
       // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (Y_DET) horizontal & perpendicular to the gamma beam axis
-      histos2D[(prefix+"_vertexX_lenSum").c_str()]=
+      histos2D.add(
 	new TH2F((prefix+"_vertexX_lenSum").c_str(),
 		 Form("%s;Vertex position X_{DET} [mm];Sum of track lengths [mm];%s", info, perEventTitle),
 		 (xmax-xmin)/binSizeMM, xmin, xmax,
-		 maxLengthMM/binSizeMM, 0, maxLengthMM);
-      histos2D[(prefix+"_vertexY_lenSum").c_str()]=
+		 maxLengthMM/binSizeMM, 0, maxLengthMM));
+      histos2D.add(
 	new TH2F((prefix+"_vertexY_lenSum").c_str(),
 		 Form("%s;Vertex position Y_{DET} [mm];Sum of track lengths [mm];%s", info, perEventTitle),
 		 (ymax-ymin)/binSizeMM, ymin, ymax,
-		 maxLengthMM/binSizeMM, 0, maxLengthMM);
-      histos2D[(prefix+"_vertexZ_lenSum").c_str()]=
+		 maxLengthMM/binSizeMM, 0, maxLengthMM));
+      histos2D.add(
 	new TH2F((prefix+"_vertexZ_lenSum").c_str(),
 		 Form("%s;Vertex position Z_{DET} [mm];Sum of track lengths [mm];%s", info, perEventTitle),
 		 (zmax-zmin)/binSizeMM, zmin, zmax,
-		 maxLengthMM/binSizeMM, 0, maxLengthMM);
-      histos2D[(prefix+"_vertexY_gamma_E_LAB").c_str()]=
+		 maxLengthMM/binSizeMM, 0, maxLengthMM));
+      histos2D.add(
 	new TH2F((prefix+"_vertexY_gamma_E_LAB").c_str(),
 		 Form("%s;Vertex position Y_{DET} [mm];Beam energy in LAB [MeV];%s", info, perEventTitle),
 		 (ymax-ymin)/binSizeMM, ymin, ymax,
-		 (maxBeamEnergyMeV-minBeamEnergyMeV)/binSizeMeV_beamEnergy, minBeamEnergyMeV, maxBeamEnergyMeV); // 100, minBeamEnergyMeV, maxBeamEnergyMeV);
-      histos2D[(prefix+"_vertexY_Qvalue_CMS").c_str()]=
+		 (maxBeamEnergyMeV-minBeamEnergyMeV)/binSizeMeV_beamEnergy, minBeamEnergyMeV, maxBeamEnergyMeV)); // 100, minBeamEnergyMeV, maxBeamEnergyMeV);
+      histos2D.add(
 	new TH2F((prefix+"_vertexY_Qvalue_CMS").c_str(),
 		 Form("%s;Vertex position Y_{DET} [mm];Q value in CMS [MeV];%s", info, perEventTitle),
 		 (ymax-ymin)/binSizeMM, ymin, ymax,
-		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-      profiles1D[(prefix+"_vertexX_lenSum_prof").c_str()]=
+		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+      profiles1D.add(
 	new TProfile((prefix+"_vertexX_lenSum_prof").c_str(),
 		     Form("%s;Vertex position X_{DET} [mm];Average sum of track lengths [mm]", info),
 		     (xmax-xmin)/binSizeMM, xmin, xmax,
-		     0, maxLengthMM);
-      profiles1D[(prefix+"_vertexY_lenSum_prof").c_str()]=
+		     0, maxLengthMM));
+      profiles1D.add(
 	new TProfile((prefix+"_vertexY_lenSum_prof").c_str(),
 		     Form("%s;Vertex position Y_{DET} [mm];Average sum of track lengths [mm]", info),
 		     (ymax-ymin)/binSizeMM, ymin, ymax,
-		     0, maxLengthMM);
-      profiles1D[(prefix+"_vertexZ_lenSum_prof").c_str()]=
+		     0, maxLengthMM));
+      profiles1D.add(
 	new TProfile((prefix+"_vertexZ_lenSum_prof").c_str(),
 		     Form("%s;Vertex position Z_{DET} [mm];Average sum of track lengths [mm]", info),
 		     (zmax-zmin)/binSizeMM, zmin, zmax,
-		     0, maxLengthMM);
-      profiles1D[(prefix+"_vertexY_gamma_E_LAB_prof").c_str()]=
+		     0, maxLengthMM));
+      profiles1D.add(
 	new TProfile((prefix+"_vertexY_gamma_E_LAB_prof").c_str(),
 		     Form("%s;Vertex position Y_{DET} [mm];Average beam energy in LAB [MeV]", info),
 		     (ymax-ymin)/binSizeMM, ymin, ymax,
-		     minBeamEnergyMeV, maxBeamEnergyMeV);
-      profiles1D[(prefix+"_vertexY_Qvalue_CMS_prof").c_str()]=
+		     minBeamEnergyMeV, maxBeamEnergyMeV));
+      profiles1D.add(
 	new TProfile((prefix+"_vertexY_Qvalue_CMS_prof").c_str(),
 		     Form("%s;Vertex position Y_{DET} [mm];Average Q value in CMS [MeV]", info),
 		     (ymax-ymin)/binSizeMM, ymin, ymax,
-		     0, maxKineticEnergyMeV);
+		     0, maxKineticEnergyMeV));
       // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (X_BEAM) horizontal & perpendicular to the gamma beam axis
-      histos2D[(prefix+"_vertexXBEAM_gamma_E_LAB").c_str()]=
+      histos2D.add(
 	new TH2F((prefix+"_vertexXBEAM_gamma_E_LAB").c_str(),
 		 Form("%s;Vertex position X_{BEAM} [mm];Beam energy in LAB [MeV];%s", info, perEventTitle),
 		 (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		 (maxBeamEnergyMeV-minBeamEnergyMeV)/binSizeMeV_beamEnergy, minBeamEnergyMeV, maxBeamEnergyMeV); // 100, minBeamEnergyMeV, maxBeamEnergyMeV);
-      histos2D[(prefix+"_vertexXBEAM_Qvalue_CMS").c_str()]=
+		 (maxBeamEnergyMeV-minBeamEnergyMeV)/binSizeMeV_beamEnergy, minBeamEnergyMeV, maxBeamEnergyMeV)); // 100, minBeamEnergyMeV, maxBeamEnergyMeV);
+      histos2D.add(
 	new TH2F((prefix+"_vertexXBEAM_Qvalue_CMS").c_str(),
 		 Form("%s;Vertex position X_{BEAM} [mm];Q value in CMS [MeV];%s", info, perEventTitle),
 		 (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-      profiles1D[(prefix+"_vertexXBEAM_gamma_E_LAB_prof").c_str()]=
+		 maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+      profiles1D.add(
 	new TProfile((prefix+"_vertexXBEAM_gamma_E_LAB_prof").c_str(),
 		     Form("%s;Vertex position X_{BEAM} [mm];Average beam energy in LAB [MeV]", info),
 		     (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		     minBeamEnergyMeV, maxBeamEnergyMeV);
-      profiles1D[(prefix+"_vertexXBEAM_Qvalue_CMS_prof").c_str()]=
+		     minBeamEnergyMeV, maxBeamEnergyMeV));
+      profiles1D.add(
 	new TProfile((prefix+"_vertexXBEAM_Qvalue_CMS_prof").c_str(),
 		     Form("%s;Vertex position X_{BEAM} [mm];Average Q value in CMS [MeV]", info),
 		     (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		     0, maxKineticEnergyMeV);
+		     0, maxKineticEnergyMeV));
       break;
     default: break;
     };
@@ -329,211 +351,211 @@ void HIGGS_analysis::bookHistos(){
       auto pidLatex=categoryPIDlatex[c].at(t).c_str();
 
       // TRACK LENGTH : per category / per track
-      histos1D[(prefix+pid+"_len").c_str()]=
+      histos1D.add(
 	new TH1F((prefix+pid+"_len").c_str(),
 		 Form("%s;%s track length [mm];%s", info, pidLatex, perTrackTitle),
-		 maxLengthMM/binSizeMM, 0, maxLengthMM);
+		 maxLengthMM/binSizeMM, 0, maxLengthMM));
       // TRACK DELTA_X/Y/Z : per category / per track
-      histos1D[(prefix+pid+"_deltaX").c_str()]=
+      histos1D.add(
 	new TH1F((prefix+pid+"_deltaX").c_str(),
 		 Form("%s;%s track #DeltaX_{DET} [mm];%s", info, pidLatex, perTrackTitle),
-		 maxLengthMM/binSizeMM, -0.5*maxLengthMM, 0.5*maxLengthMM);
-      histos1D[(prefix+pid+"_deltaY").c_str()]=
+		 maxLengthMM/binSizeMM, -0.5*maxLengthMM, 0.5*maxLengthMM));
+      histos1D.add(
 	new TH1F((prefix+pid+"_deltaY").c_str(),
 		 Form("%s;%s track #DeltaY_{DET} [mm];%s", info, pidLatex, perTrackTitle),
-		 maxLengthMM/binSizeMM, -0.5*maxLengthMM, 0.5*maxLengthMM);
-      histos1D[(prefix+pid+"_deltaZ").c_str()]=
+		 maxLengthMM/binSizeMM, -0.5*maxLengthMM, 0.5*maxLengthMM));
+      histos1D.add(
 	new TH1F((prefix+pid+"_deltaZ").c_str(),
 		 Form("%s;%s track #DeltaZ_{DET} [mm];%s", info, pidLatex, perTrackTitle),
-		 maxLengthMM/binSizeMM, -0.5*maxLengthMM, 0.5*maxLengthMM);
-      histos2D[(prefix+pid+"_deltaXY").c_str()]=
+		 maxLengthMM/binSizeMM, -0.5*maxLengthMM, 0.5*maxLengthMM));
+      histos2D.add(
 	new TH2F((prefix+pid+"_deltaXY").c_str(),
 		 Form("%s;%s track #DeltaX_{DET} [mm];%s track #DeltaY_{DET} [mm];%s", info, pidLatex, pidLatex, perTrackTitle),
 		 maxLengthMM/binSizeMM_2dXY, -0.5*maxLengthMM, 0.5*maxLengthMM,
-		 maxLengthMM/binSizeMM_2dXY, -0.5*maxLengthMM, 0.5*maxLengthMM);
-      histos2D[(prefix+pid+"_deltaXZ").c_str()]=
+		 maxLengthMM/binSizeMM_2dXY, -0.5*maxLengthMM, 0.5*maxLengthMM));
+      histos2D.add(
 	new TH2F((prefix+pid+"_deltaXZ").c_str(),
 		 Form("%s;%s track #DeltaX_{DET} [mm];%s track #DeltaZ_{DET} [mm];%s", info, pidLatex, pidLatex, perTrackTitle),
 		 maxLengthMM/binSizeMM_2dXZ, -0.5*maxLengthMM, 0.5*maxLengthMM,
-		 maxLengthMM/binSizeMM_2dXZ, -0.5*maxLengthMM, 0.5*maxLengthMM);
-      histos2D[(prefix+pid+"_deltaYZ").c_str()]=
+		 maxLengthMM/binSizeMM_2dXZ, -0.5*maxLengthMM, 0.5*maxLengthMM));
+      histos2D.add(
 	new TH2F((prefix+pid+"_deltaYZ").c_str(),
 		 Form("%s;%s track #DeltaY_{DET} [mm];%s track #DeltaZ_{DET} [mm];%s", info, pidLatex, pidLatex, perTrackTitle),
 		 maxLengthMM/binSizeMM_2dYZ, -0.5*maxLengthMM, 0.5*maxLengthMM,
-		 maxLengthMM/binSizeMM_2dYZ, -0.5*maxLengthMM, 0.5*maxLengthMM);
+		 maxLengthMM/binSizeMM_2dYZ, -0.5*maxLengthMM, 0.5*maxLengthMM));
       // TRACK END_X/Y/Z : per category / per track
-      histos1D[(prefix+pid+"_endX").c_str()]=
+      histos1D.add(
 	new TH1F((prefix+pid+"_endX").c_str(),
 		 Form("%s;%s track endpoint X_{DET} [mm];%s", info, pidLatex, perTrackTitle),
-		 (xmax-xmin)/binSizeMM, xmin, xmax);
-      histos1D[(prefix+pid+"_endY").c_str()]=
+		 (xmax-xmin)/binSizeMM, xmin, xmax));
+      histos1D.add(
 	new TH1F((prefix+pid+"_endY").c_str(),
 		 Form("%s;%s track endpoint Y_{DET} [mm];%s", info, pidLatex, perTrackTitle),
-		 (ymax-ymin)/binSizeMM, ymin, ymax);
-      histos1D[(prefix+pid+"_endZ").c_str()]=
+		 (ymax-ymin)/binSizeMM, ymin, ymax));
+      histos1D.add(
 	new TH1F((prefix+pid+"_endZ").c_str(),
 		 Form("%s;%s track endpoint Z_{DET} [mm];%s", info, pidLatex, perTrackTitle),
-		 (zmax-zmin)/binSizeMM, zmin, zmax);
-      histos2D[(prefix+pid+"_endXY").c_str()]=
+		 (zmax-zmin)/binSizeMM, zmin, zmax));
+      histos2D.add(
 	new TH2F((prefix+pid+"_endXY").c_str(),
 		 Form("%s;%s track endpoint X_{DET} [mm];%s track endpoint Y_{DET} [mm];%s", info, pidLatex, pidLatex, perTrackTitle),
-		 (xmax-xmin)/binSizeMM_2dXY, xmin, xmax, (ymax-ymin)/binSizeMM_2dXY, ymin, ymax);
+		 (xmax-xmin)/binSizeMM_2dXY, xmin, xmax, (ymax-ymin)/binSizeMM_2dXY, ymin, ymax));
 
       // TRACK PHI_DET/THETA_DET/cos(THETA_DET) : per category / per track
-      histos1D[(prefix+pid+"_phiDET").c_str()]=
+      histos1D.add(
 	new TH1F((prefix+pid+"_phiDET").c_str(),
 		 Form("%s;%s track #phi_{DET} [rad];%s", info, pidLatex, perTrackTitle),
-		 100, -TMath::Pi(), TMath::Pi());
-      histos1D[(prefix+pid+"_thetaDET").c_str()]=
+		 100, -TMath::Pi(), TMath::Pi()));
+      histos1D.add(
 	new TH1F((prefix+pid+"_thetaDET").c_str(),
 		 Form("%s;%s track #theta_{DET} [rad];%s", info, pidLatex, perTrackTitle),
-		 100, 0, TMath::Pi());
-      histos1D[(prefix+pid+"_cosThetaDET").c_str()]=
+		 100, 0, TMath::Pi()));
+      histos1D.add(
 	new TH1F((prefix+pid+"_cosThetaDET").c_str(),
 		 Form("%s;%s track cos(#theta_{DET});%s", info, pidLatex, perTrackTitle),
-		 100, -1, 1);
+		 100, -1, 1));
 
       // TRACK PHI_BEAM/THETA_BEAM/cos(THETA_BEAM) : per category / per track
-      histos1D[(prefix+pid+"_phiBEAM_LAB").c_str()]=
+      histos1D.add(
 	new TH1F((prefix+pid+"_phiBEAM_LAB").c_str(),
 		 Form("%s;%s track #phi_{BEAM} in LAB [rad];%s", info, pidLatex, perTrackTitle),
-		 100, -TMath::Pi(), TMath::Pi());
-      histos1D[(prefix+pid+"_thetaBEAM_LAB").c_str()]=
+		 100, -TMath::Pi(), TMath::Pi()));
+      histos1D.add(
 	new TH1F((prefix+pid+"_thetaBEAM_LAB").c_str(),
 		 Form("%s;%s track #theta_{BEAM} in LAB [rad];%s", info, pidLatex, perTrackTitle),
-		 100, 0, TMath::Pi());
-      histos1D[(prefix+pid+"_cosThetaBEAM_LAB").c_str()]=
+		 100, 0, TMath::Pi()));
+      histos1D.add(
 	new TH1F((prefix+pid+"_cosThetaBEAM_LAB").c_str(),
 		 Form("%s;%s track cos(#theta_{BEAM}) in LAB);%s", info, pidLatex, perTrackTitle),
-		 100, -1, 1);
-      histos2D[(prefix+pid+"_cosThetaBEAM_len_LAB").c_str()]=
+		 100, -1, 1));
+      histos2D.add(
 	new TH2F((prefix+pid+"_cosThetaBEAM_len_LAB").c_str(),
 		 Form("%s;%s track cos(#theta_{BEAM}) in LAB;%s track length [mm];%s", info, pidLatex,  pidLatex, perTrackTitle),
 		 100, -1, 1,
-		 maxLengthMM/binSizeMM, 0, maxLengthMM);
-      profiles1D[(prefix+pid+"_cosThetaBEAM_len_LAB_prof").c_str()]=
+		 maxLengthMM/binSizeMM, 0, maxLengthMM));
+      profiles1D.add(
 	new TProfile((prefix+pid+"_cosThetaBEAM_len_LAB_prof").c_str(),
 		     Form("%s;%s track cos(#theta_{BEAM}) in LAB;Average %s track length [mm];%s", info, pidLatex,  pidLatex, perTrackTitle),
 		     100, -1, 1,
-		     0, maxLengthMM);
+		     0, maxLengthMM));
       
       // TRACK OBSERVABLES IN CMS/LAB : per category / per track, only for 2,3-prong
       switch(categoryPID[c].size()) {
       case 3:
       case 2: // 2,3-prong
-	histos1D[(prefix+pid+"_E_CMS").c_str()]=
+	histos1D.add(
 	  new TH1F((prefix+pid+"_E_CMS").c_str(),
 		   Form("%s;%s kinetic energy in CMS [MeV];%s", info, pidLatex, perTrackTitle),
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	histos1D[(prefix+pid+"_phiBEAM_CMS").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	histos1D.add(
 	  new TH1F((prefix+pid+"_phiBEAM_CMS").c_str(),
 		   Form("%s;%s track #phi_{BEAM} in CMS [rad];%s", info, pidLatex, perTrackTitle),
-		   100, -TMath::Pi(), TMath::Pi());
-	histos1D[(prefix+pid+"_thetaBEAM_CMS").c_str()]=
+		   100, -TMath::Pi(), TMath::Pi()));
+	histos1D.add(
 	  new TH1F((prefix+pid+"_thetaBEAM_CMS").c_str(),
 		   Form("%s;%s track #theta_{BEAM} in CMS [rad];%s", info, pidLatex, perTrackTitle),
-		   100, 0, TMath::Pi());
-	histos1D[(prefix+pid+"_cosThetaBEAM_CMS").c_str()]=
+		   100, 0, TMath::Pi()));
+	histos1D.add(
 	  new TH1F((prefix+pid+"_cosThetaBEAM_CMS").c_str(),
 		   Form("%s;%s track cos(#theta_{BEAM}) in CMS;%s", info, pidLatex, perTrackTitle),
-		   100, -1, 1);
-	histos2D[(prefix+pid+"_cosThetaBEAM_E_CMS").c_str()]=
+		   100, -1, 1));
+	histos2D.add(
 	  new TH2F((prefix+pid+"_cosThetaBEAM_E_CMS").c_str(),
 		   Form("%s;%s track cos(#theta_{BEAM}) in CMS;%s kinetic energy in CMS [MeV];%s", info, pidLatex, pidLatex, perTrackTitle),
 		   100, -1, 1,
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	profiles1D[(prefix+pid+"_cosThetaBEAM_E_CMS_prof").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	profiles1D.add(
 	  new TProfile((prefix+pid+"_cosThetaBEAM_E_CMS_prof").c_str(),
 		       Form("%s;%s track cos(#theta_{BEAM}) in CMS;Average %s kinetic energy in CMS [MeV];%s", info, pidLatex, pidLatex, perTrackTitle),
 		       100, -1, 1,
-		       0, maxKineticEnergyMeV);
+		       0, maxKineticEnergyMeV));
 	// SPECIAL PLOTS: check dependence of gamma beam energy on vertex position position (Y_DET) horizontal & perpendicular to the gamma beam axis
-	histos2D[(prefix+"_vertexY"+pid+"_len").c_str()]=
+	histos2D.add(
 	  new TH2F((prefix+"_vertexY"+pid+"_len").c_str(),
 		   Form("%s;Vertex position Y_{DET} [mm];%s track length [mm];%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax,
-		   maxLengthMM/binSizeMM, 0, maxLengthMM);
-	histos2D[(prefix+"_vertexY"+pid+"_E_LAB").c_str()]=
+		   maxLengthMM/binSizeMM, 0, maxLengthMM));
+	histos2D.add(
 	  new TH2F((prefix+"_vertexY"+pid+"_E_LAB").c_str(),
 		   Form("%s;Vertex position Y_{DET} [mm];%s kinetic energy in LAB [MeV];%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax,
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	histos2D[(prefix+"_vertexY"+pid+"_E_CMS").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	histos2D.add(
 	  new TH2F((prefix+"_vertexY"+pid+"_E_CMS").c_str(),
 		   Form("%s;Vertex position Y_{DET} [mm];%s kinetic energy in CMS [MeV];%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax,
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	histos2D[(prefix+"_vertexY"+pid+"_cosThetaBEAM_LAB").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	histos2D.add(
 	  new TH2F((prefix+"_vertexY"+pid+"_cosThetaBEAM_LAB").c_str(),
 		   Form("%s;Vertex position Y_{DET} [mm];%s track cos(#theta_{BEAM}) in LAB;%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax,
-		   100, -1, 1);
-	histos2D[(prefix+"_vertexY"+pid+"_cosThetaBEAM_CMS").c_str()]=
+		   100, -1, 1));
+	histos2D.add(
 	  new TH2F((prefix+"_vertexY"+pid+"_cosThetaBEAM_CMS").c_str(),
 		   Form("%s;Vertex position Y_{DET} [mm];%s track cos(#theta_{BEAM}) in CMS;%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax,
-		   100, -1, 1);
-	profiles1D[(prefix+"_vertexY"+pid+"_len_prof").c_str()]=
+		   100, -1, 1));
+	profiles1D.add(
 	  new TProfile((prefix+"_vertexY"+pid+"_len_prof").c_str(),
 		       Form("%s;Vertex position Y_{DET} [mm];Average %s track length [mm]", info, pidLatex),
 		       (ymax-ymin)/binSizeMM, ymin, ymax,
-		       0, maxLengthMM);
-	profiles1D[(prefix+"_vertexY"+pid+"_E_LAB_prof").c_str()]=
+		       0, maxLengthMM));
+	profiles1D.add(
 	  new TProfile((prefix+"_vertexY"+pid+"_E_LAB_prof").c_str(),
 		       Form("%s;Vertex position Y_{DET} [mm];Average %s kinetic energy in LAB [MeV]", info, pidLatex),
 		       (ymax-ymin)/binSizeMM, ymin, ymax,
-		       0, maxKineticEnergyMeV);
-	profiles1D[(prefix+"_vertexY"+pid+"_E_CMS_prof").c_str()]=
+		       0, maxKineticEnergyMeV));
+	profiles1D.add(
 	  new TProfile((prefix+"_vertexY"+pid+"_E_CMS_prof").c_str(),
 		       Form("%s;Vertex position Y_{DET} [mm];Average %s kinetic energy in CMS [MeV]", info, pidLatex),
 		       (ymax-ymin)/binSizeMM, ymin, ymax,
-		       0, maxKineticEnergyMeV);
+		       0, maxKineticEnergyMeV));
 	// SPECIAL PLOTS: check dependence of gamma beam energy on vertex position position (X_BEAM) horizontal & perpendicular to the gamma beam axis
-	histos2D[(prefix+"_vertexXBEAM"+pid+"_E_LAB").c_str()]=
+	histos2D.add(
 	  new TH2F((prefix+"_vertexXBEAM"+pid+"_E_LAB").c_str(),
 		   Form("%s;Vertex position X_{BEAM} [mm];%s kinetic energy in LAB [MeV];%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	histos2D[(prefix+"_vertexXBEAM"+pid+"_E_CMS").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	histos2D.add(
 	  new TH2F((prefix+"_vertexXBEAM"+pid+"_E_CMS").c_str(),
 		   Form("%s;Vertex position X_{BEAM} [mm];%s kinetic energy in CMS [MeV];%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	histos2D[(prefix+"_vertexXBEAM"+pid+"_cosThetaBEAM_LAB").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	histos2D.add(
 	  new TH2F((prefix+"_vertexXBEAM"+pid+"_cosThetaBEAM_LAB").c_str(),
 		   Form("%s;Vertex position X_{BEAM} [mm];%s track cos(#theta_{BEAM}) in LAB;%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		   100, -1, 1);
-	histos2D[(prefix+"_vertexXBEAM"+pid+"_cosThetaBEAM_CMS").c_str()]=
+		   100, -1, 1));
+	histos2D.add(
 	  new TH2F((prefix+"_vertexXBEAM"+pid+"_cosThetaBEAM_CMS").c_str(),
 		   Form("%s;Vertex position X_{BEAM} [mm];%s track cos(#theta_{BEAM}) in CMS;%s", info, pidLatex, perTrackTitle),
 		   (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		   100, -1, 1);
-	profiles1D[(prefix+"_vertexXBEAM"+pid+"_E_LAB_prof").c_str()]=
+		   100, -1, 1));
+	profiles1D.add(
 	  new TProfile((prefix+"_vertexXBEAM"+pid+"_E_LAB_prof").c_str(),
 		       Form("%s;Vertex position X_{BEAM} [mm];Average %s kinetic energy in LAB [MeV]", info, pidLatex),
 		       (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		       0, maxKineticEnergyMeV);
-	profiles1D[(prefix+"_vertexXBEAM"+pid+"_E_CMS_prof").c_str()]=
+		       0, maxKineticEnergyMeV));
+	profiles1D.add(
 	  new TProfile((prefix+"_vertexXBEAM"+pid+"_E_CMS_prof").c_str(),
 		       Form("%s;Vertex position X_{BEAM} [mm];Average %s kinetic energy in CMS [MeV]", info, pidLatex),
 		       (ymax-ymin)/binSizeMM, ymin, ymax, // X_BEAM -> Y_DET
-		       0, maxKineticEnergyMeV);
+		       0, maxKineticEnergyMeV));
       case 1: // 1,2,3-prong
-	histos1D[(prefix+pid+"_E_LAB").c_str()]=
+	histos1D.add(
 	  new TH1F((prefix+pid+"_E_LAB").c_str(),
 		   Form("%s;%s kinetic energy in LAB [MeV];%s", info, pidLatex, perTrackTitle),
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	histos2D[(prefix+pid+"_cosThetaBEAM_E_LAB").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	histos2D.add(
 	  new TH2F((prefix+pid+"_cosThetaBEAM_E_LAB").c_str(),
 		   Form("%s;%s track cos(#theta_{BEAM}) in LAB;%s kinetic energy in LAB [MeV];%s", info, pidLatex, pidLatex, perTrackTitle),
 		   100, -1, 1,
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	profiles1D[(prefix+pid+"_cosThetaBEAM_E_LAB_prof").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	profiles1D.add(
 	  new TProfile((prefix+pid+"_cosThetaBEAM_E_LAB_prof").c_str(),
 		       Form("%s;%s track cos(#theta_{BEAM}) in LAB;Average %s kinetic energy in LAB [MeV];%s", info, pidLatex, pidLatex, perTrackTitle),
 		       100, -1, 1,
-		       0, maxKineticEnergyMeV);
+		       0, maxKineticEnergyMeV));
       default: break;
       };
 
@@ -543,77 +565,92 @@ void HIGGS_analysis::bookHistos(){
 	auto pidLatex2=categoryPIDlatex[c].at(t2).c_str();
 
 	// TRACK-TRACK DELTA(i,j) IN LAB FRAME : per category / per track pair
-	histos1D[(prefix+pid+pid2+"_delta_LAB").c_str()]=
+	histos1D.add(
 	  new TH1F((prefix+pid+pid2+"_delta_LAB").c_str(),
 		   Form("%s;#delta(%s %s) angle in LAB [rad];%s", info, pidLatex, pidLatex2, perTrackTitle),
-		   100, 0, TMath::Pi());
-	histos1D[(prefix+pid+pid2+"_cosDelta_LAB").c_str()]=
+		   100, 0, TMath::Pi()));
+	histos1D.add(
 	  new TH1F((prefix+pid+pid2+"_cosDelta_LAB").c_str(),
 		   Form("%s;cos #delta(%s %s) in LAB [rad];%s", info, pidLatex, pidLatex2, perTrackTitle),
-		   100, -1, 1);
+		   100, -1, 1));
 	
 	// TRACK-TRACK LENGTH(i) VS LENGTH(j) IN LAB FRAME : per category / per track pair
-	histos2D[(prefix+pid+"_len"+pid2+"_len").c_str()]=
+	histos2D.add(
 	  new TH2F((prefix+pid+"_len"+pid2+"_len").c_str(),
 		   Form("%s;%s track length [mm];%s track length [mm];%s", info, pidLatex,  pidLatex2, perTrackTitle),
 		   maxLengthMM/binSizeMM, 0, maxLengthMM,
-		   maxLengthMM/binSizeMM, 0, maxLengthMM);
+		   maxLengthMM/binSizeMM, 0, maxLengthMM));
 
 	// TRACK-TRACK E(i) VS E(j) IN LAB & CMS FRAME : per category / per track pair
-	histos2D[(prefix+pid+"_E"+pid2+"_E_LAB").c_str()]=
+	histos2D.add(
 	  new TH2F((prefix+pid+"_E"+pid2+"_E_LAB").c_str(),
 		   Form("%s;%s kinetic energy in LAB [MeV];%s kinetic energy in LAB [MeV];%s", info, pidLatex,  pidLatex2, perTrackTitle),
 		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV, // 200, 0, maxKineticEnergyMeV,
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
-	histos2D[(prefix+pid+"_E"+pid2+"_E_CMS").c_str()]=
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
+	histos2D.add(
 	  new TH2F((prefix+pid+"_E"+pid2+"_E_CMS").c_str(),
 		   Form("%s;%s kinetic energy in CMS [MeV];%s kinetic energy in CMS [MeV];%s", info, pidLatex,  pidLatex2, perTrackTitle),
 		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV, // 200, 0, maxKineticEnergyMeV,
-		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV); // 200, 0, maxKineticEnergyMeV);
+		   maxKineticEnergyMeV/binSizeMeV_kineticEnergy, 0, maxKineticEnergyMeV)); // 200, 0, maxKineticEnergyMeV);
 
 	// TRACK-TRACK DELTA(i,j) IN CMS FRAME : per category / per track pair, only for 2,3-prong
 	if(categoryPIDhname[c].size()>1) {
-	  histos1D[(prefix+pid+pid2+"_delta_CMS").c_str()]=
+	  histos1D.add(
 	    new TH1F((prefix+pid+pid2+"_delta_CMS").c_str(),
 		     Form("%s;#delta(%s %s) angle in CMS [rad];%s", info, pidLatex, pidLatex2, perTrackTitle),
-		     100, 0, TMath::Pi());
-	  histos1D[(prefix+pid+pid2+"_cosDelta_CMS").c_str()]=
+		     100, 0, TMath::Pi()));
+	  histos1D.add(
 	    new TH1F((prefix+pid+pid2+"_cosDelta_CMS").c_str(),
 		     Form("%s;cos #delta(%s %s) in CMS [rad];%s", info, pidLatex, pidLatex2, perTrackTitle),
-		     100, -1, 1);
+		     100, -1, 1));
 	}
       }
     }
   }
+  TH1::AddDirectory(addDirectoryStatus);
+
+  // every histogram filled through compile-time handle must be booked above
+  const bool complete1D=histos1D.isComplete();
+  const bool complete2D=histos2D.isComplete();
+  const bool completeProf=profiles1D.isComplete();
+  if(!complete1D || !complete2D || !completeProf) {
+    std::cout<<KRED<<__FUNCTION__<<RST<<": histogram booking does not match HIGGS_analysis_histos.h!"<<std::endl;
+    exit(-1);
+  }
+  if(!outputFile) return;
+
   // dump list of histogram names
   std::cout<<__FUNCTION__<<": List of booked 1D histograms:"<<std::endl;
-  for (auto &h : histos1D) {
+  for (auto handle=0U; handle<histos1D.size(); ++handle) {
+    auto h=histos1D[handle];
     std::cout<<std::left<<std::setw(50)<<std::setfill('.')
-	     <<h.first<<"T = "<<h.second->GetTitle()<<std::endl
+	     <<histos1D.getName(handle)<<"T = "<<h->GetTitle()<<std::endl
 	     <<std::setfill(' ')<<std::right<<std::setw(50+4)
-	     <<"X = "<<std::left<<h.second->GetXaxis()->GetTitle()<<std::endl
+	     <<"X = "<<std::left<<h->GetXaxis()->GetTitle()<<std::endl
 	     <<std::right<<std::setw(50+4)
-	     <<"Y = "<<std::left<<h.second->GetYaxis()->GetTitle()<<std::endl;
+	     <<"Y = "<<std::left<<h->GetYaxis()->GetTitle()<<std::endl;
   }
   std::cout<<__FUNCTION__<<": List of booked 1D profile histograms:"<<std::endl;
-  for (auto &h : profiles1D) {
+  for (auto handle=0U; handle<profiles1D.size(); ++handle) {
+    auto h=profiles1D[handle];
     std::cout<<std::left<<std::setw(50)<<std::setfill('.')
-	     <<h.first<<"T = "<<h.second->GetTitle()<<std::endl
+	     <<profiles1D.getName(handle)<<"T = "<<h->GetTitle()<<std::endl
 	     <<std::setfill(' ')<<std::right<<std::setw(50+4)
-	     <<"X = "<<std::left<<h.second->GetXaxis()->GetTitle()<<std::endl
+	     <<"X = "<<std::left<<h->GetXaxis()->GetTitle()<<std::endl
 	     <<std::right<<std::setw(50+4)
-	     <<"Y = "<<std::left<<h.second->GetYaxis()->GetTitle()<<std::endl;
+	     <<"Y = "<<std::left<<h->GetYaxis()->GetTitle()<<std::endl;
   }
   std::cout<<__FUNCTION__<<": List of booked 2D histograms:"<<std::endl;
-  for (auto &h : histos2D) {
+  for (auto handle=0U; handle<histos2D.size(); ++handle) {
+    auto h=histos2D[handle];
     std::cout<<std::left<<std::setw(50)<<std::setfill('.')
-	     <<h.first<<"T = "<<h.second->GetTitle()<<std::endl
+	     <<histos2D.getName(handle)<<"T = "<<h->GetTitle()<<std::endl
 	     <<std::setfill(' ')<<std::right<<std::setw(50+4)
-	     <<"X = "<<std::left<<h.second->GetXaxis()->GetTitle()<<std::endl
+	     <<"X = "<<std::left<<h->GetXaxis()->GetTitle()<<std::endl
 	     <<std::right<<std::setw(50+4)
-	     <<"Y = "<<std::left<<h.second->GetYaxis()->GetTitle()<<std::endl
+	     <<"Y = "<<std::left<<h->GetYaxis()->GetTitle()<<std::endl
 	     <<std::right<<std::setw(50+4)
-	     <<"Z = "<<std::left<<h.second->GetZaxis()->GetTitle()<<std::endl;
+	     <<"Z = "<<std::left<<h->GetZaxis()->GetTitle()<<std::endl;
   }
 }
 ///////////////////////////////
@@ -627,7 +664,7 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
   // - for 3-prong events: all tracks are ALPHAS, descending order by their energy/length
   
   const int ntracks = aTrack->getSegments().size();
-  histos1D["h_ntracks"]->Fill(ntracks);
+  histos1D[h_ntracks]->Fill(ntracks);
   if (ntracks==0) return;
   
   // get sorted list of tracks (descending order by track length)
@@ -639,145 +676,145 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
   // ALL event categories
   TVector3 vertexPos = list.front().getStart(); // DET coordintate system, LAB reference frame
   TVector3 vertexPos_BEAM_LAB = coordinateConverter.detToBeamWithOffset(vertexPos);
-  histos1D["h_all_vertexX"]->Fill(vertexPos.X());
-  histos1D["h_all_vertexY"]->Fill(vertexPos.Y());
-  histos1D["h_all_vertexZ"]->Fill(vertexPos.Z());
-  histos2D["h_all_vertexXY"]->Fill(vertexPos.X(), vertexPos.Y());
-  histos2D["h_all_vertexYZ"]->Fill(vertexPos.Y(), vertexPos.Z());
-  profiles1D["h_all_vertexXY_prof"]->Fill(vertexPos.X(), vertexPos.Y());
-  histos1D["h_all_vertexXBEAM"]->Fill(vertexPos_BEAM_LAB.X());
-  histos1D["h_all_vertexYBEAM"]->Fill(vertexPos_BEAM_LAB.Y());
-  histos1D["h_all_vertexZBEAM"]->Fill(vertexPos_BEAM_LAB.Z());
-  histos2D["h_all_vertexZXBEAM"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
-  histos2D["h_all_vertexXYBEAM"]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
-  profiles1D["h_all_vertexZXBEAM_prof"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+  histos1D[h_all_vertexX]->Fill(vertexPos.X());
+  histos1D[h_all_vertexY]->Fill(vertexPos.Y());
+  histos1D[h_all_vertexZ]->Fill(vertexPos.Z());
+  histos2D[h_all_vertexXY]->Fill(vertexPos.X(), vertexPos.Y());
+  histos2D[h_all_vertexYZ]->Fill(vertexPos.Y(), vertexPos.Z());
+  profiles1D[h_all_vertexXY_prof]->Fill(vertexPos.X(), vertexPos.Y());
+  histos1D[h_all_vertexXBEAM]->Fill(vertexPos_BEAM_LAB.X());
+  histos1D[h_all_vertexYBEAM]->Fill(vertexPos_BEAM_LAB.Y());
+  histos1D[h_all_vertexZBEAM]->Fill(vertexPos_BEAM_LAB.Z());
+  histos2D[h_all_vertexZXBEAM]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+  histos2D[h_all_vertexXYBEAM]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
+  profiles1D[h_all_vertexZXBEAM_prof]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
   for(auto & track: list) {
     const double len=track.getLength();
-    histos1D["h_all_len"]->Fill(len);
-    histos1D["h_all_deltaX"]->Fill(len*track.getTangent().X());
-    histos1D["h_all_deltaY"]->Fill(len*track.getTangent().Y());
-    histos1D["h_all_deltaZ"]->Fill(len*track.getTangent().Z());
-    histos2D["h_all_deltaXY"]->Fill(len*track.getTangent().X(), len*track.getTangent().Y());
-    histos2D["h_all_deltaXZ"]->Fill(len*track.getTangent().X(), len*track.getTangent().Z());
-    histos2D["h_all_deltaYZ"]->Fill(len*track.getTangent().Y(), len*track.getTangent().Z());
-    histos1D["h_all_endX"]->Fill(track.getEnd().X());
-    histos1D["h_all_endY"]->Fill(track.getEnd().Y());
-    histos1D["h_all_endZ"]->Fill(track.getEnd().Z());
-    histos2D["h_all_endXY"]->Fill(track.getEnd().X(), track.getEnd().Y());
-    histos1D["h_all_phiDET"]->Fill(track.getTangent().Phi());
-    histos1D["h_all_thetaDET"]->Fill(track.getTangent().Theta());
-    histos1D["h_all_cosThetaDET"]->Fill(track.getTangent().CosTheta());
+    histos1D[h_all_len]->Fill(len);
+    histos1D[h_all_deltaX]->Fill(len*track.getTangent().X());
+    histos1D[h_all_deltaY]->Fill(len*track.getTangent().Y());
+    histos1D[h_all_deltaZ]->Fill(len*track.getTangent().Z());
+    histos2D[h_all_deltaXY]->Fill(len*track.getTangent().X(), len*track.getTangent().Y());
+    histos2D[h_all_deltaXZ]->Fill(len*track.getTangent().X(), len*track.getTangent().Z());
+    histos2D[h_all_deltaYZ]->Fill(len*track.getTangent().Y(), len*track.getTangent().Z());
+    histos1D[h_all_endX]->Fill(track.getEnd().X());
+    histos1D[h_all_endY]->Fill(track.getEnd().Y());
+    histos1D[h_all_endZ]->Fill(track.getEnd().Z());
+    histos2D[h_all_endXY]->Fill(track.getEnd().X(), track.getEnd().Y());
+    histos1D[h_all_phiDET]->Fill(track.getTangent().Phi());
+    histos1D[h_all_thetaDET]->Fill(track.getTangent().Theta());
+    histos1D[h_all_cosThetaDET]->Fill(track.getTangent().CosTheta());
 
     auto tangent_BEAM_LAB = coordinateConverter.detToBeam(track.getTangent());
     double phi_BEAM_LAB = tangent_BEAM_LAB.Phi();
     double cosTheta_BEAM_LAB = tangent_BEAM_LAB.CosTheta();
-    histos1D["h_all_phiBEAM_LAB"]->Fill(phi_BEAM_LAB);
-    histos1D["h_all_thetaBEAM_LAB"]->Fill(acos(cosTheta_BEAM_LAB));
-    histos1D["h_all_cosThetaBEAM_LAB"]->Fill(cosTheta_BEAM_LAB);
-    histos2D["h_all_cosThetaBEAM_len_LAB"]->Fill(cosTheta_BEAM_LAB, len);
-    profiles1D["h_all_cosThetaBEAM_len_LAB_prof"]->Fill(cosTheta_BEAM_LAB, len);
+    histos1D[h_all_phiBEAM_LAB]->Fill(phi_BEAM_LAB);
+    histos1D[h_all_thetaBEAM_LAB]->Fill(acos(cosTheta_BEAM_LAB));
+    histos1D[h_all_cosThetaBEAM_LAB]->Fill(cosTheta_BEAM_LAB);
+    histos2D[h_all_cosThetaBEAM_len_LAB]->Fill(cosTheta_BEAM_LAB, len);
+    profiles1D[h_all_cosThetaBEAM_len_LAB_prof]->Fill(cosTheta_BEAM_LAB, len);
   }
 
   // 1-prong (alpha)
   if(ntracks==1) {
-    histos1D["h_1prong_vertexX"]->Fill(vertexPos.X());
-    histos1D["h_1prong_vertexY"]->Fill(vertexPos.Y());
-    histos1D["h_1prong_vertexZ"]->Fill(vertexPos.Z());
-    histos2D["h_1prong_vertexXY"]->Fill(vertexPos.X(), vertexPos.Y());
-    histos2D["h_1prong_vertexYZ"]->Fill(vertexPos.Y(), vertexPos.Z());
-    profiles1D["h_1prong_vertexXY_prof"]->Fill(vertexPos.X(), vertexPos.Y());
-    histos1D["h_1prong_vertexXBEAM"]->Fill(vertexPos_BEAM_LAB.X());
-    histos1D["h_1prong_vertexYBEAM"]->Fill(vertexPos_BEAM_LAB.Y());
-    histos1D["h_1prong_vertexZBEAM"]->Fill(vertexPos_BEAM_LAB.Z());
-    histos2D["h_1prong_vertexZXBEAM"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
-    histos2D["h_1prong_vertexXYBEAM"]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
-    profiles1D["h_1prong_vertexZXBEAM_prof"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+    histos1D[h_1prong_vertexX]->Fill(vertexPos.X());
+    histos1D[h_1prong_vertexY]->Fill(vertexPos.Y());
+    histos1D[h_1prong_vertexZ]->Fill(vertexPos.Z());
+    histos2D[h_1prong_vertexXY]->Fill(vertexPos.X(), vertexPos.Y());
+    histos2D[h_1prong_vertexYZ]->Fill(vertexPos.Y(), vertexPos.Z());
+    profiles1D[h_1prong_vertexXY_prof]->Fill(vertexPos.X(), vertexPos.Y());
+    histos1D[h_1prong_vertexXBEAM]->Fill(vertexPos_BEAM_LAB.X());
+    histos1D[h_1prong_vertexYBEAM]->Fill(vertexPos_BEAM_LAB.Y());
+    histos1D[h_1prong_vertexZBEAM]->Fill(vertexPos_BEAM_LAB.Z());
+    histos2D[h_1prong_vertexZXBEAM]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+    histos2D[h_1prong_vertexXYBEAM]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
+    profiles1D[h_1prong_vertexZXBEAM_prof]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
     auto track=list.front();
     const double len=track.getLength(); // [mm]
-    histos1D["h_1prong_alpha_len"]->Fill(len);
-    histos1D["h_1prong_alpha_deltaX"]->Fill(len*track.getTangent().X());
-    histos1D["h_1prong_alpha_deltaY"]->Fill(len*track.getTangent().Y());
-    histos1D["h_1prong_alpha_deltaZ"]->Fill(len*track.getTangent().Z());
-    histos2D["h_1prong_alpha_deltaXY"]->Fill(len*track.getTangent().X(), len*track.getTangent().Y());
-    histos2D["h_1prong_alpha_deltaXZ"]->Fill(len*track.getTangent().X(), len*track.getTangent().Z());
-    histos2D["h_1prong_alpha_deltaYZ"]->Fill(len*track.getTangent().Y(), len*track.getTangent().Z());
-    histos1D["h_1prong_alpha_endX"]->Fill(track.getEnd().X());
-    histos1D["h_1prong_alpha_endY"]->Fill(track.getEnd().Y());
-    histos1D["h_1prong_alpha_endZ"]->Fill(track.getEnd().Z());
-    histos2D["h_1prong_alpha_endXY"]->Fill(track.getEnd().X(), track.getEnd().Y());
-    histos1D["h_1prong_alpha_phiDET"]->Fill(track.getTangent().Phi());
-    histos1D["h_1prong_alpha_thetaDET"]->Fill(track.getTangent().Theta());
-    histos1D["h_1prong_alpha_cosThetaDET"]->Fill(track.getTangent().CosTheta());
+    histos1D[h_1prong_alpha_len]->Fill(len);
+    histos1D[h_1prong_alpha_deltaX]->Fill(len*track.getTangent().X());
+    histos1D[h_1prong_alpha_deltaY]->Fill(len*track.getTangent().Y());
+    histos1D[h_1prong_alpha_deltaZ]->Fill(len*track.getTangent().Z());
+    histos2D[h_1prong_alpha_deltaXY]->Fill(len*track.getTangent().X(), len*track.getTangent().Y());
+    histos2D[h_1prong_alpha_deltaXZ]->Fill(len*track.getTangent().X(), len*track.getTangent().Z());
+    histos2D[h_1prong_alpha_deltaYZ]->Fill(len*track.getTangent().Y(), len*track.getTangent().Z());
+    histos1D[h_1prong_alpha_endX]->Fill(track.getEnd().X());
+    histos1D[h_1prong_alpha_endY]->Fill(track.getEnd().Y());
+    histos1D[h_1prong_alpha_endZ]->Fill(track.getEnd().Z());
+    histos2D[h_1prong_alpha_endXY]->Fill(track.getEnd().X(), track.getEnd().Y());
+    histos1D[h_1prong_alpha_phiDET]->Fill(track.getTangent().Phi());
+    histos1D[h_1prong_alpha_thetaDET]->Fill(track.getTangent().Theta());
+    histos1D[h_1prong_alpha_cosThetaDET]->Fill(track.getTangent().CosTheta());
 
     auto tangent_BEAM_LAB = coordinateConverter.detToBeam(track.getTangent());
     double phi_BEAM_LAB = tangent_BEAM_LAB.Phi();
     double cosTheta_BEAM_LAB = tangent_BEAM_LAB.CosTheta();
-    histos1D["h_1prong_alpha_phiBEAM_LAB"]->Fill(phi_BEAM_LAB);
-    histos1D["h_1prong_alpha_thetaBEAM_LAB"]->Fill(acos(cosTheta_BEAM_LAB));
-    histos1D["h_1prong_alpha_cosThetaBEAM_LAB"]->Fill(cosTheta_BEAM_LAB);
-    histos2D["h_1prong_alpha_cosThetaBEAM_len_LAB"]->Fill(cosTheta_BEAM_LAB, len);
-    profiles1D["h_1prong_alpha_cosThetaBEAM_len_LAB_prof"]->Fill(cosTheta_BEAM_LAB, len);
+    histos1D[h_1prong_alpha_phiBEAM_LAB]->Fill(phi_BEAM_LAB);
+    histos1D[h_1prong_alpha_thetaBEAM_LAB]->Fill(acos(cosTheta_BEAM_LAB));
+    histos1D[h_1prong_alpha_cosThetaBEAM_LAB]->Fill(cosTheta_BEAM_LAB);
+    histos2D[h_1prong_alpha_cosThetaBEAM_len_LAB]->Fill(cosTheta_BEAM_LAB, len);
+    profiles1D[h_1prong_alpha_cosThetaBEAM_len_LAB_prof]->Fill(cosTheta_BEAM_LAB, len);
 
     // reconstruct kinetic energy from particle range [mm]
     double T_LAB=myRangeCalculator.getIonEnergyMeV(/*IonRangeCalculator::*/ALPHA, len);
     //    double p_LAB=sqrt(T_LAB*(T_LAB+2*alphaMass));
-    histos1D["h_1prong_alpha_E_LAB"]->Fill(T_LAB);
-    histos2D["h_1prong_alpha_cosThetaBEAM_E_LAB"]->Fill(cosTheta_BEAM_LAB, T_LAB);
-    profiles1D["h_1prong_alpha_cosThetaBEAM_E_LAB_prof"]->Fill(cosTheta_BEAM_LAB, T_LAB);
+    histos1D[h_1prong_alpha_E_LAB]->Fill(T_LAB);
+    histos2D[h_1prong_alpha_cosThetaBEAM_E_LAB]->Fill(cosTheta_BEAM_LAB, T_LAB);
+    profiles1D[h_1prong_alpha_cosThetaBEAM_E_LAB_prof]->Fill(cosTheta_BEAM_LAB, T_LAB);
   }
 
   // 2-prong (alpha+carbon)
   if(ntracks==2) {
-    histos1D["h_2prong_vertexX"]->Fill(vertexPos.X());
-    histos1D["h_2prong_vertexY"]->Fill(vertexPos.Y());
-    histos1D["h_2prong_vertexZ"]->Fill(vertexPos.Z());
-    histos2D["h_2prong_vertexXY"]->Fill(vertexPos.X(), vertexPos.Y());
-    histos2D["h_2prong_vertexYZ"]->Fill(vertexPos.Y(), vertexPos.Z());
-    profiles1D["h_2prong_vertexXY_prof"]->Fill(vertexPos.X(), vertexPos.Y());
-    histos1D["h_2prong_vertexXBEAM"]->Fill(vertexPos_BEAM_LAB.X());
-    histos1D["h_2prong_vertexYBEAM"]->Fill(vertexPos_BEAM_LAB.Y());
-    histos1D["h_2prong_vertexZBEAM"]->Fill(vertexPos_BEAM_LAB.Z());
-    histos2D["h_2prong_vertexZXBEAM"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
-    histos2D["h_2prong_vertexXYBEAM"]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
-    profiles1D["h_2prong_vertexZXBEAM_prof"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+    histos1D[h_2prong_vertexX]->Fill(vertexPos.X());
+    histos1D[h_2prong_vertexY]->Fill(vertexPos.Y());
+    histos1D[h_2prong_vertexZ]->Fill(vertexPos.Z());
+    histos2D[h_2prong_vertexXY]->Fill(vertexPos.X(), vertexPos.Y());
+    histos2D[h_2prong_vertexYZ]->Fill(vertexPos.Y(), vertexPos.Z());
+    profiles1D[h_2prong_vertexXY_prof]->Fill(vertexPos.X(), vertexPos.Y());
+    histos1D[h_2prong_vertexXBEAM]->Fill(vertexPos_BEAM_LAB.X());
+    histos1D[h_2prong_vertexYBEAM]->Fill(vertexPos_BEAM_LAB.Y());
+    histos1D[h_2prong_vertexZBEAM]->Fill(vertexPos_BEAM_LAB.Z());
+    histos2D[h_2prong_vertexZXBEAM]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+    histos2D[h_2prong_vertexXYBEAM]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
+    profiles1D[h_2prong_vertexZXBEAM_prof]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
 
     const double alpha_len = list.front().getLength(); // longest = alpha
     const double carbon_len = list.back().getLength(); // shortest = carbon
-    histos1D["h_2prong_alpha_len"]->Fill(alpha_len);
-    histos2D["h_2prong_alpha_len_carbon_len"]->Fill(alpha_len, carbon_len);
-    histos1D["h_2prong_lenSum"]->Fill(alpha_len+carbon_len);
-    histos1D["h_2prong_alpha_deltaX"]->Fill(alpha_len*list.front().getTangent().X());
-    histos1D["h_2prong_alpha_deltaY"]->Fill(alpha_len*list.front().getTangent().Y());
-    histos1D["h_2prong_alpha_deltaZ"]->Fill(alpha_len*list.front().getTangent().Z());
-    histos2D["h_2prong_alpha_deltaXY"]->Fill(alpha_len*list.front().getTangent().X(), alpha_len*list.front().getTangent().Y());
-    histos2D["h_2prong_alpha_deltaXZ"]->Fill(alpha_len*list.front().getTangent().X(), alpha_len*list.front().getTangent().Z());
-    histos2D["h_2prong_alpha_deltaYZ"]->Fill(alpha_len*list.front().getTangent().Y(), alpha_len*list.front().getTangent().Z());
-    histos1D["h_2prong_alpha_endX"]->Fill(list.front().getEnd().X());
-    histos1D["h_2prong_alpha_endY"]->Fill(list.front().getEnd().Y());
-    histos1D["h_2prong_alpha_endZ"]->Fill(list.front().getEnd().Z());
-    histos2D["h_2prong_alpha_endXY"]->Fill(list.front().getEnd().X(), list.front().getEnd().Y());
-    histos1D["h_2prong_alpha_phiDET"]->Fill(list.front().getTangent().Phi());
-    histos1D["h_2prong_alpha_thetaDET"]->Fill(list.front().getTangent().Theta());
-    histos1D["h_2prong_alpha_cosThetaDET"]->Fill(list.front().getTangent().CosTheta());
-    histos1D["h_2prong_carbon_len"]->Fill(carbon_len);
-    histos1D["h_2prong_carbon_deltaX"]->Fill(carbon_len*list.back().getTangent().X());
-    histos1D["h_2prong_carbon_deltaY"]->Fill(carbon_len*list.back().getTangent().Y());
-    histos1D["h_2prong_carbon_deltaZ"]->Fill(carbon_len*list.back().getTangent().Z());
-    histos2D["h_2prong_carbon_deltaXY"]->Fill(carbon_len*list.back().getTangent().X(), carbon_len*list.back().getTangent().Y());
-    histos2D["h_2prong_carbon_deltaXZ"]->Fill(carbon_len*list.back().getTangent().X(), carbon_len*list.back().getTangent().Z());
-    histos2D["h_2prong_carbon_deltaYZ"]->Fill(carbon_len*list.back().getTangent().Y(), carbon_len*list.back().getTangent().Z());
-    histos1D["h_2prong_carbon_endX"]->Fill(list.back().getEnd().X());
-    histos1D["h_2prong_carbon_endY"]->Fill(list.back().getEnd().Y());
-    histos1D["h_2prong_carbon_endZ"]->Fill(list.back().getEnd().Z());
-    histos2D["h_2prong_carbon_endXY"]->Fill(list.back().getEnd().X(), list.back().getEnd().Y());
+    histos1D[h_2prong_alpha_len]->Fill(alpha_len);
+    histos2D[h_2prong_alpha_len_carbon_len]->Fill(alpha_len, carbon_len);
+    histos1D[h_2prong_lenSum]->Fill(alpha_len+carbon_len);
+    histos1D[h_2prong_alpha_deltaX]->Fill(alpha_len*list.front().getTangent().X());
+    histos1D[h_2prong_alpha_deltaY]->Fill(alpha_len*list.front().getTangent().Y());
+    histos1D[h_2prong_alpha_deltaZ]->Fill(alpha_len*list.front().getTangent().Z());
+    histos2D[h_2prong_alpha_deltaXY]->Fill(alpha_len*list.front().getTangent().X(), alpha_len*list.front().getTangent().Y());
+    histos2D[h_2prong_alpha_deltaXZ]->Fill(alpha_len*list.front().getTangent().X(), alpha_len*list.front().getTangent().Z());
+    histos2D[h_2prong_alpha_deltaYZ]->Fill(alpha_len*list.front().getTangent().Y(), alpha_len*list.front().getTangent().Z());
+    histos1D[h_2prong_alpha_endX]->Fill(list.front().getEnd().X());
+    histos1D[h_2prong_alpha_endY]->Fill(list.front().getEnd().Y());
+    histos1D[h_2prong_alpha_endZ]->Fill(list.front().getEnd().Z());
+    histos2D[h_2prong_alpha_endXY]->Fill(list.front().getEnd().X(), list.front().getEnd().Y());
+    histos1D[h_2prong_alpha_phiDET]->Fill(list.front().getTangent().Phi());
+    histos1D[h_2prong_alpha_thetaDET]->Fill(list.front().getTangent().Theta());
+    histos1D[h_2prong_alpha_cosThetaDET]->Fill(list.front().getTangent().CosTheta());
+    histos1D[h_2prong_carbon_len]->Fill(carbon_len);
+    histos1D[h_2prong_carbon_deltaX]->Fill(carbon_len*list.back().getTangent().X());
+    histos1D[h_2prong_carbon_deltaY]->Fill(carbon_len*list.back().getTangent().Y());
+    histos1D[h_2prong_carbon_deltaZ]->Fill(carbon_len*list.back().getTangent().Z());
+    histos2D[h_2prong_carbon_deltaXY]->Fill(carbon_len*list.back().getTangent().X(), carbon_len*list.back().getTangent().Y());
+    histos2D[h_2prong_carbon_deltaXZ]->Fill(carbon_len*list.back().getTangent().X(), carbon_len*list.back().getTangent().Z());
+    histos2D[h_2prong_carbon_deltaYZ]->Fill(carbon_len*list.back().getTangent().Y(), carbon_len*list.back().getTangent().Z());
+    histos1D[h_2prong_carbon_endX]->Fill(list.back().getEnd().X());
+    histos1D[h_2prong_carbon_endY]->Fill(list.back().getEnd().Y());
+    histos1D[h_2prong_carbon_endZ]->Fill(list.back().getEnd().Z());
+    histos2D[h_2prong_carbon_endXY]->Fill(list.back().getEnd().X(), list.back().getEnd().Y());
 
     // calculate angles in LAB reference frame in DET coordinate system
     double delta_LAB=list.front().getTangent().Angle(list.back().getTangent()); // [rad]
-    histos1D["h_2prong_carbon_phiDET"]->Fill(list.back().getTangent().Phi());
-    histos1D["h_2prong_carbon_thetaDET"]->Fill(list.back().getTangent().Theta());
-    histos1D["h_2prong_carbon_cosThetaDET"]->Fill(list.back().getTangent().CosTheta());
-    histos1D["h_2prong_alpha_carbon_delta_LAB"]->Fill(delta_LAB);
-    histos1D["h_2prong_alpha_carbon_cosDelta_LAB"]->Fill(cos(delta_LAB));
+    histos1D[h_2prong_carbon_phiDET]->Fill(list.back().getTangent().Phi());
+    histos1D[h_2prong_carbon_thetaDET]->Fill(list.back().getTangent().Theta());
+    histos1D[h_2prong_carbon_cosThetaDET]->Fill(list.back().getTangent().CosTheta());
+    histos1D[h_2prong_alpha_carbon_delta_LAB]->Fill(delta_LAB);
+    histos1D[h_2prong_alpha_carbon_cosDelta_LAB]->Fill(cos(delta_LAB));
 
     auto alpha_tangent_BEAM_LAB = coordinateConverter.detToBeam(list.front().getTangent());
     auto carbon_tangent_BEAM_LAB = coordinateConverter.detToBeam(list.back().getTangent());
@@ -785,16 +822,16 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
     double carbon_phi_BEAM_LAB = carbon_tangent_BEAM_LAB.Phi();
     double alpha_cosTheta_BEAM_LAB = alpha_tangent_BEAM_LAB.CosTheta();
     double carbon_cosTheta_BEAM_LAB = carbon_tangent_BEAM_LAB.CosTheta();
-    histos1D["h_2prong_alpha_phiBEAM_LAB"]->Fill(alpha_phi_BEAM_LAB);
-    histos1D["h_2prong_alpha_thetaBEAM_LAB"]->Fill(acos(alpha_cosTheta_BEAM_LAB));
-    histos1D["h_2prong_alpha_cosThetaBEAM_LAB"]->Fill(alpha_cosTheta_BEAM_LAB);
-    histos2D["h_2prong_alpha_cosThetaBEAM_len_LAB"]->Fill(alpha_cosTheta_BEAM_LAB, alpha_len);
-    profiles1D["h_2prong_alpha_cosThetaBEAM_len_LAB_prof"]->Fill(alpha_cosTheta_BEAM_LAB, alpha_len);
-    histos1D["h_2prong_carbon_phiBEAM_LAB"]->Fill(carbon_phi_BEAM_LAB);
-    histos1D["h_2prong_carbon_thetaBEAM_LAB"]->Fill(acos(carbon_cosTheta_BEAM_LAB));
-    histos1D["h_2prong_carbon_cosThetaBEAM_LAB"]->Fill(carbon_cosTheta_BEAM_LAB);
-    histos2D["h_2prong_carbon_cosThetaBEAM_len_LAB"]->Fill(carbon_cosTheta_BEAM_LAB, carbon_len);
-    profiles1D["h_2prong_carbon_cosThetaBEAM_len_LAB_prof"]->Fill(carbon_cosTheta_BEAM_LAB, carbon_len);
+    histos1D[h_2prong_alpha_phiBEAM_LAB]->Fill(alpha_phi_BEAM_LAB);
+    histos1D[h_2prong_alpha_thetaBEAM_LAB]->Fill(acos(alpha_cosTheta_BEAM_LAB));
+    histos1D[h_2prong_alpha_cosThetaBEAM_LAB]->Fill(alpha_cosTheta_BEAM_LAB);
+    histos2D[h_2prong_alpha_cosThetaBEAM_len_LAB]->Fill(alpha_cosTheta_BEAM_LAB, alpha_len);
+    profiles1D[h_2prong_alpha_cosThetaBEAM_len_LAB_prof]->Fill(alpha_cosTheta_BEAM_LAB, alpha_len);
+    histos1D[h_2prong_carbon_phiBEAM_LAB]->Fill(carbon_phi_BEAM_LAB);
+    histos1D[h_2prong_carbon_thetaBEAM_LAB]->Fill(acos(carbon_cosTheta_BEAM_LAB));
+    histos1D[h_2prong_carbon_cosThetaBEAM_LAB]->Fill(carbon_cosTheta_BEAM_LAB);
+    histos2D[h_2prong_carbon_cosThetaBEAM_len_LAB]->Fill(carbon_cosTheta_BEAM_LAB, carbon_len);
+    profiles1D[h_2prong_carbon_cosThetaBEAM_len_LAB_prof]->Fill(carbon_cosTheta_BEAM_LAB, carbon_len);
 
     // reconstruct kinetic energy from particle range [mm]
     const double alphaMass=myRangeCalculator.getIonMassMeV(/*IonRangeCalculator::*/ALPHA);
@@ -837,22 +874,22 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
     double oxygenExcitationEnergy=oxygenMassExcited-oxygenMassGroundState;
     double Qvalue_CMS=oxygenMassExcited-alphaMass-carbonMass;
 
-    histos1D["h_2prong_alpha_E_LAB"]->Fill(alpha_T_LAB);
-    histos1D["h_2prong_carbon_E_LAB"]->Fill(carbon_T_LAB);
-    histos1D["h_2prong_alpha_E_CMS"]->Fill(alpha_T_CMS);
-    histos1D["h_2prong_carbon_E_CMS"]->Fill(carbon_T_CMS);
-    histos1D["h_2prong_total_PxBEAM_CMS"]->Fill((alphaP4_BEAM_CMS+carbonP4_BEAM_CMS).Px());
-    histos1D["h_2prong_total_PyBEAM_CMS"]->Fill((alphaP4_BEAM_CMS+carbonP4_BEAM_CMS).Py());
-    histos1D["h_2prong_total_PzBEAM_CMS"]->Fill((alphaP4_BEAM_CMS+carbonP4_BEAM_CMS).Pz());
-    histos1D["h_2prong_total_PxBEAM_LAB"]->Fill((alphaP4_BEAM_LAB+carbonP4_BEAM_LAB).Px());
-    histos1D["h_2prong_total_PyBEAM_LAB"]->Fill((alphaP4_BEAM_LAB+carbonP4_BEAM_LAB).Py());
-    histos1D["h_2prong_total_PzBEAM_LAB"]->Fill((alphaP4_BEAM_LAB+carbonP4_BEAM_LAB).Pz());
-    histos1D["h_2prong_total_E_CMS"]->Fill(totalEnergy_CMS);
-    histos1D["h_2prong_excitation_E_CMS"]->Fill(oxygenExcitationEnergy);
-    histos1D["h_2prong_Qvalue_CMS"]->Fill(Qvalue_CMS);
-    histos1D["h_2prong_gamma_E_LAB"]->Fill(photon_E_LAB);
-    histos1D["h_2prong_E_CMS"]->Fill(alpha_T_CMS+carbon_T_CMS);
-    histos1D["h_2prong_E_LAB"]->Fill(alpha_T_LAB+carbon_T_LAB);
+    histos1D[h_2prong_alpha_E_LAB]->Fill(alpha_T_LAB);
+    histos1D[h_2prong_carbon_E_LAB]->Fill(carbon_T_LAB);
+    histos1D[h_2prong_alpha_E_CMS]->Fill(alpha_T_CMS);
+    histos1D[h_2prong_carbon_E_CMS]->Fill(carbon_T_CMS);
+    histos1D[h_2prong_total_PxBEAM_CMS]->Fill((alphaP4_BEAM_CMS+carbonP4_BEAM_CMS).Px());
+    histos1D[h_2prong_total_PyBEAM_CMS]->Fill((alphaP4_BEAM_CMS+carbonP4_BEAM_CMS).Py());
+    histos1D[h_2prong_total_PzBEAM_CMS]->Fill((alphaP4_BEAM_CMS+carbonP4_BEAM_CMS).Pz());
+    histos1D[h_2prong_total_PxBEAM_LAB]->Fill((alphaP4_BEAM_LAB+carbonP4_BEAM_LAB).Px());
+    histos1D[h_2prong_total_PyBEAM_LAB]->Fill((alphaP4_BEAM_LAB+carbonP4_BEAM_LAB).Py());
+    histos1D[h_2prong_total_PzBEAM_LAB]->Fill((alphaP4_BEAM_LAB+carbonP4_BEAM_LAB).Pz());
+    histos1D[h_2prong_total_E_CMS]->Fill(totalEnergy_CMS);
+    histos1D[h_2prong_excitation_E_CMS]->Fill(oxygenExcitationEnergy);
+    histos1D[h_2prong_Qvalue_CMS]->Fill(Qvalue_CMS);
+    histos1D[h_2prong_gamma_E_LAB]->Fill(photon_E_LAB);
+    histos1D[h_2prong_E_CMS]->Fill(alpha_T_CMS+carbon_T_CMS);
+    histos1D[h_2prong_E_LAB]->Fill(alpha_T_LAB+carbon_T_LAB);
 
     // calculate angles in CMS reference frame in BEAM coordinate system
     double delta_CMS=alphaP4_BEAM_CMS.Angle(carbonP4_BEAM_CMS.Vect()); // [rad]
@@ -862,86 +899,86 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
     double carbon_cosTheta_BEAM_CMS=carbonP4_BEAM_CMS.CosTheta(); // [rad], polar angle from Z axis
 
     // alpha particle
-    histos1D["h_2prong_alpha_phiBEAM_CMS"]->Fill(alpha_phi_BEAM_CMS);
-    histos1D["h_2prong_alpha_thetaBEAM_CMS"]->Fill(acos(alpha_cosTheta_BEAM_CMS));
-    histos1D["h_2prong_alpha_cosThetaBEAM_CMS"]->Fill(alpha_cosTheta_BEAM_CMS);
-    histos2D["h_2prong_alpha_cosThetaBEAM_E_CMS"]->Fill(alpha_cosTheta_BEAM_CMS, alpha_T_CMS);
-    histos2D["h_2prong_alpha_cosThetaBEAM_E_LAB"]->Fill(alpha_cosTheta_BEAM_LAB, alpha_T_LAB);
-    profiles1D["h_2prong_alpha_cosThetaBEAM_E_CMS_prof"]->Fill(alpha_cosTheta_BEAM_CMS, alpha_T_CMS);
-    profiles1D["h_2prong_alpha_cosThetaBEAM_E_LAB_prof"]->Fill(alpha_cosTheta_BEAM_LAB, alpha_T_LAB);
+    histos1D[h_2prong_alpha_phiBEAM_CMS]->Fill(alpha_phi_BEAM_CMS);
+    histos1D[h_2prong_alpha_thetaBEAM_CMS]->Fill(acos(alpha_cosTheta_BEAM_CMS));
+    histos1D[h_2prong_alpha_cosThetaBEAM_CMS]->Fill(alpha_cosTheta_BEAM_CMS);
+    histos2D[h_2prong_alpha_cosThetaBEAM_E_CMS]->Fill(alpha_cosTheta_BEAM_CMS, alpha_T_CMS);
+    histos2D[h_2prong_alpha_cosThetaBEAM_E_LAB]->Fill(alpha_cosTheta_BEAM_LAB, alpha_T_LAB);
+    profiles1D[h_2prong_alpha_cosThetaBEAM_E_CMS_prof]->Fill(alpha_cosTheta_BEAM_CMS, alpha_T_CMS);
+    profiles1D[h_2prong_alpha_cosThetaBEAM_E_LAB_prof]->Fill(alpha_cosTheta_BEAM_LAB, alpha_T_LAB);
     // carbon recoil
-    histos1D["h_2prong_carbon_phiBEAM_CMS"]->Fill(carbon_phi_BEAM_CMS);
-    histos1D["h_2prong_carbon_thetaBEAM_CMS"]->Fill(acos(carbon_cosTheta_BEAM_CMS));
-    histos1D["h_2prong_carbon_cosThetaBEAM_CMS"]->Fill(carbon_cosTheta_BEAM_CMS);
-    histos2D["h_2prong_carbon_cosThetaBEAM_E_CMS"]->Fill(carbon_cosTheta_BEAM_CMS, carbon_T_CMS);
-    histos2D["h_2prong_carbon_cosThetaBEAM_E_LAB"]->Fill(carbon_cosTheta_BEAM_CMS, carbon_T_LAB);
-    profiles1D["h_2prong_carbon_cosThetaBEAM_E_CMS_prof"]->Fill(carbon_cosTheta_BEAM_CMS, carbon_T_CMS);
-    profiles1D["h_2prong_carbon_cosThetaBEAM_E_LAB_prof"]->Fill(carbon_cosTheta_BEAM_LAB, carbon_T_LAB);
+    histos1D[h_2prong_carbon_phiBEAM_CMS]->Fill(carbon_phi_BEAM_CMS);
+    histos1D[h_2prong_carbon_thetaBEAM_CMS]->Fill(acos(carbon_cosTheta_BEAM_CMS));
+    histos1D[h_2prong_carbon_cosThetaBEAM_CMS]->Fill(carbon_cosTheta_BEAM_CMS);
+    histos2D[h_2prong_carbon_cosThetaBEAM_E_CMS]->Fill(carbon_cosTheta_BEAM_CMS, carbon_T_CMS);
+    histos2D[h_2prong_carbon_cosThetaBEAM_E_LAB]->Fill(carbon_cosTheta_BEAM_CMS, carbon_T_LAB);
+    profiles1D[h_2prong_carbon_cosThetaBEAM_E_CMS_prof]->Fill(carbon_cosTheta_BEAM_CMS, carbon_T_CMS);
+    profiles1D[h_2prong_carbon_cosThetaBEAM_E_LAB_prof]->Fill(carbon_cosTheta_BEAM_LAB, carbon_T_LAB);
     // alpha-carbon correlations
-    histos1D["h_2prong_alpha_carbon_delta_CMS"]->Fill(delta_CMS);
-    histos1D["h_2prong_alpha_carbon_cosDelta_CMS"]->Fill(cos(delta_CMS));
-    histos2D["h_2prong_alpha_E_carbon_E_CMS"]->Fill(alpha_T_CMS, carbon_T_CMS);
-    histos2D["h_2prong_alpha_E_carbon_E_LAB"]->Fill(alpha_T_LAB, carbon_T_LAB);
+    histos1D[h_2prong_alpha_carbon_delta_CMS]->Fill(delta_CMS);
+    histos1D[h_2prong_alpha_carbon_cosDelta_CMS]->Fill(cos(delta_CMS));
+    histos2D[h_2prong_alpha_E_carbon_E_CMS]->Fill(alpha_T_CMS, carbon_T_CMS);
+    histos2D[h_2prong_alpha_E_carbon_E_LAB]->Fill(alpha_T_LAB, carbon_T_LAB);
 
     // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (Y_DET) horizontal & perpendicular to the gamma beam axis
-    histos2D["h_2prong_vertexX_lenSum"]->Fill(vertexPos.X(), alpha_len+carbon_len);
-    histos2D["h_2prong_vertexY_lenSum"]->Fill(vertexPos.Y(), alpha_len+carbon_len);
-    histos2D["h_2prong_vertexZ_lenSum"]->Fill(vertexPos.Z(), alpha_len+carbon_len);
-    histos2D["h_2prong_vertexY_alpha_len"]->Fill(vertexPos.Y(), alpha_len);
-    histos2D["h_2prong_vertexY_carbon_len"]->Fill(vertexPos.Y(), carbon_len);
-    histos2D["h_2prong_vertexY_alpha_E_LAB"]->Fill(vertexPos.Y(), alpha_T_LAB);
-    histos2D["h_2prong_vertexY_carbon_E_LAB"]->Fill(vertexPos.Y(), carbon_T_LAB);
-    histos2D["h_2prong_vertexY_alpha_E_CMS"]->Fill(vertexPos.Y(), alpha_T_CMS);
-    histos2D["h_2prong_vertexY_carbon_E_CMS"]->Fill(vertexPos.Y(), carbon_T_CMS);
-    histos2D["h_2prong_vertexY_alpha_cosThetaBEAM_LAB"]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_LAB);
-    histos2D["h_2prong_vertexY_carbon_cosThetaBEAM_LAB"]->Fill(vertexPos.Y(), carbon_cosTheta_BEAM_LAB);
-    histos2D["h_2prong_vertexY_alpha_cosThetaBEAM_CMS"]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_CMS);
-    histos2D["h_2prong_vertexY_carbon_cosThetaBEAM_CMS"]->Fill(vertexPos.Y(), carbon_cosTheta_BEAM_CMS);
-    histos2D["h_2prong_vertexY_gamma_E_LAB"]->Fill(vertexPos.Y(), photon_E_LAB);
-    histos2D["h_2prong_vertexY_Qvalue_CMS"]->Fill(vertexPos.Y(), Qvalue_CMS);
-    profiles1D["h_2prong_vertexX_lenSum_prof"]->Fill(vertexPos.X(), alpha_len+carbon_len);
-    profiles1D["h_2prong_vertexY_lenSum_prof"]->Fill(vertexPos.Y(), alpha_len+carbon_len);
-    profiles1D["h_2prong_vertexZ_lenSum_prof"]->Fill(vertexPos.Z(), alpha_len+carbon_len);
-    profiles1D["h_2prong_vertexY_alpha_len_prof"]->Fill(vertexPos.Y(), alpha_len);
-    profiles1D["h_2prong_vertexY_carbon_len_prof"]->Fill(vertexPos.Y(), carbon_len);
-    profiles1D["h_2prong_vertexY_alpha_E_LAB_prof"]->Fill(vertexPos.Y(), alpha_T_LAB);
-    profiles1D["h_2prong_vertexY_carbon_E_LAB_prof"]->Fill(vertexPos.Y(), carbon_T_LAB);
-    profiles1D["h_2prong_vertexY_alpha_E_CMS_prof"]->Fill(vertexPos.Y(), alpha_T_CMS);
-    profiles1D["h_2prong_vertexY_carbon_E_CMS_prof"]->Fill(vertexPos.Y(), carbon_T_CMS);
-    profiles1D["h_2prong_vertexY_gamma_E_LAB_prof"]->Fill(vertexPos.Y(), photon_E_LAB);
-    profiles1D["h_2prong_vertexY_Qvalue_CMS_prof"]->Fill(vertexPos.Y(), Qvalue_CMS);
+    histos2D[h_2prong_vertexX_lenSum]->Fill(vertexPos.X(), alpha_len+carbon_len);
+    histos2D[h_2prong_vertexY_lenSum]->Fill(vertexPos.Y(), alpha_len+carbon_len);
+    histos2D[h_2prong_vertexZ_lenSum]->Fill(vertexPos.Z(), alpha_len+carbon_len);
+    histos2D[h_2prong_vertexY_alpha_len]->Fill(vertexPos.Y(), alpha_len);
+    histos2D[h_2prong_vertexY_carbon_len]->Fill(vertexPos.Y(), carbon_len);
+    histos2D[h_2prong_vertexY_alpha_E_LAB]->Fill(vertexPos.Y(), alpha_T_LAB);
+    histos2D[h_2prong_vertexY_carbon_E_LAB]->Fill(vertexPos.Y(), carbon_T_LAB);
+    histos2D[h_2prong_vertexY_alpha_E_CMS]->Fill(vertexPos.Y(), alpha_T_CMS);
+    histos2D[h_2prong_vertexY_carbon_E_CMS]->Fill(vertexPos.Y(), carbon_T_CMS);
+    histos2D[h_2prong_vertexY_alpha_cosThetaBEAM_LAB]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_LAB);
+    histos2D[h_2prong_vertexY_carbon_cosThetaBEAM_LAB]->Fill(vertexPos.Y(), carbon_cosTheta_BEAM_LAB);
+    histos2D[h_2prong_vertexY_alpha_cosThetaBEAM_CMS]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_CMS);
+    histos2D[h_2prong_vertexY_carbon_cosThetaBEAM_CMS]->Fill(vertexPos.Y(), carbon_cosTheta_BEAM_CMS);
+    histos2D[h_2prong_vertexY_gamma_E_LAB]->Fill(vertexPos.Y(), photon_E_LAB);
+    histos2D[h_2prong_vertexY_Qvalue_CMS]->Fill(vertexPos.Y(), Qvalue_CMS);
+    profiles1D[h_2prong_vertexX_lenSum_prof]->Fill(vertexPos.X(), alpha_len+carbon_len);
+    profiles1D[h_2prong_vertexY_lenSum_prof]->Fill(vertexPos.Y(), alpha_len+carbon_len);
+    profiles1D[h_2prong_vertexZ_lenSum_prof]->Fill(vertexPos.Z(), alpha_len+carbon_len);
+    profiles1D[h_2prong_vertexY_alpha_len_prof]->Fill(vertexPos.Y(), alpha_len);
+    profiles1D[h_2prong_vertexY_carbon_len_prof]->Fill(vertexPos.Y(), carbon_len);
+    profiles1D[h_2prong_vertexY_alpha_E_LAB_prof]->Fill(vertexPos.Y(), alpha_T_LAB);
+    profiles1D[h_2prong_vertexY_carbon_E_LAB_prof]->Fill(vertexPos.Y(), carbon_T_LAB);
+    profiles1D[h_2prong_vertexY_alpha_E_CMS_prof]->Fill(vertexPos.Y(), alpha_T_CMS);
+    profiles1D[h_2prong_vertexY_carbon_E_CMS_prof]->Fill(vertexPos.Y(), carbon_T_CMS);
+    profiles1D[h_2prong_vertexY_gamma_E_LAB_prof]->Fill(vertexPos.Y(), photon_E_LAB);
+    profiles1D[h_2prong_vertexY_Qvalue_CMS_prof]->Fill(vertexPos.Y(), Qvalue_CMS);
     // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (X_BEAM) horizontal & perpendicular to the gamma beam axis
-    histos2D["h_2prong_vertexXBEAM_alpha_E_LAB"]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB);
-    histos2D["h_2prong_vertexXBEAM_carbon_E_LAB"]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_LAB);
-    histos2D["h_2prong_vertexXBEAM_alpha_E_CMS"]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS);
-    histos2D["h_2prong_vertexXBEAM_carbon_E_CMS"]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_CMS);
-    histos2D["h_2prong_vertexXBEAM_alpha_cosThetaBEAM_LAB"]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_LAB);
-    histos2D["h_2prong_vertexXBEAM_carbon_cosThetaBEAM_LAB"]->Fill(vertexPos_BEAM_LAB.X(), carbon_cosTheta_BEAM_LAB);
-    histos2D["h_2prong_vertexXBEAM_alpha_cosThetaBEAM_CMS"]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_CMS);
-    histos2D["h_2prong_vertexXBEAM_carbon_cosThetaBEAM_CMS"]->Fill(vertexPos_BEAM_LAB.X(), carbon_cosTheta_BEAM_CMS);
-    histos2D["h_2prong_vertexXBEAM_gamma_E_LAB"]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
-    histos2D["h_2prong_vertexXBEAM_Qvalue_CMS"]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
-    profiles1D["h_2prong_vertexXBEAM_alpha_E_LAB_prof"]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB);
-    profiles1D["h_2prong_vertexXBEAM_carbon_E_LAB_prof"]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_LAB);
-    profiles1D["h_2prong_vertexXBEAM_alpha_E_CMS_prof"]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS);
-    profiles1D["h_2prong_vertexXBEAM_carbon_E_CMS_prof"]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_CMS);
-    profiles1D["h_2prong_vertexXBEAM_gamma_E_LAB_prof"]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
-    profiles1D["h_2prong_vertexXBEAM_Qvalue_CMS_prof"]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
+    histos2D[h_2prong_vertexXBEAM_alpha_E_LAB]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB);
+    histos2D[h_2prong_vertexXBEAM_carbon_E_LAB]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_LAB);
+    histos2D[h_2prong_vertexXBEAM_alpha_E_CMS]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS);
+    histos2D[h_2prong_vertexXBEAM_carbon_E_CMS]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_CMS);
+    histos2D[h_2prong_vertexXBEAM_alpha_cosThetaBEAM_LAB]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_LAB);
+    histos2D[h_2prong_vertexXBEAM_carbon_cosThetaBEAM_LAB]->Fill(vertexPos_BEAM_LAB.X(), carbon_cosTheta_BEAM_LAB);
+    histos2D[h_2prong_vertexXBEAM_alpha_cosThetaBEAM_CMS]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_CMS);
+    histos2D[h_2prong_vertexXBEAM_carbon_cosThetaBEAM_CMS]->Fill(vertexPos_BEAM_LAB.X(), carbon_cosTheta_BEAM_CMS);
+    histos2D[h_2prong_vertexXBEAM_gamma_E_LAB]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
+    histos2D[h_2prong_vertexXBEAM_Qvalue_CMS]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
+    profiles1D[h_2prong_vertexXBEAM_alpha_E_LAB_prof]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB);
+    profiles1D[h_2prong_vertexXBEAM_carbon_E_LAB_prof]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_LAB);
+    profiles1D[h_2prong_vertexXBEAM_alpha_E_CMS_prof]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS);
+    profiles1D[h_2prong_vertexXBEAM_carbon_E_CMS_prof]->Fill(vertexPos_BEAM_LAB.X(), carbon_T_CMS);
+    profiles1D[h_2prong_vertexXBEAM_gamma_E_LAB_prof]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
+    profiles1D[h_2prong_vertexXBEAM_Qvalue_CMS_prof]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
   }
   // 3-prong (triple alpha)
   if(ntracks==3) {
-    histos1D["h_3prong_vertexX"]->Fill(vertexPos.X());
-    histos1D["h_3prong_vertexY"]->Fill(vertexPos.Y());
-    histos1D["h_3prong_vertexZ"]->Fill(vertexPos.Z());
-    histos2D["h_3prong_vertexXY"]->Fill(vertexPos.X(), vertexPos.Y());
-    histos2D["h_3prong_vertexYZ"]->Fill(vertexPos.Y(), vertexPos.Z());
-    profiles1D["h_3prong_vertexXY_prof"]->Fill(vertexPos.X(), vertexPos.Y());
-    histos1D["h_3prong_vertexXBEAM"]->Fill(vertexPos_BEAM_LAB.X());
-    histos1D["h_3prong_vertexYBEAM"]->Fill(vertexPos_BEAM_LAB.Y());
-    histos1D["h_3prong_vertexZBEAM"]->Fill(vertexPos_BEAM_LAB.Z());
-    histos2D["h_3prong_vertexZXBEAM"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
-    histos2D["h_3prong_vertexXYBEAM"]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
-    profiles1D["h_3prong_vertexZXBEAM_prof"]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+    histos1D[h_3prong_vertexX]->Fill(vertexPos.X());
+    histos1D[h_3prong_vertexY]->Fill(vertexPos.Y());
+    histos1D[h_3prong_vertexZ]->Fill(vertexPos.Z());
+    histos2D[h_3prong_vertexXY]->Fill(vertexPos.X(), vertexPos.Y());
+    histos2D[h_3prong_vertexYZ]->Fill(vertexPos.Y(), vertexPos.Z());
+    profiles1D[h_3prong_vertexXY_prof]->Fill(vertexPos.X(), vertexPos.Y());
+    histos1D[h_3prong_vertexXBEAM]->Fill(vertexPos_BEAM_LAB.X());
+    histos1D[h_3prong_vertexYBEAM]->Fill(vertexPos_BEAM_LAB.Y());
+    histos1D[h_3prong_vertexZBEAM]->Fill(vertexPos_BEAM_LAB.Z());
+    histos2D[h_3prong_vertexZXBEAM]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
+    histos2D[h_3prong_vertexXYBEAM]->Fill(vertexPos_BEAM_LAB.X(), vertexPos_BEAM_LAB.Y());
+    profiles1D[h_3prong_vertexZXBEAM_prof]->Fill(vertexPos_BEAM_LAB.Z(), vertexPos_BEAM_LAB.X());
 
     const double carbonMassGroundState=myRangeCalculator.getIonMassMeV(/*IonRangeCalculator::*/CARBON_12);
     const double alphaMass=myRangeCalculator.getIonMassMeV(/*IonRangeCalculator::*/ALPHA);
@@ -1027,70 +1064,70 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
     // fill properties per track
     for(auto i=0;i<3;i++) {
       auto track=list.at(i);
-      histos1D[Form("h_3prong_alpha%d_len",i+1)]->Fill(alpha_len[i]);
-      histos1D[Form("h_3prong_alpha%d_deltaX",i+1)]->Fill(alpha_len[i]*track.getTangent().X());
-      histos1D[Form("h_3prong_alpha%d_deltaY",i+1)]->Fill(alpha_len[i]*track.getTangent().Y());
-      histos1D[Form("h_3prong_alpha%d_deltaZ",i+1)]->Fill(alpha_len[i]*track.getTangent().Z());
-      histos2D[Form("h_3prong_alpha%d_deltaXY",i+1)]->Fill(alpha_len[i]*track.getTangent().X(), alpha_len[i]*track.getTangent().Y());
-      histos2D[Form("h_3prong_alpha%d_deltaXZ",i+1)]->Fill(alpha_len[i]*track.getTangent().X(), alpha_len[i]*track.getTangent().Z());
-      histos2D[Form("h_3prong_alpha%d_deltaYZ",i+1)]->Fill(alpha_len[i]*track.getTangent().Y(), alpha_len[i]*track.getTangent().Z());
-      histos1D[Form("h_3prong_alpha%d_endX",i+1)]->Fill(track.getEnd().X());
-      histos1D[Form("h_3prong_alpha%d_endY",i+1)]->Fill(track.getEnd().Y());
-      histos1D[Form("h_3prong_alpha%d_endZ",i+1)]->Fill(track.getEnd().Z());
-      histos2D[Form("h_3prong_alpha%d_endXY",i+1)]->Fill(track.getEnd().X(), track.getEnd().Y());
-      histos1D[Form("h_3prong_alpha%d_phiDET",i+1)]->Fill(track.getTangent().Phi());
-      histos1D[Form("h_3prong_alpha%d_thetaDET",i+1)]->Fill(track.getTangent().Theta());
-      histos1D[Form("h_3prong_alpha%d_cosThetaDET",i+1)]->Fill(track.getTangent().CosTheta());
+      histos1D[h_3prong_alpha1_len+i]->Fill(alpha_len[i]);
+      histos1D[h_3prong_alpha1_deltaX+i]->Fill(alpha_len[i]*track.getTangent().X());
+      histos1D[h_3prong_alpha1_deltaY+i]->Fill(alpha_len[i]*track.getTangent().Y());
+      histos1D[h_3prong_alpha1_deltaZ+i]->Fill(alpha_len[i]*track.getTangent().Z());
+      histos2D[h_3prong_alpha1_deltaXY+i]->Fill(alpha_len[i]*track.getTangent().X(), alpha_len[i]*track.getTangent().Y());
+      histos2D[h_3prong_alpha1_deltaXZ+i]->Fill(alpha_len[i]*track.getTangent().X(), alpha_len[i]*track.getTangent().Z());
+      histos2D[h_3prong_alpha1_deltaYZ+i]->Fill(alpha_len[i]*track.getTangent().Y(), alpha_len[i]*track.getTangent().Z());
+      histos1D[h_3prong_alpha1_endX+i]->Fill(track.getEnd().X());
+      histos1D[h_3prong_alpha1_endY+i]->Fill(track.getEnd().Y());
+      histos1D[h_3prong_alpha1_endZ+i]->Fill(track.getEnd().Z());
+      histos2D[h_3prong_alpha1_endXY+i]->Fill(track.getEnd().X(), track.getEnd().Y());
+      histos1D[h_3prong_alpha1_phiDET+i]->Fill(track.getTangent().Phi());
+      histos1D[h_3prong_alpha1_thetaDET+i]->Fill(track.getTangent().Theta());
+      histos1D[h_3prong_alpha1_cosThetaDET+i]->Fill(track.getTangent().CosTheta());
 
       // properties in LAB reference frame in BEAM coordinate system
-      histos1D[Form("h_3prong_alpha%d_phiBEAM_LAB",i+1)]->Fill(alpha_phi_BEAM_LAB[i]);
-      histos1D[Form("h_3prong_alpha%d_thetaBEAM_LAB",i+1)]->Fill(acos(alpha_cosTheta_BEAM_LAB[i]));
-      histos1D[Form("h_3prong_alpha%d_cosThetaBEAM_LAB",i+1)]->Fill(alpha_cosTheta_BEAM_LAB[i]);
-      histos2D[Form("h_3prong_alpha%d_cosThetaBEAM_len_LAB",i+1)]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_len[i]);
-      profiles1D[Form("h_3prong_alpha%d_cosThetaBEAM_len_LAB_prof",i+1)]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_len[i]);
-      histos2D[Form("h_3prong_alpha%d_cosThetaBEAM_E_LAB",i+1)]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_T_LAB[i]);
-      profiles1D[Form("h_3prong_alpha%d_cosThetaBEAM_E_LAB_prof",i+1)]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_T_LAB[i]);
-      histos1D[Form("h_3prong_alpha%d_E_LAB",i+1)]->Fill(alpha_T_LAB[i]);
+      histos1D[h_3prong_alpha1_phiBEAM_LAB+i]->Fill(alpha_phi_BEAM_LAB[i]);
+      histos1D[h_3prong_alpha1_thetaBEAM_LAB+i]->Fill(acos(alpha_cosTheta_BEAM_LAB[i]));
+      histos1D[h_3prong_alpha1_cosThetaBEAM_LAB+i]->Fill(alpha_cosTheta_BEAM_LAB[i]);
+      histos2D[h_3prong_alpha1_cosThetaBEAM_len_LAB+i]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_len[i]);
+      profiles1D[h_3prong_alpha1_cosThetaBEAM_len_LAB_prof+i]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_len[i]);
+      histos2D[h_3prong_alpha1_cosThetaBEAM_E_LAB+i]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_T_LAB[i]);
+      profiles1D[h_3prong_alpha1_cosThetaBEAM_E_LAB_prof+i]->Fill(alpha_cosTheta_BEAM_LAB[i], alpha_T_LAB[i]);
+      histos1D[h_3prong_alpha1_E_LAB+i]->Fill(alpha_T_LAB[i]);
 
       // properties in CMS reference frame in BEAM coordinate system
-      histos1D[Form("h_3prong_alpha%d_phiBEAM_CMS",i+1)]->Fill(alpha_phi_BEAM_CMS[i]);
-      histos1D[Form("h_3prong_alpha%d_thetaBEAM_CMS",i+1)]->Fill(acos(alpha_cosTheta_BEAM_CMS[i]));
-      histos1D[Form("h_3prong_alpha%d_cosThetaBEAM_CMS",i+1)]->Fill(alpha_cosTheta_BEAM_CMS[i]);
-      histos2D[Form("h_3prong_alpha%d_cosThetaBEAM_E_CMS",i+1)]->Fill(alpha_cosTheta_BEAM_CMS[i], alpha_T_CMS[i]);
-      profiles1D[Form("h_3prong_alpha%d_cosThetaBEAM_E_CMS_prof",i+1)]->Fill(alpha_cosTheta_BEAM_CMS[i], alpha_T_CMS[i]);
-      histos1D[Form("h_3prong_alpha%d_E_CMS",i+1)]->Fill(alpha_T_CMS[i]);
+      histos1D[h_3prong_alpha1_phiBEAM_CMS+i]->Fill(alpha_phi_BEAM_CMS[i]);
+      histos1D[h_3prong_alpha1_thetaBEAM_CMS+i]->Fill(acos(alpha_cosTheta_BEAM_CMS[i]));
+      histos1D[h_3prong_alpha1_cosThetaBEAM_CMS+i]->Fill(alpha_cosTheta_BEAM_CMS[i]);
+      histos2D[h_3prong_alpha1_cosThetaBEAM_E_CMS+i]->Fill(alpha_cosTheta_BEAM_CMS[i], alpha_T_CMS[i]);
+      profiles1D[h_3prong_alpha1_cosThetaBEAM_E_CMS_prof+i]->Fill(alpha_cosTheta_BEAM_CMS[i], alpha_T_CMS[i]);
+      histos1D[h_3prong_alpha1_E_CMS+i]->Fill(alpha_T_CMS[i]);
 
       // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (Y_DET) horizontal & perpendicular to the gamma beam axis
-      histos2D[Form("h_3prong_vertexY_alpha%d_E_LAB",i+1)]->Fill(vertexPos.Y(), alpha_T_LAB[i]);
-      histos2D[Form("h_3prong_vertexY_alpha%d_E_CMS",i+1)]->Fill(vertexPos.Y(), alpha_T_CMS[i]);
-      histos2D[Form("h_3prong_vertexY_alpha%d_len",i+1)]->Fill(vertexPos.Y(), alpha_len[i]);
-      histos2D[Form("h_3prong_vertexY_alpha%d_cosThetaBEAM_LAB",i+1)]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_LAB[i]);
-      histos2D[Form("h_3prong_vertexY_alpha%d_cosThetaBEAM_CMS",i+1)]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_CMS[i]);
-      profiles1D[Form("h_3prong_vertexY_alpha%d_E_LAB_prof",i+1)]->Fill(vertexPos.Y(), alpha_T_LAB[i]);
-      profiles1D[Form("h_3prong_vertexY_alpha%d_E_CMS_prof",i+1)]->Fill(vertexPos.Y(), alpha_T_CMS[i]);
-      profiles1D[Form("h_3prong_vertexY_alpha%d_len_prof",i+1)]->Fill(vertexPos.Y(), alpha_len[i]);
+      histos2D[h_3prong_vertexY_alpha1_E_LAB+i]->Fill(vertexPos.Y(), alpha_T_LAB[i]);
+      histos2D[h_3prong_vertexY_alpha1_E_CMS+i]->Fill(vertexPos.Y(), alpha_T_CMS[i]);
+      histos2D[h_3prong_vertexY_alpha1_len+i]->Fill(vertexPos.Y(), alpha_len[i]);
+      histos2D[h_3prong_vertexY_alpha1_cosThetaBEAM_LAB+i]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_LAB[i]);
+      histos2D[h_3prong_vertexY_alpha1_cosThetaBEAM_CMS+i]->Fill(vertexPos.Y(), alpha_cosTheta_BEAM_CMS[i]);
+      profiles1D[h_3prong_vertexY_alpha1_E_LAB_prof+i]->Fill(vertexPos.Y(), alpha_T_LAB[i]);
+      profiles1D[h_3prong_vertexY_alpha1_E_CMS_prof+i]->Fill(vertexPos.Y(), alpha_T_CMS[i]);
+      profiles1D[h_3prong_vertexY_alpha1_len_prof+i]->Fill(vertexPos.Y(), alpha_len[i]);
       // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (X_BEAM) horizontal & perpendicular to the gamma beam axis
-      histos2D[Form("h_3prong_vertexXBEAM_alpha%d_E_LAB",i+1)]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB[i]);
-      histos2D[Form("h_3prong_vertexXBEAM_alpha%d_E_CMS",i+1)]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS[i]);
-      histos2D[Form("h_3prong_vertexXBEAM_alpha%d_cosThetaBEAM_LAB",i+1)]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_LAB[i]);
-      histos2D[Form("h_3prong_vertexXBEAM_alpha%d_cosThetaBEAM_CMS",i+1)]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_CMS[i]);
-      profiles1D[Form("h_3prong_vertexXBEAM_alpha%d_E_LAB_prof",i+1)]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB[i]);
-      profiles1D[Form("h_3prong_vertexXBEAM_alpha%d_E_CMS_prof",i+1)]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS[i]);
+      histos2D[h_3prong_vertexXBEAM_alpha1_E_LAB+i]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB[i]);
+      histos2D[h_3prong_vertexXBEAM_alpha1_E_CMS+i]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS[i]);
+      histos2D[h_3prong_vertexXBEAM_alpha1_cosThetaBEAM_LAB+i]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_LAB[i]);
+      histos2D[h_3prong_vertexXBEAM_alpha1_cosThetaBEAM_CMS+i]->Fill(vertexPos_BEAM_LAB.X(), alpha_cosTheta_BEAM_CMS[i]);
+      profiles1D[h_3prong_vertexXBEAM_alpha1_E_LAB_prof+i]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_LAB[i]);
+      profiles1D[h_3prong_vertexXBEAM_alpha1_E_CMS_prof+i]->Fill(vertexPos_BEAM_LAB.X(), alpha_T_CMS[i]);
 
       // fill properties per track pair
       for(auto i2=i+1;i2<3;i2++) {
 
 	// properties in LAB reference frame in DET coordinate system
 	double delta_LAB=track.getTangent().Angle(list.at(i2).getTangent()); // [rad]
-	histos1D[Form("h_3prong_alpha%d_alpha%d_delta_LAB",i+1,i2+1)]->Fill(delta_LAB);
-	histos1D[Form("h_3prong_alpha%d_alpha%d_cosDelta_LAB",i+1,i2+1)]->Fill(cos(delta_LAB));
-	histos2D[Form("h_3prong_alpha%d_len_alpha%d_len",i+1,i2+1)]->Fill(alpha_len[i], alpha_len[i2]);
+	histos1D[h_3prong_alpha1_alpha2_delta_LAB+i+i2-1]->Fill(delta_LAB);
+	histos1D[h_3prong_alpha1_alpha2_cosDelta_LAB+i+i2-1]->Fill(cos(delta_LAB));
+	histos2D[h_3prong_alpha1_len_alpha2_len+i+i2-1]->Fill(alpha_len[i], alpha_len[i2]);
 	// properties in CMS reference frame in BEAM coordinate system
 	double delta_CMS=alphaP4_BEAM_CMS[i].Angle(alphaP4_BEAM_CMS[i2].Vect()); // [rad]
-	histos1D[Form("h_3prong_alpha%d_alpha%d_delta_CMS",i+1,i2+1)]->Fill(delta_CMS);
-	histos1D[Form("h_3prong_alpha%d_alpha%d_cosDelta_CMS",i+1,i2+1)]->Fill(cos(delta_CMS));
-	histos2D[Form("h_3prong_alpha%d_E_alpha%d_E_LAB",i+1,i2+1)]->Fill(alpha_T_LAB[i], alpha_T_LAB[i2]); 
-	histos2D[Form("h_3prong_alpha%d_E_alpha%d_E_CMS",i+1,i2+1)]->Fill(alpha_T_CMS[i], alpha_T_CMS[i2]);
+	histos1D[h_3prong_alpha1_alpha2_delta_CMS+i+i2-1]->Fill(delta_CMS);
+	histos1D[h_3prong_alpha1_alpha2_cosDelta_CMS+i+i2-1]->Fill(cos(delta_CMS));
+	histos2D[h_3prong_alpha1_E_alpha2_E_LAB+i+i2-1]->Fill(alpha_T_LAB[i], alpha_T_LAB[i2]); 
+	histos2D[h_3prong_alpha1_E_alpha2_E_CMS+i+i2-1]->Fill(alpha_T_CMS[i], alpha_T_CMS[i2]);
      }
     }
 
@@ -1099,43 +1136,43 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
     double carbonMassExcited=totalEnergy_CMS;
     double carbonExcitationEnergy=carbonMassExcited-carbonMassGroundState;
     double Qvalue_CMS=carbonMassExcited-massSUM;
-    histos1D["h_3prong_lenSum"]->Fill(lengthSUM);
-    histos1D["h_3prong_total_PxBEAM_CMS"]->Fill(sumP4_BEAM_CMS.Px());
-    histos1D["h_3prong_total_PyBEAM_CMS"]->Fill(sumP4_BEAM_CMS.Py());
-    histos1D["h_3prong_total_PzBEAM_CMS"]->Fill(sumP4_BEAM_CMS.Pz());
-    histos1D["h_3prong_total_PxBEAM_LAB"]->Fill(sumP4_BEAM_LAB.Px());
-    histos1D["h_3prong_total_PyBEAM_LAB"]->Fill(sumP4_BEAM_LAB.Py());
-    histos1D["h_3prong_total_PzBEAM_LAB"]->Fill(sumP4_BEAM_LAB.Pz());
-    histos1D["h_3prong_total_E_CMS"]->Fill(totalEnergy_CMS);
-    histos1D["h_3prong_excitation_E_CMS"]->Fill(carbonExcitationEnergy);
-    histos1D["h_3prong_Qvalue_CMS"]->Fill(Qvalue_CMS);
-    histos1D["h_3prong_gamma_E_LAB"]->Fill(photon_E_LAB);
-    histos1D["h_3prong_E_CMS"]->Fill(alpha_T_LAB[0]+alpha_T_LAB[1]+alpha_T_LAB[2]);
-    histos1D["h_3prong_E_LAB"]->Fill(alpha_T_CMS[0]+alpha_T_CMS[1]+alpha_T_CMS[2]);
+    histos1D[h_3prong_lenSum]->Fill(lengthSUM);
+    histos1D[h_3prong_total_PxBEAM_CMS]->Fill(sumP4_BEAM_CMS.Px());
+    histos1D[h_3prong_total_PyBEAM_CMS]->Fill(sumP4_BEAM_CMS.Py());
+    histos1D[h_3prong_total_PzBEAM_CMS]->Fill(sumP4_BEAM_CMS.Pz());
+    histos1D[h_3prong_total_PxBEAM_LAB]->Fill(sumP4_BEAM_LAB.Px());
+    histos1D[h_3prong_total_PyBEAM_LAB]->Fill(sumP4_BEAM_LAB.Py());
+    histos1D[h_3prong_total_PzBEAM_LAB]->Fill(sumP4_BEAM_LAB.Pz());
+    histos1D[h_3prong_total_E_CMS]->Fill(totalEnergy_CMS);
+    histos1D[h_3prong_excitation_E_CMS]->Fill(carbonExcitationEnergy);
+    histos1D[h_3prong_Qvalue_CMS]->Fill(Qvalue_CMS);
+    histos1D[h_3prong_gamma_E_LAB]->Fill(photon_E_LAB);
+    histos1D[h_3prong_E_CMS]->Fill(alpha_T_LAB[0]+alpha_T_LAB[1]+alpha_T_LAB[2]);
+    histos1D[h_3prong_E_LAB]->Fill(alpha_T_CMS[0]+alpha_T_CMS[1]+alpha_T_CMS[2]);
 
     // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (Y_DET) horizontal & perpendicular to the gamma beam axis
-    histos2D["h_3prong_vertexX_lenSum"]->Fill(vertexPos.X(), lengthSUM);
-    histos2D["h_3prong_vertexY_lenSum"]->Fill(vertexPos.Y(), lengthSUM);
-    histos2D["h_3prong_vertexZ_lenSum"]->Fill(vertexPos.Z(), lengthSUM);
-    histos2D["h_3prong_vertexY_gamma_E_LAB"]->Fill(vertexPos.Y(), photon_E_LAB);
-    histos2D["h_3prong_vertexY_Qvalue_CMS"]->Fill(vertexPos.Y(), Qvalue_CMS);
-    profiles1D["h_3prong_vertexX_lenSum_prof"]->Fill(vertexPos.X(), lengthSUM);
-    profiles1D["h_3prong_vertexY_lenSum_prof"]->Fill(vertexPos.Y(), lengthSUM);
-    profiles1D["h_3prong_vertexZ_lenSum_prof"]->Fill(vertexPos.Z(), lengthSUM);
-    profiles1D["h_3prong_vertexY_gamma_E_LAB_prof"]->Fill(vertexPos.Y(), photon_E_LAB);
-    profiles1D["h_3prong_vertexY_Qvalue_CMS_prof"]->Fill(vertexPos.Y(), Qvalue_CMS);
+    histos2D[h_3prong_vertexX_lenSum]->Fill(vertexPos.X(), lengthSUM);
+    histos2D[h_3prong_vertexY_lenSum]->Fill(vertexPos.Y(), lengthSUM);
+    histos2D[h_3prong_vertexZ_lenSum]->Fill(vertexPos.Z(), lengthSUM);
+    histos2D[h_3prong_vertexY_gamma_E_LAB]->Fill(vertexPos.Y(), photon_E_LAB);
+    histos2D[h_3prong_vertexY_Qvalue_CMS]->Fill(vertexPos.Y(), Qvalue_CMS);
+    profiles1D[h_3prong_vertexX_lenSum_prof]->Fill(vertexPos.X(), lengthSUM);
+    profiles1D[h_3prong_vertexY_lenSum_prof]->Fill(vertexPos.Y(), lengthSUM);
+    profiles1D[h_3prong_vertexZ_lenSum_prof]->Fill(vertexPos.Z(), lengthSUM);
+    profiles1D[h_3prong_vertexY_gamma_E_LAB_prof]->Fill(vertexPos.Y(), photon_E_LAB);
+    profiles1D[h_3prong_vertexY_Qvalue_CMS_prof]->Fill(vertexPos.Y(), Qvalue_CMS);
     // SPECIAL PLOTS: check dependence of gamma beam energy on vertex position (X_BEAM) horizontal & perpendicular to the gamma beam axis
-    histos2D["h_3prong_vertexXBEAM_gamma_E_LAB"]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
-    histos2D["h_3prong_vertexXBEAM_Qvalue_CMS"]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
-    profiles1D["h_3prong_vertexXBEAM_gamma_E_LAB_prof"]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
-    profiles1D["h_3prong_vertexXBEAM_Qvalue_CMS_prof"]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
+    histos2D[h_3prong_vertexXBEAM_gamma_E_LAB]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
+    histos2D[h_3prong_vertexXBEAM_Qvalue_CMS]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
+    profiles1D[h_3prong_vertexXBEAM_gamma_E_LAB_prof]->Fill(vertexPos_BEAM_LAB.X(), photon_E_LAB);
+    profiles1D[h_3prong_vertexXBEAM_Qvalue_CMS_prof]->Fill(vertexPos_BEAM_LAB.X(), Qvalue_CMS);
 
     // fill symmetrized Dalitz plots
     for(auto i1=0; i1<3; i1++) {
 
       // triple-alpha coincidence plots => 3 entries per event
-      histos2D["h_3prong_Dalitz3_CMS"]->Fill(alpha_T_CMS[i1], carbonExcitationEnergy);
-      histos2D["h_3prong_Dalitz4_CMS"]->Fill(alpha_T_CMS[i1], alpha_T_CMS[0]+alpha_T_CMS[1]+alpha_T_CMS[2]);
+      histos2D[h_3prong_Dalitz3_CMS]->Fill(alpha_T_CMS[i1], carbonExcitationEnergy);
+      histos2D[h_3prong_Dalitz4_CMS]->Fill(alpha_T_CMS[i1], alpha_T_CMS[0]+alpha_T_CMS[1]+alpha_T_CMS[2]);
 
       auto i2=(i1+1)%3;
       auto i3=(i1+2)%3;
@@ -1143,39 +1180,67 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack){
       // consider even and odd permutations of {0,1,2} set => 6 entries per event
       auto mass1=(alphaP4_BEAM_CMS[i1]+alphaP4_BEAM_CMS[i2]).M(); // [MeV/c^2]
       auto mass2=(alphaP4_BEAM_CMS[i1]+alphaP4_BEAM_CMS[i3]).M(); // [MeV/c^2]
-      histos2D["h_3prong_Dalitz1_CMS"]->Fill(mass1, mass2);
-      histos2D["h_3prong_Dalitz1_CMS"]->Fill(mass2, mass1);
+      histos2D[h_3prong_Dalitz1_CMS]->Fill(mass1, mass2);
+      histos2D[h_3prong_Dalitz1_CMS]->Fill(mass2, mass1);
 
       // consider even and odd permutations of {0,1,2} set => 6 entries per event
       auto eps1=alpha_T_CMS[i1]/Qvalue_CMS;
       auto eps2=alpha_T_CMS[i2]/Qvalue_CMS;
       auto eps3=alpha_T_CMS[i3]/Qvalue_CMS;
-      histos2D["h_3prong_Dalitz2_CMS"]->Fill( (eps1+2*eps2-1)/sqrt(3.), // chi
+      histos2D[h_3prong_Dalitz2_CMS]->Fill( (eps1+2*eps2-1)/sqrt(3.), // chi
 					      eps1-1/3. ); // psi
-      histos2D["h_3prong_Dalitz2_CMS"]->Fill( (eps1+2*eps3-1)/sqrt(3.), // chi
+      histos2D[h_3prong_Dalitz2_CMS]->Fill( (eps1+2*eps3-1)/sqrt(3.), // chi
 					      eps1-1/3. ); // psi
       
     }
   }
 }
 
+///////////////////////////////
+///////////////////////////////
+void HIGGS_analysis::merge(const HIGGS_analysis & other){
+
+  if(histos1D.size()!=other.histos1D.size() ||
+     histos2D.size()!=other.histos2D.size() ||
+     profiles1D.size()!=other.profiles1D.size()) {
+    std::cout<<KRED<<__FUNCTION__<<RST<<": histogram sets do not match!"<<std::endl;
+    exit(-1);
+  }
+  // histograms are booked in the same order, so handles of both instances point to the same histogram names
+  TList aList;
+  for(auto handle=0U; handle<histos1D.size(); ++handle) {
+    aList.Add(other.histos1D[handle]);
+    histos1D[handle]->Merge(&aList);
+    aList.Clear();
+  }
+  for(auto handle=0U; handle<histos2D.size(); ++handle) {
+    aList.Add(other.histos2D[handle]);
+    histos2D[handle]->Merge(&aList);
+    aList.Clear();
+  }
+  for(auto handle=0U; handle<profiles1D.size(); ++handle) {
+    aList.Add(other.profiles1D[handle]);
+    profiles1D[handle]->Merge(&aList);
+    aList.Clear();
+  }
+}
 ///////////////////////////////
 ///////////////////////////////
 void HIGGS_analysis::finalize(){
 
-  for (auto &h : histos1D) {
-    h.second->SetTitleOffset(1.3, "X");
-    h.second->SetTitleOffset(1.4, "Y");
-    h.second->SetOption("COLZ");
+  for (auto h : histos1D) {
+    h->SetTitleOffset(1.3, "X");
+    h->SetTitleOffset(1.4, "Y");
+    h->SetOption("COLZ");
   }
-  for (auto &h : histos2D) {
-    h.second->SetTitleOffset(1.4, "X");
-    h.second->SetTitleOffset(1.4, "Y");
-    h.second->SetOption("COLZ");
+  for (auto h : histos2D) {
+    h->SetTitleOffset(1.4, "X");
+    h->SetTitleOffset(1.4, "Y");
+    h->SetOption("COLZ");
   }
-  for (auto &p : profiles1D) {
-    p.second->SetTitleOffset(1.4, "X");
-    p.second->SetTitleOffset(1.4, "Y");
+  for (auto p : profiles1D) {
+    p->SetTitleOffset(1.4, "X");
+    p->SetTitleOffset(1.4, "Y");
   }
   outputFile->Write();
 }
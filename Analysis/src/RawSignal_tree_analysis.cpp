@@ -122,11 +122,11 @@ void RawSignal_tree_analysis::fillTree(std::shared_ptr<EventTPC> aEventTPC, bool
   filter_type filterType = filter_type::none;
   if(myClusterConfig.clusterEnable) { // CLUSTER
     filterType = filter_type::threshold;
-    boost::property_tree::ptree config;
-    config.put("recoClusterThreshold", myClusterConfig.clusterThreshold);
-    config.put("recoClusterDeltaStrips",myClusterConfig.clusterDeltaStrips);
-    config.put("recoClusterDeltaTimeCells",myClusterConfig.clusterDeltaTimeCells);  
-    aEventTPC->setHitFilterConfig(filterType, config);    
+    EventTPC::HitFilterParameters parameters;
+    parameters.chargeThreshold = myClusterConfig.clusterThreshold;
+    parameters.deltaStrips = myClusterConfig.clusterDeltaStrips;
+    parameters.deltaTimeCells = myClusterConfig.clusterDeltaTimeCells;
+    aEventTPC->setHitFilterParameters(filterType, parameters);
   }
   
   // MAKE A CLUSTER AND COMPUTE SOME STATISTICS
@@ -94,11 +94,11 @@ void TrackDiffusion_tree_analysis::fillTree(const std::shared_ptr<EventTPC> aEve
   filter_type filterType = filter_type::none;
   if(myConfig.clusterEnable) { // CLUSTER
     filterType = filter_type::threshold;
-    boost::property_tree::ptree config;
-    config.put("recoClusterThreshold", myConfig.clusterThreshold);
-    config.put("recoClusterDeltaStrips",myConfig.clusterDeltaStrips);
-    config.put("recoClusterDeltaTimeCells",myConfig.clusterDeltaTimeCells);  
-    aEventTPC->setHitFilterConfig(filterType, config);
+    EventTPC::HitFilterParameters parameters;
+    parameters.chargeThreshold = myConfig.clusterThreshold;
+    parameters.deltaStrips = myConfig.clusterDeltaStrips;
+    parameters.deltaTimeCells = myConfig.clusterDeltaTimeCells;
+    aEventTPC->setHitFilterParameters(filterType, parameters);
   }
   
   // MAKE A CLUSTER AND EXTRACT 2D PROJECTIONS IN MM
@@ -0,0 +1,160 @@
+#include "TPCReco/BatchRequirementsCollection.h"
+#include "TPCReco/Cuts.h"
+#include "TPCReco/RequirementsCollection.h"
+#include "gtest/gtest.h"
+#include <TVector3.h>
+#include <functional>
+#include <random>
+#include <vector>
+using namespace tpcreco::cuts;
+
+struct FakeSegment {
+  TVector3 start, end;
+  pid_type pid;
+  TVector3 getStart() const { return start; }
+  TVector3 getEnd() const { return end; }
+  pid_type getPID() const { return pid; }
+  double getLength() const { return (end - start).Mag(); }
+};
+
+struct FakeTrack {
+  std::vector<FakeSegment> segments;
+  double chi2, hypothesisChi2;
+  std::vector<FakeSegment> &getSegments() { return segments; }
+  double getChi2() const { return chi2; }
+  double getHypothesisFitChi2() const { return hypothesisChi2; }
+  double getLength() const {
+    double length = 0;
+    for (const auto &segment : segments) {
+      length += segment.getLength();
+    }
+    return length;
+  }
+};
+
+struct FakeGeometry {
+  double GetDriftCageZmin() const { return -100; }
+  double GetDriftCageZmax() const { return 100; }
+  int GetAgetNtimecells() const { return 512; }
+  double Timecell2pos(double timecell, bool &err) const {
+    err = false;
+    return timecell - 256;
+  }
+  TGraph GetActiveAreaConvexHull(double margin) const {
+    double x[] = {-150 + margin, 0, 150 - margin, 0, -150 + margin};
+    double y[] = {0, 100 - margin, 0, -100 + margin, 0};
+    return TGraph(5, x, y);
+  }
+};
+
+class CutsBatchTest : public ::testing::Test {
+public:
+  std::vector<FakeTrack> tracks;
+  TrackColumns columns{true};
+  FakeGeometry geometry;
+
+  void SetUp() override {
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> xy(-160, 160);
+    std::uniform_real_distribution<double> z(-150, 150);
+    std::uniform_real_distribution<double> direction(-70, 70);
+    std::uniform_real_distribution<double> quality(0, 20);
+    std::uniform_int_distribution<int> nSegments(0, 3);
+    std::uniform_int_distribution<int> pid(ALPHA, CARBON_12);
+    tracks.resize(5000);
+    for (auto &track : tracks) {
+      track.chi2 = quality(generator);
+      track.hypothesisChi2 = quality(generator);
+      auto n = nSegments(generator);
+      TVector3 vertex(xy(generator), 0.1 * xy(generator), z(generator));
+      for (int i = 0; i < n; ++i) {
+        TVector3 end(direction(generator), direction(generator),
+                     direction(generator));
+        track.segments.push_back(
+            {vertex, vertex + end, static_cast<pid_type>(pid(generator))});
+      }
+      columns.push_back(&track);
+    }
+    columns.push_back<FakeTrack>(nullptr);
+  }
+
+  // per-event and batch results of the same cut must agree
+  template <class Cut> void compare(Cut cut, bool skipEmpty = true) {
+    TrackColumns::Flags flags;
+    cut(columns, flags);
+    ASSERT_EQ(flags.size(), tracks.size() + 1);
+    for (size_t i = 0; i < tracks.size(); ++i) {
+      if (skipEmpty && tracks[i].segments.empty()) {
+        continue; // per-event version requires at least one segment
+      }
+      EXPECT_EQ(bool(flags[i]), cut(&tracks[i])) << "event " << i;
+    }
+  }
+};
+
+TEST_F(CutsBatchTest, Columns) {
+  EXPECT_EQ(columns.size(), tracks.size() + 1);
+  EXPECT_EQ(columns.firstSegment.size(), columns.size() + 1);
+  EXPECT_EQ(columns.firstSegment.back(), columns.getNsegments());
+  columns.clear();
+  EXPECT_EQ(columns.size(), 0);
+  EXPECT_EQ(columns.getNsegments(), 0);
+}
+
+TEST_F(CutsBatchTest, Cut1) {
+  compare(Cut1{}, false);
+  TrackColumns::Flags flags;
+  Cut1{}(columns, flags);
+  EXPECT_FALSE(flags.back());
+}
+
+TEST_F(CutsBatchTest, Cut2) { compare(Cut2{10, 0.1, 20}); }
+
+TEST_F(CutsBatchTest, Cut3) { compare(Cut3{&geometry, 5}, false); }
+
+TEST_F(CutsBatchTest, Cut3a) { compare(Cut3a{-100, 120, -50, 60}, false); }
+
+TEST_F(CutsBatchTest, Cut4) { compare(Cut4{&geometry, 25, 5}); }
+
+TEST_F(CutsBatchTest, Cut5) { compare(Cut5{&geometry, 10}); }
+
+TEST_F(CutsBatchTest, Cut6) {
+  compare(Cut6{ALPHA, CARBON_12, 10, 10, 30, 0}, false);
+  TrackColumns noQuality;
+  TrackColumns::Flags flags;
+  EXPECT_THROW(Cut6(ALPHA, CARBON_12, 10, 10, 30, 0)(noQuality, flags),
+               std::runtime_error);
+}
+
+TEST_F(CutsBatchTest, Cut7) {
+  compare(Cut7{false, ALPHA, 30, 90, CARBON_12, 5, 60}, false);
+  compare(Cut7{true, ALPHA, 30, 90, CARBON_12, 5, 60}, false);
+}
+
+TEST_F(CutsBatchTest, Collection) {
+  RequirementsCollection<CountedRequirement<std::function<bool(FakeTrack *)>>> cuts;
+  cuts.push_back(make_counted<std::function<bool(FakeTrack *)>>(Cut1{}));
+  cuts.push_back(make_counted<std::function<bool(FakeTrack *)>>(Cut2{10, 0.1, 40}));
+  cuts.push_back(make_counted<std::function<bool(FakeTrack *)>>(Cut3{&geometry, 5}));
+  cuts.push_back(make_counted<std::function<bool(FakeTrack *)>>(Cut4{&geometry, 25, 5}));
+  cuts.push_back(make_counted<std::function<bool(FakeTrack *)>>(Cut5{&geometry, 10}));
+  cuts.push_back(make_counted<std::function<bool(FakeTrack *)>>(
+      Cut7{false, ALPHA, 30, 90, CARBON_12, 5, 60}));
+
+  BatchRequirementsCollection<TrackColumns> batchCuts = {
+      Cut1{}, Cut2{10, 0.1, 40}, Cut3{&geometry, 5}, Cut4{&geometry, 25, 5},
+      Cut5{&geometry, 10}, Cut7{false, ALPHA, 30, 90, CARBON_12, 5, 60}};
+  batchCuts.evaluate(columns);
+
+  std::vector<size_t> selected;
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    if (cuts(&tracks[i])) {
+      selected.push_back(i);
+    }
+  }
+  EXPECT_EQ(batchCuts.getSelected(), selected);
+  size_t k = 0;
+  for (auto it = cuts.cbegin(); it != cuts.cend(); ++it, ++k) {
+    EXPECT_EQ(batchCuts.getCount(k), it->getCount()) << "cut " << k;
+  }
+}
@@ -31,7 +31,22 @@ class EventTPC {
   void SetEventInfo(const eventraw::EventInfo & aEvInfo) {myEventInfo = aEvInfo; };
   void SetGeoPtr(std::shared_ptr<GeometryTPC> aPtr);
 
+  // Parameters of the threshold filter, compiled once from the configuration
+  struct HitFilterParameters{
+    double chargeThreshold{35.0};
+    int deltaStrips{2};
+    int deltaTimeCells{5};
+    bool operator==(const HitFilterParameters &other) const {
+      return chargeThreshold==other.chargeThreshold &&
+	deltaStrips==other.deltaStrips && deltaTimeCells==other.deltaTimeCells;
+    }
+  };
+
+  static HitFilterParameters getHitFilterParameters(const boost::property_tree::ptree &config);
+
   void setHitFilterConfig(filter_type filterType, const boost::property_tree::ptree &config);
+  // hits are filtered again only if the parameters changed
+  void setHitFilterParameters(filter_type filterType, const HitFilterParameters &parameters);
 
   // valid range [0-2][X-Y][1-1024][0-511] 
   double GetValByStrip(int strip_dir, int strip_section, int strip_number, int time_cell) const;
@@ -88,7 +103,8 @@ class EventTPC {
   void filterHits(filter_type filterType);
 
   void addEnvelope(PEventTPC::chargeMapType::key_type key,
-		   std::set<PEventTPC::chargeMapType::key_type> & keyList);
+		   std::set<PEventTPC::chargeMapType::key_type> & keyList,
+		   const HitFilterParameters &parameters);
     
   void create3DHistoTemplate();
   
@@ -118,7 +134,7 @@ class EventTPC {
 
   std::map<filter_type, std::set<PEventTPC::chargeMapType::key_type> > keyLists;
 
-  std::map<filter_type, boost::property_tree::ptree> filterConfigs;
+  HitFilterParameters thresholdFilterParameters;
 
   friend std::ostream& operator<<(std::ostream& os, const EventTPC& e);
  
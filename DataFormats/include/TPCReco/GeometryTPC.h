@@ -23,6 +23,7 @@
 #include "TPCReco/GeometryStats.h"
 #include "TPCReco/UtilsMath.h"
 #include "TPCReco/StripTPC.h"
+#include "TPCReco/PolygonGridIndex.h"
 
 #define FPN_CH   3     // FPN channel type index
 #define ERROR    -1    // error result indicator
@@ -71,6 +72,8 @@ class GeometryTPC {
   bool isOK_TH2Poly;               // is TH2Poly already initialized?
   bool _debug;                     // debug/verbose info flag
   TH2PolyBin* tp_convex;           // for internal storage of the convex hull for UVW active area
+  PolygonGridIndex stripIndex;     //! fast spatial index of individual strip pads, ID=TH2Poly bin
+  PolygonGridIndex convexIndex;    //! fast spatial index of the convex hull for UVW active area
 
   // Setter methods 
   
@@ -103,6 +106,10 @@ class GeometryTPC {
 
   inline TH2Poly *GetTH2Poly() const{ return tp; }   // returns pointer to the underlying TH2Poly
   std::shared_ptr<StripTPC> GetTH2PolyStrip(int ibin)const;          // returns pointer to StripTPC object corresponding to TH2Poly bin 
+  int FindStripBin(double x, double y) const; // [mm] same as GetTH2Poly()->FindBin(x,y) but uses fast grid index, returns -1 when not found
+  void FindStripBins(size_t n, const double *x, const double *y, int *bins) const; // [mm] batch version of FindStripBin
+  std::shared_ptr<StripTPC> GetStripByPosition(double x, double y) const; // [mm] returns strip covering given XY point or empty pointer
+  inline const PolygonGridIndex &GetStripIndex() const { return stripIndex; }
   
   inline bool IsOK() const{ return initOK; }
   
@@ -221,6 +228,7 @@ class GeometryTPC {
   bool IsInsideActiveVolume(TVector3 point); // checks if 3D point [mm] has X,Y inside
                                              // UVW active area and Z within [zmin, zmax] range
   bool IsInsideActiveArea(TVector2 point); // checks if 2D point [mm] is inside UVW active area
+  bool IsInsideActiveArea(double x, double y) const; // checks if 2D point [mm] is inside UVW active area
   bool IsInsideElectronicsRange(double z); // checks if Z coordinate [mm] is inside Z-slice covered by the GET electronics
   bool IsInsideElectronicsRange(TVector3 point); // checks 3D point [mm] is inside Z-slice covered by the GET electronics
 
@@ -0,0 +1,112 @@
+#ifndef __POLYGONGRIDINDEX_H__
+#define __POLYGONGRIDINDEX_H__
+
+// Uniform-grid spatial index of convex 2D polygons.
+//
+// Each registered convex polygon carries an integer ID (e.g. TH2Poly bin number).
+// The XY plane is partitioned into NX*NY rectangular cells and every cell keeps
+// a compact list of candidate polygons whose bounding box overlaps that cell.
+// Point-in-polygon tests are reduced to a handful of precomputed half-plane checks.
+// Polygons are tested in the order of registration, so for overlapping polygons
+// the first matching ID is returned (same convention as TH2Poly::FindBin).
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <TVector2.h>
+
+class TGraph;
+
+class PolygonGridIndex {
+
+ public:
+  static const int notFound{-1}; // ID returned for points outside of all polygons
+
+  PolygonGridIndex() = default;
+
+  // Registers convex polygon [mm] with given ID, vertices can be in CW or CCW order.
+  // The last vertex may repeat the first one (closed TGraph contour).
+  // Returns false for degenerate polygons (less than 3 distinct vertices).
+  bool AddConvexPolygon(const std::vector<TVector2> &points, int id);
+  bool AddConvexPolygon(const TGraph &g, int id);
+
+  // Builds NX*NY grid spanning bounding box of all registered polygons.
+  // Must be called after the last AddConvexPolygon() and before any query.
+  bool Build(int nx, int ny);
+
+  // Builds grid with cells of approximately given size [mm].
+  bool BuildWithCellSize(double cellSize);
+
+  void Clear();
+
+  inline bool IsOK() const { return isBuilt; }
+  inline size_t GetNpolygons() const { return polygonId.size(); }
+  inline int GetNx() const { return grid_nx; }
+  inline int GetNy() const { return grid_ny; }
+
+  // returns ID of the first polygon containing point (x,y) [mm], or notFound
+  int FindBin(double x, double y) const;
+
+  // batch version: fills result[i] for each point (x[i],y[i]), i=[0, n-1]
+  void FindBins(size_t n, const double *x, const double *y, int *result) const;
+  void FindBins(const std::vector<double> &x, const std::vector<double> &y, std::vector<int> &result) const;
+
+  // checks if point (x,y) [mm] is inside any polygon
+  inline bool IsInside(double x, double y) const { return FindBin(x, y)!=notFound; }
+
+  // Exact overlap area [mm^2] of each polygon with rectangle [x1, x2] x [y1, y2],
+  // computed by Sutherland-Hodgman clipping of convex polygons.
+  // Areas are summed per polygon ID, IDs with zero overlap are not stored.
+  void GetOverlapAreas(double x1, double x2, double y1, double y2, std::map<int, double> &areaById) const;
+
+  // indices of polygons (in registration order) whose bounding box overlaps rectangle [x1, x2] x [y1, y2]
+  void GetPolygonsInBox(double x1, double x2, double y1, double y2, std::vector<unsigned int> &result) const;
+
+  // ID and flat (x, y) CCW vertices of polygon with given index=[0, Npolygons-1]
+  inline int GetPolygonId(unsigned int ipoly) const { return polygonId[ipoly]; }
+  void GetPolygonVertices(unsigned int ipoly, std::vector<double> &xy) const;
+
+  // area [mm^2] of convex polygon clipped to rectangle [x1, x2] x [y1, y2]
+  static double ClipConvexPolygonArea(const double *xy, unsigned int npoints,
+				      double x1, double x2, double y1, double y2);
+
+  // 64-bit FNV-1a checksum of all polygons and their IDs (independent of grid partition)
+  uint64_t GetChecksum() const;
+
+ private:
+
+  // returns linear cell index or -1 when point is outside of the grid
+  inline int GetCell(double x, double y) const {
+    const double fx=(x-xmin)*inv_dx;
+    const double fy=(y-ymin)*inv_dy;
+    if(!(fx>=0.0 && fx<grid_nx && fy>=0.0 && fy<grid_ny)) return -1; // also rejects NaN
+    return static_cast<int>(fy)*grid_nx+static_cast<int>(fx);
+  }
+
+  // half-plane test: a*x+b*y<=c for every edge of given polygon
+  inline bool IsInsidePolygon(unsigned int ipoly, double x, double y) const {
+    const double *e=&edges[3*edgeStart[ipoly]];
+    const double *last=&edges[3*edgeStart[ipoly+1]];
+    for(; e!=last; e+=3) {
+      if(e[0]*x+e[1]*y>e[2]) return false;
+    }
+    return true;
+  }
+
+  std::vector<double> edges;                // flat (a, b, c) coefficients of all half-planes
+  std::vector<double> vertices;             // flat (x, y) CCW vertices of all polygons, same indexing as edges
+  std::vector<unsigned int> edgeStart;      // first half-plane of each polygon, size=Npolygons+1
+  std::vector<int> polygonId;               // user ID of each polygon
+  std::vector<double> bbox;                 // flat (xmin, xmax, ymin, ymax) of each polygon
+  std::vector<unsigned int> cellStart;      // first candidate of each cell, size=Ncells+1
+  std::vector<unsigned int> cellPolygons;   // candidate polygon indices of all cells
+  int grid_nx{0};
+  int grid_ny{0};
+  double xmin{0}, ymin{0};
+  double inv_dx{0}, inv_dy{0};
+  bool isBuilt{false};
+};
+
+#endif
@@ -18,13 +18,6 @@
 EventTPC::EventTPC(){
 
   Clear();
-  
-  boost::property_tree::ptree tree;
-  tree.put("hitFilter.recoClusterThreshold", 35.0);
-  tree.put("hitFilter.recoClusterDeltaStrips",2);
-  tree.put("hitFilter.recoClusterDeltaTimeCells",5);
-  filterConfigs[filter_type::threshold] = tree;
-
 }
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
@@ -49,9 +42,29 @@ void EventTPC::SetGeoPtr(std::shared_ptr<GeometryTPC> aPtr) {
 }
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
+EventTPC::HitFilterParameters EventTPC::getHitFilterParameters(const boost::property_tree::ptree &config){
+
+  HitFilterParameters parameters;
+  parameters.chargeThreshold = config.get<double>("hitFilter.recoClusterThreshold");
+  parameters.deltaStrips = config.get<int>("hitFilter.recoClusterDeltaStrips");
+  parameters.deltaTimeCells = config.get<int>("hitFilter.recoClusterDeltaTimeCells");
+  return parameters;
+}
+///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////
 void EventTPC::setHitFilterConfig(filter_type filterType, const boost::property_tree::ptree &config){
 
-  filterConfigs[filterType] = config;
+  setHitFilterParameters(filterType, filterType==filter_type::threshold ?
+			 getHitFilterParameters(config) : HitFilterParameters());
+}
+///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////
+void EventTPC::setHitFilterParameters(filter_type filterType, const HitFilterParameters &parameters){
+
+  if(filterType==filter_type::threshold){
+    if(histoCacheUpdated.at(filterType) && parameters==thresholdFilterParameters) return;
+    thresholdFilterParameters = parameters;
+  }
   histoCacheUpdated.at(filterType) = false;
   filterHits(filterType);
 }
@@ -73,14 +86,13 @@ void EventTPC::filterHits(filter_type filterType){
 
   switch(filterType){
   case filter_type::threshold: {
-    const auto & config = filterConfigs.at(filter_type::threshold);
-    double chargeThreshold = config.get<double>("hitFilter.recoClusterThreshold");
+    const auto & parameters = thresholdFilterParameters;
     for(const auto & item: chargeMapWithSections){
       auto key = item.first;
       auto value = item.second;
-      if(value>chargeThreshold){
+      if(value>parameters.chargeThreshold){
 	keyList.insert(key);
-	addEnvelope(key, keyList);
+	addEnvelope(key, keyList, parameters);
       }
     }}
     break;
@@ -98,16 +110,16 @@ void EventTPC::filterHits(filter_type filterType){
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
 void EventTPC::addEnvelope(PEventTPC::chargeMapType::key_type key,
-			   std::set<PEventTPC::chargeMapType::key_type> & keyList){
+			   std::set<PEventTPC::chargeMapType::key_type> & keyList,
+			   const HitFilterParameters &parameters){
 
   int strip_dir = std::get<0>(key);
   int strip_section  = std::get<1>(key);
   int strip_number  = std::get<2>(key);
   int time_cell = std::get<3>(key);
     
-  const auto & config = filterConfigs.at(filter_type::threshold);
-  int delta_timecells = config.get<int>("hitFilter.recoClusterDeltaTimeCells");
-  int delta_strips = config.get<int>("hitFilter.recoClusterDeltaStrips");
+  int delta_timecells = parameters.deltaTimeCells;
+  int delta_strips = parameters.deltaStrips;
 
   for(int iCell=time_cell-delta_timecells;
       iCell<=time_cell+delta_timecells;++iCell){
@@ -531,6 +531,7 @@ bool GeometryTPC::InitTH2Poly() {
 
   isOK_TH2Poly = false;
   fStripMap.clear();
+  stripIndex.Clear();
 
   // sanity checks
   if (grid_nx < 1 || grid_ny < 1 || !initOK) {
@@ -686,6 +687,16 @@ bool GeometryTPC::InitTH2Poly() {
     // update strip map
     SetTH2PolyStrip(ibin, s);
 
+    // update fast spatial index with convex diamond-shaped pads of this strip
+    for (int ipad = 0; ipad < npads; ipad++) {
+      TVector2 corner = point0 + s->Unit() * ipad * pad_pitch;
+      stripIndex.AddConvexPolygon({corner,
+                                   corner + s->Unit().Rotate(TMath::Pi() / 6.) * pad_size,
+                                   corner + s->Unit() * pad_pitch,
+                                   corner + s->Unit().Rotate(-TMath::Pi() / 6.) * pad_size},
+                                  ibin);
+    }
+
     // DEBUG
     if (_debug) {
       std::cout << "TH2POLY ADDBIN: DIR=" << this->GetDirName(dir)
@@ -700,7 +711,7 @@ bool GeometryTPC::InitTH2Poly() {
   }
 
   // final result
-  if (fStripMap.size()>0 && InitActiveAreaConvexHull(gr))
+  if (fStripMap.size()>0 && stripIndex.BuildWithCellSize(pad_pitch) && InitActiveAreaConvexHull(gr))
     isOK_TH2Poly = true;
 
   if (_debug) {
@@ -931,6 +942,15 @@ bool GeometryTPC::InitActiveAreaConvexHull(TGraph *g) {
   }
   tp_convex = new TH2PolyBin(gr4, 1);
 
+  // build fast spatial index of the convex hull
+  convexIndex.Clear();
+  if(!convexIndex.AddConvexPolygon(*gr4, 1) || !convexIndex.Build(grid_nx, grid_ny)) {
+    if (_debug) {
+      std::cerr << __FUNCTION__ << ": Cannot build spatial index of the convex hull - Abort" << std::flush << std::endl;
+    }
+    return false;
+  }
+
   if(_debug) { // DEBUG
     std::cout << __FUNCTION__ << ": Created TH2PolyBin with " << gr4->GetN() << " points, "
 	      << "and starting point (X0=" << x0 << "mm, Y0="<< y0 << "mm)" << std::endl;
@@ -1107,7 +1127,7 @@ TGraph GeometryTPC::GetActiveAreaConvexHull(double vetoBand) const{
 //
 bool GeometryTPC::IsInsideActiveVolume(TVector3 point) { // [mm]
   if(!isOK_TH2Poly || point.Z()<drift_zmin || point.Z()>drift_zmax ||
-     !tp_convex->IsInside(point.X(), point.Y())) return false;
+     !convexIndex.IsInside(point.X(), point.Y())) return false;
   return true;
 }
 
@@ -1116,8 +1136,12 @@ bool GeometryTPC::IsInsideActiveVolume(TVector3 point) { // [mm]
 // Checks if 2D point [mm] is inside UVW active area
 //
 bool GeometryTPC::IsInsideActiveArea(TVector2 point) { // [m]]
+  return IsInsideActiveArea(point.X(), point.Y());
+}
+
+bool GeometryTPC::IsInsideActiveArea(double x, double y) const { // [mm]
   if(!isOK_TH2Poly ||
-     !tp_convex->IsInside(point.X(), point.Y())) return false;
+     !convexIndex.IsInside(x, y)) return false;
   return true;
 }
 
@@ -1155,6 +1179,26 @@ std::shared_ptr<StripTPC> GeometryTPC::GetTH2PolyStrip(int ibin) const{
   return (fStripMap.find(ibin) == fStripMap.end() ? std::shared_ptr<StripTPC>() : fStripMap.at(ibin));
 }
 
+////////////////////////////////////////////////////////////
+//
+// Finds TH2Poly bin [mm] using uniform-grid index of individual pads.
+// Returns the same bin as TH2Poly::FindBin() or PolygonGridIndex::notFound
+// for points outside of all strips.
+//
+int GeometryTPC::FindStripBin(double x, double y) const{
+  return stripIndex.FindBin(x, y);
+}
+
+void GeometryTPC::FindStripBins(size_t n, const double *x, const double *y, int *bins) const{
+  stripIndex.FindBins(n, x, y, bins);
+}
+
+std::shared_ptr<StripTPC> GeometryTPC::GetStripByPosition(double x, double y) const{
+  const int ibin = stripIndex.FindBin(x, y);
+  if(ibin == PolygonGridIndex::notFound) return std::shared_ptr<StripTPC>();
+  return GetTH2PolyStrip(ibin);
+}
+
 int GeometryTPC::GetDirNstrips(int dir) const{
   if (!IsOK())
     return -1;
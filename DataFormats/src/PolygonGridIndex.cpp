@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include <TGraph.h>
+
+#include "TPCReco/PolygonGridIndex.h"
+#include "TPCReco/UtilsMath.h"
+
+////////////////////////////////////////////////////////////
+//
+// Registers convex polygon [mm] with given ID
+//
+bool PolygonGridIndex::AddConvexPolygon(const std::vector<TVector2> &points, int id) {
+
+  // remove duplicated consecutive vertices (including closing vertex)
+  std::vector<TVector2> v;
+  for(auto &p : points) {
+    if(v.size() && (p-v.back()).Mod2()<Utils::NUMERICAL_TOLERANCE*Utils::NUMERICAL_TOLERANCE) continue;
+    v.push_back(p);
+  }
+  while(v.size()>1 && (v.front()-v.back()).Mod2()<Utils::NUMERICAL_TOLERANCE*Utils::NUMERICAL_TOLERANCE) v.pop_back();
+  if(v.size()<3) return false;
+
+  // enforce counter-clockwise orientation
+  double area=0;
+  for(auto i=0u; i<v.size(); i++) {
+    area+=v[i]^v[(i+1)%v.size()];
+  }
+  if(fabs(area)<Utils::NUMERICAL_TOLERANCE) return false;
+  if(area<0) std::reverse(v.begin(), v.end());
+
+  // interior of CCW polygon is on the left side of each edge:
+  // cross(d, p-v)>=0  <=>  d.Y*p.X - d.X*p.Y <= d.Y*v.X - d.X*v.Y
+  if(edgeStart.empty()) edgeStart.push_back(0);
+  double x1=std::numeric_limits<double>::max(), x2=-x1, y1=x1, y2=-x1;
+  for(auto i=0u; i<v.size(); i++) {
+    const auto &p0=v[i];
+    const auto d=v[(i+1)%v.size()]-p0;
+    edges.push_back(d.Y());
+    edges.push_back(-d.X());
+    edges.push_back(d.Y()*p0.X()-d.X()*p0.Y());
+    vertices.push_back(p0.X());
+    vertices.push_back(p0.Y());
+    x1=std::min(x1, p0.X());
+    x2=std::max(x2, p0.X());
+    y1=std::min(y1, p0.Y());
+    y2=std::max(y2, p0.Y());
+  }
+  edgeStart.push_back(edges.size()/3);
+  polygonId.push_back(id);
+  bbox.insert(bbox.end(), {x1, x2, y1, y2});
+  isBuilt=false;
+  return true;
+}
+
+////////////////////////////////////////////////////////////
+//
+// Registers convex polygon [mm] stored as TGraph contour
+//
+bool PolygonGridIndex::AddConvexPolygon(const TGraph &g, int id) {
+  std::vector<TVector2> points;
+  for(auto ipoint=0; ipoint<g.GetN(); ipoint++) {
+    points.push_back(TVector2(g.GetX()[ipoint], g.GetY()[ipoint]));
+  }
+  return AddConvexPolygon(points, id);
+}
+
+////////////////////////////////////////////////////////////
+//
+// Builds NX*NY uniform grid over bounding box of all polygons
+//
+bool PolygonGridIndex::Build(int nx, int ny) {
+
+  isBuilt=false;
+  cellStart.clear();
+  cellPolygons.clear();
+  if(nx<1 || ny<1 || polygonId.empty()) return false;
+
+  double x1=std::numeric_limits<double>::max(), x2=-x1, y1=x1, y2=-x1;
+  for(auto ipoly=0u; ipoly<polygonId.size(); ipoly++) {
+    x1=std::min(x1, bbox[4*ipoly]);
+    x2=std::max(x2, bbox[4*ipoly+1]);
+    y1=std::min(y1, bbox[4*ipoly+2]);
+    y2=std::max(y2, bbox[4*ipoly+3]);
+  }
+  // add small margin to include points lying exactly on the outer edges
+  const double marginX=std::max(Utils::NUMERICAL_TOLERANCE, 1e-6*(x2-x1));
+  const double marginY=std::max(Utils::NUMERICAL_TOLERANCE, 1e-6*(y2-y1));
+  x1-=marginX;
+  x2+=marginX;
+  y1-=marginY;
+  y2+=marginY;
+
+  grid_nx=nx;
+  grid_ny=ny;
+  xmin=x1;
+  ymin=y1;
+  const double dx=(x2-x1)/nx;
+  const double dy=(y2-y1)/ny;
+  inv_dx=1.0/dx;
+  inv_dy=1.0/dy;
+
+  // collect candidates per cell in the order of polygon registration,
+  // a cell fully covered by a polygon does not accept any further candidates
+  std::vector<std::vector<unsigned int> > cells(nx*ny);
+  std::vector<bool> cellClosed(nx*ny, false);
+  for(auto ipoly=0u; ipoly<polygonId.size(); ipoly++) {
+    const int ix1=std::max(0, static_cast<int>((bbox[4*ipoly]-xmin)*inv_dx));
+    const int ix2=std::min(nx-1, static_cast<int>((bbox[4*ipoly+1]-xmin)*inv_dx));
+    const int iy1=std::max(0, static_cast<int>((bbox[4*ipoly+2]-ymin)*inv_dy));
+    const int iy2=std::min(ny-1, static_cast<int>((bbox[4*ipoly+3]-ymin)*inv_dy));
+    for(int iy=iy1; iy<=iy2; iy++) {
+      for(int ix=ix1; ix<=ix2; ix++) {
+	const int icell=iy*nx+ix;
+	if(cellClosed[icell]) continue;
+	const double cx[4]={xmin+ix*dx, xmin+(ix+1)*dx, xmin+(ix+1)*dx, xmin+ix*dx};
+	const double cy[4]={ymin+iy*dy, ymin+iy*dy, ymin+(iy+1)*dy, ymin+(iy+1)*dy};
+	// separating axis test: all cell corners outside of the same edge
+	bool separated=false;
+	for(auto iedge=edgeStart[ipoly]; iedge<edgeStart[ipoly+1] && !separated; iedge++) {
+	  const double *e=&edges[3*iedge];
+	  separated=true;
+	  for(int icorner=0; icorner<4; icorner++) {
+	    if(e[0]*cx[icorner]+e[1]*cy[icorner]<=e[2]) { separated=false; break; }
+	  }
+	}
+	if(separated) continue;
+	cells[icell].push_back(ipoly);
+	bool covered=true;
+	for(int icorner=0; icorner<4 && covered; icorner++) {
+	  covered=IsInsidePolygon(ipoly, cx[icorner], cy[icorner]);
+	}
+	if(covered) cellClosed[icell]=true;
+      }
+    }
+  }
+
+  // flatten candidate lists
+  cellStart.reserve(cells.size()+1);
+  cellStart.push_back(0);
+  for(auto &c : cells) {
+    cellPolygons.insert(cellPolygons.end(), c.begin(), c.end());
+    cellStart.push_back(cellPolygons.size());
+  }
+  isBuilt=true;
+  return isBuilt;
+}
+
+////////////////////////////////////////////////////////////
+//
+// Builds uniform grid with cells of approximately given size [mm]
+//
+bool PolygonGridIndex::BuildWithCellSize(double cellSize) {
+  if(cellSize<=0 || polygonId.empty()) return false;
+  double x1=std::numeric_limits<double>::max(), x2=-x1, y1=x1, y2=-x1;
+  for(auto ipoly=0u; ipoly<polygonId.size(); ipoly++) {
+    x1=std::min(x1, bbox[4*ipoly]);
+    x2=std::max(x2, bbox[4*ipoly+1]);
+    y1=std::min(y1, bbox[4*ipoly+2]);
+    y2=std::max(y2, bbox[4*ipoly+3]);
+  }
+  const int nx=std::max(1, static_cast<int>(std::ceil((x2-x1)/cellSize)));
+  const int ny=std::max(1, static_cast<int>(std::ceil((y2-y1)/cellSize)));
+  return Build(nx, ny);
+}
+
+void PolygonGridIndex::Clear() {
+  edges.clear();
+  vertices.clear();
+  edgeStart.clear();
+  polygonId.clear();
+  bbox.clear();
+  cellStart.clear();
+  cellPolygons.clear();
+  grid_nx=0;
+  grid_ny=0;
+  isBuilt=false;
+}
+
+////////////////////////////////////////////////////////////
+//
+// Returns ID of the first polygon containing (x,y) point [mm]
+//
+int PolygonGridIndex::FindBin(double x, double y) const {
+  if(!isBuilt) return notFound;
+  const int icell=GetCell(x, y);
+  if(icell<0) return notFound;
+  for(auto k=cellStart[icell]; k<cellStart[icell+1]; k++) {
+    const auto ipoly=cellPolygons[k];
+    if(IsInsidePolygon(ipoly, x, y)) return polygonId[ipoly];
+  }
+  return notFound;
+}
+
+void PolygonGridIndex::FindBins(size_t n, const double *x, const double *y, int *result) const {
+  for(size_t i=0; i<n; i++) {
+    result[i]=FindBin(x[i], y[i]);
+  }
+}
+
+void PolygonGridIndex::FindBins(const std::vector<double> &x, const std::vector<double> &y, std::vector<int> &result) const {
+  const auto n=std::min(x.size(), y.size());
+  result.resize(n);
+  FindBins(n, x.data(), y.data(), result.data());
+}
+
+////////////////////////////////////////////////////////////
+//
+// Exact overlap areas [mm^2] of polygons with rectangle [x1, x2] x [y1, y2]
+//
+void PolygonGridIndex::GetOverlapAreas(double x1, double x2, double y1, double y2,
+				       std::map<int, double> &areaById) const {
+  areaById.clear();
+  std::vector<unsigned int> candidates;
+  GetPolygonsInBox(x1, x2, y1, y2, candidates);
+  for(auto ipoly : candidates) {
+    const double area=ClipConvexPolygonArea(&vertices[2*edgeStart[ipoly]], edgeStart[ipoly+1]-edgeStart[ipoly],
+					    x1, x2, y1, y2);
+    if(area>0) areaById[polygonId[ipoly]]+=area;
+  }
+}
+
+////////////////////////////////////////////////////////////
+//
+// Unique polygon indices from all cells overlapping given rectangle,
+// filtered by bounding boxes and sorted by registration order
+//
+void PolygonGridIndex::GetPolygonsInBox(double x1, double x2, double y1, double y2,
+					std::vector<unsigned int> &result) const {
+  result.clear();
+  if(!isBuilt || x1>=x2 || y1>=y2) return;
+  const int ix1=std::max(0, static_cast<int>(std::floor((x1-xmin)*inv_dx)));
+  const int ix2=std::min(grid_nx-1, static_cast<int>(std::floor((x2-xmin)*inv_dx)));
+  const int iy1=std::max(0, static_cast<int>(std::floor((y1-ymin)*inv_dy)));
+  const int iy2=std::min(grid_ny-1, static_cast<int>(std::floor((y2-ymin)*inv_dy)));
+  if(ix1>ix2 || iy1>iy2) return;
+
+  for(int iy=iy1; iy<=iy2; iy++) {
+    for(int ix=ix1; ix<=ix2; ix++) {
+      const int icell=iy*grid_nx+ix;
+      result.insert(result.end(), cellPolygons.begin()+cellStart[icell], cellPolygons.begin()+cellStart[icell+1]);
+    }
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  result.erase(std::remove_if(result.begin(), result.end(), [&](unsigned int ipoly) {
+	return bbox[4*ipoly]>=x2 || bbox[4*ipoly+1]<=x1 || bbox[4*ipoly+2]>=y2 || bbox[4*ipoly+3]<=y1;
+      }), result.end());
+}
+
+void PolygonGridIndex::GetPolygonVertices(unsigned int ipoly, std::vector<double> &xy) const {
+  xy.assign(vertices.begin()+2*edgeStart[ipoly], vertices.begin()+2*edgeStart[ipoly+1]);
+}
+
+////////////////////////////////////////////////////////////
+//
+// Sutherland-Hodgman clipping of convex polygon against axis-aligned rectangle,
+// returns area [mm^2] of the resulting polygon
+//
+double PolygonGridIndex::ClipConvexPolygonArea(const double *xy, unsigned int npoints,
+					       double x1, double x2, double y1, double y2) {
+  std::vector<double> in(xy, xy+2*npoints), out;
+  out.reserve(2*(npoints+4));
+  // clipping boundaries: coordinate index (0=X, 1=Y), limit, keep lower (-1) or upper (+1) side
+  const int axis[4]={0, 0, 1, 1};
+  const double limit[4]={x1, x2, y1, y2};
+  const double side[4]={+1, -1, +1, -1};
+  for(int iclip=0; iclip<4 && in.size()>=6; iclip++) {
+    out.clear();
+    const auto n=in.size()/2;
+    for(auto i=0u; i<n; i++) {
+      const double *p=&in[2*i];
+      const double *q=&in[2*((i+1)%n)];
+      const double dp=side[iclip]*(p[axis[iclip]]-limit[iclip]); // >=0 means inside
+      const double dq=side[iclip]*(q[axis[iclip]]-limit[iclip]);
+      if(dp>=0) {
+	out.push_back(p[0]);
+	out.push_back(p[1]);
+      }
+      if((dp>=0)!=(dq>=0)) { // edge crosses clipping line
+	const double t=dp/(dp-dq);
+	out.push_back(p[0]+t*(q[0]-p[0]));
+	out.push_back(p[1]+t*(q[1]-p[1]));
+      }
+    }
+    in.swap(out);
+  }
+  if(in.size()<6) return 0.0;
+  const auto n=in.size()/2;
+  double area=0;
+  for(auto i=0u; i<n; i++) {
+    const auto j=(i+1)%n;
+    area+=in[2*i]*in[2*j+1]-in[2*j]*in[2*i+1];
+  }
+  return 0.5*fabs(area);
+}
+
+uint64_t PolygonGridIndex::GetChecksum() const {
+  uint64_t hash=14695981039346656037ULL;
+  auto update=[&hash](const void *data, size_t size) {
+    const unsigned char *bytes=static_cast<const unsigned char *>(data);
+    for(size_t i=0; i<size; i++) {
+      hash^=bytes[i];
+      hash*=1099511628211ULL;
+    }
+  };
+  update(vertices.data(), vertices.size()*sizeof(double));
+  update(edgeStart.data(), edgeStart.size()*sizeof(unsigned int));
+  update(polygonId.data(), polygonId.size()*sizeof(int));
+  return hash;
+}
@@ -0,0 +1,220 @@
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/PolygonGridIndex.h"
+#include "gtest/gtest.h"
+#include <TGraph.h>
+#include <TH2Poly.h>
+#include <TMath.h>
+#include <TRandom3.h>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+// TH2Poly::FindBin returns various negative codes for under/overflows
+int normalizeTH2PolyBin(int ibin) {
+  return ibin > 0 ? ibin : PolygonGridIndex::notFound;
+}
+} // namespace
+
+TEST(PolygonGridIndexTest, EmptyIndex) {
+  PolygonGridIndex index;
+  EXPECT_FALSE(index.Build(10, 10));
+  EXPECT_FALSE(index.IsOK());
+  EXPECT_EQ(index.FindBin(0, 0), PolygonGridIndex::notFound);
+}
+
+TEST(PolygonGridIndexTest, DegeneratePolygon) {
+  PolygonGridIndex index;
+  EXPECT_FALSE(index.AddConvexPolygon({TVector2(0, 0), TVector2(1, 1)}, 1));
+  EXPECT_FALSE(index.AddConvexPolygon(
+      {TVector2(0, 0), TVector2(1, 1), TVector2(2, 2)}, 2));
+  EXPECT_EQ(index.GetNpolygons(), 0u);
+}
+
+TEST(PolygonGridIndexTest, ClosedContourAnyOrientation) {
+  double x[] = {0, 0, 1, 1, 0}; // CW, closed
+  double y[] = {0, 1, 1, 0, 0};
+  PolygonGridIndex index;
+  EXPECT_TRUE(index.AddConvexPolygon(TGraph(5, x, y), 7));
+  EXPECT_TRUE(index.AddConvexPolygon(
+      {TVector2(1, 0), TVector2(2, 0), TVector2(2, 1), TVector2(1, 1)}, 8)); // CCW
+  EXPECT_TRUE(index.Build(4, 4));
+  EXPECT_EQ(index.FindBin(0.5, 0.5), 7);
+  EXPECT_EQ(index.FindBin(1.5, 0.5), 8);
+  EXPECT_EQ(index.FindBin(2.5, 0.5), PolygonGridIndex::notFound);
+  EXPECT_EQ(index.FindBin(0.5, -0.5), PolygonGridIndex::notFound);
+  EXPECT_EQ(index.FindBin(TMath::QuietNaN(), 0.5), PolygonGridIndex::notFound);
+}
+
+TEST(PolygonGridIndexTest, PolygonsInBox) {
+  PolygonGridIndex index;
+  EXPECT_TRUE(index.AddConvexPolygon(
+      {TVector2(0, 0), TVector2(0, 1), TVector2(1, 1), TVector2(1, 0)}, 7)); // CW
+  EXPECT_TRUE(index.AddConvexPolygon(
+      {TVector2(1, 0), TVector2(2, 0), TVector2(2, 1), TVector2(1, 1)}, 8));
+  EXPECT_TRUE(index.Build(4, 4));
+  std::vector<unsigned int> result;
+  index.GetPolygonsInBox(0.2, 0.8, 0.2, 0.8, result);
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(index.GetPolygonId(result[0]), 7);
+  index.GetPolygonsInBox(0.5, 1.5, -1, 2, result);
+  ASSERT_EQ(result.size(), 2u);
+  EXPECT_EQ(index.GetPolygonId(result[1]), 8);
+  index.GetPolygonsInBox(3, 4, 0, 1, result);
+  EXPECT_TRUE(result.empty());
+  std::vector<double> xy;
+  index.GetPolygonVertices(0, xy); // stored in CCW order
+  ASSERT_EQ(xy.size(), 8u);
+  double area = 0;
+  for (auto i = 0u; i < 4; i++) {
+    const auto j = (i + 1) % 4;
+    area += 0.5 * (xy[2 * i] * xy[2 * j + 1] - xy[2 * j] * xy[2 * i + 1]);
+  }
+  EXPECT_DOUBLE_EQ(area, 1.0);
+}
+
+TEST(PolygonGridIndexTest, SameAsTH2Poly) {
+  // pattern of randomly shaped convex quadrilaterals inscribed in circles
+  TRandom3 rand(12345);
+  TH2Poly poly("h_test", "", 10, -10, 10, 10, -10, 10);
+  PolygonGridIndex index;
+  for (int ix = 0; ix < 20; ix++) {
+    for (int iy = 0; iy < 20; iy++) {
+      const double x0 = -10 + ix + 0.5, y0 = -10 + iy + 0.5;
+      std::vector<double> x, y;
+      for (int icorner = 0; icorner < 4; icorner++) {
+        const double phi = TMath::PiOver2() * (icorner + rand.Uniform(0.1, 0.9));
+        const double r = 0.45;
+        x.push_back(x0 + r * cos(phi));
+        y.push_back(y0 + r * sin(phi));
+      }
+      TGraph g(4, x.data(), y.data());
+      const int ibin = poly.AddBin(new TGraph(g));
+      ASSERT_TRUE(index.AddConvexPolygon(g, ibin));
+    }
+  }
+  ASSERT_TRUE(index.Build(13, 17));
+  std::vector<double> x, y;
+  std::vector<int> bins;
+  for (int ipoint = 0; ipoint < 100000; ipoint++) {
+    x.push_back(rand.Uniform(-12, 12));
+    y.push_back(rand.Uniform(-12, 12));
+  }
+  index.FindBins(x, y, bins);
+  ASSERT_EQ(bins.size(), x.size());
+  for (auto ipoint = 0u; ipoint < x.size(); ipoint++) {
+    const int expected = normalizeTH2PolyBin(poly.FindBin(x[ipoint], y[ipoint]));
+    EXPECT_EQ(index.FindBin(x[ipoint], y[ipoint]), expected);
+    EXPECT_EQ(bins[ipoint], expected);
+  }
+}
+
+TEST(PolygonGridIndexTest, GeometryTPCSameAsTH2Poly) {
+  const std::string geometryFile =
+      std::string(TPCRECO_RESOURCE_DIR) + "/geometry_ELITPC.dat";
+  auto geometry = std::make_shared<GeometryTPC>(geometryFile.c_str(), false);
+  ASSERT_TRUE(geometry->IsOK());
+
+  double xmin, xmax, ymin, ymax;
+  std::tie(xmin, xmax, ymin, ymax) = geometry->rangeXY();
+  auto hull = geometry->GetActiveAreaConvexHull(0.0);
+  TH2PolyBin hullBin(new TGraph(hull), 1);
+  TRandom3 rand(54321);
+  for (int ipoint = 0; ipoint < 200000; ipoint++) {
+    const double x = rand.Uniform(xmin - 10, xmax + 10);
+    const double y = rand.Uniform(ymin - 10, ymax + 10);
+    const int expected =
+        normalizeTH2PolyBin(geometry->GetTH2Poly()->FindBin(x, y));
+    ASSERT_EQ(geometry->FindStripBin(x, y), expected) << "x=" << x << " y=" << y;
+    EXPECT_EQ(geometry->GetStripByPosition(x, y), geometry->GetTH2PolyStrip(expected));
+    EXPECT_EQ(geometry->IsInsideActiveArea(x, y), (bool)hullBin.IsInside(x, y));
+  }
+}
+
+TEST(PolygonGridIndexTest, ClipConvexPolygonArea) {
+  const double square[] = {0, 0, 1, 0, 1, 1, 0, 1};   // CCW
+  const double squareCW[] = {0, 0, 0, 1, 1, 1, 1, 0}; // CW
+  const double triangle[] = {0, 0, 2, 0, 0, 2};
+  // polygon inside the rectangle
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(square, 4, -1, 2, -1, 2), 1.0);
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(squareCW, 4, -1, 2, -1, 2), 1.0);
+  // rectangle inside the polygon
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(square, 4, 0.25, 0.5, 0.5, 0.75), 0.0625);
+  // partial overlaps
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(square, 4, 0.5, 2, -1, 2), 0.5);
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(squareCW, 4, -1, 0.25, 0.5, 2), 0.125);
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(triangle, 3, 0, 2, 0, 1), 1.5);
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(triangle, 3, 1, 2, 1, 2), 0.0);
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(triangle, 3, 0.5, 1.5, 0, 1), 0.875);
+  // disjoint
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(square, 4, 2, 3, 0, 1), 0.0);
+  EXPECT_DOUBLE_EQ(PolygonGridIndex::ClipConvexPolygonArea(square, 4, 0, 1, 1, 2), 0.0);
+}
+
+TEST(PolygonGridIndexTest, OverlapAreas) {
+  PolygonGridIndex index;
+  EXPECT_TRUE(index.AddConvexPolygon(
+      {TVector2(0, 0), TVector2(0, 1), TVector2(1, 1), TVector2(1, 0)}, 7));
+  EXPECT_TRUE(index.AddConvexPolygon(
+      {TVector2(1, 0), TVector2(2, 0), TVector2(2, 1), TVector2(1, 1)}, 8));
+  EXPECT_TRUE(index.AddConvexPolygon(
+      {TVector2(1, 0), TVector2(2, 0), TVector2(1.5, -1)}, 8)); // same ID, areas are summed
+  EXPECT_TRUE(index.Build(4, 4));
+  std::map<int, double> areas;
+  index.GetOverlapAreas(0.5, 1.5, 0.25, 0.75, areas);
+  ASSERT_EQ(areas.size(), 2u);
+  EXPECT_DOUBLE_EQ(areas[7], 0.25);
+  EXPECT_DOUBLE_EQ(areas[8], 0.25);
+  index.GetOverlapAreas(0, 2, -1, 1, areas);
+  ASSERT_EQ(areas.size(), 2u);
+  EXPECT_DOUBLE_EQ(areas[7], 1.0);
+  EXPECT_DOUBLE_EQ(areas[8], 1.5);
+  index.GetOverlapAreas(0.25, 0.75, 1, 2, areas); // touching edge only
+  EXPECT_TRUE(areas.empty());
+  index.GetOverlapAreas(3, 4, 0, 1, areas);
+  EXPECT_TRUE(areas.empty());
+}
+
+TEST(PolygonGridIndexTest, GeometryTPCOverlapAreasSameAsRandomProbing) {
+  const std::string geometryFile =
+      std::string(TPCRECO_RESOURCE_DIR) + "/geometry_ELITPC.dat";
+  auto geometry = std::make_shared<GeometryTPC>(geometryFile.c_str(), false);
+  ASSERT_TRUE(geometry->IsOK());
+  const auto &index = geometry->GetStripIndex();
+  ASSERT_TRUE(index.IsOK());
+
+  // XY bins of the size used by EventSourceMC, probed by random points
+  // as UVWprojector did before the areas were computed exactly
+  const double dx = 6, dy = 4;
+  const int npoints = 20000;
+  TRandom3 rand(777);
+  std::map<int, double> areas;
+  int nfilled = 0;
+  for (int ibin = 0; ibin < 50; ibin++) {
+    const double x1 = rand.Uniform(-120, 120 - dx);
+    const double y1 = rand.Uniform(-80, 80 - dy);
+    index.GetOverlapAreas(x1, x1 + dx, y1, y1 + dy, areas);
+    std::map<int, int> counts;
+    for (int ipoint = 0; ipoint < npoints; ipoint++) {
+      const int id = normalizeTH2PolyBin(geometry->GetTH2Poly()->FindBin(
+          rand.Uniform(x1, x1 + dx), rand.Uniform(y1, y1 + dy)));
+      if (id != PolygonGridIndex::notFound) counts[id]++;
+    }
+    for (const auto &it : counts) {
+      EXPECT_TRUE(areas.count(it.first)) << "x1=" << x1 << " y1=" << y1 << " bin=" << it.first;
+    }
+    for (const auto &it : areas) {
+      const double fraction = it.second / (dx * dy);
+      EXPECT_GT(fraction, 0);
+      EXPECT_LE(fraction, 1 + 1e-12);
+      const double fractionMC = (double)counts[it.first] / npoints;
+      const double sigma = std::sqrt(fraction * (1 - fraction) / npoints);
+      EXPECT_NEAR(fraction, fractionMC, 5 * sigma + 1.0 / npoints)
+          << "x1=" << x1 << " y1=" << y1 << " bin=" << it.first;
+    }
+    nfilled += !areas.empty();
+  }
+  EXPECT_GT(nfilled, 0);
+}
@@ -29,6 +29,7 @@
 #ifdef WITH_GET
 #include "TPCReco/EventSourceGRAW.h"
 #include "TPCReco/EventSourceMultiGRAW.h"
+#include "TPCReco/EventSourceGRAWTail.h"
 #endif
 #include "TPCReco/EventSourceROOT.h"
 #include "TPCReco/EventSourceMC.h"
@@ -88,6 +89,7 @@ namespace EventSourceFactory {
 		else if (dataFileVec.size() == 1 && dataFileName.find("_MC_") != std::string::npos) {
 			myEventSource = std::make_shared<EventSourceMC>(geometryFileName);
 			myConfig.put("transient.eventType", event_type::EventSourceMC);
+			dynamic_cast<EventSourceMC*>(myEventSource.get())->setAreaCacheDirectory(myConfig.get<std::string>("input.areaCacheDirectory", ""));
 		}		
 #ifdef WITH_GET
 		else if (all_graw) {
@@ -110,7 +112,12 @@ namespace EventSourceFactory {
 		}
 		else if (dataFileVec.size() == 1 && boost::filesystem::is_directory(dataFileVec[0])) {
 			myConfig.put("transient.onlineFlag", true);
-			if (myConfig.get<bool>("input.singleAsadGrawFile")) {
+			if (myConfig.get<bool>("online.tailFiles", true)) {
+				myEventSource = std::make_shared<EventSourceGRAWTail>(geometryFileName);
+				myConfig.put("transient.eventType", myConfig.get<bool>("input.singleAsadGrawFile") ?
+					     event_type::EventSourceMultiGRAW : event_type::EventSourceGRAW);
+			}
+			else if (myConfig.get<bool>("input.singleAsadGrawFile")) {
 				myEventSource = std::make_shared<EventSourceMultiGRAW>(geometryFileName);
 				myConfig.put("transient.eventType", event_type::EventSourceMultiGRAW);
 			}
@@ -46,6 +46,8 @@ public:
   inline void setFrameLoadRange(int range) {frameLoadRange=range;}
 
   inline void setFillEventType(EventType type) {fillEventType=type;}
+
+  inline unsigned int getCurrentEventFragments() const {return myCurrentEventFragments;} /// number of GRAW frames (ASAD fragments) found for the current event
   
 private:
   
@@ -91,6 +93,7 @@ private:
 
 protected: // needed for EventSourceMultiGRAW
   EventType fillEventType{EventType::tpc};
+  unsigned int myCurrentEventFragments{0};
 
 };
 #endif
@@ -0,0 +1,71 @@
+#ifndef _EventSourceGRAWTail_H_
+#define _EventSourceGRAWTail_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <deque>
+
+#include "TPCReco/GrawFileTail.h"
+#include "TPCReco/EventSourceGRAW.h"
+
+/////////////////////////////////////////////////////////
+/// Online event source for GRAW files growing during data taking.
+/// Every loadDataFile() call reads only the frames appended to the files
+/// since the previous call, the files are never rescanned from the start.
+/// Both a single file with all ASAD boards and one file per ASAD are handled.
+/// File entries are the complete events (all ASAD fragments found)
+/// in order of completion, the last entry is the latest complete event.
+/// Only the files named in the latest loadDataFile() call are kept open.
+/// Files superseded by a later run or chunk are read to their end and
+/// forgotten once none of their frames is kept.
+/////////////////////////////////////////////////////////
+class EventSourceGRAWTail: public EventSourceGRAW {
+
+public:
+
+  EventSourceGRAWTail(const std::string & geometryFileName);
+
+  ~EventSourceGRAWTail();
+
+  std::shared_ptr<EventTPC> getNextEvent(); // OVERLOADED
+
+  std::shared_ptr<EventTPC> getPreviousEvent(); // OVERLOADED
+
+  unsigned long int numberOfEvents() const { return nEntries; }
+
+  /// accepts comma separated list of new or growing files
+  void loadDataFile(const std::string & commaSeparatedFileNames); // OVERLOADED
+
+  void loadFileEntry(unsigned long int iEntry); // OVERLOADED
+
+  void loadEventId(unsigned long int eventId); // OVERLOADED
+
+  /// maximal number of complete events kept for browsing
+  void setMaxEvents(unsigned long int aMaxEvents) { maxEvents = aMaxEvents; }
+
+private:
+
+  struct FrameLocation {
+    unsigned int fileIndex;
+    unsigned long int frameNumber;
+    std::streamoff offset; // decoded directly, without scanning the file
+  };
+
+  void readNewFrames(unsigned int fileIndex);
+  void finishSupersededFiles(const std::string & newFileName);
+  void releaseFiles(const std::set<unsigned int> & updatedFiles);
+  void collectFragments(unsigned long int eventId);
+  void dropOldEvents();
+
+  std::map<unsigned int, std::unique_ptr<GrawFileTail> > myTails; // [file index]
+  std::map<std::string, unsigned int> myTailIndex; // file path -> index in myTails
+  std::set<unsigned int> myFinishedTails; // superseded files, no new frames expected
+  unsigned int myNextTailIndex{0};
+  std::map<unsigned long int, std::map<unsigned int, FrameLocation> > myFragments; // [eventId, {COBO, ASAD}]
+  std::deque<unsigned long int> myCompleteEvents; // eventIds in order of completion
+  unsigned long int maxEvents{10000};
+
+};
+#endif
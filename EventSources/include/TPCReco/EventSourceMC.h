@@ -41,6 +41,9 @@ public:
   unsigned long int numberOfEvents() const;
 
   void loadGeometry(const std::string & fileName);
+
+  // directory for caching XY area mappings of the UVW projector, empty=no caching
+  void setAreaCacheDirectory(const std::string & dirName);
   
  private:
 
@@ -50,6 +53,7 @@ public:
 
   mutable TRandom3 myRndm{0};
   std::shared_ptr<UVWprojector> myProjectorPtr;
+  std::string myAreaCacheDirectory;
   mutable IonRangeCalculator myRangeCalculator;
   TH3D my3DChargeCloud;
   std::vector<Track3D> myTracks3D;
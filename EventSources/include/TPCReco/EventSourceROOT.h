@@ -4,6 +4,7 @@
 #include "TPCReco/EventSourceBase.h"
 #include "TPCReco/EventRaw.h"
 #include "TPCReco/PedestalCalculator.h"
+#include "TPCReco/TTreeOps.h"
 #include <boost/property_tree/json_parser.hpp>
 
 class TFile;
@@ -38,6 +39,9 @@ public:
   void configurePedestal(const boost::property_tree::ptree &config);
 
   void loadGeometry(const std::string & fileName);
+
+  /// name of the persistent (runId, eventId) -> entry index stored next to the tree
+  static std::string getIndexName(const std::string & treeName) { return treeName+"_index"; }
   
  private:
 
@@ -53,6 +57,11 @@ public:
 
   PedestalCalculator myPedestalCalculator;  
   void setTreePointers();
+  void configureTreeCache();
+
+  std::vector<tpcreco::utilities::EntryKey> myIndex; // sorted (runId, eventId) -> entry
+  bool isIndexLoaded{false};
+  void loadIndex(); // lazy, on the first loadEventId()
 
 };
 #endif
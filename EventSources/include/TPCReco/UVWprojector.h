@@ -8,6 +8,7 @@
 #include <cstddef> // for: NULL
 #include <vector>
 #include <map>
+#include <string>
 
 #include <TROOT.h>
 #include <TH3D.h>
@@ -30,7 +31,8 @@ class UVWprojector {
   // Setter methods 
   
   UVWprojector(std::shared_ptr<GeometryTPC> geo, int n=100, int nx=25, int ny=25);
-  void SetAreaNpoints(int n); // change number of points used for random probing of TH2Poly bins
+  void SetAreaNpoints(int n); // obsolete: area fractions are now computed exactly, kept for backward compatibility
+  void SetCacheDirectory(const std::string &dir); // directory for caching area mappings, empty=no caching
   void SetEvent3D(TH3D &h3); // 3D ionization map: (x [mm], y [mm], z [mm], Q [arb.u.])
   void SetEvent2D(TH2D &h2); // 2D ionization map: (x [mm], y [mm], Q [arb.u.])
   inline void SetDebug(bool flag) { _debug = flag; }
@@ -41,6 +43,8 @@ class UVWprojector {
   TH2Poly *GetStripProfile_TH2Poly();     // Get TH2Poly of time-integrated strip projection (ALL STRIPS)
   TH2D    *GetStripVsTime_TH2D(int dir);  // Get TH2D of strip vs time projection (SELECTED DIRECTION)  
   inline int GetAreaNpoints() { return area_npoints; }
+  inline const std::string & GetCacheDirectory() const { return cache_dir; }
+  std::string GetAreaMappingFileName() const; // cache file name for the current geometry and XY binning
   inline double GetEventIntegral() { return (input_hist==NULL ? 0.0 : input_hist->Integral()); }
   
   // Nested helper class definitions
@@ -53,6 +57,8 @@ class UVWprojector {
   // Setter methods
 
   bool InitAreaMapping();
+  bool LoadAreaMapping(const std::string &fname); // read area mapping from binary cache file
+  bool SaveAreaMapping(const std::string &fname) const; // write area mapping to binary cache file
   bool InitTimeMapping();
   virtual void AddBinContent(Int_t bin, Double_t val);
   virtual void SetBinContent(Int_t bin, Double_t val);
@@ -69,6 +75,7 @@ class UVWprojector {
   std::shared_ptr<GeometryTPC> geo_ptr; // pointer to the existing TPC geometry
   TH1 *input_hist; // input histogram to be projected (can be TH3D/TH3F or TH2D/TH2F)
   bool is_input_2D; // is the event input histogram of TH2D or TH3D type?
+  std::string cache_dir; // directory with cached area mappings
   
   std::map<MultiKey2 /* TH2 bin index [1..NX*NY] */, BinFracMap> fAreaFractionMap;
   std::map<int /* TH1 bin index [1..NX] */, BinFracMap> fTimeFractionMap; 
@@ -2,6 +2,7 @@
 #define _grawToEventTPC_H_
 
 #include <string>
+#include <vector>
 
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -12,4 +13,30 @@ std::string createROOTFileName(const  std::string & grawFileName);
 
 int convertGRAWFile(boost::property_tree::ptree & aConfig);
 
+/// Event converted from a single GRAW file chunk
+struct ChunkEventEntry {
+  unsigned int eventId;
+  unsigned int nFragments; // number of ASAD frames found for the event
+  unsigned int chunk;      // index of the chunk in the run
+  unsigned long int entry; // entry in the temporary tree of the chunk
+};
+
+/// Lists GRAW file chunks (_0000, _0001, ...) of a run starting from the given one.
+/// Each element is a comma separated list of files, one file per AsAd stream.
+/// The list ends with the first chunk missing any of the streams.
+std::vector<std::string> listGRAWFileChunks(const std::string & grawFileName);
+
+/// Selects a single version of every event from converted chunks.
+/// Events crossing chunk boundary are complete in the earlier chunk (the GRAW source
+/// looks ahead into the next file), but partial in the later one: the version with
+/// the most fragments wins, the earliest chunk is taken for equal counts.
+/// Result is sorted by event id.
+std::vector<ChunkEventEntry> stitchChunkEvents(const std::vector<std::vector<ChunkEventEntry> > & chunkEvents);
+
+/// Converts all file chunks of a run, starting from input.dataFile, with nThreads workers.
+/// Each chunk is converted into a temporary tree, events are stitched with stitchChunkEvents
+/// and merged into the output tree in event id order.
+/// Returns 1 if any chunk fails, the workers are joined and temporary files removed.
+int convertGRAWRun(boost::property_tree::ptree & aConfig, unsigned int nThreads);
+
 #endif
\ No newline at end of file
@@ -234,8 +234,10 @@ void EventSourceGRAW::findEventFragments(unsigned long int eventId, unsigned int
 /////////////////////////////////////////////////////////
 void EventSourceGRAW::collectEventFragments(unsigned int eventId){
 
+  myCurrentEventFragments = 0;
   auto it = myFramesMap.find(eventId);
   if(it==myFramesMap.end()) return;
+  myCurrentEventFragments = it->second.size();
   if(it->second.size()!=GRAW_EVENT_FRAGMENTS){
       std::cerr<<KRED<<"Fragment counts for eventId = "<<RST<<eventId
 	       <<KRED<<" mismatch. Expected: "<<RST<<GRAW_EVENT_FRAGMENTS
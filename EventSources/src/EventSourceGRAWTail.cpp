@@ -0,0 +1,195 @@
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "TPCReco/EventSourceGRAWTail.h"
+#include "TPCReco/RunIdParser.h"
+#include "TPCReco/colorText.h"
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+EventSourceGRAWTail::EventSourceGRAWTail(const std::string & geometryFileName) : EventSourceGRAW(geometryFileName) {}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+EventSourceGRAWTail::~EventSourceGRAWTail(){}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+std::shared_ptr<EventTPC> EventSourceGRAWTail::getNextEvent(){
+
+  if(myCurrentEntry+1<nEntries) loadFileEntry(myCurrentEntry+1);
+  return myCurrentEvent;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+std::shared_ptr<EventTPC> EventSourceGRAWTail::getPreviousEvent(){
+
+  if(myCurrentEntry>0 && myCurrentEntry-1<nEntries) loadFileEntry(myCurrentEntry-1);
+  return myCurrentEvent;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::loadDataFile(const std::string & commaSeparatedFileNames){
+
+  const char del = ','; // delimiter character
+  std::stringstream sstream(commaSeparatedFileNames);
+  std::string fileName;
+  std::set<unsigned int> updatedFiles;
+  while (std::getline(sstream, fileName, del)) {
+    if(fileName.empty()) continue;
+    auto it = myTailIndex.find(fileName);
+    if(it==myTailIndex.end()){
+      EventSourceBase::loadDataFile(fileName);
+      finishSupersededFiles(fileName);
+      it = myTailIndex.insert(std::make_pair(fileName, myNextTailIndex++)).first;
+      myTails[it->second].reset(new GrawFileTail(fileName));
+    }
+    readNewFrames(it->second);
+    updatedFiles.insert(it->second);
+  }
+  dropOldEvents();
+  releaseFiles(updatedFiles);
+  nEntries = myCompleteEvents.size();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::finishSupersededFiles(const std::string & newFileName){
+
+  for(const auto & aTail: myTails){
+    if(myFinishedTails.count(aTail.first) ||
+       !GrawFileTail::isSupersededBy(aTail.second->getFilePath(), newFileName)) continue;
+    readNewFrames(aTail.first); // frames written before the new file was started
+    myFinishedTails.insert(aTail.first);
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::releaseFiles(const std::set<unsigned int> & updatedFiles){
+
+  // the frames are decoded by the frame loader, which opens the files itself
+  for(auto & aTail: myTails){
+    if(!updatedFiles.count(aTail.first)) aTail.second->close();
+  }
+  if(myFinishedTails.empty()) return;
+
+  std::set<unsigned int> usedFiles;
+  for(const auto & aEvent: myFragments){
+    for(const auto & aFragment: aEvent.second) usedFiles.insert(aFragment.second.fileIndex);
+  }
+  for(auto it=myFinishedTails.begin(); it!=myFinishedTails.end();){
+    if(usedFiles.count(*it)){
+      ++it;
+      continue;
+    }
+    myTailIndex.erase(myTails.at(*it)->getFilePath());
+    myTails.erase(*it);
+    it = myFinishedTails.erase(it);
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::readNewFrames(unsigned int fileIndex){
+
+  for(const auto & aFrame: myTails.at(fileIndex)->update()){
+    auto & fragments = myFragments[aFrame.eventIdx];
+    unsigned int boardKey = (aFrame.coboIdx<<8) | aFrame.asadIdx;
+    if(fragments.count(boardKey)) continue; // duplicated fragment
+    fragments[boardKey] = FrameLocation{fileIndex, aFrame.frameNumber, aFrame.offset};
+    if(fragments.size()==GRAW_EVENT_FRAGMENTS) myCompleteEvents.push_back(aFrame.eventIdx);
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::dropOldEvents(){
+
+  if(myCompleteEvents.size()<=maxEvents) return;
+  unsigned long int lastDroppedEventId = 0;
+  while(myCompleteEvents.size()>maxEvents){
+    lastDroppedEventId = myCompleteEvents.front();
+    myFragments.erase(lastDroppedEventId);
+    myCompleteEvents.pop_front();
+  }
+  // incomplete events older than the dropped ones will not be completed anymore
+  for(auto it=myFragments.begin(); it!=myFragments.end() && it->first<lastDroppedEventId;){
+    if(it->second.size()<GRAW_EVENT_FRAGMENTS) it = myFragments.erase(it);
+    else ++it;
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::loadFileEntry(unsigned long int iEntry){
+
+  if(iEntry>=nEntries){
+    std::cerr<<KRED<<__FUNCTION__
+	     <<": File entry: "<<RST<<iEntry
+	     <<KRED<<" is out of range. Number of complete events: "<<RST<<nEntries
+	     <<std::endl;
+    return;
+  }
+  myCurrentEntry = iEntry;
+  collectFragments(myCompleteEvents[iEntry]);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::loadEventId(unsigned long int eventId){
+
+  auto it = std::find(myCompleteEvents.begin(), myCompleteEvents.end(), eventId);
+  if(it!=myCompleteEvents.end()){
+    loadFileEntry(std::distance(myCompleteEvents.begin(), it));
+    return;
+  }
+  if(myFragments.count(eventId)){
+    collectFragments(eventId); // incomplete event, fragments mismatch is reported
+    return;
+  }
+  std::cout<<__FUNCTION__<<KRED
+	   <<": Event id: "<<RST<<eventId
+	   <<KRED<<" not found in the data read so far."<<RST<<std::endl;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAWTail::collectFragments(unsigned long int eventId){
+
+  myCurrentEventFragments = 0;
+  auto it = myFragments.find(eventId);
+  if(it==myFragments.end() || it->second.empty()) return;
+  myCurrentEventFragments = it->second.size();
+  if(it->second.size()!=GRAW_EVENT_FRAGMENTS){
+    std::cerr<<KRED<<"Fragment counts for eventId = "<<RST<<eventId
+	     <<KRED<<" mismatch. Expected: "<<RST<<GRAW_EVENT_FRAGMENTS
+	     <<KRED<<" found: "<<RST<<it->second.size()
+	     <<RST<<std::endl;
+  }
+  myCurrentPEvent->Clear();
+
+  const auto & aFirstLocation = it->second.begin()->second;
+  RunIdParser runParser(myTails.at(aFirstLocation.fileIndex)->getFilePath());
+  myCurrentEventInfo.SetRunId(runParser.runId());
+
+  for(const auto & aFragment: it->second){
+    const auto & aLocation = aFragment.second;
+    const std::string & aFilePath = myTails.at(aLocation.fileIndex)->getFilePath();
+    bool dataFrameRead = myFrameLoader.getGrawFrameAt(aFilePath, aLocation.offset, myDataFrame);
+    if(!dataFrameRead){
+      std::cerr<<KRED<<__FUNCTION__
+	       <<": ERROR: cannot read file entry: "<<RST<<aLocation.frameNumber
+	       <<KRED<<" from file: "<<RST<<aFilePath
+	       <<std::endl;
+      continue;
+    }
+    if(myDataFrame.fHeader.fEventIdx!=eventId){
+      std::cerr<<KRED<<__FUNCTION__
+	       <<": Event id mismatch!: eventId="<<eventId
+	       <<", eventId_fromFrame="<<myDataFrame.fHeader.fEventIdx
+	       <<RST<<std::endl;
+      continue;
+    }
+    myCurrentEventInfo.SetEventId(eventId);
+    myCurrentEventInfo.SetEventTimestamp(myDataFrame.fHeader.fEventTime);
+    if(fillEventType==EventType::tpc) fillEventFromFrame(myDataFrame);
+    else if(fillEventType==EventType::raw) fillEventRawFromFrame(myDataFrame);
+  }
+  fillEventTPC();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
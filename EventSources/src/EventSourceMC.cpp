@@ -1,5 +1,7 @@
 #include <iostream>
 
+#include <boost/filesystem.hpp>
+
 #include "TPCReco/colorText.h"
 #include "TPCReco/EventSourceMC.h"
 
@@ -76,6 +78,24 @@ void EventSourceMC::loadGeometry(const std::string & fileName){
 
   EventSourceBase::loadGeometry(fileName);
   myProjectorPtr.reset(new UVWprojector(myGeometryPtr));
+  setAreaCacheDirectory(myAreaCacheDirectory);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceMC::setAreaCacheDirectory(const std::string & dirName){
+
+  // reuse XY area mappings computed in previous runs for the same geometry and binning
+  myAreaCacheDirectory.clear();
+  if(!dirName.empty()){
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(dirName, ec);
+    if(ec){
+      std::cerr<<KRED<<"Can not create area mapping cache directory: "<<RST<<dirName
+	       <<" ("<<ec.message()<<")"<<std::endl;
+    }
+    else myAreaCacheDirectory = dirName;
+  }
+  if(myProjectorPtr) myProjectorPtr->SetCacheDirectory(myAreaCacheDirectory);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -246,7 +266,7 @@ void EventSourceMC::fillPEventTPC(const TH3D & h3DChargeCloud, const Track3D & a
       smearedPosition = TVector3(myRndm.Gaus(depositPosition.X(), sigma),
 				 myRndm.Gaus(depositPosition.Y(), sigma),
 				 myRndm.Gaus(depositPosition.Z(), sigma));
-      iPolyBin = myGeometryPtr->GetTH2Poly()->FindBin(smearedPosition.X(), smearedPosition.Y());
+      iPolyBin = myGeometryPtr->FindStripBin(smearedPosition.X(), smearedPosition.Y());
       iCell = myGeometryPtr->Pos2timecell(smearedPosition.Z(), err_flag);
       std::shared_ptr<StripTPC> aStrip = myGeometryPtr->GetTH2PolyStrip(iPolyBin);
       if(aStrip){
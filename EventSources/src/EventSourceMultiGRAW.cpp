@@ -419,6 +419,7 @@ void EventSourceMultiGRAW::collectEventFragments(unsigned int eventId){
 
   unsigned int nFragments=0;
   std::set<int> asadCounter;
+  myCurrentEventFragments=0;
   for(unsigned int streamIndex=0; streamIndex<myFramesMapList.size(); streamIndex++) {
     auto it = myFramesMapList[streamIndex].find(eventId);
     if(it==myFramesMapList[streamIndex].end()) continue;
@@ -464,6 +465,7 @@ void EventSourceMultiGRAW::collectEventFragments(unsigned int eventId){
     nFragments++; 
   }
   fillEventTPC();
+  myCurrentEventFragments = nFragments;
   
   if(nFragments!=GRAW_EVENT_FRAGMENTS) {
     std::cerr<<KRED<<__FUNCTION__
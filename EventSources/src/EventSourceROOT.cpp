@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <iostream>
+#include <algorithm>
 
 #include <TFile.h>
 #include <TTree.h>
@@ -71,9 +72,48 @@ void EventSourceROOT::loadDataFile(const std::string & fileName){
   }
 
     myTree->SetBranchAddress("Event", &aPtr);
-    myTree->BuildIndex("myEventInfo.runId", "myEventInfo.eventId");
+    configureTreeCache();
 
   nEntries = myTree->GetEntries();
+  myIndex.clear();
+  isIndexLoaded = false;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceROOT::configureTreeCache(){
+
+  const auto & config = ConfigManager::getConfig();
+  auto cacheSize = config.get<long int>("input.treeCacheSize", 30000000);
+  if(cacheSize>0){
+    myTree->SetCacheSize(cacheSize);
+    myTree->SetCacheLearnEntries(config.get<int>("input.treeCacheLearnEntries", 10));
+    myTree->AddBranchToCache("Event", true); // the only branch read, learning may add more
+  }
+  if(config.get<bool>("input.parallelUnzip", false)){
+    myTree->SetParallelUnzip(true); // baskets are decompressed in background threads
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceROOT::loadIndex(){
+
+  if(isIndexLoaded) return;
+  isIndexLoaded = true;
+  myIndex = tpcreco::utilities::readStoredEntryKeys(myFile.get(), getIndexName(treeName));
+  if(myIndex.size()==nEntries) return;
+
+  // index not stored in the file (or outdated): read event ids only, in a single pass
+  if(!myIndex.empty()){
+    std::cout<<KYEL<<__FUNCTION__<<": stored index does not match the tree, rebuilding."<<RST<<std::endl;
+  }
+  try{
+    myIndex = tpcreco::utilities::readEntryKeys(myTree.get(), "myEventInfo.runId", "myEventInfo.eventId");
+    std::sort(myIndex.begin(), myIndex.end());
+  }
+  catch(const std::exception & e){
+    std::cerr<<KRED<<__FUNCTION__<<": cannot build (runId, eventId) index: "<<RST<<e.what()<<std::endl;
+    myIndex.clear();
+  }
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -119,10 +159,24 @@ void EventSourceROOT::loadEventId(unsigned long int iEvent){
     std::cerr<<"ROOT tree not available!"<<std::endl;
     return;
   }
-  // primary method: assumes that TTree::BuildIndex() was performed while storing/reading myTree
-  loadFileEntry(myTree->GetEntryNumberWithIndex(getCurrentEvent()->GetEventInfo().GetRunId(), iEvent));
+  // primary method: binary search in the sorted (runId, eventId) index
+  loadIndex();
+  if(!myIndex.empty()){
+    auto iEntry = tpcreco::utilities::findEntry(myIndex, getCurrentEvent()->GetEventInfo().GetRunId(), iEvent);
+    if(iEntry<0){ // e.g. nothing loaded yet, match the event id only
+      auto it = std::find_if(myIndex.begin(), myIndex.end(),
+			     [iEvent](const tpcreco::utilities::EntryKey & key){ return key.minor==(Long64_t)iEvent; });
+      if(it!=myIndex.end()) iEntry = it->entry;
+    }
+    if(iEntry<0){
+      std::cerr<<KRED<<__FUNCTION__<<": event id not found: "<<RST<<iEvent<<std::endl;
+      return;
+    }
+    loadFileEntry(iEntry);
+    return;
+  }
 
-  // secondary (failover) method: when TTree::BuildIndex() did not work properly
+  // secondary (failover) method: when the index could not be built
   unsigned long int iEntry = 0;
   while(currentEventNumber()!=iEvent && iEntry<nEntries){  
     loadFileEntry(iEntry);
@@ -3,6 +3,10 @@
 
 #include <cstdlib>
 #include <cstddef>  // for: NULL
+#include <cstdint>
+#include <cstdio>   // for: rename
+#include <cstring>  // for: memcmp
+#include <fstream>
 #include <iostream> // for: cout, cerr, endl
 #include <vector>
 #include <map>
@@ -33,6 +37,7 @@ UVWprojector::UVWprojector(std::shared_ptr<GeometryTPC> geo, int n, int nx, int
     geo_ptr(geo),
     input_hist(NULL),
     is_input_2D(false),
+    cache_dir(""),
     _debug(false)
 { 
   SetAreaNpoints(n);
@@ -48,8 +53,9 @@ UVWprojector::~UVWprojector() {
 }
     
 // change number of points used for random probing of TH2Poly bins
+// NOTE: area fractions are computed exactly, this parameter has no effect on the mapping
 void UVWprojector::SetAreaNpoints(int n) {
-  if(n>0 && n!=area_npoints) { area_npoints=n; isOK_AreaMapping=false; }
+  if(n>0) area_npoints=n;
 }
 
 // 3D ionization map: (x [mm], y [mm], z [mm], Q [arb.u.])
@@ -180,13 +186,12 @@ bool UVWprojector::InitAreaMapping() {
   fAreaFractionMap.clear();
 
   // sanity checks
-  TH2Poly *tp=NULL;
-  if( area_npoints<1 || !h2 || !geo_ptr || !(geo_ptr->IsOK()) || !(tp=geo_ptr->GetTH2Poly())) {
+  if( !h2 || !geo_ptr || !(geo_ptr->IsOK()) || !(geo_ptr->GetStripIndex().IsOK()) ) {
 
     // DEBUG
     if(_debug) {
       std::cerr << "InitAreaMapping: ERROR: Failed sanity checks (1): " 
-		<< "NPOINTS=" << area_npoints << ", HIST_PTR=" << h2 << ", TH2POLY=" << tp << ", GEO_PTR=" << geo_ptr << std::endl;
+		<< "HIST_PTR=" << h2 << ", GEO_PTR=" << geo_ptr << std::endl;
     }
     // DEBUG
 
@@ -213,44 +218,39 @@ bool UVWprojector::InitAreaMapping() {
     return false;
   }
 
+  // try cached mapping for the same geometry and XY binning first
+  const std::string cacheFile = (cache_dir.empty() ? "" : cache_dir+"/"+GetAreaMappingFileName());
+  if(!cacheFile.empty() && LoadAreaMapping(cacheFile)) {
+    isOK_AreaMapping=true;
+
+    // DEBUG
+    if(_debug) {
+      std::cout << "InitAreaMapping: Loaded area mapping from: " << cacheFile << std::endl;
+    }
+    // DEBUG
+
+    return isOK_AreaMapping;
+  }
+
   const double dx = (xmax-xmin)/nxbins;
   const double dy = (ymax-ymin)/nybins;
 
-  // create list of sampling points within [0, dx[ x [0, dy[ rectangle,
-  // always include the bin centre and randomly distribute the rest
-  std::vector<TVector2> offset;
-  offset.push_back(TVector2(0.5*dx, 0.5*dy)); 
-  TRandom3 *rand = new TRandom3(); 
-  for(int ipoint=1; ipoint<area_npoints; ipoint++) {
-    offset.push_back(TVector2(rand->Rndm()*dx, rand->Rndm()*dy)); 
-  }
-  
   // for each cartesian (X,Y) bin of the event histogram prepare:
   // - list of TH2Poly bins partially enclosed in the cartesian bin
-  // - for each TH2Poly bin of the list estimate ratio of the enclosed surface
-  //   to the total surface of the cartesian bin
-  double weight = 1. / area_npoints;
+  // - for each TH2Poly bin of the list compute exact ratio of the enclosed surface
+  //   to the total surface of the cartesian bin (convex pad polygons clipped to the bin rectangle)
+  const double weight = 1. / (dx*dy);
+  std::map<int, double> areaMap;
   for(int ibinx=0; ibinx<nxbins; ibinx++) {
     for(int ibiny=0; ibiny<nybins; ibiny++) {
-      TVector2 pos(xmin + ibinx * dx, ymin + ibiny * dy);
-      for(int ipoint=0; ipoint<area_npoints; ipoint++) {
-	TVector2 probe=pos+offset[ipoint];
-	int ibin = tp->FindBin(probe.X(), probe.Y()); // TH2Poly bin index
-
-	// DEBUG - VERY VERBOSE
-	//	if(_debug) {
-	//	  std::cout << "InitAreaMapping: Probing (X=" << probe.X() << ", Y=" << probe.Y() <<"): TH2POLY_BIN=" << ibin << std::endl;
-	//	}
-	// DEBUG - VERY VERBOSE
-	
-	if(ibin<1) continue; // skip underflow/overflow/sea bins
-	BinFracMap &bmap = fAreaFractionMap[MultiKey2(ibinx,ibiny)];
-	if( bmap.FracMap.find(ibin)==bmap.FracMap.end() ) {
-	  bmap.FracMap[ibin] = weight;  // assign weight to a new strip
-	} else {
-	  bmap.FracMap[ibin] += weight; // increase weight of existing strip 
-	}
-      } // end of random sampling loop      
+      const double x1 = xmin + ibinx * dx;
+      const double y1 = ymin + ibiny * dy;
+      geo_ptr->GetStripIndex().GetOverlapAreas(x1, x1+dx, y1, y1+dy, areaMap);
+      if(areaMap.empty()) continue;
+      BinFracMap &bmap = fAreaFractionMap[MultiKey2(ibinx,ibiny)];
+      for(auto &it : areaMap) {
+	bmap.FracMap[it.first] = it.second * weight;
+      }
     }
   } // end of loop over all (X,Y) bins
   
@@ -271,6 +271,9 @@ bool UVWprojector::InitAreaMapping() {
 
   // final result
   if(fAreaFractionMap.size()>0) isOK_AreaMapping=true;
+  if(isOK_AreaMapping && !cacheFile.empty() && !SaveAreaMapping(cacheFile)) {
+    std::cerr << "InitAreaMapping: WARNING: Cannot write area mapping cache: " << cacheFile << std::endl;
+  }
 
   // DEBUG
   if(_debug) {
@@ -282,6 +285,112 @@ bool UVWprojector::InitAreaMapping() {
   return isOK_AreaMapping;
 }
 
+// set directory for caching area mappings, empty string disables caching
+void UVWprojector::SetCacheDirectory(const std::string &dir) {
+  cache_dir=dir;
+}
+
+// cache file name encodes geometry checksum and XY binning of the input histogram
+std::string UVWprojector::GetAreaMappingFileName() const {
+  if(!input_hist || !geo_ptr) return "";
+  const TAxis *ax=input_hist->GetXaxis();
+  const TAxis *ay=input_hist->GetYaxis();
+  return Form("UVWprojectorAreaMap_G%016llx_X%d_%g_%g_Y%d_%g_%g.bin",
+	      (unsigned long long)geo_ptr->GetStripIndex().GetChecksum(),
+	      ax->GetNbins(), ax->GetXmin(), ax->GetXmax(),
+	      ay->GetNbins(), ay->GetXmin(), ay->GetXmax());
+}
+
+namespace {
+  // binary cache layout:
+  // header: magic, version, geometry checksum, NX, XMIN, XMAX, NY, YMIN, YMAX, number of XY bins
+  // for each XY bin: IX, IY, number of strips, (TH2Poly bin, fraction) pairs
+  const char areaMapMagic[8]={'U','V','W','A','M','A','P','\0'};
+  const uint32_t areaMapVersion=1;
+
+  template<class T> void writeValue(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template<class T> bool readValue(std::istream &in, T &value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.good();
+  }
+}
+
+bool UVWprojector::SaveAreaMapping(const std::string &fname) const {
+  if(!input_hist || !geo_ptr || fAreaFractionMap.empty()) return false;
+  const std::string tmpName=fname+".tmp";
+  std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+  if(!out.is_open()) return false;
+  out.write(areaMapMagic, sizeof(areaMapMagic));
+  writeValue(out, areaMapVersion);
+  writeValue(out, geo_ptr->GetStripIndex().GetChecksum());
+  const TAxis *ax=input_hist->GetXaxis();
+  const TAxis *ay=input_hist->GetYaxis();
+  writeValue(out, (int32_t)ax->GetNbins());
+  writeValue(out, ax->GetXmin());
+  writeValue(out, ax->GetXmax());
+  writeValue(out, (int32_t)ay->GetNbins());
+  writeValue(out, ay->GetXmin());
+  writeValue(out, ay->GetXmax());
+  writeValue(out, (uint64_t)fAreaFractionMap.size());
+  for(auto &it : fAreaFractionMap) {
+    writeValue(out, (int32_t)std::get<0>(it.first));
+    writeValue(out, (int32_t)std::get<1>(it.first));
+    writeValue(out, (uint32_t)it.second.FracMap.size());
+    for(auto &it2 : it.second.FracMap) {
+      writeValue(out, (int32_t)it2.first);
+      writeValue(out, it2.second);
+    }
+  }
+  out.close();
+  if(!out) return false;
+  // atomic replace, safe for concurrent jobs sharing the same cache directory
+  return std::rename(tmpName.c_str(), fname.c_str())==0;
+}
+
+bool UVWprojector::LoadAreaMapping(const std::string &fname) {
+  if(!input_hist || !geo_ptr) return false;
+  std::ifstream in(fname, std::ios::binary);
+  if(!in.is_open()) return false;
+  char magic[sizeof(areaMapMagic)];
+  uint32_t version;
+  uint64_t checksum, nentries;
+  int32_t nx, ny;
+  double xmin, xmax, ymin, ymax;
+  in.read(magic, sizeof(magic));
+  if(!in.good() || std::memcmp(magic, areaMapMagic, sizeof(magic))!=0 ||
+     !readValue(in, version) || version!=areaMapVersion ||
+     !readValue(in, checksum) || checksum!=geo_ptr->GetStripIndex().GetChecksum() ||
+     !readValue(in, nx) || !readValue(in, xmin) || !readValue(in, xmax) ||
+     !readValue(in, ny) || !readValue(in, ymin) || !readValue(in, ymax) ||
+     !readValue(in, nentries)) return false;
+  const TAxis *ax=input_hist->GetXaxis();
+  const TAxis *ay=input_hist->GetYaxis();
+  if(nx!=ax->GetNbins() || xmin!=ax->GetXmin() || xmax!=ax->GetXmax() ||
+     ny!=ay->GetNbins() || ymin!=ay->GetXmin() || ymax!=ay->GetXmax()) return false;
+  fAreaFractionMap.clear();
+  for(uint64_t ientry=0; ientry<nentries; ientry++) {
+    int32_t ix, iy;
+    uint32_t nfrac;
+    if(!readValue(in, ix) || !readValue(in, iy) || !readValue(in, nfrac)) {
+      fAreaFractionMap.clear();
+      return false;
+    }
+    BinFracMap &bmap = fAreaFractionMap[MultiKey2(ix,iy)];
+    for(uint32_t ifrac=0; ifrac<nfrac; ifrac++) {
+      int32_t ibin;
+      double frac;
+      if(!readValue(in, ibin) || !readValue(in, frac)) {
+	fAreaFractionMap.clear();
+	return false;
+      }
+      bmap.FracMap[ibin]=frac;
+    }
+  }
+  return fAreaFractionMap.size()>0;
+}
+
 bool UVWprojector::InitTimeMapping() {
 
   if(is_input_2D) return false; // input event contains only time-intergral 
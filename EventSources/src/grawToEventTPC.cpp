@@ -1,9 +1,20 @@
 #include "TPCReco/grawToEventTPC.h"
 
 #include <iostream>
+#include <sstream>
+#include <iomanip>
 #include <cstdlib>
+#include <cctype>
 #include <memory>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
 
+#include <boost/filesystem.hpp>
+
+#include <TROOT.h>
 #include <TFile.h>
 #include <TTree.h>
 
@@ -12,6 +23,8 @@
 #include "TPCReco/EventSourceGRAW.h"
 #include "TPCReco/EventSourceMultiGRAW.h"
 #include "TPCReco/EventSourceFactory.h"
+#include "TPCReco/EventSourceROOT.h"
+#include "TPCReco/TTreeOps.h"
 
 /////////////////////////////////////
 /////////////////////////////////////
@@ -44,7 +57,14 @@ std::string createROOTFileName(const  std::string & grawFileName){
 /////////////////////////////////////
 /////////////////////////////////////
 int convertGRAWFile(boost::property_tree::ptree & aConfig){
-  
+
+  int nThreads = aConfig.get<int>("input.convertThreads",1);
+  if(aConfig.get<bool>("input.convertRun",false)) return convertGRAWRun(aConfig, std::max(nThreads,0));
+  if(nThreads!=1){
+    std::cout<<KBLU<<"input.convertThreads is used with input.convertRun only, converting: "<<RST
+	     <<aConfig.get("input.dataFile","")<<std::endl;
+  }
+
   std::shared_ptr<EventSourceBase> myEventSource = EventSourceFactory::makeEventSourceObject(aConfig);
 
   std::string grawFileName = aConfig.get("input.dataFile","");
@@ -68,6 +88,7 @@ int convertGRAWFile(boost::property_tree::ptree & aConfig){
   int splitlevel=2;
   aTree.Branch("Event", &persistent_event, bufsize, splitlevel); 
   std::map<unsigned int, bool> eventIdMap;
+  std::vector<tpcreco::utilities::EntryKey> index;
 
 
   for(int iEntry=0; iEntry<readNEvents; iEntry++) 
@@ -79,6 +100,7 @@ int convertGRAWFile(boost::property_tree::ptree & aConfig){
       eventIdMap[eventId] = true;
 
       std::cout<< myEventPtr->GetEventInfo()<<std::endl;
+      index.push_back({(Long64_t)myEventPtr->GetEventInfo().GetRunId(), eventId, aTree.GetEntries()});
       aTree.Fill();
       if(eventIdMap.size()%100==0) aTree.FlushBaskets();
     }
@@ -88,6 +110,8 @@ int convertGRAWFile(boost::property_tree::ptree & aConfig){
   // build index based on: majorname=EventId, minorname=NONE
   //aTree.BuildIndex("Event.myEventInfo.eventId");
   aTree.Write("", TObject::kOverwrite); // save only the new version of the tree
+  std::sort(index.begin(), index.end());
+  tpcreco::utilities::writeEntryKeys(index, EventSourceROOT::getIndexName(aTree.GetName()), &aFile);
   aFile.Close();
 
   return 0;
@@ -95,3 +119,207 @@ int convertGRAWFile(boost::property_tree::ptree & aConfig){
 }
 /////////////////////////////////////
 /////////////////////////////////////
+namespace {
+  std::string getNextChunkPath(const std::string & filePath){
+
+    std::string token = "_";
+    auto index = filePath.rfind(token);
+    if(index==std::string::npos) return "";
+    int fieldLength = 4;
+    std::string fileIndex = filePath.substr(index+token.size(), fieldLength);
+    if(fileIndex.size()!=(unsigned int)fieldLength ||
+       !std::all_of(fileIndex.begin(), fileIndex.end(), ::isdigit)) return "";
+    std::ostringstream ostr;
+    ostr<<filePath.substr(0,index+token.size())<<std::setfill('0')<<std::setw(fieldLength)<<std::stoi(fileIndex)+1<<".graw";
+    return ostr.str();
+  }
+}
+/////////////////////////////////////
+/////////////////////////////////////
+std::vector<std::string> listGRAWFileChunks(const std::string & grawFileName){
+
+  std::vector<std::string> streams;
+  std::stringstream sstr(grawFileName);
+  std::string token;
+  while(std::getline(sstr, token, ',')) {
+    if(!token.empty()) streams.push_back(token);
+  }
+  std::vector<std::string> chunks;
+  if(streams.empty()) return chunks;
+  chunks.push_back(grawFileName);
+  while(true) {
+    std::string nextChunk;
+    for(auto & aStream: streams) {
+      aStream = getNextChunkPath(aStream);
+      if(aStream.empty() || !boost::filesystem::exists(aStream)) return chunks;
+      nextChunk += (nextChunk.empty() ? "" : ",") + aStream;
+    }
+    chunks.push_back(nextChunk);
+  }
+}
+/////////////////////////////////////
+/////////////////////////////////////
+std::vector<ChunkEventEntry> stitchChunkEvents(const std::vector<std::vector<ChunkEventEntry> > & chunkEvents){
+
+  std::map<unsigned int, ChunkEventEntry> bestEvents;
+  for(const auto & aChunk: chunkEvents) {
+    for(const auto & anEvent: aChunk) {
+      auto it = bestEvents.find(anEvent.eventId);
+      if(it==bestEvents.end()) {
+	bestEvents.emplace(anEvent.eventId, anEvent);
+	continue;
+      }
+      const auto & best = it->second;
+      if(anEvent.nFragments>best.nFragments ||
+	 (anEvent.nFragments==best.nFragments &&
+	  (anEvent.chunk<best.chunk || (anEvent.chunk==best.chunk && anEvent.entry<best.entry)))) {
+	it->second = anEvent;
+      }
+    }
+  }
+  std::vector<ChunkEventEntry> result;
+  result.reserve(bestEvents.size());
+  for(const auto & item: bestEvents) result.push_back(item.second);
+  return result;
+}
+/////////////////////////////////////
+/////////////////////////////////////
+int convertGRAWRun(boost::property_tree::ptree & aConfig, unsigned int nThreads){
+
+  if(nThreads==0) nThreads = std::max(1U, std::thread::hardware_concurrency());
+
+  std::string grawFileName = aConfig.get("input.dataFile","");
+  std::string treeName = aConfig.get<std::string>("input.treeName");
+  std::string rootFileName = createROOTFileName(grawFileName);
+  auto chunks = listGRAWFileChunks(grawFileName);
+  nThreads = std::min<unsigned int>(nThreads, chunks.size());
+
+  std::cout<<__FUNCTION__<<": converting "<<chunks.size()<<" GRAW file chunk(s) with "
+	   <<nThreads<<" thread(s) into: "<<rootFileName<<std::endl;
+
+  // 1. every chunk is converted by a worker into its own temporary file
+  ROOT::EnableThreadSafety();
+  std::vector<std::string> chunkFileNames;
+  for(unsigned int iChunk=0; iChunk<chunks.size(); ++iChunk) {
+    chunkFileNames.push_back(boost::filesystem::unique_path(rootFileName+".%%%%-%%%%.tmp.root").string());
+  }
+  auto removeChunkFiles = [&chunkFileNames]() {
+    for(const auto & aChunkFileName: chunkFileNames) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(aChunkFileName, ec);
+    }
+  };
+  std::vector<std::vector<ChunkEventEntry> > chunkEvents(chunks.size());
+  std::vector<std::string> chunkErrors(chunks.size()); // empty for chunks converted successfully
+  std::atomic<bool> failed{false}; // remaining chunks are not started after the first error
+  std::atomic<unsigned int> nextChunk{0};
+  std::mutex factoryMutex; // geometry and pedestal setup is not guaranteed to be thread safe
+  std::vector<std::thread> workers;
+  for(unsigned int iThread=0; iThread<nThreads; ++iThread) {
+    workers.emplace_back([&]() {
+	for(unsigned int iChunk=nextChunk++; iChunk<chunks.size() && !failed; iChunk=nextChunk++) {
+	  try {
+	    auto chunkConfig = aConfig;
+	    chunkConfig.put("input.dataFile", chunks[iChunk]);
+	    std::shared_ptr<EventSourceBase> myEventSource;
+	    {
+	      std::lock_guard<std::mutex> lock(factoryMutex);
+	      myEventSource = EventSourceFactory::makeEventSourceObject(chunkConfig);
+	    }
+	    auto myGrawSource = dynamic_cast<EventSourceGRAW*>(myEventSource.get());
+	    if(!myGrawSource) {
+	      chunkErrors[iChunk] = "parallel conversion requires GRAW input";
+	      failed = true;
+	      continue;
+	    }
+	    TFile aChunkFile(chunkFileNames[iChunk].c_str(),"RECREATE");
+	    TTree aChunkTree(treeName.c_str(),"");
+	    auto myEventPtr = myEventSource->getCurrentPEvent();
+	    auto persistent_event = myEventPtr.get();
+	    Int_t bufsize=128000;
+	    int splitlevel=2;
+	    aChunkTree.Branch("Event", &persistent_event, bufsize, splitlevel);
+	    std::map<unsigned int, bool> eventIdMap;
+	    auto & events = chunkEvents[iChunk];
+
+	    unsigned long int nEntries = myEventSource->numberOfEntries();
+	    for(unsigned long int iEntry=0; iEntry<nEntries; ++iEntry) {
+	      myEventSource->loadFileEntry(iEntry);
+	      unsigned int eventId = myEventPtr->GetEventInfo().GetEventId();
+	      if(eventIdMap.find(eventId)!=eventIdMap.end()) continue;
+	      eventIdMap[eventId] = true;
+	      events.push_back({eventId, myGrawSource->getCurrentEventFragments(), iChunk,
+				(unsigned long int)aChunkTree.GetEntries()});
+	      aChunkTree.Fill();
+	    }
+	    aChunkTree.Write("", TObject::kOverwrite);
+	    aChunkFile.Close();
+	  }
+	  catch(const std::exception & e) {
+	    chunkErrors[iChunk] = e.what();
+	    failed = true;
+	  }
+	}
+      });
+  }
+  for(auto & aWorker: workers) aWorker.join();
+  if(failed) {
+    for(unsigned int iChunk=0; iChunk<chunks.size(); ++iChunk) {
+      if(chunkErrors[iChunk].empty()) continue;
+      std::cerr<<KRED<<__FUNCTION__<<": ERROR: "<<chunkErrors[iChunk]<<", dataFile: "<<RST<<chunks[iChunk]<<std::endl;
+    }
+    removeChunkFiles();
+    return 1;
+  }
+
+  // 2. events crossing chunk boundaries are resolved by event id
+  auto events = stitchChunkEvents(chunkEvents);
+
+  // 3. selected events are copied in event id order, reading of each chunk is mostly sequential
+  std::vector<std::unique_ptr<TFile> > chunkFiles;
+  std::vector<TTree*> chunkTrees;
+  auto persistent_event = new PEventTPC();
+  for(const auto & aChunkFileName: chunkFileNames) {
+    chunkFiles.emplace_back(TFile::Open(aChunkFileName.c_str()));
+    auto aChunkTree = chunkFiles.back() ? (TTree*)chunkFiles.back()->Get(treeName.c_str()) : nullptr;
+    if(!aChunkTree) {
+      std::cerr<<KRED<<__FUNCTION__<<": ERROR: cannot read temporary file: "<<RST<<aChunkFileName<<std::endl;
+      for(auto aTree: chunkTrees) aTree->ResetBranchAddresses();
+      chunkFiles.clear();
+      removeChunkFiles();
+      delete persistent_event;
+      return 1;
+    }
+    aChunkTree->SetBranchAddress("Event", &persistent_event);
+    chunkTrees.push_back(aChunkTree);
+  }
+  TFile aFile(rootFileName.c_str(),"RECREATE");
+  TTree aTree(treeName.c_str(),"");
+  Int_t bufsize=128000;
+  int splitlevel=2;
+  aTree.Branch("Event", &persistent_event, bufsize, splitlevel);
+  std::vector<tpcreco::utilities::EntryKey> index;
+  for(const auto & anEvent: events) {
+    chunkTrees[anEvent.chunk]->GetEntry(anEvent.entry);
+    index.push_back({(Long64_t)persistent_event->GetEventInfo().GetRunId(), anEvent.eventId, aTree.GetEntries()});
+    aTree.Fill();
+    if(aTree.GetEntries()%100==0) aTree.FlushBaskets();
+  }
+  aTree.Print();
+  aTree.Write("", TObject::kOverwrite); // save only the new version of the tree
+  std::sort(index.begin(), index.end());
+  tpcreco::utilities::writeEntryKeys(index, EventSourceROOT::getIndexName(treeName), &aFile);
+  aFile.Close();
+
+  for(unsigned int iChunk=0; iChunk<chunkTrees.size(); ++iChunk) {
+    chunkTrees[iChunk]->ResetBranchAddresses();
+    chunkFiles[iChunk]->Close();
+  }
+  removeChunkFiles();
+  delete persistent_event;
+
+  std::cout<<__FUNCTION__<<": "<<events.size()<<" events written."<<std::endl;
+  return 0;
+}
+/////////////////////////////////////
+/////////////////////////////////////
@@ -0,0 +1,176 @@
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/UVWprojector.h"
+#include "gtest/gtest.h"
+#include <TH2D.h>
+#include <TRandom3.h>
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+// gives access to the XY area mapping
+class AreaMappingProjector : public UVWprojector {
+public:
+  using UVWprojector::UVWprojector;
+  using UVWprojector::LoadAreaMapping;
+  using UVWprojector::SaveAreaMapping;
+
+  std::map<std::pair<int, int>, std::map<int, double>> GetAreaMapping() const {
+    std::map<std::pair<int, int>, std::map<int, double>> result;
+    for (const auto &it : fAreaFractionMap) {
+      result[std::make_pair(std::get<0>(it.first), std::get<1>(it.first))] = it.second.FracMap;
+    }
+    return result;
+  }
+  bool IsAreaMappingOK() const { return isOK_AreaMapping; }
+};
+} // namespace
+
+class UVWprojectorTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() {
+    TH1::AddDirectory(false);
+    geometry = std::make_shared<GeometryTPC>(
+        (std::string(TPCRECO_RESOURCE_DIR) + "/geometry_ELITPC.dat").c_str(), false);
+  }
+
+  static void TearDownTestSuite() { geometry.reset(); }
+
+  void SetUp() override {
+    cacheDir = boost::filesystem::temp_directory_path() /
+               boost::filesystem::unique_path("UVWprojector_tst-%%%%-%%%%");
+    boost::filesystem::create_directories(cacheDir);
+  }
+
+  void TearDown() override { boost::filesystem::remove_all(cacheDir); }
+
+  // XY binning of EventSourceMC
+  static TH2D makeEvent(int nx = 50, int ny = 50) { return TH2D("hEvent", "", nx, -150, 150, ny, -100, 100); }
+
+  static std::shared_ptr<GeometryTPC> geometry;
+  boost::filesystem::path cacheDir;
+};
+
+std::shared_ptr<GeometryTPC> UVWprojectorTest::geometry;
+
+TEST_F(UVWprojectorTest, NoCacheByDefault) {
+  ASSERT_TRUE(geometry->IsOK());
+  AreaMappingProjector projector(geometry);
+  EXPECT_TRUE(projector.GetCacheDirectory().empty());
+  auto event = makeEvent();
+  projector.SetEvent2D(event);
+  EXPECT_TRUE(projector.IsAreaMappingOK());
+  EXPECT_TRUE(boost::filesystem::is_empty(cacheDir));
+}
+
+TEST_F(UVWprojectorTest, CacheRoundTrip) {
+  ASSERT_TRUE(geometry->IsOK());
+  auto event = makeEvent();
+
+  AreaMappingProjector computed(geometry);
+  computed.SetCacheDirectory(cacheDir.string());
+  computed.SetEvent2D(event);
+  ASSERT_TRUE(computed.IsAreaMappingOK());
+  const auto cacheFile = cacheDir / computed.GetAreaMappingFileName();
+  ASSERT_TRUE(boost::filesystem::exists(cacheFile));
+  const auto mapping = computed.GetAreaMapping();
+  ASSERT_FALSE(mapping.empty());
+
+  AreaMappingProjector loaded(geometry);
+  loaded.SetCacheDirectory(cacheDir.string());
+  loaded.SetEvent2D(event);
+  ASSERT_TRUE(loaded.IsAreaMappingOK());
+  EXPECT_EQ(loaded.GetAreaMapping(), mapping);
+
+  // cached mapping is really used: alter the first fraction of the first XY bin,
+  // stored after the 68-byte header and {IX, IY, number of strips, TH2Poly bin}
+  {
+    std::fstream file(cacheFile.string(), std::ios::binary | std::ios::in | std::ios::out);
+    const double fraction = 0.125;
+    file.seekp(68 + 4 * sizeof(int32_t));
+    file.write(reinterpret_cast<const char *>(&fraction), sizeof(fraction));
+  }
+  auto expected = mapping;
+  expected.begin()->second.begin()->second = 0.125;
+  AreaMappingProjector altered(geometry);
+  altered.SetCacheDirectory(cacheDir.string());
+  altered.SetEvent2D(event);
+  ASSERT_TRUE(altered.IsAreaMappingOK());
+  EXPECT_EQ(altered.GetAreaMapping(), expected);
+}
+
+TEST_F(UVWprojectorTest, CacheRejectsOtherBinningAndVersion) {
+  ASSERT_TRUE(geometry->IsOK());
+  auto event = makeEvent();
+  AreaMappingProjector projector(geometry);
+  projector.SetEvent2D(event);
+  ASSERT_TRUE(projector.IsAreaMappingOK());
+  const auto cacheFile = (cacheDir / "areaMap.bin").string();
+  ASSERT_TRUE(projector.SaveAreaMapping(cacheFile));
+
+  auto otherEvent = makeEvent(60, 50);
+  AreaMappingProjector other(geometry);
+  other.SetEvent2D(otherEvent);
+  EXPECT_NE(other.GetAreaMappingFileName(), projector.GetAreaMappingFileName());
+  EXPECT_FALSE(other.LoadAreaMapping(cacheFile));
+
+  // header starts with: char magic[8], uint32_t version
+  std::vector<char> image;
+  {
+    std::ifstream in(cacheFile, std::ios::binary);
+    image.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  ASSERT_GT(image.size(), 12u);
+  uint32_t version;
+  std::memcpy(&version, image.data() + 8, sizeof(version));
+  version++;
+  std::memcpy(image.data() + 8, &version, sizeof(version));
+  const auto badFile = (cacheDir / "areaMapBadVersion.bin").string();
+  {
+    std::ofstream out(badFile, std::ios::binary);
+    out.write(image.data(), image.size());
+  }
+  EXPECT_FALSE(projector.LoadAreaMapping(badFile));
+  EXPECT_FALSE(projector.LoadAreaMapping((cacheDir / "missing.bin").string()));
+  EXPECT_TRUE(projector.LoadAreaMapping(cacheFile));
+}
+
+TEST_F(UVWprojectorTest, AreaFractionsSameAsRandomProbing) {
+  ASSERT_TRUE(geometry->IsOK());
+  auto event = makeEvent();
+  AreaMappingProjector projector(geometry);
+  projector.SetEvent2D(event);
+  const auto mapping = projector.GetAreaMapping();
+  ASSERT_FALSE(mapping.empty());
+
+  // fractions of random points per TH2Poly bin, as computed by InitAreaMapping before
+  const int npoints = 10000;
+  const double dx = event.GetXaxis()->GetBinWidth(1), dy = event.GetYaxis()->GetBinWidth(1);
+  TRandom3 rand(4321);
+  int nchecked = 0;
+  for (const auto &it : mapping) {
+    if (nchecked++ % 10) continue; // every 10th bin
+    const double x1 = event.GetXaxis()->GetXmin() + it.first.first * dx;
+    const double y1 = event.GetYaxis()->GetXmin() + it.first.second * dy;
+    std::map<int, int> counts;
+    for (int ipoint = 0; ipoint < npoints; ipoint++) {
+      const int ibin = geometry->GetTH2Poly()->FindBin(rand.Uniform(x1, x1 + dx), rand.Uniform(y1, y1 + dy));
+      if (ibin > 0) counts[ibin]++;
+    }
+    for (const auto &count : counts) {
+      EXPECT_TRUE(it.second.count(count.first)) << "ix=" << it.first.first << " iy=" << it.first.second;
+    }
+    for (const auto &fraction : it.second) {
+      const double fractionMC = (double)counts[fraction.first] / npoints;
+      const double sigma = std::sqrt(fraction.second * (1 - fraction.second) / npoints);
+      EXPECT_NEAR(fraction.second, fractionMC, 5 * sigma + 1.0 / npoints)
+          << "ix=" << it.first.first << " iy=" << it.first.second << " bin=" << fraction.first;
+    }
+  }
+}
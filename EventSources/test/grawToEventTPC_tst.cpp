@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <iomanip>
+#include <fstream>
 #include <unistd.h>
 #include "gtest/gtest.h"
 #include "TFile.h"
@@ -95,3 +96,39 @@ TEST_F(grawToEventTPCTest, convertGRAWFile)
   EXPECT_EQ(rootfile->IsOpen(), false);
 }
 
+
+TEST(GRAWChunksTest, stitchChunkEvents)
+{
+  // event 11 crosses the boundary of chunks 0 and 1
+  std::vector<std::vector<ChunkEventEntry> > chunkEvents = {
+    {{10, 4, 0, 0}, {11, 4, 0, 1}},
+    {{11, 2, 1, 0}, {13, 4, 1, 1}, {12, 4, 1, 2}},
+    {{12, 4, 2, 0}, {14, 3, 2, 1}}};
+  auto events = stitchChunkEvents(chunkEvents);
+  ASSERT_EQ(events.size(), 5);
+  std::vector<unsigned int> eventIds, chunks;
+  for(const auto & anEvent: events) {
+    eventIds.push_back(anEvent.eventId);
+    chunks.push_back(anEvent.chunk);
+  }
+  EXPECT_EQ(eventIds, std::vector<unsigned int>({10, 11, 12, 13, 14}));
+  EXPECT_EQ(chunks, std::vector<unsigned int>({0, 0, 1, 1, 2}));
+
+  chunkEvents[0][1].nFragments = 1; // more complete version in the later chunk
+  EXPECT_EQ(stitchChunkEvents(chunkEvents)[1].chunk, 1);
+}
+
+TEST(GRAWChunksTest, listGRAWFileChunks)
+{
+  std::vector<std::string> fileNames = {"CoBo0_AsAd0_test_0000.graw", "CoBo0_AsAd1_test_0000.graw",
+					"CoBo0_AsAd0_test_0001.graw", "CoBo0_AsAd1_test_0001.graw",
+					"CoBo0_AsAd0_test_0002.graw"};
+  for(const auto & aFileName: fileNames) std::ofstream(aFileName).close();
+
+  auto chunks = listGRAWFileChunks("CoBo0_AsAd0_test_0000.graw,CoBo0_AsAd1_test_0000.graw");
+  EXPECT_EQ(chunks, std::vector<std::string>({"CoBo0_AsAd0_test_0000.graw,CoBo0_AsAd1_test_0000.graw",
+					      "CoBo0_AsAd0_test_0001.graw,CoBo0_AsAd1_test_0001.graw"}));
+  EXPECT_EQ(listGRAWFileChunks("CoBo0_AsAd0_test_0001.graw").size(), 2);
+
+  for(const auto & aFileName: fileNames) std::remove(aFileName.c_str());
+}
@@ -0,0 +1,92 @@
+#ifndef _BackgroundReconstruction_H_
+#define _BackgroundReconstruction_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "TPCReco/TrackBuilder.h"
+
+class EventTPC;
+class EventSourceBase;
+class GeometryTPC;
+
+/////////////////////////////////////////////////////////
+/// Runs TrackBuilder::reconstruct() on a worker thread.
+/// Every event is reconstructed by its own TrackBuilder, finished builders are
+/// kept until taken by the GUI thread (HistoManager).
+/// Requesting a new displayed event cancels all queued work and the event
+/// being reconstructed, unless it is the requested one.
+/// Events following the displayed one are reconstructed speculatively from
+/// a private event source, so that browsing forward finds them ready.
+/////////////////////////////////////////////////////////
+class BackgroundReconstruction {
+
+public:
+
+  typedef std::pair<long, unsigned int> EventKey; // (runId, eventId)
+
+  BackgroundReconstruction() = default;
+
+  ~BackgroundReconstruction();
+
+  void setConfig(const boost::property_tree::ptree &aConfig);
+
+  void setGeometry(std::shared_ptr<GeometryTPC> aGeometryPtr);
+
+  void setPressure(double aPressure);
+
+  /// requests reconstruction of the displayed event, the event is copied
+  void submit(std::shared_ptr<EventTPC> aEvent);
+
+  /// requests reconstruction of nEntries file entries following iEntry,
+  /// queued behind the displayed event
+  void prefetch(unsigned long int iEntry, unsigned int nEntries);
+
+  /// finished reconstruction of the event, nullptr if not ready (yet)
+  std::unique_ptr<TrackBuilder> take(const EventKey & aKey);
+
+  /// drops queued work and all results, e.g. after change of run conditions
+  void clear();
+
+  static EventKey getKey(const EventTPC & aEvent);
+
+private:
+
+  struct Job {
+    std::shared_ptr<EventTPC> event; // displayed event
+    long int entry{-1};               // or entry to be read by the private source
+  };
+
+  void start();
+  void run();
+  std::shared_ptr<EventTPC> loadEntry(unsigned long int iEntry, std::shared_ptr<GeometryTPC> aGeometryPtr);
+  void storeResult(const EventKey & aKey, std::unique_ptr<TrackBuilder> aBuilder);
+
+  boost::property_tree::ptree myConfig;
+  EventTPC::HitFilterParameters myHitFilterParameters;
+  std::shared_ptr<GeometryTPC> myGeometryPtr;
+  double myPressure{-1};
+  std::shared_ptr<EventSourceBase> myPrefetchSource; // used by the worker thread only
+
+  std::thread myWorker;
+  std::mutex myMutex;
+  std::condition_variable myCondition;
+  std::deque<Job> myJobs;
+  std::map<EventKey, std::unique_ptr<TrackBuilder> > myResults;
+  std::deque<EventKey> myResultsOrder; // the oldest first
+  std::map<unsigned long int, EventKey> myEntryKeys; // entries already read by the worker
+  unsigned int myMaxResults{4};
+  EventKey myRunningKey{-1, 0};
+  bool isRunningKeyValid{false};
+  std::atomic<bool> isCancelled{false};
+  bool isStopped{false};
+};
+#endif
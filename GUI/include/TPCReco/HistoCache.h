@@ -0,0 +1,74 @@
+#ifndef _HistoCache_H_
+#define _HistoCache_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <tuple>
+
+class TH1;
+
+/////////////////////////////////////////////////////////
+/// Least recently used cache of histograms prepared for display.
+/// Revisiting an event (redraw, log scale toggle, browsing back)
+/// returns the histograms without recomputing the projections.
+/// Total size of the cached histograms is bounded, the least recently
+/// used histograms are dropped first.
+/////////////////////////////////////////////////////////
+class HistoCache {
+
+public:
+
+  enum histo_kind {projection1D, projection2D, channels};
+
+  struct Key {
+    long runId;
+    unsigned int eventId;
+    unsigned long long timestamp;
+    bool autozoom;
+    int kind;
+    int param1;  // projection type or CoBo id
+    int param2;  // filter type or AsAd id
+    int param3;  // scale type
+
+    bool operator<(const Key & aKey) const {
+      return std::tie(runId, eventId, timestamp, autozoom, kind, param1, param2, param3) <
+	std::tie(aKey.runId, aKey.eventId, aKey.timestamp, aKey.autozoom, aKey.kind, aKey.param1, aKey.param2, aKey.param3);
+    }
+  };
+
+  HistoCache() = default;
+
+  /// 0 disables the cache
+  void setMaxBytes(size_t aMaxBytes);
+
+  /// cached histogram or nullptr
+  std::shared_ptr<TH1> get(const Key & aKey);
+
+  void put(const Key & aKey, std::shared_ptr<TH1> aHisto);
+
+  void clear();
+
+  size_t getBytes() const { return myBytes; }
+
+  size_t size() const { return myItems.size(); }
+
+  /// approximate memory used by the histogram contents
+  static size_t estimateBytes(const TH1 & aHisto);
+
+private:
+
+  struct Item {
+    Key key;
+    std::shared_ptr<TH1> histo;
+    size_t bytes; // as estimated when stored, the histogram may be modified later
+  };
+
+  void shrink(size_t aMaxBytes);
+
+  std::list<Item> myItems; // the most recently used first
+  std::map<Key, std::list<Item>::iterator> myIndex;
+  size_t myBytes{0};
+  size_t myMaxBytes{0};
+};
+#endif
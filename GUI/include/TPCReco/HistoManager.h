@@ -19,6 +19,8 @@
 #include "TPCReco/dEdxFitter.h"
 #include "TPCReco/RecoOutput.h"
 #include "TPCReco/IonRangeCalculator.h"
+#include "TPCReco/BackgroundReconstruction.h"
+#include "TPCReco/HistoCache.h"
 
 #include "TPCReco/CommonDefinitions.h"
 
@@ -56,6 +58,14 @@ public:
  
   void resetEventRateGraph();
 
+  /// rate and channel occupancy from the online monitor,
+  /// replace the rate computed from the displayed events
+  void setMonitorData(double aTime, double aRate, double aDeadTimeFraction,
+		      const std::vector<double> & aChannelOccupancy);
+
+  /// redraws the monitor pad of the raw histograms only
+  void drawMonitorHistos(TCanvas *aCanvas);
+
   void drawRawHistos(TCanvas *aCanvas, bool isRateDisplayOn);
 
   void drawRecoHistos(TCanvas *aCanvas);
@@ -72,6 +82,21 @@ public:
 
   void reconstruct();
 
+  /// installs background reconstruction of the displayed event, if finished,
+  /// and emits reconstructionReady(); to be called periodically by the GUI thread
+  void publishReconstruction();
+
+  void reconstructionReady(); // *SIGNAL*
+
+  /// background reconstruction of display.recoLookahead entries following iEntry
+  void prefetch(unsigned long int iEntry);
+
+  /// drops (background) reconstruction results, e.g. after change of run conditions
+  void resetReconstruction();
+
+  /// drops histograms prepared for display of already visited events
+  void clearHistoCache();
+
   void reconstructSegmentsFromMarkers(std::vector<double> * segmentsXY);
 
   TGraph* getEventRateGraph();
@@ -110,19 +135,32 @@ public:
 
   void updateEventRateGraph();
 
+  void drawEventRate(TVirtualPad *aPad);
+
   void makeAutozoom(TH1 * aHisto);
 
+  HistoCache::Key getHistoCacheKey(HistoCache::histo_kind kind, int param1, int param2, int param3=0) const;
+
   void setDetLayout();
   void setDetLayoutVetoBand(double distance); // [mm]
 
   boost::property_tree::ptree myConfig;
+  EventTPC::HitFilterParameters myHitFilterParameters;
 
   IonRangeCalculator myRangeCalculator;
   std::vector<TH2D*> projectionsInCartesianCoords;
   TH3D *h3DReco{0};
   TGraph *grEventRate{0};
-  TrackBuilder myTkBuilder;
+  TH1D *hChannelOccupancy{0};
+  bool isMonitorOn{false};
+  std::unique_ptr<TrackBuilder> myTkBuilder{new TrackBuilder()};
+  BackgroundReconstruction myBackgroundReco;
+  BackgroundReconstruction::EventKey myEventKey{-1, 0};
+  bool isBackgroundRecoOn{false};
+  bool isRecoDone{false};
+  bool isRecoPending{false};
   RecoOutput myRecoOutput;
+  HistoCache myHistoCache;
 
   std::shared_ptr<EventTPC> myEventPtr;
   eventraw::EventInfo myEventInfo;
@@ -23,6 +23,7 @@
 #include <TCanvas.h>
 #include <TObject.h>
 #include <TClass.h>
+#include <TTimer.h>
 
 #include <TLine.h>
 #include <TArrow.h>
@@ -39,6 +40,7 @@
 #include <boost/property_tree/json_parser.hpp>
 
 class EventSourceBase;
+class GrawMonitor;
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 class MainFrame : public TGMainFrame {
@@ -63,6 +65,11 @@ public:
 
 	void DoButton();
 
+	void CheckReconstruction();
+	void HandleReconstruction();
+
+	void UpdateMonitor();
+
 private:
 
 	void InitializeEventSource();
@@ -100,12 +107,15 @@ private:
 
 	std::thread fileWatchThread;
 	std::mutex myMutex;
+	std::shared_ptr<GrawMonitor> myMonitor; // online rate and occupancy
 
 	TGCompositeFrame* fFrame{ 0 };
 	TRootEmbeddedCanvas* embeddedCanvas{ 0 };
 	TCanvas* fMainCanvas{ 0 };
 	TCanvas* fRawHistosCanvas{ 0 };
 	TCanvas* fTechHistosCanvas{ 0 };
+	TTimer* fRecoTimer{ 0 }; // polls background reconstruction
+	TTimer* fMonitorTimer{ 0 }; // refreshes online monitor plots
 	TGMenuBar* fMenuBar{ 0 };
 	TGPopupMenu* fMenuFile{ 0 }, * fMenuHelp{ 0 };
 
@@ -0,0 +1,212 @@
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+#include <TROOT.h>
+#include <TDirectory.h>
+
+#include "TPCReco/EventTPC.h"
+#include "TPCReco/EventSourceBase.h"
+#include "TPCReco/EventSourceFactory.h"
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/colorText.h"
+
+#include "TPCReco/BackgroundReconstruction.h"
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+BackgroundReconstruction::~BackgroundReconstruction(){
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    isStopped = true;
+    isCancelled = true;
+    myJobs.clear();
+  }
+  myCondition.notify_all();
+  if(myWorker.joinable()) myWorker.join();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::setConfig(const boost::property_tree::ptree &aConfig){
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  myConfig = aConfig;
+  myHitFilterParameters = EventTPC::getHitFilterParameters(myConfig);
+  myMaxResults = myConfig.get<unsigned int>("display.recoLookahead", 2) + 2;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::setGeometry(std::shared_ptr<GeometryTPC> aGeometryPtr){
+
+  clear();
+  std::lock_guard<std::mutex> lock(myMutex);
+  myGeometryPtr = aGeometryPtr;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::setPressure(double aPressure){
+
+  clear();
+  std::lock_guard<std::mutex> lock(myMutex);
+  myPressure = aPressure;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+BackgroundReconstruction::EventKey BackgroundReconstruction::getKey(const EventTPC & aEvent){
+
+  return EventKey(aEvent.GetEventInfo().GetRunId(), aEvent.GetEventInfo().GetEventId());
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::submit(std::shared_ptr<EventTPC> aEvent){
+
+  if(!aEvent) return;
+  auto key = getKey(*aEvent);
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myJobs.clear(); // speculative work is queued again by prefetch()
+    if(myResults.count(key)) return;
+    if(isRunningKeyValid && myRunningKey==key) return;
+    isCancelled = true; // whatever is running now is not needed
+    Job aJob;
+    aJob.event = std::make_shared<EventTPC>(*aEvent);
+    myJobs.push_back(aJob);
+  }
+  start();
+  myCondition.notify_one();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::prefetch(unsigned long int iEntry, unsigned int nEntries){
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    for(unsigned long int aEntry=iEntry+1; aEntry<=iEntry+nEntries; ++aEntry){
+      auto it = myEntryKeys.find(aEntry);
+      if(it!=myEntryKeys.end() &&
+	 (myResults.count(it->second) || (isRunningKeyValid && myRunningKey==it->second))) continue;
+      auto isQueued = std::any_of(myJobs.begin(), myJobs.end(),
+				  [aEntry](const Job & aJob){ return aJob.entry==(long int)aEntry; });
+      if(isQueued) continue;
+      Job aJob;
+      aJob.entry = aEntry;
+      myJobs.push_back(aJob);
+    }
+    if(myJobs.empty()) return;
+  }
+  start();
+  myCondition.notify_one();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+std::unique_ptr<TrackBuilder> BackgroundReconstruction::take(const EventKey & aKey){
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  auto it = myResults.find(aKey);
+  if(it==myResults.end()) return nullptr;
+  auto aBuilder = std::move(it->second);
+  myResults.erase(it);
+  myResultsOrder.erase(std::remove(myResultsOrder.begin(), myResultsOrder.end(), aKey), myResultsOrder.end());
+  return aBuilder;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::clear(){
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  myJobs.clear();
+  myResults.clear();
+  myResultsOrder.clear();
+  isCancelled = true;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::start(){
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  if(myWorker.joinable() || isStopped) return;
+  ROOT::EnableThreadSafety();
+  myWorker = std::thread(&BackgroundReconstruction::run, this);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::storeResult(const EventKey & aKey, std::unique_ptr<TrackBuilder> aBuilder){
+
+  myResults[aKey] = std::move(aBuilder);
+  myResultsOrder.push_back(aKey);
+  while(myResultsOrder.size()>myMaxResults){
+    myResults.erase(myResultsOrder.front());
+    myResultsOrder.pop_front();
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+std::shared_ptr<EventTPC> BackgroundReconstruction::loadEntry(unsigned long int iEntry,
+								std::shared_ptr<GeometryTPC> aGeometryPtr){
+
+  boost::property_tree::ptree aConfig;
+  EventTPC::HitFilterParameters aHitFilterParameters;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    if(!myPrefetchSource) aConfig = myConfig; // the full tree is needed only once
+    aHitFilterParameters = myHitFilterParameters;
+  }
+  if(!myPrefetchSource){
+    myPrefetchSource = EventSourceFactory::makeEventSourceObject(aConfig);
+  }
+  if(!myPrefetchSource || iEntry>=myPrefetchSource->numberOfEntries()) return nullptr;
+  myPrefetchSource->loadFileEntry(iEntry);
+  auto aEvent = std::make_shared<EventTPC>(*myPrefetchSource->getCurrentEvent());
+  aEvent->SetGeoPtr(aGeometryPtr); // run conditions set in the GUI
+  aEvent->setHitFilterParameters(filter_type::threshold, aHitFilterParameters);
+  return aEvent;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void BackgroundReconstruction::run(){
+
+  TDirectory::TContext context(nullptr); // histograms of this thread are not attached to gROOT
+
+  std::shared_ptr<GeometryTPC> aGeometryPtr;
+  double aPressure = -1;
+  while(true){
+    Job aJob;
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+      myCondition.wait(lock, [this](){ return isStopped || !myJobs.empty(); });
+      if(isStopped) return;
+      aJob = myJobs.front();
+      myJobs.pop_front();
+      isCancelled = false;
+      isRunningKeyValid = false;
+      aGeometryPtr = myGeometryPtr;
+      aPressure = myPressure;
+    }
+    auto aEvent = aJob.event;
+    if(!aEvent) aEvent = loadEntry(aJob.entry, aGeometryPtr);
+    if(!aEvent) continue;
+
+    auto key = getKey(*aEvent);
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      if(aJob.entry>=0) myEntryKeys[aJob.entry] = key;
+      if(isCancelled || myResults.count(key)) continue;
+      myRunningKey = key;
+      isRunningKeyValid = true;
+    }
+    std::unique_ptr<TrackBuilder> aBuilder(new TrackBuilder());
+    aBuilder->setGeometry(aGeometryPtr);
+    if(aPressure>0) aBuilder->setPressure(aPressure);
+    aBuilder->setEvent(aEvent);
+    aBuilder->setCancelFlag(&isCancelled);
+    if(aEvent->GetEventInfo().GetPedestalSubtracted()) aBuilder->reconstruct();
+    aBuilder->setCancelFlag(nullptr);
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      isRunningKeyValid = false;
+      if(!isCancelled) storeResult(key, std::move(aBuilder));
+    }
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
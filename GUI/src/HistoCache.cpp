@@ -0,0 +1,64 @@
+#include <TH1.h>
+
+#include "TPCReco/HistoCache.h"
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoCache::setMaxBytes(size_t aMaxBytes){
+
+  myMaxBytes = aMaxBytes;
+  shrink(myMaxBytes);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+size_t HistoCache::estimateBytes(const TH1 & aHisto){
+
+  size_t nArrays = 1 + (aHisto.GetSumw2N()>0);
+  return sizeof(TH1) + aHisto.GetNcells()*nArrays*sizeof(double);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+std::shared_ptr<TH1> HistoCache::get(const Key & aKey){
+
+  auto it = myIndex.find(aKey);
+  if(it==myIndex.end()) return nullptr;
+  myItems.splice(myItems.begin(), myItems, it->second);
+  return it->second->histo;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoCache::put(const Key & aKey, std::shared_ptr<TH1> aHisto){
+
+  if(!aHisto) return;
+  size_t aBytes = estimateBytes(*aHisto);
+  if(aBytes>myMaxBytes) return;
+  auto it = myIndex.find(aKey);
+  if(it!=myIndex.end()){
+    myBytes -= it->second->bytes;
+    myItems.erase(it->second);
+    myIndex.erase(it);
+  }
+  shrink(myMaxBytes - aBytes);
+  myItems.push_front({aKey, aHisto, aBytes});
+  myIndex[aKey] = myItems.begin();
+  myBytes += aBytes;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoCache::clear(){
+
+  myItems.clear();
+  myIndex.clear();
+  myBytes = 0;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoCache::shrink(size_t aMaxBytes){
+
+  while(!myItems.empty() && myBytes>aMaxBytes){
+    myBytes -= myItems.back().bytes;
+    myIndex.erase(myItems.back().key);
+    myItems.pop_back();
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
@@ -34,20 +34,26 @@ HistoManager::HistoManager() {
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
-HistoManager::~HistoManager() { }
+HistoManager::~HistoManager() {
+
+  delete hChannelOccupancy;
+}
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 void HistoManager::setGeometry(std::shared_ptr<GeometryTPC> aGeometryPtr){
   
   myGeometryPtr = aGeometryPtr;
-  myTkBuilder.setGeometry(aGeometryPtr);
+  myTkBuilder->setGeometry(aGeometryPtr);
+  myBackgroundReco.setGeometry(aGeometryPtr);
+  myHistoCache.clear();
   setDetLayout();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 void HistoManager::setPressure(double aPressure){
   
-  myTkBuilder.setPressure(aPressure);
+  myTkBuilder->setPressure(aPressure);
+  myBackgroundReco.setPressure(aPressure);
   myRangeCalculator.setGasPressure(aPressure);
 }
 /////////////////////////////////////////////////////////
@@ -55,7 +61,11 @@ void HistoManager::setPressure(double aPressure){
 void HistoManager::setConfig(const boost::property_tree::ptree &aConfig){
   
   myConfig = aConfig;
-
+  myHitFilterParameters = EventTPC::getHitFilterParameters(myConfig);
+  isBackgroundRecoOn = myConfig.get<bool>("display.backgroundReco", false);
+  myBackgroundReco.setConfig(myConfig);
+  myHistoCache.clear(); // hit filter settings may change
+  myHistoCache.setMaxBytes(myConfig.get<size_t>("display.histoCacheSize", 200)*1024*1024);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -70,19 +80,81 @@ void HistoManager::setEvent(std::shared_ptr<EventTPC> aEvent){
   
   if(!aEvent) return;
   myEventPtr = aEvent;
-  myEventPtr->setHitFilterConfig(filter_type::threshold, myConfig);
-  myTkBuilder.setEvent(myEventPtr);
+  myEventPtr->setHitFilterParameters(filter_type::threshold, myHitFilterParameters);
+  auto eventKey = BackgroundReconstruction::getKey(*myEventPtr);
+  if(isBackgroundRecoOn && isRecoDone && eventKey==myEventKey) return; // redraw of the same event
+  myEventKey = eventKey;
+  isRecoDone = false;
+  isRecoPending = false;
+  myTkBuilder->setEvent(myEventPtr);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 void HistoManager::reconstruct(){
-  if(myEventPtr->GetEventInfo().GetPedestalSubtracted()) myTkBuilder.reconstruct();
+
+  if(!myEventPtr->GetEventInfo().GetPedestalSubtracted()) return;
+  if(!isBackgroundRecoOn){
+    myTkBuilder->reconstruct();
+    return;
+  }
+  if(isRecoDone) return;
+  auto aTkBuilder = myBackgroundReco.take(myEventKey);
+  if(aTkBuilder){ // already reconstructed, e.g. speculatively
+    myTkBuilder = std::move(aTkBuilder);
+    isRecoDone = true;
+    isRecoPending = false;
+    return;
+  }
+  // event is drawn without reconstruction, reconstructionReady() is emitted when it is done
+  myBackgroundReco.submit(myEventPtr);
+  isRecoPending = true;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::publishReconstruction(){
+
+  if(!isRecoPending) return;
+  auto aTkBuilder = myBackgroundReco.take(myEventKey);
+  if(!aTkBuilder) return;
+  myTkBuilder = std::move(aTkBuilder);
+  isRecoDone = true;
+  isRecoPending = false;
+  reconstructionReady();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::reconstructionReady(){
+
+  Emit("reconstructionReady()");
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::prefetch(unsigned long int iEntry){
+
+  if(!isBackgroundRecoOn || !myConfig.get<bool>("display.develMode")) return; // no reconstruction in other modes
+  myBackgroundReco.prefetch(iEntry, myConfig.get<unsigned int>("display.recoLookahead", 2));
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::resetReconstruction(){
+
+  myBackgroundReco.clear();
+  isRecoDone = false;
+  isRecoPending = false;
+  if(myEventPtr) myTkBuilder->setEvent(myEventPtr);
+  clearHistoCache();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::clearHistoCache(){
+
+  myHistoCache.clear();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 void HistoManager::reconstructSegmentsFromMarkers(std::vector<double> * segmentsXY){
 
-  myTkBuilder.getSegment2DCollectionFromGUI(*segmentsXY);
+  myTkBuilder->getSegment2DCollectionFromGUI(*segmentsXY);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -111,7 +183,7 @@ void HistoManager::drawRawHistos(TCanvas *aCanvas, bool isRateDisplayOn){
   aCanvas->Modified();
   aCanvas->Update();
   if(isRateDisplayOn){
-    fObjClones.push_back(getEventRateGraph()->DrawClone("AP"));
+    drawEventRate(aPad);
   } else{
     get1DProjection(definitions::projection_type::DIR_TIME, filter_type::none, scale_type::raw)->DrawCopy("hist");
   }
@@ -362,12 +434,17 @@ std::shared_ptr<TH1D> HistoManager::get1DProjection(definitions::projection_type
 						    filter_type filterType,
 						    scale_type scaleType){
   
+  auto key = getHistoCacheKey(HistoCache::projection1D, (int)projType, (int)filterType, (int)scaleType);
+  auto aCachedHisto = myHistoCache.get(key);
+  if(aCachedHisto) return std::static_pointer_cast<TH1D>(aCachedHisto);
+  
   auto aHisto = myEventPtr->get1DProjection(projType, filterType, scaleType);
   if(aHisto) {
     if(doAutozoom) makeAutozoom(aHisto.get());
     aHisto->GetXaxis()->SetTitleOffset(1.5);
     aHisto->GetYaxis()->SetTitleOffset(1.6);
     aHisto->SetDrawOption("HIST0");
+    myHistoCache.put(key, aHisto);
   }
   return aHisto;
 }
@@ -377,6 +454,10 @@ std::shared_ptr<TH2D> HistoManager::get2DProjection(definitions::projection_type
 						    filter_type filterType,
 						    scale_type scaleType){
 
+  auto key = getHistoCacheKey(HistoCache::projection2D, (int)projType, (int)filterType, (int)scaleType);
+  auto aCachedHisto = myHistoCache.get(key);
+  if(aCachedHisto) return std::static_pointer_cast<TH2D>(aCachedHisto);
+
   auto aHisto = myEventPtr->get2DProjection(projType, filterType, scaleType);
   if(aHisto) {
     if(doAutozoom) makeAutozoom(aHisto.get());
@@ -384,25 +465,41 @@ std::shared_ptr<TH2D> HistoManager::get2DProjection(definitions::projection_type
     aHisto->GetYaxis()->SetTitleOffset(1.5);
     aHisto->GetZaxis()->SetTitleOffset(1.5);
     aHisto->SetDrawOption("COLZ");
+    myHistoCache.put(key, aHisto);
   }
   return aHisto;
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 std::shared_ptr<TH2D> HistoManager::getChannels(int cobo_id, int asad_id){
+
+  auto key = getHistoCacheKey(HistoCache::channels, cobo_id, asad_id);
+  auto aCachedHisto = myHistoCache.get(key);
+  if(aCachedHisto) return std::static_pointer_cast<TH2D>(aCachedHisto);
+  
   auto aHisto=std::shared_ptr<TH2D>(myEventPtr->GetChannels(cobo_id, asad_id));
   if(aHisto) {
     aHisto->GetXaxis()->SetTitleOffset(1.5);
     aHisto->GetYaxis()->SetTitleOffset(1.5);
     aHisto->GetZaxis()->SetTitleOffset(1.5);
     aHisto->SetDrawOption("COLZ");
+    myHistoCache.put(key, aHisto);
   }
   return aHisto;
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+HistoCache::Key HistoManager::getHistoCacheKey(HistoCache::histo_kind kind,
+					       int param1, int param2, int param3) const{
+
+  const auto & aInfo = myEventPtr->GetEventInfo();
+  return HistoCache::Key{aInfo.GetRunId(), aInfo.GetEventId(), aInfo.GetEventTimestamp(),
+			 doAutozoom, kind, param1, param2, param3};
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 std::shared_ptr<TH2D> HistoManager::getRecHitStripVsTime(int strip_dir){
-  TH2D *h = (TH2D*)myTkBuilder.getRecHits2D(strip_dir).Clone("hRecHitStripVsTime");
+  TH2D *h = (TH2D*)myTkBuilder->getRecHits2D(strip_dir).Clone("hRecHitStripVsTime");
   std::shared_ptr<TH2D> aHisto(h);
   if(aHisto) {
     if(doAutozoom) makeAutozoom(aHisto.get());
@@ -418,7 +515,7 @@ std::shared_ptr<TH2D> HistoManager::getRecHitStripVsTime(int strip_dir){
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 std::shared_ptr<TH1D> HistoManager::getRecHitTimeProjection(){
-  TH1D *h = (TH1D*)myTkBuilder.getRecHitsTimeProjection().Clone("hRecHitTimeProjection");
+  TH1D *h = (TH1D*)myTkBuilder->getRecHitsTimeProjection().Clone("hRecHitTimeProjection");
   auto aHisto=std::shared_ptr<TH1D>(h);
   if(doAutozoom) makeAutozoom(aHisto.get());
   aHisto->SetLineColor(2);
@@ -428,7 +525,7 @@ std::shared_ptr<TH1D> HistoManager::getRecHitTimeProjection(){
 /////////////////////////////////////////////////////////
 const TH2D & HistoManager::getHoughAccumulator(int strip_dir, int iPeak){
 
-  return myTkBuilder.getHoughtTransform(strip_dir);
+  return myTkBuilder->getHoughtTransform(strip_dir);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -446,7 +543,7 @@ void HistoManager::drawTrack3D(TVirtualPad *aPad){
   TVirtualViewer3D * view3D = aPad->GetViewer3D("pad");
   view3D->BeginScene();
   
-  const Track3D & aTrack3D = myTkBuilder.getTrack3D(0);
+  const Track3D & aTrack3D = myTkBuilder->getTrack3D(0);
   const TrackSegment3DCollection & trackSegments = aTrack3D.getSegments();
   if(!trackSegments.size()) return;
   
@@ -525,7 +622,7 @@ void HistoManager::drawTrack3DProjectionXY(TVirtualPad *aPad){
   aPad->SetLogz(kFALSE);
   drawDetLayout();
   
-  const Track3D & aTrack3D = myTkBuilder.getTrack3D(0);
+  const Track3D & aTrack3D = myTkBuilder->getTrack3D(0);
 
   int iSegment = 0;
   TLine aSegment2DLine;
@@ -544,7 +641,7 @@ void HistoManager::drawTrack3DProjectionXY(TVirtualPad *aPad){
 /////////////////////////////////////////////////////////
 void HistoManager::drawTrack2DSeed(int strip_dir, TVirtualPad *aPad){
 
-  const TrackSegment2D & aSegment2D = myTkBuilder.getSegment2D(strip_dir);
+  const TrackSegment2D & aSegment2D = myTkBuilder->getSegment2D(strip_dir);
   const TVector3 & start = aSegment2D.getStart();
   const TVector3 & end = aSegment2D.getEnd();
 
@@ -559,7 +656,7 @@ void HistoManager::drawTrack2DSeed(int strip_dir, TVirtualPad *aPad){
 void HistoManager::drawTrack3DProjectionTimeStrip(int strip_dir, TVirtualPad *aPad,  bool zoomIn){
 
   aPad->cd();
-  const Track3D & aTrack3D = myTkBuilder.getTrack3D(0);
+  const Track3D & aTrack3D = myTkBuilder->getTrack3D(0);
 
   int iSegment = 0;
   TLine aSegment2DLine;
@@ -617,7 +714,7 @@ void HistoManager::drawChargeAlongTrack3D(TVirtualPad *aPad){
 
   aPad->cd();
 
-  const Track3D & aTrack3D = myTkBuilder.getTrack3D(0);
+  const Track3D & aTrack3D = myTkBuilder->getTrack3D(0);
   if(aTrack3D.getLength()<1) return;
   
   TH1F hFrame("hFrame",";d [mm];charge [arb. units]",2,-20, 20+aTrack3D.getLength());
@@ -649,7 +746,7 @@ void HistoManager::drawChargeAlongTrack3D(TVirtualPad *aPad){
   TLegend *aLegend = new TLegend(0.7, 0.75, 0.95,0.95);
   fObjClones.push_back(aLegend);
   
-  TF1 dEdx = myTkBuilder.getdEdx();
+  TF1 dEdx = myTkBuilder->getdEdx();
   if(!dEdx.GetNpar()) return;
   //////// HACK by MC - for prettier HistoManager::drawDevelHistos (1/04/2023)
   const double points_per_mm = 100;
@@ -744,7 +841,7 @@ void HistoManager::writeRecoData(unsigned long eventType){
 
   myEventInfo = myEventPtr->GetEventInfo(); 
   myEventInfo.SetEventType(eventType);				   
-  myRecoOutput.setRecTrack(myTkBuilder.getTrack3D(0));
+  myRecoOutput.setRecTrack(myTkBuilder->getTrack3D(0));
   myRecoOutput.setEventInfo(myEventInfo);				   
   myRecoOutput.update();  
 }
@@ -762,6 +859,7 @@ void HistoManager::updateEventRateGraph(){
     grEventRate->GetYaxis()->SetTitleOffset(1.5);
     grEventRate->GetXaxis()->SetNdivisions(5);
   }
+  if(isMonitorOn) return; // filled by setMonitorData()
   Long64_t currentEventTime = myEventPtr->GetEventInfo().GetEventTimestamp()*1E-8;//[s]
   Long64_t currentEventNumber = myEventPtr->GetEventInfo().GetEventId();  
   if(previousEventTime<0 || previousEventNumber>currentEventNumber){
@@ -794,6 +892,62 @@ void HistoManager::resetEventRateGraph(){
    grEventRate->Set(0);
   }
 }
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::setMonitorData(double aTime, double aRate, double aDeadTimeFraction,
+				  const std::vector<double> & aChannelOccupancy){
+
+  isMonitorOn = true;
+  updateEventRateGraph();
+  int nPoints = grEventRate->GetN();
+  if(nPoints==0 || aTime>grEventRate->GetX()[nPoints-1]){
+    grEventRate->SetPoint(nPoints, aTime, aRate);
+  }
+  grEventRate->SetTitle(Form("Rate: %.1f Hz, dead time: %.1f%%", aRate, 100*aDeadTimeFraction));
+
+  int nChannels = aChannelOccupancy.size();
+  if(!hChannelOccupancy || hChannelOccupancy->GetNbinsX()!=nChannels){
+    delete hChannelOccupancy;
+    hChannelOccupancy = new TH1D("hChannelOccupancy","Channel occupancy;CoBo/AsAd/AGET/channel index;Fraction of events",
+				 nChannels, -0.5, nChannels-0.5);
+    hChannelOccupancy->SetDirectory(0);
+    hChannelOccupancy->SetStats(false);
+  }
+  for(int iChannel=0;iChannel<nChannels;++iChannel){
+    hChannelOccupancy->SetBinContent(iChannel+1, aChannelOccupancy[iChannel]);
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::drawEventRate(TVirtualPad *aPad){
+
+  if(isMonitorOn && hChannelOccupancy){
+    aPad->Divide(1,2);
+    aPad->cd(1);
+    fObjClones.push_back(getEventRateGraph()->DrawClone("AP"));
+    aPad->cd(2);
+    hChannelOccupancy->DrawCopy("hist");
+    aPad->cd();
+  }
+  else fObjClones.push_back(getEventRateGraph()->DrawClone("AP"));
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void HistoManager::drawMonitorHistos(TCanvas *aCanvas){
+
+  if(!aCanvas) return;
+  int padNumberOffset = 0;
+  if(std::string(aCanvas->GetName())=="fRawHistosCanvas") padNumberOffset = 100;
+  int strip_dir=3;
+  TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+strip_dir+1);
+  if(!aPad) return;
+  aPad->Clear();
+  aPad->cd();
+  drawEventRate(aPad);
+  aPad->Modified();
+  aCanvas->Modified();
+  aCanvas->Update();
+}
 /*
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
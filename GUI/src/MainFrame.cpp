@@ -25,6 +25,9 @@
 #include <TProfile.h>
 
 #include "TPCReco/EventSourceFactory.h"
+#ifdef WITH_GET
+#include "TPCReco/GrawMonitor.h"
+#endif
 
 #include <TGButtonGroup.h>
 #include <TGButton.h>
@@ -59,7 +62,10 @@ MainFrame::MainFrame(const TGWindow* p, UInt_t w, UInt_t h, const boost::propert
 /////////////////////////////////////////////////////////
 MainFrame::~MainFrame() {
 
-	fileWatchThread.join();
+	myDirWatch.stop();
+	if (fileWatchThread.joinable()) fileWatchThread.join();
+	delete fRecoTimer;
+	delete fMonitorTimer;
 	// Delete all created widgets.
 	delete fMenuFile;
 	delete fMenuHelp;
@@ -107,10 +113,27 @@ void MainFrame::InitializeEventSource() {
 	bool onlineFlag = myConfig.get<bool>("transient.onlineFlag");
 
 	if (onlineFlag) {
-		fileWatchThread = std::thread(&DirectoryWatch::watch, &myDirWatch, dataFileName);
 		int updateInterval = myConfig.get<int>("online.updateInterval");
 		myDirWatch.setUpdateInterval(updateInterval);
+		fileWatchThread = std::thread(&DirectoryWatch::watch, &myDirWatch, dataFileName);
 		myDirWatch.Connect("Message(const char *)", "MainFrame", this, "ProcessMessage(const char *)");
+#ifdef WITH_GET
+		if (myConfig.get<bool>("online.monitor", true)) {
+			auto aGeometry = myEventSource->getGeometry();
+			// one bin per second, every bin holds a counter per channel
+			int monitorWindow = myConfig.get<int>("online.monitorWindow", 10);
+			if (monitorWindow < 1 || monitorWindow > 3600) {
+				std::cout << KRED << "Invalid online.monitorWindow: " << RST << monitorWindow
+						  << KRED << " s, allowed range is 1-3600 s. Using 10 s." << RST << std::endl;
+				monitorWindow = 10;
+			}
+			myMonitor = std::make_shared<GrawMonitor>(aGeometry->GetAsadNboards(0), aGeometry->GetCoboNboards(),
+													  1.0, monitorWindow);
+			fMonitorTimer = new TTimer(myConfig.get<int>("online.monitorRefresh", 1000));
+			fMonitorTimer->Connect("Timeout()", "MainFrame", this, "UpdateMonitor()");
+			fMonitorTimer->TurnOn();
+		}
+#endif
 	}
 
 	if (eventSourceType == event_type::EventSourceROOT) {
@@ -131,6 +154,13 @@ void MainFrame::InitializeEventSource() {
 
 	if (isRecoModeOn) myHistoManager.openOutputStream(dataFileName);
 	myEventSource->getEventFilter().setConditions(myConfig);
+
+	if (myConfig.get<bool>("display.backgroundReco", false)) {
+		myHistoManager.Connect("reconstructionReady()", "MainFrame", this, "HandleReconstruction()");
+		fRecoTimer = new TTimer(100);
+		fRecoTimer->Connect("Timeout()", "MainFrame", this, "CheckReconstruction()");
+		fRecoTimer->TurnOn();
+	}
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -538,6 +568,39 @@ void MainFrame::Update() {
 	else if(myConfig.get<bool>("display.develMode")) myHistoManager.drawDevelHistos(fMainCanvas);
 	else if(myConfig.get<bool>("display.technicalMode")) myHistoManager.drawTechnicalHistos(fMainCanvas, myEventSource->getGeometry()->GetAgetNchips());
 	else myHistoManager.drawRawHistos(fMainCanvas, isRateDisplayOn);
+
+	if (myWorkMode != M_ONLINE_GRAW_MODE && myWorkMode != M_ONLINE_NGRAW_MODE) {
+		myHistoManager.prefetch(myEventSource->currentEntryNumber());
+	}
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void MainFrame::CheckReconstruction() {
+
+	myHistoManager.publishReconstruction();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void MainFrame::UpdateMonitor() {
+
+#ifdef WITH_GET
+	if (!myMonitor) return;
+	GrawMonitor::Snapshot aSnapshot = myMonitor->getSnapshot();
+	if (!aSnapshot.nEvents) return;
+	myHistoManager.setMonitorData(aSnapshot.time, aSnapshot.rate, aSnapshot.deadTimeFraction,
+								  aSnapshot.channelOccupancy);
+	if (!isRateDisplayOn || isRecoModeOn ||
+		myConfig.get<bool>("display.develMode") ||
+		myConfig.get<bool>("display.technicalMode")) return;
+	std::lock_guard<std::mutex> lock(myMutex);
+	myHistoManager.drawMonitorHistos(fMainCanvas);
+#endif
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void MainFrame::HandleReconstruction() {
+
+	Update();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -603,6 +666,7 @@ void MainFrame::updateRunConditions(std::vector<double>* runParams) {
 	myEventSource->getGeometry()->setSamplingRate(runParams->at(1));
 	myEventSource->getGeometry()->setTriggerDelay(runParams->at(2));
 	std::cout << myEventSource->getGeometry()->getRunConditions() << _endl_;
+	myHistoManager.resetReconstruction();
 	if (isRecoModeOn) {
 		ClearCanvases();
 		Update();
@@ -650,6 +714,9 @@ Bool_t MainFrame::ProcessMessage(const char* msg) {
 
 #ifdef DEBUG
 	std::cout << __FUNCTION__ << " msg: " << msg << _endl_;
+#endif
+#ifdef WITH_GET
+	if (myMonitor) myMonitor->notify(std::string(msg));
 #endif
 	myMutex.lock();
 	myEventSource->loadDataFile(std::string(msg));
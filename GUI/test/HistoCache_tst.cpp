@@ -0,0 +1,130 @@
+#include "TPCReco/HistoCache.h"
+#include "gtest/gtest.h"
+#include <TH1D.h>
+#include <TH2D.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+class HistoCacheTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() { TH1::AddDirectory(false); }
+
+  static HistoCache::Key makeKey(unsigned int eventId, int param1 = 0, int param2 = 0, int param3 = 0) {
+    return HistoCache::Key{7, eventId, 1000ULL * eventId, false, HistoCache::projection2D, param1, param2, param3};
+  }
+
+  static std::shared_ptr<TH1> makeHisto(int nbins = 100) {
+    return std::make_shared<TH2D>("h", "", nbins, 0, 1, nbins, 0, 1);
+  }
+
+  // display.histoCacheSize is given in MB
+  static const size_t megabyte = 1024 * 1024;
+};
+
+TEST_F(HistoCacheTest, HitAndMiss) {
+  HistoCache cache;
+  cache.setMaxBytes(200 * megabyte);
+  const auto key = makeKey(1);
+  EXPECT_FALSE(cache.get(key));
+  auto histo = makeHisto();
+  cache.put(key, histo);
+  EXPECT_EQ(cache.get(key), histo);
+  EXPECT_FALSE(cache.get(makeKey(2)));
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.getBytes(), HistoCache::estimateBytes(*histo));
+
+  // replacing histogram for the same key
+  auto other = makeHisto(50);
+  cache.put(key, other);
+  EXPECT_EQ(cache.get(key), other);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.getBytes(), HistoCache::estimateBytes(*other));
+
+  cache.put(makeKey(2), nullptr);
+  EXPECT_EQ(cache.size(), 1u);
+
+  cache.clear();
+  EXPECT_FALSE(cache.get(key));
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.getBytes(), 0u);
+}
+
+TEST_F(HistoCacheTest, DisabledByZeroSize) {
+  HistoCache cache; // nothing is cached until the limit is set
+  cache.put(makeKey(1), makeHisto());
+  EXPECT_FALSE(cache.get(makeKey(1)));
+  cache.setMaxBytes(0);
+  cache.put(makeKey(1), makeHisto());
+  EXPECT_FALSE(cache.get(makeKey(1)));
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(HistoCacheTest, LeastRecentlyUsedEvicted) {
+  const auto histoBytes = HistoCache::estimateBytes(*makeHisto(200)); // ~320 kB
+  const size_t maxBytes = 1 * megabyte;
+  const size_t capacity = maxBytes / histoBytes;
+  ASSERT_GE(capacity, 2u);
+
+  HistoCache cache;
+  cache.setMaxBytes(maxBytes);
+  std::vector<std::shared_ptr<TH1>> histos;
+  for (auto i = 0u; i < capacity; i++) {
+    histos.push_back(makeHisto(200));
+    cache.put(makeKey(i), histos.back());
+  }
+  EXPECT_EQ(cache.size(), capacity);
+  EXPECT_LE(cache.getBytes(), maxBytes);
+
+  // event 0 is used again, event 1 becomes the least recently used one
+  EXPECT_EQ(cache.get(makeKey(0)), histos[0]);
+  cache.put(makeKey(capacity), makeHisto(200));
+  EXPECT_EQ(cache.size(), capacity);
+  EXPECT_LE(cache.getBytes(), maxBytes);
+  EXPECT_EQ(cache.get(makeKey(0)), histos[0]);
+  EXPECT_FALSE(cache.get(makeKey(1)));
+  for (auto i = 2u; i < capacity; i++) {
+    EXPECT_EQ(cache.get(makeKey(i)), histos[i]);
+  }
+  EXPECT_TRUE(cache.get(makeKey(capacity)));
+
+  // histogram above the limit is not stored and does not evict anything
+  cache.put(makeKey(100), makeHisto(400));
+  EXPECT_FALSE(cache.get(makeKey(100)));
+  EXPECT_EQ(cache.size(), capacity);
+
+  // lowering the limit drops the least recently used histograms
+  cache.setMaxBytes(histoBytes);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.getBytes(), histoBytes);
+  EXPECT_TRUE(cache.get(makeKey(capacity)));
+}
+
+TEST_F(HistoCacheTest, KeyDiscrimination) {
+  HistoCache cache;
+  cache.setMaxBytes(200 * megabyte);
+  const auto key = makeKey(1, 2, 3, 4); // projection, filter, scale
+  auto histo = makeHisto(10);
+  cache.put(key, histo);
+
+  std::vector<HistoCache::Key> others(8, key);
+  others[0].runId++;
+  others[1].eventId++;
+  others[2].timestamp++;
+  others[3].autozoom = !key.autozoom;
+  others[4].kind = HistoCache::projection1D;
+  others[5].param1++; // projection type or CoBo id
+  others[6].param2++; // filter type or AsAd id
+  others[7].param3++; // scale type
+  for (auto i = 0u; i < others.size(); i++) {
+    EXPECT_FALSE(cache.get(others[i])) << "key field " << i;
+    cache.put(others[i], makeHisto(10));
+  }
+  EXPECT_EQ(cache.size(), others.size() + 1);
+  EXPECT_EQ(cache.get(key), histo);
+  for (auto i = 0u; i < others.size(); i++) {
+    auto cached = cache.get(others[i]);
+    EXPECT_TRUE(cached);
+    EXPECT_NE(cached, histo);
+  }
+}
@@ -21,6 +21,11 @@ public:
 		    size_t frameOffset, GET::GDataFrame & dataFrame,
 		    bool readFullEvent);
 
+  /// full CoBo frame starting at byteOffset of the file,
+  /// the preceding frames are not scanned
+  bool getGrawFrameAt(const std::string & filePath,
+		      std::streamoff byteOffset, GET::GDataFrame & dataFrame);
+
   //size_t getGrawFramesNumber(const std::string & filePath);
 
 private:
@@ -33,6 +38,10 @@ private:
   bool getGrawFrameFull(const std::string & filePath,
 			size_t frameOffset, GET::GDataFrame & dataFrame);
 
+  static void fillHeader(mfm::Frame & aFrame, GET::GDataFrame & dataFrame);
+
+  static void fillSamples(mfm::Frame & aFrame, GET::GDataFrame & dataFrame);
+
   std::ifstream inputFile;
   std::string inputFilePath{""};
 
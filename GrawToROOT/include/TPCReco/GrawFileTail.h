@@ -0,0 +1,77 @@
+#ifndef GRAWFILETAIL_H
+#define GRAWFILETAIL_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+#include "TPCReco/GrawFrameHeader.h"
+
+/////////////////////////////////////////////////////////
+/// Incremental reader of a GRAW file being written by the DAQ.
+/// Keeps the offset of the first byte not read yet, each update()
+/// reads only the frames appended since the previous call.
+/// A frame is read only when it is complete on disk,
+/// only the headers of the frames are read.
+/////////////////////////////////////////////////////////
+class GrawFileTail{
+
+public:
+
+  struct FrameInfo: public GrawFrameHeader::CoboHeader {
+    unsigned long int frameNumber; // counted from 0 among all frames of the file
+    std::streamoff offset;         // of the first byte of the frame
+  };
+
+  static const unsigned int coboHeaderSize = GrawFrameHeader::coboHeaderSize;
+
+  GrawFileTail(const std::string & filePath);
+
+  ~GrawFileTail();
+
+  const std::string & getFilePath() const { return myFilePath; }
+
+  /// CoBo data frames completed since the previous call
+  std::vector<FrameInfo> update();
+
+  /// number of complete frames (of any type) read so far
+  unsigned long int getFramesNumber() const { return myFramesNumber; }
+
+  std::streamoff getOffset() const { return myOffset; }
+
+  /// releases the file descriptor, the next update() reopens the file
+  /// and continues from the same offset
+  void close() { myFile.close(); }
+
+  bool isOpen() const { return myFile.is_open(); }
+
+  /// true if no more frames are expected in olderFile once newerFile exists:
+  /// newerFile belongs to a later run or is a later chunk of the same CoBo/AsAd stream.
+  /// False if a run id can not be parsed from the file names.
+  static bool isSupersededBy(const std::string & olderFile, const std::string & newerFile);
+
+  /// size in bytes and type of a frame from its 8 byte MFM primary header
+  static bool decodePrimaryHeader(const unsigned char *header,
+				  uint64_t & frameBytes, uint16_t & frameType){
+    return GrawFrameHeader::decodePrimaryHeader(header, frameBytes, frameType);
+  }
+
+  /// event, board and hit pattern fields of a CoBo frame header,
+  /// decoded from raw bytes, without reading the frame items
+  static bool decodeCoboHeader(const unsigned char *header, size_t size,
+			       FrameInfo & aFrame){
+    return GrawFrameHeader::decodeCoboHeader(header, size, aFrame);
+  }
+
+private:
+
+  bool open();
+
+  std::string myFilePath;
+  std::ifstream myFile;
+  std::streamoff myOffset{0};
+  unsigned long int myFramesNumber{0};
+
+};
+#endif
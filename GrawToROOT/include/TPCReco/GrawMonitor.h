@@ -0,0 +1,94 @@
+#ifndef GRAWMONITOR_H
+#define GRAWMONITOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TPCReco/GrawFileTail.h"
+
+/////////////////////////////////////////////////////////
+/// Online rate, dead time and occupancy monitor.
+/// Reads only the CoBo frame headers of the growing GRAW files on its own thread,
+/// independently of the displayed events, and accumulates them in a rolling
+/// window of time bins. The counters are atomic: the GUI thread takes
+/// snapshots without locking the monitor thread.
+/// Files superseded by a later run or chunk are read to their end and forgotten.
+/////////////////////////////////////////////////////////
+class GrawMonitor{
+
+public:
+
+  static const unsigned int nAgetChips = 4;
+  static const unsigned int nAgetChannels = 68; // raw channel numbering, including FPN channels
+
+  struct Snapshot {
+    double time{0};             // [s] timestamp of the latest event
+    double windowLength{0};     // [s] time covered by the rolling window
+    double rate{0};             // [Hz] event rate in the window
+    double deadTimeFraction{0}; // estimated from the shortest time between events
+    unsigned long int nEvents{0};     // events since start of the monitor
+    unsigned long int lastEventId{0};
+    std::vector<double> channelOccupancy; // fraction of events with a hit, index from getChannelIndex()
+  };
+
+  /// nBins bins of binWidth seconds make the rolling window
+  GrawMonitor(unsigned int nAsadBoards, unsigned int nCoboBoards=1,
+	      double binWidth=1.0, unsigned int nBins=10);
+
+  ~GrawMonitor();
+
+  /// comma separated list of new or growing files, wakes up the monitor thread
+  void notify(const std::string & commaSeparatedFileNames);
+
+  /// accounts one frame header, called by the monitor thread.
+  /// A timestamp older than the whole window starts the accumulation
+  /// anew: the CoBo clock is reset at the start of every run.
+  void processFrame(const GrawFileTail::FrameInfo & aFrame);
+
+  Snapshot getSnapshot() const;
+
+  unsigned int getChannelIndex(unsigned int coboIdx, unsigned int asadIdx,
+			       unsigned int agetIdx, unsigned int chanIdx) const;
+
+  unsigned int getNumberOfChannels() const { return nChannels; }
+
+private:
+
+  struct TimeBin {
+    std::atomic<long long> binId{-1};
+    std::atomic<unsigned int> nEvents{0};
+    std::unique_ptr<std::atomic<unsigned int>[]> nHits;
+  };
+
+  void run();
+  TimeBin & getBin(long long binId);
+  void reset(); // empties the rolling window, called by the monitor thread only
+
+  const unsigned int nAsadBoards, nCoboBoards, nChannels;
+  const uint64_t binTicks; // bin width in CoBo clock ticks (10 ns)
+  std::vector<TimeBin> myBins;
+
+  std::atomic<long long> myLastBinId{-1}, myFirstBinId{-1};
+  std::atomic<uint64_t> myLastEventTime{0};
+  std::atomic<uint64_t> myMinEventInterval{0};
+  std::atomic<unsigned long int> myEventCount{0};
+  std::atomic<unsigned long int> myLastEventId{0};
+
+  // used by the monitor thread only, the files not modified in the last update are closed
+  std::map<std::string, std::unique_ptr<GrawFileTail> > myTails; // [file path]
+  long myRunId{-1}; // of the newest file, -1 if not known
+
+  std::thread myWorker;
+  std::mutex myMutex; // guards the list of modified files only
+  std::condition_variable myCondition;
+  std::set<std::string> myModifiedFiles;
+  bool isStopped{false};
+};
+#endif
@@ -124,15 +124,7 @@ bool Graw2DataFrame::getGrawFrameHeader(const std::string & filePath,
     if(accepted) {
       // Reset ROOT frame
       dataFrame.Clear();
-      // Get meta-data
-      dataFrame.fHeader.fRevision = frame->header().revision();
-      dataFrame.fHeader.fDataSource = frame->header().dataSource();
-      dataFrame.fHeader.fEventTime = frame->headerField("eventTime").value<uint64_t>();
-      dataFrame.fHeader.fEventIdx = frame->headerField("eventIdx").value<uint32_t>();
-      dataFrame.fHeader.fCoboIdx = frame->headerField("coboIdx").value<uint8_t>();
-      dataFrame.fHeader.fAsadIdx = frame->headerField("asadIdx").value<uint8_t>();
-      dataFrame.fHeader.fReadOffset = frame->headerField("readOffset").value<uint16_t>();
-      dataFrame.fHeader.fStatus = frame->headerField("status").value<uint8_t>();
+      fillHeader(*frame, dataFrame);
     }
   }
   catch (const std::exception & e)
@@ -143,6 +135,80 @@ bool Graw2DataFrame::getGrawFrameHeader(const std::string & filePath,
 }
 ////////////////////////////////////
 ////////////////////////////////////
+bool Graw2DataFrame::getGrawFrameAt(const std::string & filePath,
+				    std::streamoff byteOffset, GET::GDataFrame & dataFrame){
+
+  if(!loadFile(filePath)) return false;
+  // the stream is left at an unknown frame number,
+  // so the next read by frame number has to reopen the file
+  inputFilePath = "";
+  lastFrameRead = 0;
+  try {
+    inputFile.seekg(byteOffset);
+    frame = Frame::read(inputFile);
+    // Skip frames with anything other than CoBo data
+    if (0x1 != frame->header().frameType() and 0x2 != frame->header().frameType()){
+      LOG_ERROR() << "No CoBo frame at offset " << byteOffset << " of file '" << filePath << "'";
+      return false;
+    }
+    dataFrame.Clear();
+    fillHeader(*frame, dataFrame);
+    fillSamples(*frame, dataFrame);
+  }
+  catch (const std::exception & e)
+    {
+      LOG_ERROR() << "Error reading frame at offset " << byteOffset << " of file '" << filePath << "': " << e.what();
+      return false;
+    }
+  return true;
+}
+////////////////////////////////////
+////////////////////////////////////
+void Graw2DataFrame::fillHeader(mfm::Frame & aFrame, GET::GDataFrame & dataFrame){
+
+  dataFrame.fHeader.fRevision = aFrame.header().revision();
+  dataFrame.fHeader.fDataSource = aFrame.header().dataSource();
+  dataFrame.fHeader.fEventTime = aFrame.headerField("eventTime").value<uint64_t>();
+  dataFrame.fHeader.fEventIdx = aFrame.headerField("eventIdx").value<uint32_t>();
+  dataFrame.fHeader.fCoboIdx = aFrame.headerField("coboIdx").value<uint8_t>();
+  dataFrame.fHeader.fAsadIdx = aFrame.headerField("asadIdx").value<uint8_t>();
+  dataFrame.fHeader.fReadOffset = aFrame.headerField("readOffset").value<uint16_t>();
+  dataFrame.fHeader.fStatus = aFrame.headerField("status").value<uint8_t>();
+}
+////////////////////////////////////
+////////////////////////////////////
+void Graw2DataFrame::fillSamples(mfm::Frame & aFrame, GET::GDataFrame & dataFrame){
+
+  const size_t nItems = aFrame.itemCount();
+  if(aFrame.header().frameType()==0x1){
+    // partial readout: every item carries its AGET, channel and time bucket
+    for(size_t iItem=0; iItem<nItems; ++iItem){
+      mfm::Field field = aFrame.itemAt(iItem).field("");
+      dataFrame.AddSample(field.bitField("agetIdx").value<uint32_t>(),
+			  field.bitField("chanIdx").value<uint32_t>(),
+			  field.bitField("buckIdx").value<uint32_t>(),
+			  field.bitField("sample").value<uint32_t>());
+    }
+    return;
+  }
+  // full readout: per AGET, all 68 channels of a time bucket follow each other
+  const uint32_t nChannels = 68;
+  uint32_t chanIdx[4] = {0, 0, 0, 0};
+  uint32_t buckIdx[4] = {0, 0, 0, 0};
+  for(size_t iItem=0; iItem<nItems; ++iItem){
+    mfm::Field field = aFrame.itemAt(iItem).field("");
+    uint32_t agetIdx = field.bitField("agetIdx").value<uint32_t>();
+    if(agetIdx>3) continue;
+    dataFrame.AddSample(agetIdx, chanIdx[agetIdx], buckIdx[agetIdx],
+			field.bitField("sample").value<uint32_t>());
+    if(++chanIdx[agetIdx]==nChannels){
+      chanIdx[agetIdx] = 0;
+      ++buckIdx[agetIdx];
+    }
+  }
+}
+////////////////////////////////////
+////////////////////////////////////
 bool Graw2DataFrame::loadFile(const std::string & filePath){
 
   if(true || filePath!=inputFilePath){
@@ -0,0 +1,88 @@
+#include "TPCReco/GrawFileTail.h"
+#include "TPCReco/RunIdParser.h"
+
+#include <utl/Logging.h>
+
+#include <cerrno>
+#include <cstring>
+
+using std::strerror;
+
+////////////////////////////////////
+////////////////////////////////////
+GrawFileTail::GrawFileTail(const std::string & filePath):myFilePath(filePath){
+
+  open();
+}
+////////////////////////////////////
+////////////////////////////////////
+GrawFileTail::~GrawFileTail(){
+
+  myFile.close();
+}
+////////////////////////////////////
+////////////////////////////////////
+bool GrawFileTail::open(){
+
+  if(myFile.is_open()) return true;
+  myFile.open(myFilePath.c_str(), std::ios::in | std::ios::binary);
+  if(!myFile.is_open()){
+    LOG_ERROR() << "Could not open file '" << myFilePath << "': " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+////////////////////////////////////
+////////////////////////////////////
+std::vector<GrawFileTail::FrameInfo> GrawFileTail::update(){
+
+  std::vector<FrameInfo> newFrames;
+  if(!open()) return newFrames;
+
+  myFile.clear(); // EOF of the previous update
+  myFile.seekg(0, std::ios::end);
+  std::streamoff fileSize = myFile.tellg();
+
+  unsigned char header[coboHeaderSize];
+  while(myOffset+8<=fileSize){
+    myFile.seekg(myOffset);
+    myFile.read(reinterpret_cast<char*>(header), 8);
+    if(!myFile) break;
+    uint64_t frameBytes = 0;
+    uint16_t frameType = 0;
+    if(!decodePrimaryHeader(header, frameBytes, frameType)){
+      LOG_ERROR() << "Corrupted frame header at offset " << myOffset << " of file '" << myFilePath << "'";
+      break;
+    }
+    if(myOffset+(std::streamoff)frameBytes>fileSize) break; // frame not written completely yet
+
+    // Skip frames with anything other than CoBo data
+    if(GrawFrameHeader::isCoboFrame(frameType) && frameBytes>=coboHeaderSize){
+      myFile.read(reinterpret_cast<char*>(header)+8, coboHeaderSize-8);
+      FrameInfo aFrame;
+      aFrame.frameNumber = myFramesNumber;
+      aFrame.offset = myOffset;
+      if(myFile && decodeCoboHeader(header, coboHeaderSize, aFrame)) newFrames.push_back(aFrame);
+      myFile.clear();
+    }
+    myOffset += frameBytes;
+    ++myFramesNumber;
+  }
+  return newFrames;
+}
+////////////////////////////////////
+////////////////////////////////////
+bool GrawFileTail::isSupersededBy(const std::string & olderFile, const std::string & newerFile){
+
+  try {
+    RunIdParser older(olderFile), newer(newerFile);
+    if(newer.runId()!=older.runId()) return newer.runId()>older.runId();
+    return newer.CoBoId()==older.CoBoId() && newer.AsAdId()==older.AsAdId() &&
+      newer.fileId()>older.fileId();
+  }
+  catch(const RunIdParser::ParseError &){
+    return false;
+  }
+}
+////////////////////////////////////
+////////////////////////////////////
@@ -0,0 +1,200 @@
+#include "TPCReco/GrawMonitor.h"
+#include "TPCReco/RunIdParser.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+  const double tickSeconds = 1E-8; // CoBo clock period [s]
+}
+
+////////////////////////////////////
+////////////////////////////////////
+GrawMonitor::GrawMonitor(unsigned int nAsadBoards, unsigned int nCoboBoards,
+			 double binWidth, unsigned int nBins):
+  nAsadBoards(nAsadBoards), nCoboBoards(nCoboBoards),
+  nChannels(nCoboBoards*nAsadBoards*nAgetChips*nAgetChannels),
+  binTicks(std::max(uint64_t(1), uint64_t(binWidth/tickSeconds))),
+  myBins(std::max(1U, nBins)){
+
+  for(auto & aBin: myBins){
+    aBin.nHits.reset(new std::atomic<unsigned int>[nChannels]());
+  }
+  myWorker = std::thread(&GrawMonitor::run, this);
+}
+////////////////////////////////////
+////////////////////////////////////
+GrawMonitor::~GrawMonitor(){
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    isStopped = true;
+  }
+  myCondition.notify_all();
+  if(myWorker.joinable()) myWorker.join();
+}
+////////////////////////////////////
+////////////////////////////////////
+unsigned int GrawMonitor::getChannelIndex(unsigned int coboIdx, unsigned int asadIdx,
+					  unsigned int agetIdx, unsigned int chanIdx) const{
+
+  return ((coboIdx*nAsadBoards + asadIdx)*nAgetChips + agetIdx)*nAgetChannels + chanIdx;
+}
+////////////////////////////////////
+////////////////////////////////////
+void GrawMonitor::notify(const std::string & commaSeparatedFileNames){
+
+  const char del = ','; // delimiter character
+  std::stringstream sstream(commaSeparatedFileNames);
+  std::string fileName;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    while (std::getline(sstream, fileName, del)) {
+      if(fileName.size()) myModifiedFiles.insert(fileName);
+    }
+  }
+  myCondition.notify_one();
+}
+////////////////////////////////////
+////////////////////////////////////
+void GrawMonitor::run(){
+
+  while(true){
+    std::set<std::string> aModifiedFiles;
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+      myCondition.wait(lock, [this](){ return isStopped || !myModifiedFiles.empty(); });
+      if(isStopped) return;
+      aModifiedFiles.swap(myModifiedFiles);
+    }
+    for(const auto & fileName: aModifiedFiles){
+      auto it = myTails.find(fileName);
+      if(it==myTails.end()){
+	// files older than the ones already seen are not monitored
+	if(std::any_of(myTails.begin(), myTails.end(),
+		       [&fileName](const std::pair<const std::string, std::unique_ptr<GrawFileTail> > & aTail){
+			 return GrawFileTail::isSupersededBy(fileName, aTail.first); })) continue;
+	// frames written to the superseded files before the new one was started
+	for(auto itOld=myTails.begin(); itOld!=myTails.end();){
+	  if(GrawFileTail::isSupersededBy(itOld->first, fileName)){
+	    for(const auto & aFrame: itOld->second->update()) processFrame(aFrame);
+	    itOld = myTails.erase(itOld);
+	  }
+	  else ++itOld;
+	}
+	it = myTails.insert(std::make_pair(fileName, std::unique_ptr<GrawFileTail>(new GrawFileTail(fileName)))).first;
+	try {
+	  long runId = RunIdParser(fileName).runId();
+	  if(myRunId>=0 && runId>myRunId) reset();
+	  myRunId = std::max(myRunId, runId);
+	}
+	catch(const RunIdParser::ParseError &){} // timestamp check in processFrame() only
+      }
+      for(const auto & aFrame: it->second->update()) processFrame(aFrame);
+    }
+    for(auto & aTail: myTails){
+      if(!aModifiedFiles.count(aTail.first)) aTail.second->close();
+    }
+  }
+}
+////////////////////////////////////
+// Bins are recycled by the monitor thread only.
+// A snapshot taken while a bin is being recycled may miss a few counts.
+////////////////////////////////////
+GrawMonitor::TimeBin & GrawMonitor::getBin(long long binId){
+
+  TimeBin & aBin = myBins[binId % myBins.size()];
+  if(aBin.binId.load(std::memory_order_acquire)!=binId){
+    aBin.binId.store(-1, std::memory_order_release);
+    aBin.nEvents.store(0, std::memory_order_relaxed);
+    for(unsigned int iChannel=0;iChannel<nChannels;++iChannel){
+      aBin.nHits[iChannel].store(0, std::memory_order_relaxed);
+    }
+    aBin.binId.store(binId, std::memory_order_release);
+  }
+  return aBin;
+}
+////////////////////////////////////
+// Counters of the recycled bins are cleared by getBin().
+////////////////////////////////////
+void GrawMonitor::reset(){
+
+  myLastBinId.store(-1, std::memory_order_release);
+  myFirstBinId.store(-1, std::memory_order_relaxed);
+  for(auto & aBin: myBins) aBin.binId.store(-1, std::memory_order_release);
+  myLastEventTime.store(0, std::memory_order_relaxed);
+  myMinEventInterval.store(0, std::memory_order_relaxed);
+}
+////////////////////////////////////
+////////////////////////////////////
+void GrawMonitor::processFrame(const GrawFileTail::FrameInfo & aFrame){
+
+  if(aFrame.coboIdx>=nCoboBoards || aFrame.asadIdx>=nAsadBoards) return;
+  uint64_t windowTicks = binTicks*myBins.size();
+  if(aFrame.eventTime+windowTicks<myLastEventTime.load(std::memory_order_relaxed)) reset(); // new run
+  long long binId = aFrame.eventTime/binTicks;
+  long long lastBinId = myLastBinId.load(std::memory_order_acquire);
+  if(lastBinId>=0 && binId<=lastBinId-(long long)myBins.size()) return; // older than the window
+  if(myFirstBinId.load(std::memory_order_relaxed)<0) myFirstBinId.store(binId, std::memory_order_relaxed);
+  TimeBin & aBin = getBin(binId);
+
+  // use only {ASAD=0, COBO=0} for event counting purpose
+  if(aFrame.coboIdx==0 && aFrame.asadIdx==0){
+    aBin.nEvents.fetch_add(1, std::memory_order_relaxed);
+    myEventCount.fetch_add(1, std::memory_order_relaxed);
+    uint64_t lastEventTime = myLastEventTime.load(std::memory_order_relaxed);
+    if(aFrame.eventTime>lastEventTime){
+      uint64_t interval = aFrame.eventTime - lastEventTime;
+      uint64_t minInterval = myMinEventInterval.load(std::memory_order_relaxed);
+      if(lastEventTime>0 && (minInterval==0 || interval<minInterval)){
+	myMinEventInterval.store(interval, std::memory_order_relaxed);
+      }
+      myLastEventTime.store(aFrame.eventTime, std::memory_order_relaxed);
+      myLastEventId.store(aFrame.eventIdx, std::memory_order_relaxed);
+    }
+  }
+  for(unsigned int agetIdx=0;agetIdx<nAgetChips;++agetIdx){
+    if(aFrame.hitPattern[agetIdx].none()) continue;
+    for(unsigned int chanIdx=0;chanIdx<nAgetChannels;++chanIdx){
+      if(!aFrame.hitPattern[agetIdx][chanIdx]) continue;
+      aBin.nHits[getChannelIndex(aFrame.coboIdx, aFrame.asadIdx, agetIdx, chanIdx)].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  if(binId>lastBinId) myLastBinId.store(binId, std::memory_order_release);
+}
+////////////////////////////////////
+////////////////////////////////////
+GrawMonitor::Snapshot GrawMonitor::getSnapshot() const{
+
+  Snapshot aSnapshot;
+  aSnapshot.channelOccupancy.assign(nChannels, 0.0);
+  aSnapshot.nEvents = myEventCount.load(std::memory_order_relaxed);
+  aSnapshot.lastEventId = myLastEventId.load(std::memory_order_relaxed);
+  long long lastBinId = myLastBinId.load(std::memory_order_acquire);
+  if(lastBinId<0) return aSnapshot;
+
+  long long firstBinId = std::max(myFirstBinId.load(std::memory_order_relaxed),
+				  lastBinId-(long long)myBins.size()+1);
+  unsigned long int nEvents = 0;
+  for(const auto & aBin: myBins){
+    long long binId = aBin.binId.load(std::memory_order_acquire);
+    if(binId<firstBinId || binId>lastBinId) continue;
+    nEvents += aBin.nEvents.load(std::memory_order_relaxed);
+    for(unsigned int iChannel=0;iChannel<nChannels;++iChannel){
+      aSnapshot.channelOccupancy[iChannel] += aBin.nHits[iChannel].load(std::memory_order_relaxed);
+    }
+  }
+  uint64_t lastEventTime = myLastEventTime.load(std::memory_order_relaxed);
+  uint64_t windowStart = firstBinId*binTicks;
+  aSnapshot.time = lastEventTime*tickSeconds;
+  aSnapshot.windowLength = lastEventTime>windowStart ? (lastEventTime-windowStart)*tickSeconds : 0.0;
+  if(aSnapshot.windowLength>0) aSnapshot.rate = nEvents/aSnapshot.windowLength;
+  // non-paralyzable dead time: the shortest observed interval approximates the readout time
+  aSnapshot.deadTimeFraction = std::min(1.0, aSnapshot.rate*myMinEventInterval.load(std::memory_order_relaxed)*tickSeconds);
+  for(auto & aOccupancy: aSnapshot.channelOccupancy){
+    aOccupancy = nEvents ? aOccupancy/nEvents : 0.0;
+  }
+  return aSnapshot;
+}
+////////////////////////////////////
+////////////////////////////////////
@@ -0,0 +1,133 @@
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include "gtest/gtest.h"
+
+#include "TPCReco/GrawFileTail.h"
+
+namespace {
+// MFM frame of 64 byte blocks, big endian, with no CoBo data
+std::vector<char> makeFrame(unsigned int nBlocks, unsigned short frameType) {
+  std::vector<char> frame(nBlocks * 64, 0);
+  frame[0] = 0x06;
+  frame[1] = (nBlocks >> 16) & 0xFF;
+  frame[2] = (nBlocks >> 8) & 0xFF;
+  frame[3] = nBlocks & 0xFF;
+  frame[5] = (frameType >> 8) & 0xFF;
+  frame[6] = frameType & 0xFF;
+  return frame;
+}
+} // namespace
+
+TEST(GrawFileTailTest, decodePrimaryHeader) {
+  uint64_t frameBytes = 0;
+  uint16_t frameType = 0;
+  const unsigned char bigEndian[8] = {0x06, 0x00, 0x01, 0x02, 0x00, 0x00, 0x02, 0x05};
+  EXPECT_TRUE(GrawFileTail::decodePrimaryHeader(bigEndian, frameBytes, frameType));
+  EXPECT_EQ(frameBytes, 258 * 64);
+  EXPECT_EQ(frameType, 0x2);
+
+  const unsigned char littleEndian[8] = {0x86, 0x02, 0x01, 0x00, 0x00, 0x01, 0x00, 0x05};
+  EXPECT_TRUE(GrawFileTail::decodePrimaryHeader(littleEndian, frameBytes, frameType));
+  EXPECT_EQ(frameBytes, 258 * 64);
+  EXPECT_EQ(frameType, 0x1);
+
+  const unsigned char empty[8] = {0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x05};
+  EXPECT_FALSE(GrawFileTail::decodePrimaryHeader(empty, frameBytes, frameType));
+}
+
+TEST(GrawFileTailTest, readsOnlyCompleteFrames) {
+  auto filePath = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("GrawFileTail_tst-%%%%-%%%%.graw");
+  std::ofstream output(filePath.string(), std::ios::binary);
+  auto frame1 = makeFrame(1, 0x8);
+  auto frame2 = makeFrame(3, 0x8);
+  output.write(frame1.data(), frame1.size());
+  output.write(frame2.data(), 100); // the DAQ is still writing the second frame
+  output.flush();
+
+  GrawFileTail aTail(filePath.string());
+  EXPECT_TRUE(aTail.update().empty());
+  EXPECT_EQ(aTail.getFramesNumber(), 1);
+  EXPECT_EQ(aTail.getOffset(), 64);
+  EXPECT_TRUE(aTail.update().empty());
+  EXPECT_EQ(aTail.getFramesNumber(), 1);
+
+  output.write(frame2.data() + 100, frame2.size() - 100);
+  output.flush();
+  EXPECT_TRUE(aTail.update().empty());
+  EXPECT_EQ(aTail.getFramesNumber(), 2);
+  EXPECT_EQ(aTail.getOffset(), 4 * 64);
+
+  output.close();
+  boost::filesystem::remove(filePath);
+}
+
+TEST(GrawFileTailTest, coboFrameOffsets) {
+  auto filePath = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("GrawFileTail_tst-%%%%-%%%%.graw");
+  std::ofstream output(filePath.string(), std::ios::binary);
+  auto frame1 = makeFrame(1, 0x8);
+  auto frame2 = makeFrame(2, 0x1);
+  frame2[25] = 7; // eventIdx
+  frame2[27] = 1; // asadIdx
+  auto frame3 = makeFrame(3, 0x2);
+  frame3[25] = 8;
+  output.write(frame1.data(), frame1.size());
+  output.write(frame2.data(), frame2.size());
+  output.write(frame3.data(), frame3.size());
+  output.close();
+
+  GrawFileTail aTail(filePath.string());
+  auto frames = aTail.update();
+  ASSERT_EQ(frames.size(), 2);
+  EXPECT_EQ(frames[0].eventIdx, 7);
+  EXPECT_EQ(frames[0].asadIdx, 1);
+  EXPECT_EQ(frames[0].frameNumber, 1);
+  EXPECT_EQ(frames[0].offset, 64);
+  EXPECT_EQ(frames[1].eventIdx, 8);
+  EXPECT_EQ(frames[1].frameNumber, 2);
+  EXPECT_EQ(frames[1].offset, 3 * 64);
+
+  boost::filesystem::remove(filePath);
+}
+
+TEST(GrawFileTailTest, closeAndContinue) {
+  auto filePath = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("GrawFileTail_tst-%%%%-%%%%.graw");
+  std::ofstream output(filePath.string(), std::ios::binary);
+  auto frame1 = makeFrame(1, 0x8);
+  auto frame2 = makeFrame(2, 0x8);
+  output.write(frame1.data(), frame1.size());
+  output.flush();
+
+  GrawFileTail aTail(filePath.string());
+  EXPECT_TRUE(aTail.update().empty());
+  EXPECT_TRUE(aTail.isOpen());
+  aTail.close();
+  EXPECT_FALSE(aTail.isOpen());
+
+  output.write(frame2.data(), frame2.size());
+  output.close();
+  EXPECT_TRUE(aTail.update().empty());
+  EXPECT_TRUE(aTail.isOpen());
+  EXPECT_EQ(aTail.getFramesNumber(), 2);
+  EXPECT_EQ(aTail.getOffset(), 3 * 64);
+
+  boost::filesystem::remove(filePath);
+}
+
+TEST(GrawFileTailTest, isSupersededBy) {
+  const std::string chunk0 = "CoBo0_AsAd1_2021-06-22T12:01:56.568_0000.graw";
+  const std::string chunk1 = "CoBo0_AsAd1_2021-06-22T12:01:56.568_0001.graw";
+  const std::string otherAsad = "CoBo0_AsAd2_2021-06-22T12:01:56.568_0001.graw";
+  const std::string nextRun = "CoBo0_AsAd2_2021-06-22T14:11:06.123_0000.graw";
+  EXPECT_TRUE(GrawFileTail::isSupersededBy(chunk0, chunk1));
+  EXPECT_FALSE(GrawFileTail::isSupersededBy(chunk1, chunk0));
+  EXPECT_FALSE(GrawFileTail::isSupersededBy(chunk0, chunk0));
+  EXPECT_FALSE(GrawFileTail::isSupersededBy(chunk0, otherAsad));
+  EXPECT_TRUE(GrawFileTail::isSupersededBy(chunk1, nextRun));
+  EXPECT_FALSE(GrawFileTail::isSupersededBy(nextRun, chunk1));
+  EXPECT_FALSE(GrawFileTail::isSupersededBy("data.graw", chunk1));
+}
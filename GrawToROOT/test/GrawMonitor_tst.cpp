@@ -0,0 +1,168 @@
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include "gtest/gtest.h"
+
+#include "TPCReco/GrawFileTail.h"
+#include "TPCReco/GrawMonitor.h"
+
+namespace {
+// CoBo frame header, big endian
+std::vector<unsigned char> makeCoboHeader(uint64_t eventTime, unsigned int eventIdx,
+                                          unsigned int coboIdx, unsigned int asadIdx) {
+  std::vector<unsigned char> header(GrawFileTail::coboHeaderSize, 0);
+  header[0] = 0x06;
+  for (int iByte = 0; iByte < 6; ++iByte) {
+    header[16 + iByte] = (eventTime >> (8 * (5 - iByte))) & 0xFF;
+  }
+  for (int iByte = 0; iByte < 4; ++iByte) {
+    header[22 + iByte] = (eventIdx >> (8 * (3 - iByte))) & 0xFF;
+  }
+  header[26] = coboIdx;
+  header[27] = asadIdx;
+  return header;
+}
+
+GrawFileTail::FrameInfo makeFrame(uint64_t eventTime, unsigned int eventIdx,
+                                  unsigned int asadIdx, unsigned int chanIdx) {
+  GrawFileTail::FrameInfo aFrame{};
+  aFrame.eventTime = eventTime;
+  aFrame.eventIdx = eventIdx;
+  aFrame.coboIdx = 0;
+  aFrame.asadIdx = asadIdx;
+  aFrame.hitPattern[1].set(chanIdx);
+  return aFrame;
+}
+// complete CoBo frame of one 128 byte block: partial readout, no items
+void writeFrame(std::ofstream &output, uint64_t eventTime, unsigned int eventIdx) {
+  auto frame = makeCoboHeader(eventTime, eventIdx, 0, 0);
+  frame.resize(128, 0);
+  frame[1] = 0; // block size 2^6 bytes
+  frame[3] = 2; // frame size in blocks
+  frame[6] = 0x1; // frame type
+  output.write(reinterpret_cast<const char *>(frame.data()), frame.size());
+  output.flush();
+}
+
+bool waitForEvents(const GrawMonitor &aMonitor, unsigned long int nEvents) {
+  for (int iTry = 0; iTry < 500 && aMonitor.getSnapshot().nEvents < nEvents; ++iTry) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return aMonitor.getSnapshot().nEvents == nEvents;
+}
+} // namespace
+
+TEST(GrawMonitorTest, decodeCoboHeader) {
+  auto header = makeCoboHeader(0x123456789AULL, 42, 0, 1);
+  header[31 + 9 + 8] = 0x01;     // AGET 1, channel 0
+  header[31 + 9 + 0] = 0x08;     // AGET 1, channel 67
+  header[31 + 27 + 7] = 0x02;    // AGET 3, channel 9
+  header[67 + 2 + 1] = 2;        // AGET 1 multiplicity
+
+  GrawFileTail::FrameInfo aFrame;
+  EXPECT_FALSE(GrawFileTail::decodeCoboHeader(header.data(), header.size() - 1, aFrame));
+  ASSERT_TRUE(GrawFileTail::decodeCoboHeader(header.data(), header.size(), aFrame));
+  EXPECT_EQ(aFrame.eventTime, 0x123456789AULL);
+  EXPECT_EQ(aFrame.eventIdx, 42);
+  EXPECT_EQ(aFrame.coboIdx, 0);
+  EXPECT_EQ(aFrame.asadIdx, 1);
+  EXPECT_TRUE(aFrame.hitPattern[0].none());
+  EXPECT_EQ(aFrame.hitPattern[1].count(), 2);
+  EXPECT_TRUE(aFrame.hitPattern[1][0]);
+  EXPECT_TRUE(aFrame.hitPattern[1][67]);
+  EXPECT_EQ(aFrame.hitPattern[3].count(), 1);
+  EXPECT_TRUE(aFrame.hitPattern[3][9]);
+  EXPECT_EQ(aFrame.multiplicity[1], 2);
+}
+
+TEST(GrawMonitorTest, rateAndOccupancy) {
+  GrawMonitor aMonitor(2, 1, 1.0, 5);
+  EXPECT_EQ(aMonitor.getNumberOfChannels(), 2 * 4 * 68);
+  EXPECT_EQ(aMonitor.getSnapshot().nEvents, 0);
+
+  // 100 Hz during 10 s, both ASAD boards, channel 5 hit every second event on ASAD 1
+  const uint64_t period = 1000000; // 10 ms in 10 ns ticks
+  for (unsigned int iEvent = 0; iEvent <= 1000; ++iEvent) {
+    aMonitor.processFrame(makeFrame(iEvent * period, iEvent, 0, 3));
+    if (iEvent % 2) aMonitor.processFrame(makeFrame(iEvent * period, iEvent, 1, 5));
+  }
+  auto aSnapshot = aMonitor.getSnapshot();
+  EXPECT_EQ(aSnapshot.nEvents, 1001);
+  EXPECT_EQ(aSnapshot.lastEventId, 1000);
+  EXPECT_DOUBLE_EQ(aSnapshot.time, 10.0);
+  EXPECT_NEAR(aSnapshot.windowLength, 4.0, 1E-9); // last bin has just started
+  EXPECT_NEAR(aSnapshot.rate, 100.0, 1.0);
+  EXPECT_NEAR(aSnapshot.deadTimeFraction, 1.0, 1E-2); // events back-to-back
+  ASSERT_EQ(aSnapshot.channelOccupancy.size(), aMonitor.getNumberOfChannels());
+  EXPECT_NEAR(aSnapshot.channelOccupancy[aMonitor.getChannelIndex(0, 0, 1, 3)], 1.0, 1E-2);
+  EXPECT_NEAR(aSnapshot.channelOccupancy[aMonitor.getChannelIndex(0, 1, 1, 5)], 0.5, 1E-2);
+  EXPECT_EQ(aSnapshot.channelOccupancy[aMonitor.getChannelIndex(0, 1, 1, 3)], 0.0);
+
+  // frames of unknown boards are ignored
+  aMonitor.processFrame(makeFrame(1001 * period, 1001, 2, 3));
+  EXPECT_EQ(aMonitor.getSnapshot().nEvents, 1001);
+}
+
+TEST(GrawMonitorTest, timestampReset) {
+  GrawMonitor aMonitor(1, 1, 1.0, 5);
+  const uint64_t period = 1000000; // 10 ms in 10 ns ticks
+
+  // first run: 100 Hz during 60 s
+  for (unsigned int iEvent = 0; iEvent <= 6000; ++iEvent) {
+    aMonitor.processFrame(makeFrame(iEvent * period, iEvent, 0, 3));
+  }
+  EXPECT_DOUBLE_EQ(aMonitor.getSnapshot().time, 60.0);
+
+  // next run: the CoBo clock starts from 0 again, 50 Hz during 10 s
+  for (unsigned int iEvent = 0; iEvent <= 500; ++iEvent) {
+    aMonitor.processFrame(makeFrame(iEvent * 2 * period, iEvent, 0, 4));
+  }
+  auto aSnapshot = aMonitor.getSnapshot();
+  EXPECT_EQ(aSnapshot.nEvents, 6001 + 501);
+  EXPECT_EQ(aSnapshot.lastEventId, 500);
+  EXPECT_DOUBLE_EQ(aSnapshot.time, 10.0);
+  EXPECT_NEAR(aSnapshot.rate, 50.0, 1.0);
+  EXPECT_NEAR(aSnapshot.deadTimeFraction, 1.0, 1E-2); // interval of the new run
+  EXPECT_NEAR(aSnapshot.channelOccupancy[aMonitor.getChannelIndex(0, 0, 1, 4)], 1.0, 1E-2);
+  EXPECT_EQ(aSnapshot.channelOccupancy[aMonitor.getChannelIndex(0, 0, 1, 3)], 0.0);
+
+  // frames slightly out of order are not a new run
+  aMonitor.processFrame(makeFrame(499 * 2 * period, 499, 0, 4));
+  EXPECT_DOUBLE_EQ(aMonitor.getSnapshot().time, 10.0);
+}
+
+TEST(GrawMonitorTest, supersededFiles) {
+  auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("GrawMonitor_tst-%%%%-%%%%");
+  boost::filesystem::create_directories(directory);
+  const std::string chunk0 = (directory / "CoBo0_AsAd0_2021-06-22T12:01:56.568_0000.graw").string();
+  const std::string chunk1 = (directory / "CoBo0_AsAd0_2021-06-22T12:01:56.568_0001.graw").string();
+  const uint64_t period = 1000000; // 10 ms in 10 ns ticks
+  unsigned int eventIdx = 0;
+  {
+    GrawMonitor aMonitor(1, 1, 1.0, 5);
+    std::ofstream output0(chunk0, std::ios::binary);
+    for (; eventIdx < 10; ++eventIdx) writeFrame(output0, eventIdx * period, eventIdx);
+    aMonitor.notify(chunk0);
+    ASSERT_TRUE(waitForEvents(aMonitor, 10));
+
+    // the last frames of a chunk are read when the next chunk appears
+    for (; eventIdx < 15; ++eventIdx) writeFrame(output0, eventIdx * period, eventIdx);
+    std::ofstream output1(chunk1, std::ios::binary);
+    for (; eventIdx < 20; ++eventIdx) writeFrame(output1, eventIdx * period, eventIdx);
+    aMonitor.notify(chunk1);
+    ASSERT_TRUE(waitForEvents(aMonitor, 20));
+
+    // the superseded chunk is not monitored anymore,
+    // it is notified before the frames that are counted
+    writeFrame(output0, 100 * period, 100);
+    aMonitor.notify(chunk0);
+    for (; eventIdx < 22; ++eventIdx) writeFrame(output1, eventIdx * period, eventIdx);
+    aMonitor.notify(chunk1);
+    ASSERT_TRUE(waitForEvents(aMonitor, 22));
+    EXPECT_EQ(aMonitor.getSnapshot().lastEventId, 21);
+  }
+  boost::filesystem::remove_all(directory);
+}
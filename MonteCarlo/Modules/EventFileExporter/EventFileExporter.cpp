@@ -1,28 +1,67 @@
 #include "EventFileExporter.h"
 #include "TPCReco/SaveCurrentTDirectory.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+namespace {
+    // ROOT compression algorithm codes, same values as ROOT::RCompressionSetting::EAlgorithm
+    const std::map<std::string, int> compressionAlgorithms{
+            {"zlib", 1},
+            {"lzma", 2},
+            {"lz4",  4},
+            {"zstd", 5}};
+}
 
 EventFileExporter::EventFileExporter()
         : file{nullptr}, tpcDataTree{nullptr}, currSimEvent{nullptr}, currPEventTPC{nullptr}, currTrack3D{nullptr},
           currEventInfo{nullptr} {}
 
+EventFileExporter::~EventFileExporter() {
+    // run aborted before Finish(): a joinable std::thread would call std::terminate
+    StopWriter();
+    delete file; // closes the file without writing the trees
+}
+
 fwk::VModule::EResultFlag EventFileExporter::Init(boost::property_tree::ptree config) {
     //create file and ttree
     auto fname = config.get<std::string>("FileName");
+    asynchronous = config.get<bool>("Asynchronous", false);
+    if (asynchronous)
+        ROOT::EnableThreadSafety(); // writer thread uses ROOT I/O concurrently with simulation
     utl::SaveCurrentTDirectory s;
     file = new TFile(fname.c_str(), "RECREATE");
+    auto algorithm = config.get_optional<std::string>("CompressionAlgorithm");
+    if (algorithm) {
+        auto it = compressionAlgorithms.find(*algorithm);
+        if (it == compressionAlgorithms.end())
+            throw std::runtime_error("EventFileExporter: unknown compression algorithm: " + *algorithm);
+        file->SetCompressionAlgorithm(it->second);
+    }
+    auto level = config.get_optional<int>("CompressionLevel");
+    if (level)
+        file->SetCompressionLevel(*level);
     tpcDataTree = new TTree("TPCData", "");
     tpcRecoDataTree = new TTree("TPCRecoData", "");
+    auto autoFlush = config.get_optional<Long64_t>("AutoFlush");
+    if (autoFlush) {
+        tpcDataTree->SetAutoFlush(*autoFlush);
+        tpcRecoDataTree->SetAutoFlush(*autoFlush);
+    }
+    const auto basketSize = config.get<int>("BasketSize", 32000);
 
     //setup ON branches:
     for (const auto &br: config.get_child("EnabledBranches")) {
         auto branchName = std::string(br.second.data());
         if (branchName == "SimEvent")
-            tpcDataTree->Branch("SimEvent", &currSimEvent);
+            tpcDataTree->Branch("SimEvent", &currSimEvent, basketSize);
         if (branchName == "PEventTPC")
-            tpcDataTree->Branch("Event", &currPEventTPC);
+            tpcDataTree->Branch("Event", &currPEventTPC, basketSize);
         if (branchName == "Track3D") {
-            tpcRecoDataTree->Branch("RecoEvent", &currTrack3D);
-            tpcRecoDataTree->Branch("EventInfo", &currEventInfo);
+            tpcRecoDataTree->Branch("RecoEvent", &currTrack3D, basketSize);
+            tpcRecoDataTree->Branch("EventInfo", &currEventInfo, basketSize);
         }
     }
     //setup OFF branches if there are any:
@@ -40,25 +79,90 @@ fwk::VModule::EResultFlag EventFileExporter::Init(boost::property_tree::ptree co
             }
         }
     }
+    if (traceRecorder) {
+        // in asynchronous mode only the time spent by the simulation thread (waiting for a free slot and copying) is traced
+        fillTraceId = traceRecorder->GetNameId(asynchronous ? "EventFileExporter::Enqueue" : "EventFileExporter::Fill", "io");
+        writeTraceId = traceRecorder->GetNameId("EventFileExporter::Write", "io");
+    }
+    if (asynchronous) {
+        slots.resize(std::max(1, config.get<int>("QueueSize", 16)));
+        firstSlot = usedSlots = 0;
+        stopWriter = false;
+        writer = std::thread(&EventFileExporter::WriterLoop, this);
+    }
     return fwk::VModule::eSuccess;
 }
 
 fwk::VModule::EResultFlag EventFileExporter::Process(ModuleExchangeSpace &event) {
+    utl::TraceRecorder::Scope trace(traceRecorder.get(), fillTraceId);
+    if (!asynchronous) {
+        FillTrees(event);
+        return fwk::VModule::eSuccess;
+    }
+    size_t slot;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        slotFreed.wait(lock, [this] { return usedSlots < slots.size(); });
+        slot = (firstSlot + usedSlots) % slots.size();
+    }
+    slots[slot] = event; // slot is not visible to writer until usedSlots is incremented
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        ++usedSlots;
+    }
+    slotFilled.notify_one();
+    return fwk::VModule::eSuccess;
+}
+
+void EventFileExporter::FillTrees(ModuleExchangeSpace &event) {
     currSimEvent = &(event.simEvt);
     currPEventTPC = &(event.tpcPEvt);
     currEventInfo = &(event.eventInfo);
     currTrack3D = &(event.track3D);
     tpcDataTree->Fill();
     tpcRecoDataTree->Fill();
-    return fwk::VModule::eSuccess;
+}
+
+void EventFileExporter::WriterLoop() {
+    while (true) {
+        size_t slot;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            slotFilled.wait(lock, [this] { return usedSlots > 0 || stopWriter; });
+            if (!usedSlots)
+                return; // stop requested and queue drained
+            slot = firstSlot;
+        }
+        FillTrees(slots[slot]); // slot stays reserved until released below
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            firstSlot = (firstSlot + 1) % slots.size();
+            --usedSlots;
+        }
+        slotFreed.notify_one();
+    }
+}
+
+void EventFileExporter::StopWriter() {
+    if (!writer.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopWriter = true;
+    }
+    slotFilled.notify_one();
+    writer.join();
 }
 
 fwk::VModule::EResultFlag EventFileExporter::Finish() {
+    StopWriter();
     utl::SaveCurrentTDirectory s;
+    utl::TraceRecorder::Scope trace(traceRecorder.get(), writeTraceId);
     file->cd();
     tpcDataTree->Write("", TObject::kWriteDelete);
     tpcRecoDataTree->Write("", TObject::kWriteDelete);
     file->Close();
     delete file;
+    file = nullptr;
     return fwk::VModule::eSuccess;
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #ifndef TPCSOFT_EVENTFILEEXPORTER_H
 #define TPCSOFT_EVENTFILEEXPORTER_H
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "TPCReco/VModule.h"
 #include "TTree.h"
 #include "TFile.h"
@@ -8,6 +13,7 @@
 
 class EventFileExporter: public fwk::VModule{
     EventFileExporter();
+    ~EventFileExporter() override;
     EResultFlag Init(boost::property_tree::ptree config) override;
     fwk::VModule::EResultFlag Process(ModuleExchangeSpace &event) override;
     fwk::VModule::EResultFlag Finish() override;
@@ -21,6 +27,24 @@ private:
     eventraw::EventInfo* currEventInfo;
     std::vector<std::string> offBranches;
     std::vector<std::string> onBranches;
+    unsigned int fillTraceId{0};  // TTree::Fill, including basket flushes
+    unsigned int writeTraceId{0}; // final TTree::Write and file close
+
+    // asynchronous mode: events are copied into bounded ring buffer,
+    // TTree::Fill (serialization and compression) runs on a dedicated writer thread
+    bool asynchronous{false};
+    std::vector<ModuleExchangeSpace> slots;
+    size_t firstSlot{0}; // oldest event waiting for writer
+    size_t usedSlots{0}; // number of events waiting for writer, including the one being written
+    bool stopWriter{false};
+    std::mutex queueMutex;
+    std::condition_variable slotFilled;
+    std::condition_variable slotFreed;
+    std::thread writer;
+
+    void FillTrees(ModuleExchangeSpace &event);
+    void WriterLoop();
+    void StopWriter(); // drains the queue and joins the writer thread, if running
 
     REGISTER_MODULE(EventFileExporter)
 };
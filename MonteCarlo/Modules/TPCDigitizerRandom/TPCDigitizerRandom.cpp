@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
 #include "TPCDigitizerRandom.h"
+#include "TPCReco/CounterRandom.h"
 #include "TRandom.h"
+#include "TMath.h"
 
 fwk::VModule::EResultFlag TPCDigitizerRandom::Init(boost::property_tree::ptree config) {
     aEventInfo = std::make_unique<eventraw::EventInfo>();
@@ -11,6 +17,18 @@ fwk::VModule::EResultFlag TPCDigitizerRandom::Init(boost::property_tree::ptree c
     diffSigmaZmin = config.get<double>("sigmaZmin");
     diffSigmaZmax = config.get<double>("sigmaZmax");
     nSamplesPerHit = config.get<unsigned int>("NSamplesPerHit");
+    fastMode = config.get<bool>("FastMode", false);
+    if (fastMode) {
+        // default seed follows gRandom, so that fixing gRandom seed fixes the whole simulation;
+        // gRandom is not advanced when the seed is given
+        auto seed = config.get_optional<uint64_t>("RandomSeed");
+        randomSeed = seed ? *seed : static_cast<uint64_t>(gRandom->Integer(4294967295u));
+        if (!initFastLookup()) {
+            std::cerr << "TPCDigitizerRandom: geometry does not match analytic strip lookup, fast mode disabled!"
+                      << std::endl;
+            fastMode = false;
+        }
+    }
     return fwk::VModule::eSuccess;
 }
 
@@ -24,6 +42,12 @@ fwk::VModule::EResultFlag TPCDigitizerRandom::Process(ModuleExchangeSpace &event
     // diffsigmaXY = rand->Gaus(0, diffSigmaXY);
     diffSigmaXY = gRandom->Uniform(diffSigmaXYmin, diffSigmaXYmax);
     diffSigmaZ = gRandom->Uniform(diffSigmaZmin, diffSigmaZmax);
+    if (fastMode) {
+        // same linear mapping as GeometryTPC::Pos2timecell, run conditions may change between events
+        nTimecells = geometry->GetAgetNtimecells();
+        timecellScale = geometry->GetSamplingRate() / geometry->GetDriftVelocity() / 10.0;
+        timecellOffset = nTimecells - geometry->GetSamplingRate() * geometry->GetTriggerDelay();
+    }
     for (auto &t: currentSimEvent.GetTracks()) {
         //loop over hits
         for (auto &h: t.GetHits()) {
@@ -31,16 +55,18 @@ fwk::VModule::EResultFlag TPCDigitizerRandom::Process(ModuleExchangeSpace &event
             auto edep = h.GetEnergy();
             auto isIn = geometry->IsInsideActiveVolume(pos);
             h.SetInside(isIn);
-            if(isIn) {
+            if(isIn && fastMode) {
+                processHitFast(pos, edep / nSamplesPerHit * MeVToChargeScale, currentPEventTPC);
+            }
+            else if(isIn) {
                 for (unsigned int i = 0; i < nSamplesPerHit; i++) {
                     auto smearedPosition = TVector3(
                             gRandom->Gaus(pos.X(), diffSigmaXY),
                             gRandom->Gaus(pos.Y(), diffSigmaXY),
                             gRandom->Gaus(pos.Z(), diffSigmaZ)
                     );
-                    auto iPolyBin = geometry->GetTH2Poly()->FindBin(smearedPosition.X(), smearedPosition.Y());
                     auto iCell = static_cast<int>(geometry->Pos2timecell(smearedPosition.Z(), err_flag));
-                    auto strip = geometry->GetTH2PolyStrip(iPolyBin);
+                    auto strip = geometry->GetStripByPosition(smearedPosition.X(), smearedPosition.Y());
                     if (strip && !err_flag) {
                         currentPEventTPC.AddValByStrip(strip, iCell, edep / nSamplesPerHit * MeVToChargeScale);
                     }
@@ -56,3 +82,111 @@ fwk::VModule::EResultFlag TPCDigitizerRandom::Process(ModuleExchangeSpace &event
 fwk::VModule::EResultFlag TPCDigitizerRandom::Finish() {
     return fwk::VModule::eSuccess;
 }
+
+// Builds analytic point-to-strip mapping from the same diamond-shaped pads as GeometryTPC::InitTH2Poly.
+// Strips of each direction lie on lines spaced by strip pitch, so candidate strips of a point
+// follow directly from its coordinate along the pitch axis.
+bool TPCDigitizerRandom::initFastLookup() {
+    if (!geometry || !geometry->IsOK()) return false;
+    stripPitch = geometry->GetStripPitch();
+    padPitch = geometry->GetPadPitch();
+    const auto padSize = geometry->GetPadSize();
+    padApex = padSize * cos(TMath::Pi() / 6.);
+    padHalfWidth = padSize * sin(TMath::Pi() / 6.);
+    if (!(stripPitch > 0 && padPitch > padApex && padHalfWidth > 0)) return false;
+    fastStrips.clear();
+    for (auto dir: {definitions::projection_type::DIR_U,
+                    definitions::projection_type::DIR_V,
+                    definitions::projection_type::DIR_W}) {
+        auto &lookup = dirLookup[dir];
+        lookup.unit = geometry->GetStripUnitVector(dir);
+        lookup.normal = lookup.unit.Rotate(TMath::Pi() / 2.);
+        std::vector<std::pair<double, PadRow>> rows; // {position along pitch axis, pad row}
+        for (auto section: geometry->GetDirSectionIndexList(dir)) {
+            for (auto num = geometry->GetDirMinStrip(dir, section); num <= geometry->GetDirMaxStrip(dir, section); num++) {
+                auto strip = geometry->GetStripByDir(dir, section, num);
+                if (!strip || strip->Npads() < 1) continue;
+                const auto point0 = geometry->GetReferencePoint() + strip->Offset() - strip->Unit() * 0.5 * padPitch;
+                PadRow row;
+                row.along0 = point0 * lookup.unit;
+                row.npads = strip->Npads();
+                row.stripIndex = fastStrips.size();
+                rows.emplace_back(point0 * lookup.normal, row);
+                fastStrips.push_back(strip);
+            }
+        }
+        if (rows.empty()) return false;
+        std::sort(rows.begin(), rows.end(), [](const std::pair<double, PadRow> &a, const std::pair<double, PadRow> &b) {
+            return a.first < b.first;
+        });
+        lookup.perp0 = rows.front().first;
+        const auto npositions = static_cast<int>(std::lround((rows.back().first - lookup.perp0) / stripPitch)) + 1;
+        lookup.rowStart.assign(npositions + 1, 0);
+        lookup.rows.clear();
+        for (auto &row: rows) {
+            const auto f = (row.first - lookup.perp0) / stripPitch;
+            const auto ipos = static_cast<int>(std::lround(f));
+            if (fabs(f - ipos) > 1e-3) return false; // strips are not on a regular pitch grid
+            lookup.rowStart[ipos + 1]++;
+            lookup.rows.push_back(row.second);
+        }
+        for (auto ipos = 0; ipos < npositions; ipos++) lookup.rowStart[ipos + 1] += lookup.rowStart[ipos];
+    }
+    return true;
+}
+
+// Fills n normal deviates N(0,1) using Box-Muller transformation of counter-based uniform deviates.
+void TPCDigitizerRandom::fillNormals(size_t n) {
+    normals.resize(n + 1);
+    for (size_t i = 0; i < n; i += 2) {
+        tpcreco::utilities::gaussianPair(randomSeed, randomCounter++, 1.0, normals[i], normals[i + 1]);
+    }
+}
+
+int TPCDigitizerRandom::findFastStrip(double x, double y) const {
+    for (const auto &lookup: dirLookup) {
+        const auto perp = x * lookup.normal.X() + y * lookup.normal.Y() - lookup.perp0;
+        const auto along = x * lookup.unit.X() + y * lookup.unit.Y();
+        const auto npositions = static_cast<int>(lookup.rowStart.size()) - 1;
+        const auto iposMin = std::max(0, static_cast<int>(std::ceil((perp - padHalfWidth) / stripPitch)));
+        const auto iposMax = std::min(npositions - 1, static_cast<int>(std::floor((perp + padHalfWidth) / stripPitch)));
+        for (auto ipos = iposMin; ipos <= iposMax; ipos++) {
+            const auto dperp = fabs(perp - ipos * stripPitch);
+            for (auto irow = lookup.rowStart[ipos]; irow < lookup.rowStart[ipos + 1]; irow++) {
+                const auto &row = lookup.rows[irow];
+                const auto f = (along - row.along0) / padPitch;
+                if (!(f >= 0 && f < row.npads)) continue;
+                const auto dalong = (f - static_cast<int>(f)) * padPitch; // position inside pad
+                // diamond: widest at dalong=padApex, pointed at dalong=0 and dalong=padPitch
+                if (dperp * padApex <= dalong * padHalfWidth &&
+                    dperp * (padPitch - padApex) <= (padPitch - dalong) * padHalfWidth) {
+                    return row.stripIndex;
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+// Same as the default loop over samples, but charges of samples falling into the same
+// {strip, time cell} are summed before being added to the event.
+void TPCDigitizerRandom::processHitFast(const TVector3 &pos, double charge, PEventTPC &aEvent) {
+    fillNormals(3 * nSamplesPerHit);
+    sampleKeys.clear();
+    const auto x0 = pos.X(), y0 = pos.Y(), z0 = pos.Z();
+    for (unsigned int i = 0; i < nSamplesPerHit; i++) {
+        const auto cellPos = (z0 + diffSigmaZ * normals[3 * i + 2]) * timecellScale + timecellOffset;
+        if (!(cellPos >= 0.0 && cellPos <= nTimecells)) continue;
+        const auto istrip = findFastStrip(x0 + diffSigmaXY * normals[3 * i], y0 + diffSigmaXY * normals[3 * i + 1]);
+        if (istrip < 0) continue;
+        sampleKeys.push_back(static_cast<int64_t>(istrip) * (nTimecells + 1) + static_cast<int>(cellPos));
+    }
+    std::sort(sampleKeys.begin(), sampleKeys.end());
+    for (size_t i = 0; i < sampleKeys.size();) {
+        auto j = i;
+        while (j < sampleKeys.size() && sampleKeys[j] == sampleKeys[i]) j++;
+        aEvent.AddValByStrip(fastStrips[sampleKeys[i] / (nTimecells + 1)],
+                             static_cast<int>(sampleKeys[i] % (nTimecells + 1)), (j - i) * charge);
+        i = j;
+    }
+}
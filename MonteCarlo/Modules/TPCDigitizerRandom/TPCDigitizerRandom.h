@@ -1,6 +1,10 @@
 #ifndef TPCSOFT_TPCDIGITIZERRANDOM_H
 #define TPCSOFT_TPCDIGITIZERRANDOM_H
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include "TPCReco/VModule.h"
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/EventInfo.h"
@@ -26,6 +30,40 @@ private:
     double diffSigmaZmax{};
     unsigned int nSamplesPerHit{};
 
+    // fast mode: counter-based Gaussian batches, analytic strip lookup, linear time-cell mapping
+    bool fastMode{false};
+    uint64_t randomSeed{0};
+    uint64_t randomCounter{0}; // index of the next pair of normal deviates
+    std::vector<double> normals;     // batch of N(0,1) deviates, 3 per sample
+    std::vector<int64_t> sampleKeys; // strip index * (Ntimecells+1) + time cell, per sample
+
+    // diamond-shaped pads of one strip, corner of the first pad at {along0, perp} in strip coordinates
+    struct PadRow {
+        double along0{0};
+        int npads{0};
+        int stripIndex{0};
+    };
+    // pad rows of one strip direction, ordered by strip position along pitch axis
+    struct DirLookup {
+        TVector2 unit, normal;               // along strip, along pitch axis
+        double perp0{0};                     // position of the first strip along pitch axis [mm]
+        std::vector<unsigned int> rowStart;  // first pad row of each strip position, size=Npositions+1
+        std::vector<PadRow> rows;
+    };
+    std::array<DirLookup, 3> dirLookup;
+    std::vector<std::shared_ptr<StripTPC>> fastStrips;
+    double stripPitch{0}, padPitch{0};
+    double padApex{0}, padHalfWidth{0};  // position along strip and half-width [mm] of the widest point of a pad
+    double timecellScale{0}, timecellOffset{0}; // time cell = z*scale+offset
+    int nTimecells{0};
+
+    bool initFastLookup();
+    void fillNormals(size_t n);
+    int findFastStrip(double x, double y) const; // index in fastStrips or -1
+    void processHitFast(const TVector3 &pos, double charge, PEventTPC &aEvent);
+
+    friend class TPCDigitizerRandomTest;
+
     REGISTER_MODULE(TPCDigitizerRandom)
 };
 
@@ -1,5 +1,7 @@
 #include "TPCDigitizerSRC.h"
 #include "boost/core/null_deleter.hpp"
+#include "TPCReco/colorText.h"
+#include <iostream>
 
 namespace fs = boost::filesystem;
 
@@ -18,6 +20,7 @@ fwk::VModule::EResultFlag TPCDigitizerSRC::Init(boost::property_tree::ptree conf
     nCells = config.get<int>("nCells");
     nPads = config.get<int>("nPads");
     pathToResponses = config.get<fs::path>("StripResponsePath");
+    responseCacheDirectory = config.get<fs::path>("ResponseCacheDirectory", fs::path());
 
     geometry->SetTH2PolyPartition(th2PolyPartitionX,th2PolyPartitionY);
 
@@ -25,9 +28,37 @@ fwk::VModule::EResultFlag TPCDigitizerSRC::Init(boost::property_tree::ptree conf
                                                                peakingTime, geometry->GetSamplingRate(),
                                                                geometry->GetDriftVelocity());
     auto filePath = pathToResponses / fname;
-    if (fs::exists(filePath)) {
+    // binary response tables are mapped instantly and shared between processes,
+    // they are created in the cache directory on first use (if one is configured)
+    boost::filesystem::path binaryPath;
+    if (!responseCacheDirectory.empty()) {
+        boost::system::error_code ec;
+        fs::create_directories(responseCacheDirectory, ec);
+        if (ec) {
+            std::cerr << KRED << "TPCDigitizerSRC: can not create response table cache directory: " << RST
+                      << responseCacheDirectory << " (" << ec.message() << ")" << std::endl;
+        } else {
+            binaryPath = responseCacheDirectory /
+                         StripResponseCalculator::generateBinaryFileName(nStrips, nCells, nPads, diffSigmaXY,
+                                                                         diffSigmaZ, peakingTime,
+                                                                         geometry->GetSamplingRate(),
+                                                                         geometry->GetDriftVelocity());
+        }
+    }
+    if (!binaryPath.empty() && StripResponseTable::isResponseTableFile(binaryPath.string())) {
+        calculator = std::make_unique<StripResponseCalculator>(geometry, nStrips, nCells, nPads, diffSigmaXY,
+                                                               diffSigmaZ, peakingTime, binaryPath.c_str());
+    } else if (fs::exists(filePath)) {
         calculator = std::make_unique<StripResponseCalculator>(geometry, nStrips, nCells, nPads, diffSigmaXY,
                                                                diffSigmaZ, peakingTime, filePath.c_str());
+        if (!binaryPath.empty()) {
+            if (calculator->saveResponseTable(binaryPath.c_str())) {
+                std::cout << "TPCDigitizerSRC: created strip response table " << binaryPath << std::endl;
+            } else {
+                std::cerr << KRED << "TPCDigitizerSRC: can not write strip response table: " << RST
+                          << binaryPath << std::endl;
+            }
+        }
     } else {
         std::stringstream msg;
         msg << "File " << filePath
@@ -46,6 +77,10 @@ fwk::VModule::EResultFlag TPCDigitizerSRC::Process(ModuleExchangeSpace &event) {
     currentPEventTPC = std::shared_ptr<PEventTPC>(&event.tpcPEvt,boost::null_deleter());
     currentPEventTPC->Clear();
     //loop over tracks
+    hitX.clear();
+    hitY.clear();
+    hitZ.clear();
+    hitCharge.clear();
     for (auto &t: currentSimEvent.GetTracks()) {
         //loop over hits
         for (auto &h: t.GetHits()) {
@@ -53,10 +88,17 @@ fwk::VModule::EResultFlag TPCDigitizerSRC::Process(ModuleExchangeSpace &event) {
             auto edep = h.GetEnergy();
             auto isIn = geometry->IsInsideActiveVolume(pos);
             h.SetInside(isIn);
-            if(isIn)
-                calculator->addCharge(pos, edep * MeVToChargeScale, currentPEventTPC);
+            if(isIn) {
+                hitX.push_back(pos.X());
+                hitY.push_back(pos.Y());
+                hitZ.push_back(pos.Z());
+                hitCharge.push_back(edep * MeVToChargeScale);
+            }
         }
     }
+    //smear all deposits of the event at once
+    calculator->addCharges(hitCharge.size(), hitX.data(), hitY.data(), hitZ.data(), hitCharge.data(),
+                           currentPEventTPC);
     currentPEventTPC->SetEventInfo(*aEventInfo);
     event.eventInfo = *aEventInfo;
     return fwk::VModule::eSuccess;
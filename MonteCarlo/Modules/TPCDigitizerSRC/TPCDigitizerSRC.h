@@ -32,6 +32,10 @@ private:
     int nCells{};
     int nPads{};
     boost::filesystem::path pathToResponses;
+    // directory of binary response tables, empty disables them
+    boost::filesystem::path responseCacheDirectory;
+    // per-event buffers of deposits passed to StripResponseCalculator::addCharges
+    std::vector<double> hitX, hitY, hitZ, hitCharge;
     REGISTER_MODULE(TPCDigitizerSRC)
 };
 
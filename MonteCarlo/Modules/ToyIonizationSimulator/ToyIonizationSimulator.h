@@ -1,8 +1,12 @@
 #ifndef TPCSOFT_TOYIONIZATIONSIMULATOR_H
 #define TPCSOFT_TOYIONIZATIONSIMULATOR_H
 
+#include <map>
+#include <vector>
+
 #include "TPCReco/VModule.h"
 #include "TPCReco/IonRangeCalculator.h"
+#include "TPCReco/IonEnergyLossTable.h"
 
 class ToyIonizationSimulator : public fwk::VModule{
 public:
@@ -14,6 +18,9 @@ public:
 private:
     std::unique_ptr<IonRangeCalculator> rangeCalc;
     double pointsPerMm{1};
+    std::map<pid_type, IonEnergyLossTable> lossTables; // cumulative energy loss vs residual range, built once per ion
+    std::vector<double> deposits;
+    const IonEnergyLossTable &getLossTable(pid_type ion);
     REGISTER_MODULE(ToyIonizationSimulator)
 };
 
@@ -0,0 +1,111 @@
+#include "../EventFileExporter/EventFileExporter.h"
+#include "TPCReco/EventInfo.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pt = boost::property_tree;
+
+namespace {
+
+    const uint32_t kEvents = 100;
+
+    pt::ptree MakeConfig(const std::string &fileName, bool asynchronous) {
+        pt::ptree config;
+        config.put("FileName", fileName);
+        config.put("Asynchronous", asynchronous);
+        config.put("QueueSize", 4); // smaller than kEvents, so the simulation thread has to wait for the writer
+        pt::ptree branches;
+        for (const std::string name: {"SimEvent", "Track3D"}) {
+            pt::ptree item;
+            item.put("", name);
+            branches.push_back(std::make_pair("", item));
+        }
+        config.add_child("EnabledBranches", branches);
+        return config;
+    }
+
+    void ProcessEvents(fwk::VModule &exporter) {
+        ModuleExchangeSpace event;
+        event.eventInfo.SetRunId(7);
+        for (uint32_t i = 0; i < kEvents; ++i) {
+            event.eventInfo.SetEventId(i);
+            ASSERT_EQ(exporter.Process(event), fwk::VModule::eSuccess);
+        }
+    }
+
+    void Export(const std::string &fileName, bool asynchronous) {
+        std::unique_ptr<fwk::VModule> exporter(EventFileExporter::Create());
+        ASSERT_EQ(exporter->Init(MakeConfig(fileName, asynchronous)), fwk::VModule::eSuccess);
+        ProcessEvents(*exporter);
+        ASSERT_EQ(exporter->Finish(), fwk::VModule::eSuccess);
+    }
+
+    struct TreeContent {
+        Long64_t simEntries{-1};
+        std::vector<std::pair<long, uint32_t>> ids;
+    };
+
+    TreeContent Read(const std::string &fileName) {
+        TreeContent content;
+        TFile file(fileName.c_str(), "READ");
+        auto tpcData = dynamic_cast<TTree *>(file.Get("TPCData"));
+        auto tpcRecoData = dynamic_cast<TTree *>(file.Get("TPCRecoData"));
+        if (!tpcData || !tpcRecoData)
+            return content;
+        content.simEntries = tpcData->GetEntries();
+        eventraw::EventInfo *info = nullptr;
+        tpcRecoData->SetBranchAddress("EventInfo", &info);
+        for (Long64_t i = 0; i < tpcRecoData->GetEntries(); ++i) {
+            tpcRecoData->GetEntry(i);
+            content.ids.emplace_back(info->GetRunId(), info->GetEventId());
+        }
+        tpcRecoData->ResetBranchAddresses();
+        delete info;
+        return content;
+    }
+}
+
+TEST(EventFileExporter, AsynchronousSameAsSynchronous) {
+    const std::string syncName = "EventFileExporter_tst_sync.root";
+    const std::string asyncName = "EventFileExporter_tst_async.root";
+    Export(syncName, false);
+    Export(asyncName, true);
+
+    auto sync = Read(syncName);
+    auto async = Read(asyncName);
+    std::remove(syncName.c_str());
+    std::remove(asyncName.c_str());
+
+    ASSERT_EQ(sync.simEntries, kEvents);
+    ASSERT_EQ(sync.ids.size(), kEvents);
+    for (uint32_t i = 0; i < kEvents; ++i) {
+        EXPECT_EQ(sync.ids[i].first, 7);
+        EXPECT_EQ(sync.ids[i].second, i);
+    }
+    EXPECT_EQ(async.simEntries, sync.simEntries);
+    EXPECT_EQ(async.ids, sync.ids);
+}
+
+TEST(EventFileExporter, AsynchronousShutdownWithoutFinish) {
+    const std::string fileName = "EventFileExporter_tst_abort.root";
+    {
+        std::unique_ptr<fwk::VModule> exporter(EventFileExporter::Create());
+        ASSERT_EQ(exporter->Init(MakeConfig(fileName, true)), fwk::VModule::eSuccess);
+        ProcessEvents(*exporter);
+        // destroyed with the writer thread still running, as when a run throws before Finish()
+    }
+    // trees are not written, the file is closed
+    EXPECT_EQ(Read(fileName).simEntries, -1);
+    std::remove(fileName.c_str());
+}
+
+TEST(EventFileExporter, DestroyWithoutInit) {
+    std::unique_ptr<fwk::VModule> exporter(EventFileExporter::Create());
+    exporter.reset();
+    SUCCEED();
+}
@@ -0,0 +1,67 @@
+#include "../TPCDigitizerRandom/TPCDigitizerRandom.h"
+#include "TPCReco/CounterRandom.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <tuple>
+
+namespace pt = boost::property_tree;
+
+class TPCDigitizerRandomTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        geometry = std::make_shared<GeometryTPC>(
+                (std::string(TPCRECO_RESOURCE_DIR) + "/geometry_ELITPC.dat").c_str(), false);
+    }
+
+    static void TearDownTestSuite() { geometry.reset(); }
+
+    void SetUp() override {
+        digitizer.reset(static_cast<TPCDigitizerRandom *>(TPCDigitizerRandom::Create()));
+        digitizer->SetGeometry(geometry);
+        pt::ptree config;
+        config.put("MeVToChargeScale", 1.0);
+        config.put("sigmaXYmin", 0.5);
+        config.put("sigmaXYmax", 0.5);
+        config.put("sigmaZmin", 0.5);
+        config.put("sigmaZmax", 0.5);
+        config.put("NSamplesPerHit", 100);
+        config.put("FastMode", true);
+        config.put("RandomSeed", 12345);
+        digitizer->Init(config);
+    }
+
+    bool IsFastMode() const { return digitizer->fastMode; }
+
+    std::shared_ptr<StripTPC> FindFastStrip(double x, double y) const {
+        const auto index = digitizer->findFastStrip(x, y);
+        return index < 0 ? std::shared_ptr<StripTPC>() : digitizer->fastStrips.at(index);
+    }
+
+    static std::shared_ptr<GeometryTPC> geometry;
+    std::unique_ptr<TPCDigitizerRandom> digitizer;
+};
+
+std::shared_ptr<GeometryTPC> TPCDigitizerRandomTest::geometry;
+
+TEST_F(TPCDigitizerRandomTest, FastStripLookupMatchesGeometry) {
+    ASSERT_TRUE(geometry->IsOK());
+    ASSERT_TRUE(IsFastMode());
+    double xmin, xmax, ymin, ymax;
+    std::tie(xmin, xmax, ymin, ymax) = geometry->rangeXY();
+    const double margin = 5; // [mm] points outside of the active area are covered too
+
+    const unsigned long nPoints = 200000;
+    unsigned long nInside = 0, nMismatched = 0;
+    for (unsigned long i = 0; i < nPoints; ++i) {
+        const auto x = xmin - margin + (xmax - xmin + 2 * margin) * tpcreco::utilities::uniform01(1, 2 * i);
+        const auto y = ymin - margin + (ymax - ymin + 2 * margin) * tpcreco::utilities::uniform01(1, 2 * i + 1);
+        const auto ibin = geometry->FindStripBin(x, y);
+        const auto expected = ibin < 0 ? std::shared_ptr<StripTPC>() : geometry->GetTH2PolyStrip(ibin);
+        if (expected) nInside++;
+        if (FindFastStrip(x, y) != expected) nMismatched++;
+    }
+    EXPECT_GT(nInside, nPoints / 2);
+    // points closer than rounding errors to a pad edge may go either way
+    EXPECT_LE(nMismatched, nPoints / 100000);
+}
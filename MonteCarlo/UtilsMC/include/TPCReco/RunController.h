@@ -5,6 +5,7 @@
 #include <list>
 #include <map>
 #include "VModule.h"
+#include "TraceRecorder.h"
 #include "boost/property_tree/ptree.hpp"
 #include "ModuleExchangeSpace.h"
 
@@ -39,6 +40,12 @@ namespace fwk {
         /// Is timing enabled?
         bool IsTiming() const { return fTiming; }
 
+        /// Is trace recording enabled?
+        bool IsTracing() const { return fTraceRecorder != nullptr; }
+
+        /// Are modules run as pipeline stages on separate threads?
+        bool IsPipeline() const { return fPipeline; }
+
         virtual void Init(const boost::property_tree::ptree &config);
         virtual EBreakStatus RunSingle();
         virtual void RunFull();
@@ -48,6 +55,9 @@ namespace fwk {
     private:
         void BuildModules(const boost::property_tree::ptree &moduleConfig);
         void InitModules(const boost::property_tree::ptree &moduleConfig, const std::shared_ptr<GeometryTPC>& geom);
+        void InitTrace(const boost::property_tree::ptree &traceConfig);
+        void FinishTrace();
+        void RunPipeline();
         mutable std::list<std::string> fUsedModuleNames;
         std::map<std::string, std::unique_ptr<VModule>> fModules;
         std::vector<std::string> fModuleSequence;
@@ -58,6 +68,15 @@ namespace fwk {
         utl::Stopwatch fStopwatch;
         utl::RealTimeStopwatch fRealTimeStopwatch;
 
+        std::shared_ptr<utl::TraceRecorder> fTraceRecorder;
+        std::string fTraceJsonFile;
+        std::string fTraceRootFile;
+        std::vector<unsigned int> fTraceModuleIds; // same order as fModuleSequence
+        unsigned int fTraceEventId{0};
+        long fEventCounter{0};
+
+        bool fPipeline{false};
+        size_t fPipelinePoolSize{0}; // number of ModuleExchangeSpace objects in flight
 
     };
 
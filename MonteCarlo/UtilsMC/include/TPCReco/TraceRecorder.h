@@ -0,0 +1,127 @@
+#ifndef TPCSOFT_TRACERECORDER_H
+#define TPCSOFT_TRACERECORDER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace utl {
+
+    /**
+       \class TraceRecorder TraceRecorder.h "TPCReco/TraceRecorder.h"
+
+       Records start/stop timestamps of named spans (module Process calls,
+       events, I/O flushes) and keeps per-name latency distributions.
+
+       Spans are exported as Chrome/Perfetto JSON trace ("traceEvents" array of
+       complete "X" events, timestamps in microseconds), which can be opened
+       with chrome://tracing or ui.perfetto.dev. Latency distributions use
+       fixed logarithmic bins, so memory does not grow with the number of
+       events; only the number of spans kept for the JSON file is capped.
+       Recording is thread-safe, spans from different threads get separate
+       "tid" tracks in the JSON file.
+    */
+
+    class TraceRecorder {
+
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        /// Latency histogram with logarithmic bins from 100 ns to 10^4 s
+        class LatencyHistogram {
+        public:
+            static const int binsPerDecade = 20;
+            static const int nDecades = 11;
+            static constexpr double minTime = 1e-7; // [s]
+
+            LatencyHistogram();
+            void Fill(double seconds);
+            unsigned long GetEntries() const { return fEntries; }
+            double GetMean() const { return fEntries ? fSum / fEntries : 0; }
+            double GetMax() const { return fMax; }
+            /// Quantile [s], interpolated geometrically inside bin, q=[0, 1]
+            double GetQuantile(double q) const;
+            /// lower edge [s] of bin i=[0, nBins], bin 0 is underflow
+            static double GetBinLowEdge(int i);
+            static int GetNbins() { return binsPerDecade * nDecades; }
+            unsigned long GetBinContent(int i) const { return fCounts[i]; } // i=[0, nBins+1]
+
+        private:
+            std::vector<unsigned long> fCounts; // underflow, nBins, overflow
+            unsigned long fEntries;
+            double fSum;
+            double fMax;
+        };
+
+        /// RAII helper: records span from construction to destruction, no-op for NULL recorder
+        class Scope {
+        public:
+            Scope(TraceRecorder *recorder, unsigned int nameId) :
+                    fRecorder(recorder), fNameId(nameId) {
+                if (fRecorder) fStart = Clock::now();
+            }
+            ~Scope() {
+                if (fRecorder) fRecorder->Record(fNameId, fStart, Clock::now());
+            }
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            TraceRecorder *fRecorder;
+            unsigned int fNameId;
+            Clock::time_point fStart;
+        };
+
+        explicit TraceRecorder(size_t maxTraceEvents = 1000000);
+
+        /// Returns ID of a span name within given category (e.g. "module", "event", "io")
+        unsigned int GetNameId(const std::string &name, const std::string &category);
+
+        /// Event number attached to spans recorded by the calling thread
+        void SetCurrentEvent(long eventId);
+        long GetCurrentEvent() const;
+
+        void Record(unsigned int nameId, Clock::time_point start, Clock::time_point stop);
+
+        size_t GetNames() const { return fNames.size(); }
+        const std::string &GetName(unsigned int nameId) const { return fNames[nameId]; }
+        const std::string &GetCategory(unsigned int nameId) const { return fCategories[nameId]; }
+        const LatencyHistogram &GetLatency(unsigned int nameId) const { return fLatency[nameId]; }
+        size_t GetNumberOfSpans() const { return fSpans.size(); }
+        size_t GetNumberOfDroppedSpans() const { return fDropped; }
+
+        /// Writes Chrome/Perfetto JSON trace file, returns false on I/O error
+        bool WriteChromeTrace(const std::string &fileName) const;
+
+        /// Writes latency histograms and summary tree (p50/p95/p99) into "Trace" directory
+        /// of given ROOT file, the file is updated if it already exists.
+        bool WriteLatencyHistograms(const std::string &fileName) const;
+
+    private:
+        struct Span {
+            unsigned int nameId;
+            unsigned int threadIndex;
+            long eventId;
+            int64_t start; // [ns] since construction of recorder
+            int64_t duration; // [ns]
+        };
+
+        Clock::time_point fOrigin;
+        size_t fMaxTraceEvents;
+        size_t fDropped;
+        mutable std::mutex fMutex;
+        std::vector<std::thread::id> fThreads; // index of thread = "tid" in JSON trace
+        std::vector<std::string> fNames;
+        std::vector<std::string> fCategories;
+        std::vector<LatencyHistogram> fLatency;
+        std::vector<Span> fSpans;
+
+    };
+
+}
+
+#endif //TPCSOFT_TRACERECORDER_H
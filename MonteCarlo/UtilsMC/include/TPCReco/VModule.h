@@ -9,6 +9,7 @@
 #include "ObjectFactory.h"
 #include "Stopwatch.h"
 #include "RealTimeStopwatch.h"
+#include "TraceRecorder.h"
 #include "ModuleExchangeSpace.h"
 #include "TPCReco/GeometryTPC.h"
 
@@ -147,9 +148,13 @@ private:                                                                 \
 
         void SetGeometry(std::shared_ptr<GeometryTPC> geom) { geometry = std::move(geom); }
 
+        /// Set by RunController before Init() when tracing is enabled, modules may record own spans (e.g. I/O)
+        void SetTraceRecorder(std::shared_ptr<utl::TraceRecorder> recorder) { traceRecorder = std::move(recorder); }
+
 
     protected:
         std::shared_ptr<GeometryTPC> geometry;
+        std::shared_ptr<utl::TraceRecorder> traceRecorder; // NULL when tracing is disabled
     private:
         utl::Stopwatch fStopwatch;
         utl::RealTimeStopwatch fRealTimeStopwatch;
@@ -1,7 +1,18 @@
 #include "TPCReco/RunController.h"
 #include "TPCReco/TabularStream.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <boost/lexical_cast.hpp>
+#include "TROOT.h"
+#include "TRandom3.h"
 #include "TPCReco/VModule.h"
 
 
@@ -9,6 +20,115 @@ using namespace std;
 using namespace utl;
 namespace pt = boost::property_tree;
 
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    inline double SecondsSince(const Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // event travelling between pipeline stages, NULL event marks end of the run
+    struct PipelineItem {
+        ModuleExchangeSpace *event;
+        long sequence;
+    };
+
+    // bounded blocking FIFO connecting pipeline stages
+    class PipelineQueue {
+    public:
+        explicit PipelineQueue(size_t capacity) : fCapacity(capacity) { }
+
+        void Push(const PipelineItem &item) {
+            {
+                std::unique_lock<std::mutex> lock(fMutex);
+                fNotFull.wait(lock, [this] { return fItems.size() < fCapacity; });
+                fItems.push_back(item);
+            }
+            fNotEmpty.notify_one();
+        }
+
+        PipelineItem Pop() {
+            PipelineItem item;
+            {
+                std::unique_lock<std::mutex> lock(fMutex);
+                fNotEmpty.wait(lock, [this] { return !fItems.empty(); });
+                item = fItems.front();
+                fItems.pop_front();
+            }
+            fNotFull.notify_one();
+            return item;
+        }
+
+    private:
+        size_t fCapacity;
+        std::deque<PipelineItem> fItems;
+        std::mutex fMutex;
+        std::condition_variable fNotEmpty;
+        std::condition_variable fNotFull;
+    };
+
+    // gRandom replacement used in pipeline mode: every stage thread draws from its own engine,
+    // so modules in different stages neither race on the shared generator nor interleave its sequence.
+    // Other threads (main thread, helper threads of modules) share a fallback engine behind a mutex.
+    // The whole virtual TRandom interface is forwarded, so SetSeed()/GetSeed() and the distributions
+    // act on the engine of the calling thread rather than on the state of this proxy.
+    class ThreadLocalRandom : public TRandom {
+    public:
+        explicit ThreadLocalRandom(TRandom *fallback) : fFallback(fallback) { }
+
+        static thread_local TRandom *tEngine;
+
+        Int_t Binomial(Int_t ntot, Double_t prob) override { return Call([&](TRandom *r) { return r->Binomial(ntot, prob); }); }
+        Double_t BreitWigner(Double_t mean, Double_t gamma) override { return Call([&](TRandom *r) { return r->BreitWigner(mean, gamma); }); }
+        void Circle(Double_t &x, Double_t &y, Double_t r) override { Call([&](TRandom *e) { e->Circle(x, y, r); }); }
+        Double_t Exp(Double_t tau) override { return Call([&](TRandom *r) { return r->Exp(tau); }); }
+        Double_t Gaus(Double_t mean, Double_t sigma) override { return Call([&](TRandom *r) { return r->Gaus(mean, sigma); }); }
+        UInt_t GetSeed() const override { return Call([&](TRandom *r) { return r->GetSeed(); }); }
+        UInt_t Integer(UInt_t imax) override { return Call([&](TRandom *r) { return r->Integer(imax); }); }
+        Double_t Landau(Double_t mean, Double_t sigma) override { return Call([&](TRandom *r) { return r->Landau(mean, sigma); }); }
+        // return type differs between ROOT versions
+        auto Poisson(Double_t mean) -> decltype(std::declval<TRandom &>().Poisson(mean)) override {
+            return Call([&](TRandom *r) { return r->Poisson(mean); });
+        }
+        Double_t PoissonD(Double_t mean) override { return Call([&](TRandom *r) { return r->PoissonD(mean); }); }
+        void Rannor(Float_t &a, Float_t &b) override { Call([&](TRandom *r) { r->Rannor(a, b); }); }
+        void Rannor(Double_t &a, Double_t &b) override { Call([&](TRandom *r) { r->Rannor(a, b); }); }
+        void ReadRandom(const char *filename) override { Call([&](TRandom *r) { r->ReadRandom(filename); }); }
+        void SetSeed(ULong_t seed) override { Call([&](TRandom *r) { r->SetSeed(seed); }); }
+        Double_t Rndm() override { return Call([](TRandom *r) { return r->Rndm(); }); }
+        void RndmArray(Int_t n, Float_t *array) override { Call([&](TRandom *r) { r->RndmArray(n, array); }); }
+        void RndmArray(Int_t n, Double_t *array) override { Call([&](TRandom *r) { r->RndmArray(n, array); }); }
+        void Sphere(Double_t &x, Double_t &y, Double_t &z, Double_t r) override { Call([&](TRandom *e) { e->Sphere(x, y, z, r); }); }
+        Double_t Uniform(Double_t x1) override { return Call([&](TRandom *r) { return r->Uniform(x1); }); }
+        Double_t Uniform(Double_t x1, Double_t x2) override { return Call([&](TRandom *r) { return r->Uniform(x1, x2); }); }
+        void WriteRandom(const char *filename) const override { Call([&](TRandom *r) { r->WriteRandom(filename); }); }
+
+    private:
+        template<class F>
+        auto Call(F f) const -> decltype(f(std::declval<TRandom *>())) {
+            if (tEngine)
+                return f(tEngine);
+            std::lock_guard<std::mutex> lock(fFallbackMutex);
+            return f(fFallback);
+        }
+
+        TRandom *fFallback;
+        mutable std::mutex fFallbackMutex;
+    };
+
+    thread_local TRandom *ThreadLocalRandom::tEngine = nullptr;
+
+    struct StageStatistics {
+        double busy{0};    // [s] inside module Process()
+        double starved{0}; // [s] waiting for input event
+        double blocked{0}; // [s] waiting for space in output queue
+        long events{0};
+    };
+
+}
+
+
 namespace fwk {
 
     RunController::RunController() :
@@ -38,6 +158,15 @@ namespace fwk {
         fTiming = config.get<bool>("EnableTiming");
         auto geom = std::make_shared<GeometryTPC>(config.get<std::string>("GeometryConfig").c_str());
         BuildModules(config.get_child("ModuleSequence"));
+        auto traceConfig = config.get_child_optional("Trace");
+        if (traceConfig)
+            InitTrace(*traceConfig);
+        auto pipelineConfig = config.get_child_optional("Pipeline");
+        if (pipelineConfig) {
+            fPipeline = pipelineConfig->get<bool>("Enabled", true);
+            fPipelinePoolSize = std::max<size_t>(fModuleSequence.size() + 1,
+                                                 pipelineConfig->get<size_t>("PoolSize", 2 * fModuleSequence.size()));
+        }
         InitModules(config.get_child("ModuleConfiguration"), geom);
     }
 
@@ -45,7 +174,13 @@ namespace fwk {
     RunController::EBreakStatus
     RunController::RunSingle() {
         fwk::VModule::EResultFlag res;
-        for (const auto &m: fModuleSequence) {
+        if (fTraceRecorder)
+            fTraceRecorder->SetCurrentEvent(fEventCounter);
+        ++fEventCounter;
+        utl::TraceRecorder::Scope eventScope(fTraceRecorder.get(), fTraceEventId);
+        for (size_t i = 0; i < fModuleSequence.size(); ++i) {
+            const auto &m = fModuleSequence[i];
+            utl::TraceRecorder::Scope moduleScope(fTraceRecorder.get(), fTraceRecorder ? fTraceModuleIds[i] : 0);
             if (!fTiming)
                 res = fModules[m]->Process(*fCurrentEvent);
             else
@@ -60,10 +195,125 @@ namespace fwk {
 
     void
     RunController::RunFull() {
+        if (fPipeline && fModuleSequence.size() > 1) {
+            RunPipeline();
+            return;
+        }
         while (RunSingle() == eNoBreak);
     }
 
 
+    // Every module runs on its own thread and events are passed between stages through bounded queues.
+    // Events are numbered by the first stage. When any stage breaks the loop on event N, events
+    // preceding N are completed by the remaining stages, while events following N are dropped
+    // unprocessed, so the set of fully processed events is the same as in sequential mode.
+    void
+    RunController::RunPipeline() {
+        ROOT::EnableThreadSafety(); // modules of different stages use ROOT concurrently
+        const size_t nStages = fModuleSequence.size();
+        std::vector<std::unique_ptr<ModuleExchangeSpace>> pool;
+        PipelineQueue freeEvents(fPipelinePoolSize);
+        for (size_t i = 0; i < fPipelinePoolSize; ++i) {
+            pool.emplace_back(new ModuleExchangeSpace);
+            freeEvents.Push({pool.back().get(), -1});
+        }
+        std::vector<std::unique_ptr<PipelineQueue>> queues; // queues[i] = input of stage i, i>0
+        for (size_t i = 0; i < nStages; ++i)
+            queues.emplace_back(new PipelineQueue(fPipelinePoolSize));
+
+        // independent, reproducible random number streams for all stages and for other threads
+        auto sharedRandom = gRandom;
+        std::vector<std::unique_ptr<TRandom>> engines;
+        for (size_t i = 0; i < nStages; ++i)
+            engines.emplace_back(new TRandom3(1 + sharedRandom->Integer(4294967294u)));
+        TRandom3 fallbackRandom(1 + sharedRandom->Integer(4294967294u));
+        ThreadLocalRandom pipelineRandom(&fallbackRandom);
+        gRandom = &pipelineRandom;
+
+        std::vector<VModule *> modules;
+        for (const auto &m: fModuleSequence)
+            modules.push_back(fModules[m].get());
+        std::atomic<long> breakSequence(std::numeric_limits<long>::max());
+        std::vector<StageStatistics> statistics(nStages);
+        const auto startTime = Clock::now();
+
+        auto stage = [&](const size_t istage) {
+            ThreadLocalRandom::tEngine = engines[istage].get();
+            auto module = modules[istage];
+            auto &stat = statistics[istage];
+            long nextSequence = fEventCounter;
+            while (true) {
+                auto t0 = Clock::now();
+                PipelineItem item{nullptr, -1};
+                if (istage == 0) {
+                    if (breakSequence.load() == std::numeric_limits<long>::max()) {
+                        item = freeEvents.Pop();
+                        item.sequence = nextSequence++;
+                    }
+                } else
+                    item = queues[istage]->Pop();
+                stat.starved += SecondsSince(t0);
+                if (!item.event) { // end of run
+                    if (istage + 1 < nStages)
+                        queues[istage + 1]->Push(item);
+                    break;
+                }
+                if (item.sequence > breakSequence.load()) {
+                    freeEvents.Push(item);
+                    continue;
+                }
+                if (fTraceRecorder)
+                    fTraceRecorder->SetCurrentEvent(item.sequence);
+                t0 = Clock::now();
+                VModule::EResultFlag res;
+                {
+                    utl::TraceRecorder::Scope moduleScope(fTraceRecorder.get(), fTraceRecorder ? fTraceModuleIds[istage] : 0);
+                    if (!fTiming)
+                        res = module->Process(*item.event);
+                    else
+                        res = module->ProcessWithTiming(*item.event);
+                }
+                stat.busy += SecondsSince(t0);
+                ++stat.events;
+                if (res == VModule::eSuccess && istage + 1 < nStages) {
+                    t0 = Clock::now();
+                    queues[istage + 1]->Push(item);
+                    stat.blocked += SecondsSince(t0);
+                    continue;
+                }
+                if (res != VModule::eSuccess && res != VModule::eContinueLoop) {
+                    long expected = breakSequence.load();
+                    while (item.sequence < expected && !breakSequence.compare_exchange_weak(expected, item.sequence));
+                }
+                freeEvents.Push(item);
+            }
+            if (istage == 0)
+                fEventCounter = nextSequence;
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < nStages; ++i)
+            threads.emplace_back(stage, i);
+        for (auto &t: threads)
+            t.join();
+        gRandom = sharedRandom;
+
+        const double wallTime = SecondsSince(startTime);
+        TabularStream tab("r:  .  .  .  .  .");
+        tab << "Stage" << endc << "EVENTS" << endc << "BUSY" << endc << "STARVED" << endc << "BLOCKED" << endc << "UTIL%"
+            << endr << hline;
+        for (size_t i = 0; i < nStages; ++i) {
+            const auto &stat = statistics[i];
+            tab << fModuleSequence[i] << endc << stat.events << endc << stat.busy << endc << stat.starved << endc
+                << stat.blocked << endc << int(1000 * stat.busy / wallTime + 0.5) / 10. << endr;
+        }
+        ostringstream info;
+        info << "\n\nPipeline stages: wall time [s] and utilisation, total wall time " << wallTime << " s\n"
+             << tab;
+        std::cout << info.str() << std::endl;
+    }
+
+
     void
     RunController::Finish() {
         fStopwatch.Stop();
@@ -115,6 +365,9 @@ namespace fwk {
                  << tab;
             std::cout << info.str() << std::endl;
         }
+        if (fTraceRecorder)
+            FinishTrace();
+
         const double time = fRealTimeStopwatch.Stop();
         ostringstream info;
         info << "Total real time of the run: " << time / second << " sec.";
@@ -177,10 +430,49 @@ namespace fwk {
                 throw std::runtime_error(emsg.str());
             }
             fModules[m]->SetGeometry(geom);
+            fModules[m]->SetTraceRecorder(fTraceRecorder);
             fModules[m]->Init(*modCfg);
             if (fTiming)
                 fModules[m]->InitTiming();
         }
     }
 
+
+    void
+    RunController::InitTrace(const boost::property_tree::ptree &traceConfig) {
+        fTraceJsonFile = traceConfig.get<std::string>("JsonFile", "");
+        fTraceRootFile = traceConfig.get<std::string>("RootFile", "");
+        fTraceRecorder = std::make_shared<utl::TraceRecorder>(traceConfig.get<size_t>("MaxTraceEvents", 1000000));
+        fTraceEventId = fTraceRecorder->GetNameId("Event", "event");
+        fTraceModuleIds.clear();
+        for (const auto &m: fModuleSequence)
+            fTraceModuleIds.push_back(fTraceRecorder->GetNameId(m, "module"));
+    }
+
+    // Called after Finish() of all modules, so that output files of modules are already closed
+    void
+    RunController::FinishTrace() {
+        TabularStream tab("r:  .  .  .  .  .");
+        tab << "Span" << endc << "CALLS" << endc << "P50" << endc << "P95" << endc << "P99" << endc << "MAX" << endr
+            << hline;
+        for (unsigned int id = 0; id < fTraceRecorder->GetNames(); ++id) {
+            const auto &latency = fTraceRecorder->GetLatency(id);
+            tab << fTraceRecorder->GetName(id) << endc << latency.GetEntries() << endc
+                << latency.GetQuantile(0.50) << endc << latency.GetQuantile(0.95) << endc
+                << latency.GetQuantile(0.99) << endc << latency.GetMax() << endr;
+        }
+        ostringstream info;
+        info << "\n\nWall-time latency [s] of traced spans\n"
+             << tab;
+        std::cout << info.str() << std::endl;
+
+        if (fTraceRecorder->GetNumberOfDroppedSpans())
+            std::cout << "Trace: " << fTraceRecorder->GetNumberOfDroppedSpans()
+                      << " spans exceeding MaxTraceEvents were not stored in JSON trace." << std::endl;
+        if (!fTraceJsonFile.empty() && !fTraceRecorder->WriteChromeTrace(fTraceJsonFile))
+            std::cerr << "Trace: failed to write JSON trace file: " << fTraceJsonFile << std::endl;
+        if (!fTraceRootFile.empty() && !fTraceRecorder->WriteLatencyHistograms(fTraceRootFile))
+            std::cerr << "Trace: failed to write latency histograms to: " << fTraceRootFile << std::endl;
+    }
+
 }
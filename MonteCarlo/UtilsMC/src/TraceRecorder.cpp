@@ -0,0 +1,230 @@
+#include "TPCReco/TraceRecorder.h"
+#include "TPCReco/SaveCurrentTDirectory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+
+#include "TFile.h"
+#include "TH1D.h"
+#include "TTree.h"
+
+using namespace utl;
+
+
+constexpr double TraceRecorder::LatencyHistogram::minTime;
+
+namespace {
+    thread_local long tCurrentEvent = -1;
+}
+
+
+TraceRecorder::LatencyHistogram::LatencyHistogram() :
+        fCounts(GetNbins() + 2, 0),
+        fEntries(0),
+        fSum(0),
+        fMax(0)
+{
+}
+
+
+void
+TraceRecorder::LatencyHistogram::Fill(const double seconds)
+{
+    int bin = 0;
+    if (seconds >= minTime)
+        bin = std::min(GetNbins() + 1, 1 + static_cast<int>(binsPerDecade * std::log10(seconds / minTime)));
+    ++fCounts[bin];
+    ++fEntries;
+    fSum += seconds;
+    if (seconds > fMax)
+        fMax = seconds;
+}
+
+
+double
+TraceRecorder::LatencyHistogram::GetBinLowEdge(const int i)
+{
+    return minTime * std::pow(10.0, double(i - 1) / binsPerDecade);
+}
+
+
+double
+TraceRecorder::LatencyHistogram::GetQuantile(const double q) const
+{
+    if (!fEntries)
+        return 0;
+    const double target = q * fEntries;
+    double sum = 0;
+    for (int i = 0; i <= GetNbins() + 1; ++i) {
+        if (!fCounts[i] || sum + fCounts[i] < target) {
+            sum += fCounts[i];
+            continue;
+        }
+        if (i == 0)
+            return minTime;
+        if (i == GetNbins() + 1)
+            return fMax;
+        const double frac = (target - sum) / fCounts[i];
+        return std::min(fMax, GetBinLowEdge(i) * std::pow(10.0, frac / binsPerDecade));
+    }
+    return fMax;
+}
+
+
+TraceRecorder::TraceRecorder(const size_t maxTraceEvents) :
+        fOrigin(Clock::now()),
+        fMaxTraceEvents(maxTraceEvents),
+        fDropped(0)
+{
+}
+
+
+void
+TraceRecorder::SetCurrentEvent(const long eventId)
+{
+    tCurrentEvent = eventId;
+}
+
+
+long
+TraceRecorder::GetCurrentEvent() const
+{
+    return tCurrentEvent;
+}
+
+
+unsigned int
+TraceRecorder::GetNameId(const std::string &name, const std::string &category)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (unsigned int i = 0; i < fNames.size(); ++i)
+        if (fNames[i] == name && fCategories[i] == category)
+            return i;
+    fNames.push_back(name);
+    fCategories.push_back(category);
+    fLatency.emplace_back();
+    return fNames.size() - 1;
+}
+
+
+void
+TraceRecorder::Record(const unsigned int nameId, const Clock::time_point start, const Clock::time_point stop)
+{
+    const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    std::lock_guard<std::mutex> lock(fMutex);
+    fLatency[nameId].Fill(duration * 1e-9);
+    if (fSpans.size() >= fMaxTraceEvents) {
+        ++fDropped;
+        return;
+    }
+    const auto thread = std::this_thread::get_id();
+    unsigned int threadIndex = 0;
+    while (threadIndex < fThreads.size() && fThreads[threadIndex] != thread)
+        ++threadIndex;
+    if (threadIndex == fThreads.size())
+        fThreads.push_back(thread);
+    fSpans.push_back({nameId, threadIndex, tCurrentEvent,
+                      std::chrono::duration_cast<std::chrono::nanoseconds>(start - fOrigin).count(),
+                      duration});
+}
+
+
+namespace {
+
+    std::string
+    EscapeJSON(const std::string &s)
+    {
+        std::string out;
+        for (const char c: s) {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20)
+                out += c;
+        }
+        return out;
+    }
+
+}
+
+
+bool
+TraceRecorder::WriteChromeTrace(const std::string &fileName) const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    std::ofstream out(fileName);
+    if (!out)
+        return false;
+    const int pid = getpid();
+    out << std::fixed << std::setprecision(3)
+        << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedSpans\":" << fDropped << "},\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"name\":\"mcRunController\"}}";
+    for (const auto &s: fSpans) {
+        out << ",\n{\"name\":\"" << EscapeJSON(fNames[s.nameId])
+            << "\",\"cat\":\"" << EscapeJSON(fCategories[s.nameId])
+            << "\",\"ph\":\"X\",\"ts\":" << s.start * 1e-3
+            << ",\"dur\":" << s.duration * 1e-3
+            << ",\"pid\":" << pid << ",\"tid\":" << s.threadIndex << ",\"args\":{\"event\":" << s.eventId << "}}";
+    }
+    out << "\n]}\n";
+    out.close();
+    return !out.fail();
+}
+
+
+bool
+TraceRecorder::WriteLatencyHistograms(const std::string &fileName) const
+{
+    SaveCurrentTDirectory save;
+    TFile file(fileName.c_str(), "UPDATE");
+    if (file.IsZombie())
+        return false;
+    auto dir = file.GetDirectory("Trace");
+    if (!dir)
+        dir = file.mkdir("Trace");
+    dir->cd();
+
+    std::vector<double> edges(LatencyHistogram::GetNbins() + 1);
+    for (int i = 0; i <= LatencyHistogram::GetNbins(); ++i)
+        edges[i] = LatencyHistogram::GetBinLowEdge(i + 1);
+
+    std::string name, category;
+    Long64_t entries;
+    double mean, p50, p95, p99, max;
+    auto summary = new TTree("latencySummary", "Latency quantiles [s] per traced span"); // owned by file
+    summary->Branch("name", &name);
+    summary->Branch("category", &category);
+    summary->Branch("entries", &entries);
+    summary->Branch("mean", &mean);
+    summary->Branch("p50", &p50);
+    summary->Branch("p95", &p95);
+    summary->Branch("p99", &p99);
+    summary->Branch("max", &max);
+
+    for (unsigned int id = 0; id < fNames.size(); ++id) {
+        const auto &latency = fLatency[id];
+        const auto hname = "latency_" + fCategories[id] + "_" + fNames[id];
+        TH1D h(hname.c_str(), (fNames[id] + ";latency [s];calls").c_str(), LatencyHistogram::GetNbins(), edges.data());
+        h.SetDirectory(nullptr);
+        for (int i = 0; i <= LatencyHistogram::GetNbins() + 1; ++i)
+            h.SetBinContent(i, latency.GetBinContent(i));
+        h.SetEntries(latency.GetEntries());
+        h.Write("", TObject::kOverwrite);
+
+        name = fNames[id];
+        category = fCategories[id];
+        entries = latency.GetEntries();
+        mean = latency.GetMean();
+        p50 = latency.GetQuantile(0.50);
+        p95 = latency.GetQuantile(0.95);
+        p99 = latency.GetQuantile(0.99);
+        max = latency.GetMax();
+        summary->Fill();
+    }
+    summary->Write("", TObject::kOverwrite);
+    file.Close();
+    return true;
+}
@@ -0,0 +1,121 @@
+#include "TPCReco/RunController.h"
+#include "TPCReco/VModule.h"
+#include "TRandom.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+using namespace fwk;
+namespace pt = boost::property_tree;
+
+namespace {
+
+    // every stage is run by a single thread, so the records need no locking
+    std::vector<std::pair<uint32_t, double>> gSourceDraws;
+    std::vector<std::pair<uint32_t, double>> gSinkDraws;
+    std::vector<double> gHelperDraws;
+    const uint32_t kEvents = 200;
+
+    class PipelineTestSource : public VModule {
+    public:
+        EResultFlag Init(boost::property_tree::ptree) override {
+            fCounter = 0;
+            return eSuccess;
+        }
+
+        EResultFlag Process(ModuleExchangeSpace &event) override {
+            if (fCounter == kEvents)
+                return eBreakLoop;
+            event.eventInfo.SetEventId(fCounter++);
+            gSourceDraws.emplace_back(event.eventInfo.GetEventId(), gRandom->Gaus(0, 1));
+            return eSuccess;
+        }
+
+        EResultFlag Finish() override { return eSuccess; }
+
+    private:
+        uint32_t fCounter{0};
+    REGISTER_MODULE(PipelineTestSource);
+    };
+
+    class PipelineTestSink : public VModule {
+    public:
+        EResultFlag Init(boost::property_tree::ptree) override { return eSuccess; }
+
+        EResultFlag Process(ModuleExchangeSpace &event) override {
+            gSinkDraws.emplace_back(event.eventInfo.GetEventId(), gRandom->Uniform(0, 1) + gRandom->Integer(10));
+            if (event.eventInfo.GetEventId() % 50 == 0) {
+                // helper threads of a module are not pipeline stages
+                double value = -1;
+                std::thread helper([&value] { value = gRandom->Rndm(); });
+                helper.join();
+                gHelperDraws.push_back(value);
+            }
+            return eSuccess;
+        }
+
+        EResultFlag Finish() override { return eSuccess; }
+    REGISTER_MODULE(PipelineTestSink);
+    };
+
+    pt::ptree MakeConfig() {
+        pt::ptree config;
+        config.put("EnableTiming", false);
+        config.put("GeometryConfig", std::string(TPCRECO_RESOURCE_DIR) + "/geometry_ELITPC.dat");
+        pt::ptree sequence;
+        for (const std::string name: {"PipelineTestSource", "PipelineTestSink"}) {
+            pt::ptree item;
+            item.put("", name);
+            sequence.push_back(std::make_pair("", item));
+        }
+        config.add_child("ModuleSequence", sequence);
+        config.put("ModuleConfiguration.PipelineTestSource.dummy", 0);
+        config.put("ModuleConfiguration.PipelineTestSink.dummy", 0);
+        config.put("Pipeline.Enabled", true);
+        config.put("Pipeline.PoolSize", 4);
+        return config;
+    }
+
+    void RunPipeline(unsigned long seed) {
+        gSourceDraws.clear();
+        gSinkDraws.clear();
+        gHelperDraws.clear();
+        gRandom->SetSeed(seed);
+        RunController controller;
+        controller.Init(MakeConfig());
+        ASSERT_TRUE(controller.IsPipeline());
+        controller.RunFull();
+        controller.Finish();
+    }
+}
+
+TEST(RunControllerPipeline, Reproducible) {
+    auto originalRandom = gRandom;
+    RunPipeline(1234);
+    EXPECT_EQ(gRandom, originalRandom);
+    const auto source = gSourceDraws;
+    const auto sink = gSinkDraws;
+    const auto helper = gHelperDraws;
+    ASSERT_EQ(source.size(), kEvents);
+    ASSERT_EQ(sink.size(), kEvents);
+    ASSERT_EQ(helper.size(), kEvents / 50);
+    for (uint32_t i = 0; i < kEvents; ++i) {
+        EXPECT_EQ(source[i].first, i);
+        EXPECT_EQ(sink[i].first, i);
+    }
+    for (auto value: helper) {
+        EXPECT_GE(value, 0);
+        EXPECT_LT(value, 1);
+    }
+
+    RunPipeline(1234);
+    EXPECT_EQ(gSourceDraws, source);
+    EXPECT_EQ(gSinkDraws, sink);
+    EXPECT_EQ(gHelperDraws, helper);
+
+    RunPipeline(4321);
+    EXPECT_NE(gSourceDraws, source);
+}
@@ -0,0 +1,86 @@
+#include "TPCReco/TraceRecorder.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+using namespace utl;
+
+namespace {
+    TraceRecorder::Clock::time_point At(const TraceRecorder::Clock::time_point origin, const double seconds) {
+        return origin + std::chrono::duration_cast<TraceRecorder::Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+}
+
+TEST(TraceRecorder, NameIds) {
+    TraceRecorder recorder;
+    auto a = recorder.GetNameId("Generator", "module");
+    auto b = recorder.GetNameId("Event", "event");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(recorder.GetNameId("Generator", "module"), a);
+    EXPECT_NE(recorder.GetNameId("Generator", "io"), a);
+    EXPECT_EQ(recorder.GetNames(), 3u);
+    EXPECT_EQ(recorder.GetName(a), "Generator");
+    EXPECT_EQ(recorder.GetCategory(b), "event");
+}
+
+TEST(TraceRecorder, LatencyQuantiles) {
+    TraceRecorder::LatencyHistogram h;
+    EXPECT_EQ(h.GetQuantile(0.5), 0);
+    // 1..1000 ms, uniformly
+    for (int i = 1; i <= 1000; ++i)
+        h.Fill(i * 1e-3);
+    EXPECT_EQ(h.GetEntries(), 1000u);
+    EXPECT_NEAR(h.GetMean(), 0.5005, 1e-9);
+    EXPECT_DOUBLE_EQ(h.GetMax(), 1.0);
+    // logarithmic bins: 20 per decade, i.e. ~12% relative resolution
+    EXPECT_NEAR(h.GetQuantile(0.50), 0.50, 0.06);
+    EXPECT_NEAR(h.GetQuantile(0.95), 0.95, 0.1);
+    EXPECT_NEAR(h.GetQuantile(0.99), 0.99, 0.1);
+    EXPECT_LE(h.GetQuantile(1.0), 1.0);
+    // underflow and overflow
+    h.Fill(1e-9);
+    h.Fill(1e5);
+    EXPECT_EQ(h.GetBinContent(0), 1u);
+    EXPECT_EQ(h.GetBinContent(TraceRecorder::LatencyHistogram::GetNbins() + 1), 1u);
+    EXPECT_DOUBLE_EQ(h.GetQuantile(1.0), 1e5);
+}
+
+TEST(TraceRecorder, SpanCap) {
+    TraceRecorder recorder(5);
+    auto id = recorder.GetNameId("Module", "module");
+    auto t0 = TraceRecorder::Clock::now();
+    for (int i = 0; i < 8; ++i) {
+        recorder.SetCurrentEvent(i);
+        recorder.Record(id, At(t0, i), At(t0, i + 0.001));
+    }
+    EXPECT_EQ(recorder.GetNumberOfSpans(), 5u);
+    EXPECT_EQ(recorder.GetNumberOfDroppedSpans(), 3u);
+    EXPECT_EQ(recorder.GetLatency(id).GetEntries(), 8u); // statistics include dropped spans
+}
+
+TEST(TraceRecorder, ChromeTrace) {
+    TraceRecorder recorder;
+    auto id = recorder.GetNameId("My\"Module", "module");
+    recorder.SetCurrentEvent(7);
+    {
+        TraceRecorder::Scope scope(&recorder, id);
+    }
+    TraceRecorder::Scope noop(nullptr, id);
+    EXPECT_EQ(recorder.GetNumberOfSpans(), 1u);
+
+    const std::string fname = "TraceRecorder_tst.json";
+    ASSERT_TRUE(recorder.WriteChromeTrace(fname));
+    std::ifstream in(fname);
+    std::stringstream content;
+    content << in.rdbuf();
+    std::remove(fname.c_str());
+    const auto json = content.str();
+    EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"My\\\"Module\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"event\":7}"), std::string::npos);
+    EXPECT_EQ(json.back(), '\n');
+}
@@ -119,7 +119,7 @@ int main(int argc, char **argv) {
     }
 
     auto rCal = std::make_unique<IonRangeCalculator>();
-    auto g = rCal->getIonBraggCurveMeVPerMM(pid_type::ALPHA, 3, 1000);
+    auto g = *rCal->getIonBraggCurveMeVPerMM(pid_type::ALPHA, 3, 1000);
 
     c->SetGridx();
     c->SetGridy();
@@ -877,7 +877,7 @@ void testResponse4(const char *fname, // input ROOT file with Track3D tree
       for(auto ipoint=0; ipoint<npoints; ipoint++) { // generate NPOINTS hits along the track
 	auto depth=(ipoint+0.5)*length/npoints; // mm
 	auto hitPosition=origin+unit_vec*depth; // mm
-	auto hitCharge=adcPerMeV*curve.Eval(depth)*(length/npoints); // ADC units
+	auto hitCharge=adcPerMeV*curve->Eval(depth)*(length/npoints); // ADC units
 	calcStrip->addCharge(hitPosition, hitCharge, pevent);
 	if(aEventInfo) pevent->SetEventInfo(*aEventInfo);
 #ifdef DEBUG
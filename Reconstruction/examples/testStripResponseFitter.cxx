@@ -242,7 +242,7 @@ private:
       for(auto ipoint=0; ipoint<npoints; ipoint++) { // generate NPOINTS hits along the track
 	auto depth=(ipoint+0.5)*length/npoints; // mm
 	auto hitPosition=origin+unit_vec*depth; // mm
-	auto hitCharge=myScale*curve.Eval(depth)*(length/npoints); // ADC units
+	auto hitCharge=myScale*curve->Eval(depth)*(length/npoints); // ADC units
 	myResponseCalc->addCharge(hitPosition, hitCharge);
 #if defined(DEBUG_CHARGE) && DEBUG_CHARGE
 	sum_charge+=hitCharge;
@@ -1732,7 +1732,7 @@ int loop(const long maxIter=1, const int runId=1234) {
       for(auto ipoint=0; ipoint<reference_npoints; ipoint++) { // generate NPOINTS hits along the track
 	auto depth=(ipoint+0.5)*length/reference_npoints; // mm
 	auto hitPosition=reference_origin+unit_vec*depth; // mm
-	auto hitCharge=reference_adcPerMeV*curve.Eval(depth)*(length/reference_npoints); // ADC units, arbitrary scaling factor
+	auto hitCharge=reference_adcPerMeV*curve->Eval(depth)*(length/reference_npoints); // ADC units, arbitrary scaling factor
 	aCalcResponse->addCharge(hitPosition, hitCharge); // fill referenceHistosInMM
       }
     }
@@ -11,6 +11,8 @@
 //#include <memory>
 //#include <tuple>
 
+#include "TPCReco/HistogramRegistry.h"
+
 class TH1D;
 class TH2D;
 class TProfile;
@@ -74,10 +76,15 @@ class DotFinder {
   Long64_t myEventCounter_Dot; // # of point-like events
   Long64_t previousEventTime_All; // from GET electronics: in 10ns units
   Long64_t previousEventTime_Dot; // from GET electronics: in 10ns units
-  std::map< std::string, TH1D* > myHistograms; // map of histograms indexed by TH1D name
-  std::map< std::string, TH2D* > myHistograms2D; // map of histograms indexed by TH2D name
-  std::map< std::string, TProfile* > myHistogramsProf; // map of histograms indexed by TProfile name
-  std::map< std::string, TProfile2D* > myHistogramsProf2D; // map of histograms indexed by TProfile2D name
+  HistogramRegistry<TH1D> myHistograms; // TH1D histograms indexed by handle
+  HistogramRegistry<TH2D> myHistograms2D; // TH2D histograms indexed by handle
+  HistogramRegistry<TProfile> myHistogramsProf; // TProfile histograms indexed by handle
+  HistogramRegistry<TProfile2D> myHistogramsProf2D; // TProfile2D histograms indexed by handle
+  static const int nTimeDiffHistos = 5; // time difference ranges: 100s, 10s, 1s, 0.1s, 0.01s
+  unsigned int h_timediff_all[nTimeDiffHistos]; // handles resolved at booking time
+  unsigned int h_timediff_dot[nTimeDiffHistos];
+  unsigned int h_xy_dot, h_x_dot, h_y_dot, h_z_dot;
+  unsigned int prof_deltaz_xy_dot, prof_deltaz_x_dot, prof_deltaz_y_dot;
   
   std::shared_ptr<TFile> myOutputFilePtr;
   //  std::shared_ptr<TTree> myOutputTreePtr;
@@ -6,8 +6,11 @@
 #include <tuple>
 #include <utility>
 #include <cmath>
+#include <memory>
+#include <string>
 
 #include "TPCReco/MultiKey.h"
+#include "TPCReco/StripResponseTable.h"
 
 class GeometryTPC;
 
@@ -58,6 +61,15 @@ public:
     void addCharge(double x, double y, double z, double charge,
                    std::shared_ptr<PEventTPC> aEventPtr = std::shared_ptr<PEventTPC>(nullptr));
 
+    // same as addCharge() for many point-like charges at once: deposits sharing the same reference
+    // strip node and time cell are processed together with geometry lookups done once per group,
+    // smeared charges are accumulated in local buffers and committed to the event/histograms once per bin
+    void addCharges(size_t n, const double *x, const double *y, const double *z, const double *charge,
+                    std::shared_ptr<PEventTPC> aEventPtr = std::shared_ptr<PEventTPC>(nullptr));
+
+    void addCharges(const std::vector<TVector3> &positions, const std::vector<double> &charges,
+                    std::shared_ptr<PEventTPC> aEventPtr = std::shared_ptr<PEventTPC>(nullptr));
+
     void setDebug(bool enable) { debug_flag = enable; }
 
     int getDeltaStrips() const { return Nstrips; }
@@ -96,6 +108,30 @@ public:
     // load underlying response histograms from existing TFile
     bool loadHistograms(const char *fname);
 
+    // save response tables in compact binary format (see StripResponseTable)
+    bool saveResponseTable(const char *fname) const;
+
+    // map existing binary response tables read-only, histograms are not created
+    bool loadResponseTable(const char *fname);
+
+    // read-only response tables used by addCharge(), can be shared between threads
+    std::shared_ptr<const StripResponseTable> getResponseTable() const { return responseTable; }
+
+    // method used to re-generate underlying response histograms
+    enum class InitMode {
+        MonteCarlo, // random sampling, counter-based RNG gives identical results for any number of threads
+        Analytic    // Gaussian integrals over pad polygons and AGET response CDF, no sampling
+    };
+
+    void setInitMode(InitMode mode) { init_mode = mode; }
+
+    InitMode getInitMode() const { return init_mode; }
+
+    void setNthreads(unsigned int n) { nthreads = n; } // 0 = all hardware threads
+    unsigned int getNthreads() const { return nthreads; }
+
+    void setRandomSeed(unsigned long seed) { random_seed = seed; }
+
     // re-generate underlying response histograms
     void initializeStripResponse(unsigned long NpointsXY = StripResponseCalculator::default_NpointsXY,
                                  int NbinsXY = StripResponseCalculator::default_NbinsXY);
@@ -107,6 +143,10 @@ public:
     generateRootFileName(int nStrips, int nCells, int nPads, double sigmaXY, double sigmaZ, double peakingTime,
                          double samplingRate, double vDrift);
 
+    static std::string
+    generateBinaryFileName(int nStrips, int nCells, int nPads, double sigmaXY, double sigmaZ, double peakingTime,
+                           double samplingRate, double vDrift);
+
 private:
 
     std::shared_ptr<GeometryTPC> myGeometryPtr; //! transient member
@@ -128,6 +168,10 @@ private:
     double peaking_time{0}; // AGET peaking time [ns], 0=none, valid range: 70-1014 ns
     //// TEST
 
+    InitMode init_mode{InitMode::MonteCarlo};
+    unsigned int nthreads{0}; // 0 = all hardware threads
+    unsigned long random_seed{0};
+
     bool has_UVWprojectionsRaw{false};
     bool has_UVWprojectionsInMM{false};
     bool debug_flag{false};
@@ -138,6 +182,21 @@ private:
     std::map<MultiKey3, TH2D *> responseMapPerStripSectionStart; // key={strip_dir, relative strip index, relative section start in pad units}
     std::map<int, TH1D *> responseMapPerTimecell; // key=relative time cell index
 
+    // flat response tables (built from histograms or mapped from binary file) and their lookup views
+    std::shared_ptr<const StripResponseTable> responseTable; //! transient member
+    std::vector<std::pair<MultiKey2, const StripResponseTable::Grid2D *> > gridsPerMergedStrip;
+    std::map<MultiKey3, const StripResponseTable::Grid2D *> gridsPerStripSectionStart;
+    std::vector<std::pair<int, const StripResponseTable::Grid1D *> > gridsPerTimecell;
+
+    // returns parameters identifying current response model
+    StripResponseTable::Parameters getResponseTableParameters() const;
+
+    // re-creates response tables from current histograms
+    void updateResponseTable();
+
+    // sets lookup views of given response tables
+    bool attachResponseTable(std::shared_ptr<const StripResponseTable> aTable);
+
     // returns name of underlying response histogram
     const char *getStripResponseHistogramName(int dir, int delta_strip);
 
@@ -0,0 +1,192 @@
+#ifndef _StripResponseTable_H_
+#define _StripResponseTable_H_
+
+// Compact, versioned binary image of StripResponseCalculator response histograms.
+//
+// Every response histogram is stored as a flat row-major float array (stride=nx)
+// preceded by a small descriptor with its binning and key. Files are mapped read-only
+// with mmap(2), so all threads and processes opening the same file share one page-cache copy.
+// Lookups reproduce TH2D::Interpolate / TH1D::Interpolate / GetBinContent(FindBin)
+// in O(1) without touching any ROOT object.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class StripResponseTable {
+
+public:
+
+    static const uint32_t formatVersion{1};
+    static const int32_t noKey{INT32_MIN}; // unused key field (e.g. delta_pad of merged strip response)
+
+    enum class Kind : int32_t {
+        MergedStrip = 0,       // key={strip_dir, delta_strip}
+        StripSectionStart = 1, // key={strip_dir, delta_strip, delta_pad}
+        Timecell = 2           // key={delta_timecell}
+    };
+
+    // parameters needed to verify that table matches given StripResponseCalculator setup
+    struct Parameters {
+        int32_t nStrips{0};
+        int32_t nTimecells{0};
+        int32_t nPads{0};
+        double sigmaXY{0};      // [mm]
+        double sigmaZ{0};       // [mm]
+        double peakingTime{0};  // [ns]
+        double samplingRate{0}; // [MHz]
+        double driftVelocity{0};// [cm/us]
+        double padSize{0};      // [mm]
+        double padPitch{0};     // [mm]
+        bool isCompatible(const Parameters &other) const;
+    };
+
+    // read-only view of a 2D response histogram
+    struct Grid2D {
+        int nx{0}, ny{0};
+        double xmin{0}, xmax{0}, ymin{0}, ymax{0};
+        double inv_dx{0}, inv_dy{0};
+        const float *data{nullptr}; // data[iy*nx+ix]
+
+        // same as TH2D::GetBinContent(TH2D::FindBin(x, y)), 0 for under/overflows
+        inline double value(double x, double y) const {
+            const double fx = (x - xmin) * inv_dx;
+            const double fy = (y - ymin) * inv_dy;
+            if (!(fx >= 0.0 && fx < nx && fy >= 0.0 && fy < ny)) return 0.0; // also rejects NaN
+            return data[static_cast<int>(fy) * nx + static_cast<int>(fx)];
+        }
+
+        // same as TH2D::Interpolate(x, y): bilinear between bin centers,
+        // constant beyond outermost bin centers, 0 outside of histogram domain
+        inline double interpolate(double x, double y) const {
+            double fx = (x - xmin) * inv_dx;
+            double fy = (y - ymin) * inv_dy;
+            if (!(fx >= 0.0 && fx < nx && fy >= 0.0 && fy < ny)) return 0.0; // also rejects NaN
+            int ix, iy;
+            double tx, ty;
+            locate(fx, nx, ix, tx);
+            locate(fy, ny, iy, ty);
+            const float *p = data + iy * nx + ix;
+            const int sx = (nx > 1 ? 1 : 0);
+            const int sy = (ny > 1 ? nx : 0);
+            return (1.0 - ty) * ((1.0 - tx) * p[0] + tx * p[sx]) + ty * ((1.0 - tx) * p[sy] + tx * p[sy + sx]);
+        }
+    };
+
+    // read-only view of a 1D response histogram
+    struct Grid1D {
+        int nx{0};
+        double xmin{0}, xmax{0};
+        double inv_dx{0};
+        const float *data{nullptr};
+
+        // same as TH1D::GetBinContent(TH1D::FindBin(x)), 0 for under/overflows
+        inline double value(double x) const {
+            const double fx = (x - xmin) * inv_dx;
+            if (!(fx >= 0.0 && fx < nx)) return 0.0;
+            return data[static_cast<int>(fx)];
+        }
+
+        // same as TH1D::Interpolate(x): linear between bin centers, content of
+        // the first/last bin beyond outermost bin centers
+        inline double interpolate(double x) const {
+            double fx = (x - xmin) * inv_dx;
+            if (!(fx == fx)) return 0.0; // NaN
+            if (fx < 0.0) fx = 0.0;
+            if (fx > nx) fx = nx;
+            int ix;
+            double tx;
+            locate(fx, nx, ix, tx);
+            const float *p = data + ix;
+            return (1.0 - tx) * p[0] + tx * p[nx > 1 ? 1 : 0];
+        }
+    };
+
+    // single entry used for building new table
+    struct Entry {
+        Kind kind{Kind::MergedStrip};
+        int32_t key1{noKey}, key2{noKey}, key3{noKey};
+        int32_t nx{0}, ny{1};
+        double xmin{0}, xmax{0}, ymin{0}, ymax{1};
+        std::vector<float> content; // row-major, size=nx*ny, no under/overflows
+    };
+
+    ~StripResponseTable();
+
+    // creates in-memory table (same layout as on disk)
+    static std::shared_ptr<const StripResponseTable> create(const Parameters &par, const std::vector<Entry> &entries);
+
+    // maps existing file read-only, returns empty pointer on error.
+    // Tables opened from the same path are shared within the process.
+    static std::shared_ptr<const StripResponseTable> open(const std::string &fname, bool debug_flag = false);
+
+    // checks magic number of existing file
+    static bool isResponseTableFile(const std::string &fname);
+
+    // writes table to file (via temporary file and atomic rename)
+    bool save(const std::string &fname) const;
+
+    const Parameters &getParameters() const { return par; }
+    size_t getNgrids2D() const { return grids2D.size(); }
+    size_t getNgrids1D() const { return grids1D.size(); }
+    bool isMapped() const { return mapAddress != nullptr; }
+
+    // returns NULL if requested key is not present
+    const Grid2D *findMergedStrip(int dir, int delta_strip) const;
+
+    const Grid2D *findStripSectionStart(int dir, int delta_strip, int delta_pad) const;
+
+    const Grid1D *findTimecell(int delta_timecell) const;
+
+    // iteration over all entries of given kind, ordered by keys
+    struct Key2D {
+        Kind kind;
+        int key1, key2, key3;
+    };
+    const std::vector<Key2D> &getKeys2D() const { return keys2D; }
+    const std::vector<Grid2D> &getGrids2D() const { return grids2D; }
+    const std::vector<int> &getKeys1D() const { return keys1D; }
+    const std::vector<Grid1D> &getGrids1D() const { return grids1D; }
+
+private:
+
+    StripResponseTable() = default;
+    StripResponseTable(const StripResponseTable &) = delete;
+    StripResponseTable &operator=(const StripResponseTable &) = delete;
+
+    // splits fractional bin coordinate f=[0, n] into lower bin-center index and weight
+    static inline void locate(double f, int n, int &i, double &t) {
+        f -= 0.5; // bin centers at integer positions
+        if (f <= 0.0 || n < 2) {
+            i = 0;
+            t = 0.0;
+            return;
+        }
+        if (f >= n - 1) {
+            i = n - 2;
+            t = 1.0;
+            return;
+        }
+        i = static_cast<int>(f);
+        t = f - i;
+    }
+
+    // validates image and builds lookup views
+    bool attach(const char *image, size_t size, bool debug_flag);
+
+    Parameters par;
+    std::vector<char> ownedImage;     // used by in-memory tables
+    void *mapAddress{nullptr};        // used by mmapped tables
+    size_t mapSize{0};
+    const char *image{nullptr};
+    size_t imageSize{0};
+
+    std::vector<Key2D> keys2D;
+    std::vector<Grid2D> grids2D;
+    std::vector<int> keys1D;
+    std::vector<Grid1D> grids1D;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include <vector>
 #include <memory>
 #include <tuple>
+#include <atomic>
 
 #include <boost/property_tree/ptree.hpp>
 
@@ -42,6 +43,9 @@ public:
 
   void reconstruct();
 
+  /// reconstruct() returns early, without a fitted track, once the flag is raised
+  void setCancelFlag(const std::atomic<bool> *aFlag) { myCancelFlag = aFlag; }
+
   const TH2D & getCluster2D(int iDir) const;
 
   const TH2D & getRecHits2D(int iDir) const;
@@ -105,6 +109,9 @@ private:
   Track3D myTmpTrack, myFittedTrack;
   
   mutable ROOT::Fit::Fitter fitter;
+
+  const std::atomic<bool> *myCancelFlag{nullptr};
+  bool isCancelled() const { return myCancelFlag && myCancelFlag->load(); }
   
 };
 #endif
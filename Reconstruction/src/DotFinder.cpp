@@ -79,34 +79,34 @@ void DotFinder::initializeHistograms(){
   double maxTimeDiff; // upper time difference range [s]
 
   hname = "h_timediff1_all"; maxTimeDiff = 100.0; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_all[0]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff2_all"; maxTimeDiff = 10.0; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_all[1]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff3_all"; maxTimeDiff = 1.0; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_all[2]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff4_all"; maxTimeDiff = 0.1; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_all[3]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff5_all"; maxTimeDiff = 0.01; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_all[4]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (no cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff1_dot"; maxTimeDiff = 100.0; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_dot[0]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff2_dot"; maxTimeDiff = 10.0; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_dot[1]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff3_dot"; maxTimeDiff = 1.0; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff); 
+  h_timediff_dot[2]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff4_dot"; maxTimeDiff = 0.1; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff);
+  h_timediff_dot[3]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff));
 
   hname = "h_timediff5_dot"; maxTimeDiff = 0.01; // sec
-  myHistograms[hname]=new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff);
+  h_timediff_dot[4]=myHistograms.add(new TH1D(hname.c_str(), "Event time difference (dot cuts)", 100, 0.0, maxTimeDiff));
 
   double xmin, xmax, ymin, ymax, zmin, zmax; // [mm]
   double bin_widthXY =  myEvent->GetGeoPtr()->GetStripPitch();// [mm]
@@ -114,30 +114,30 @@ void DotFinder::initializeHistograms(){
   const int nbinX = (int)((xmax-xmin)/bin_widthXY+0.5);
   const int nbinY = (int)((ymax-ymin)/bin_widthXY+0.5);
   hname = "h_xy_dot";
-  myHistograms2D[hname]=new TH2D(hname.c_str(), "Centers of dot-like events",
-				    nbinX, xmin, xmax, nbinY, ymin, ymax);				 
+  h_xy_dot=myHistograms2D.add(new TH2D(hname.c_str(), "Centers of dot-like events",
+				    nbinX, xmin, xmax, nbinY, ymin, ymax));				 
   hname = "h_x_dot";
-  myHistograms[hname]=new TH1D(hname.c_str(), "Centers of dot-like events",
-				  nbinX, xmin, xmax);
+  h_x_dot=myHistograms.add(new TH1D(hname.c_str(), "Centers of dot-like events",
+				  nbinX, xmin, xmax));
   hname = "h_y_dot";
-  myHistograms[hname]=new TH1D(hname.c_str(), "Centers of dot-like events",
-				  nbinY, ymin, ymax);
+  h_y_dot=myHistograms.add(new TH1D(hname.c_str(), "Centers of dot-like events",
+				  nbinY, ymin, ymax));
   hname = "prof_deltaz_xy_dot";
-  myHistogramsProf2D[hname]=new TProfile2D(hname.c_str(), "Z-width of dot-like events",
-					   nbinX, xmin, xmax, nbinY, ymin, ymax, 0., myMatchRadiusInMM);
+  prof_deltaz_xy_dot=myHistogramsProf2D.add(new TProfile2D(hname.c_str(), "Z-width of dot-like events",
+					   nbinX, xmin, xmax, nbinY, ymin, ymax, 0., myMatchRadiusInMM));
   hname = "prof_deltaz_x_dot";
-  myHistogramsProf[hname]=new TProfile(hname.c_str(), "Z-width of dot-like events",
-				       nbinX, xmin, xmax, 0., myMatchRadiusInMM);
+  prof_deltaz_x_dot=myHistogramsProf.add(new TProfile(hname.c_str(), "Z-width of dot-like events",
+				       nbinX, xmin, xmax, 0., myMatchRadiusInMM));
   hname = "prof_deltaz_y_dot";
-  myHistogramsProf[hname]=new TProfile(hname.c_str(), "Z-width of dot-like events",
-				   nbinY, ymin, ymax, 0., myMatchRadiusInMM);
+  prof_deltaz_y_dot=myHistogramsProf.add(new TProfile(hname.c_str(), "Z-width of dot-like events",
+				   nbinY, ymin, ymax, 0., myMatchRadiusInMM));
 
   zmin = myEvent->GetGeoPtr()->GetDriftCageZmin();
   zmax = myEvent->GetGeoPtr()->GetDriftCageZmax();
   const int nbinZ = myEvent->GetGeoPtr()->GetAgetNtimecells();
   hname = "h_z_dot";
-  myHistograms[hname]=new TH1D(hname.c_str(), "Centers of dot-like events",
-				  nbinZ, zmin, zmax);				 
+  h_z_dot=myHistograms.add(new TH1D(hname.c_str(), "Centers of dot-like events",
+				  nbinZ, zmin, zmax));				 
 
   myHistogramsInitialized = true;
 }
@@ -148,16 +148,16 @@ void DotFinder::resetHistograms(){
   if(!myHistogramsInitialized) return; // nothing to do
 
   for(auto it=myHistograms.begin() ; it!=myHistograms.end() ; ++it) {
-    if(it->second) (it->second)->Reset();
+    if(*it) (*it)->Reset();
   }
   for(auto it=myHistograms2D.begin() ; it!=myHistograms2D.end() ; ++it) {
-    if(it->second) (it->second)->Reset();
+    if(*it) (*it)->Reset();
   }
   for(auto it=myHistogramsProf.begin() ; it!=myHistogramsProf.end() ; ++it) {
-    if(it->second) (it->second)->Reset();
+    if(*it) (*it)->Reset();
   }
   for(auto it=myHistogramsProf2D.begin() ; it!=myHistogramsProf2D.end() ; ++it) {
-    if(it->second) (it->second)->Reset();
+    if(*it) (*it)->Reset();
   }
   myEventCounter_All = 0;
   myEventCounter_Dot = 0;
@@ -399,24 +399,24 @@ void DotFinder::reconstruct(){
   } else {
     double timeDiffInSEC = 10.0e-9*(currentEventTime-previousEventTime_All); // convert 10ns units into seconds
     previousEventTime_All = currentEventTime;
-    myHistograms.at("h_timediff1_all")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff2_all")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff3_all")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff4_all")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff5_all")->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_all[0]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_all[1]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_all[2]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_all[3]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_all[4]]->Fill( timeDiffInSEC );
   }
    
   // apply cuts
   if(!checkCuts()) return; // reject event
     
   // fill histograms after selection cuts (point-like events)
-  myHistograms2D.at("h_xy_dot")->Fill( myDot3D.X(), myDot3D.Y() );
-  myHistograms.at("h_x_dot")->Fill( myDot3D.X() );
-  myHistograms.at("h_y_dot")->Fill( myDot3D.Y() );
-  myHistograms.at("h_z_dot")->Fill( myDot3D.Z() );
-  myHistogramsProf2D.at("prof_deltaz_xy_dot")->Fill( myDot3D.X(), myDot3D.Y(), myDotDeltaZ  );
-  myHistogramsProf.at("prof_deltaz_x_dot")->Fill( myDot3D.X(), myDotDeltaZ );
-  myHistogramsProf.at("prof_deltaz_y_dot")->Fill( myDot3D.Y(), myDotDeltaZ );
+  myHistograms2D[h_xy_dot]->Fill( myDot3D.X(), myDot3D.Y() );
+  myHistograms[h_x_dot]->Fill( myDot3D.X() );
+  myHistograms[h_y_dot]->Fill( myDot3D.Y() );
+  myHistograms[h_z_dot]->Fill( myDot3D.Z() );
+  myHistogramsProf2D[prof_deltaz_xy_dot]->Fill( myDot3D.X(), myDot3D.Y(), myDotDeltaZ  );
+  myHistogramsProf[prof_deltaz_x_dot]->Fill( myDot3D.X(), myDotDeltaZ );
+  myHistogramsProf[prof_deltaz_y_dot]->Fill( myDot3D.Y(), myDotDeltaZ );
   
   if(isFirstEvent_Dot) {
     previousEventTime_Dot = currentEventTime;
@@ -424,11 +424,11 @@ void DotFinder::reconstruct(){
   } else {
     double timeDiffInSEC = 10.0e-9*(currentEventTime-previousEventTime_Dot); // convert 10ns units into seconds
     previousEventTime_Dot = currentEventTime;
-    myHistograms.at("h_timediff1_dot")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff2_dot")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff3_dot")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff4_dot")->Fill( timeDiffInSEC );
-    myHistograms.at("h_timediff5_dot")->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_dot[0]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_dot[1]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_dot[2]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_dot[3]]->Fill( timeDiffInSEC );
+    myHistograms[h_timediff_dot[4]]->Fill( timeDiffInSEC );
   }
   myEventCounter_Dot++;
 }
@@ -478,16 +478,16 @@ void DotFinder::fillOutputStream(){
     return;
   }
   for(auto it=myHistograms.begin() ; it!=myHistograms.end() ; ++it) {
-    if(it->second) (it->second)->Write();
+    if(*it) (*it)->Write();
   }
   for(auto it=myHistograms2D.begin() ; it!=myHistograms2D.end() ; ++it) {
-    if(it->second) (it->second)->Write();
+    if(*it) (*it)->Write();
   }
   for(auto it=myHistogramsProf.begin() ; it!=myHistogramsProf.end() ; ++it) {
-    if(it->second) (it->second)->Write();
+    if(*it) (*it)->Write();
   }
   for(auto it=myHistogramsProf2D.begin() ; it!=myHistogramsProf2D.end() ; ++it) {
-    if(it->second) (it->second)->Write();
+    if(*it) (*it)->Write();
   }
 
   std::cout << "DotFinder: Total analyzed events   = " << myEventCounter_All << std::endl
@@ -1,14 +1,18 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <thread>
 
 #include "TPCReco/StripResponseCalculator.h"
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/PEventTPC.h"
 #include "TPCReco/colorText.h"
+#include "TPCReco/CounterRandom.h"
 
 #include <TH1D.h>
 #include <TH2D.h>
 #include <TF1.h>
-#include <TF2.h>
 #include <TVector2.h>
 #include <TVector3.h>
 #include <TMath.h>
@@ -18,6 +22,105 @@
 #define USE_XYDET_INTERPOLATION true // default=true
 #define USE_ZDET_INTERPOLATION  true // default=true
 
+namespace {
+
+    using tpcreco::utilities::gaussianPair;
+
+    // 8-point Gauss-Legendre quadrature on [-1, 1]
+    const double glNodes[8] = {-0.9602898564975363, -0.7966664774136267, -0.5255324099163290, -0.1834346424956498,
+                               0.1834346424956498, 0.5255324099163290, 0.7966664774136267, 0.9602898564975363};
+    const double glWeights[8] = {0.1012285362903763, 0.2223810344533745, 0.3137066458778873, 0.3626837833783620,
+                                 0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763};
+
+    inline double normalCDF(double x) { return 0.5 * erfc(-x / sqrt(2.0)); }
+
+    // Owen's T function: T(h,a) = 1/(2*Pi) * Integral[ exp(-h^2*(1+x^2)/2) / (1+x^2), {x, 0, a}], h>=0
+    double owensT(double h, double a) {
+        if (a < 0) return -owensT(h, -a);
+        if (a == 0) return 0.0;
+        if (h == 0) return atan(a) / TMath::TwoPi();
+        if (h > 40) return 0.0;
+        if (a > 1) { // T(h,a) + T(ah,1/a) = Phi(h)/2 + Phi(ah)/2 - Phi(h)*Phi(ah)
+            const auto ah = a * h;
+            return 0.5 * normalCDF(h) + 0.5 * normalCDF(ah) - normalCDF(h) * normalCDF(ah) - owensT(ah, 1.0 / a);
+        }
+        const auto nsub = 1 + static_cast<int>(2.0 * a * h); // resolve exp(-h^2*x^2/2) peak
+        const auto w = a / nsub;
+        auto sum = 0.0;
+        for (auto isub = 0; isub < nsub; isub++) {
+            for (auto k = 0; k < 8; k++) {
+                const auto x = w * (isub + 0.5 + 0.5 * glNodes[k]);
+                const auto x2 = 1.0 + x * x;
+                sum += glWeights[k] * exp(-0.5 * h * h * x2) / x2;
+            }
+        }
+        return sum * 0.5 * w / TMath::TwoPi();
+    }
+
+    // Integral of 2D normal distribution N({x0, y0}, sigma) over convex CCW polygon given by flat (x, y) vertices.
+    // Sum over edges of the angular integral (1/2Pi) * Integral[1 - exp(-r(phi)^2/2/sigma^2), dphi],
+    // where r(phi) is the distance to the edge, expressed with Owen's T function.
+    double gaussianPolygonIntegral(const std::vector<double> &xy, double x0, double y0, double sigma) {
+        const auto n = xy.size() / 2;
+        auto sum = 0.0;
+        for (auto i = 0u; i < n; i++) {
+            const auto j = (i + 1) % n;
+            const auto ax = xy[2 * i] - x0, ay = xy[2 * i + 1] - y0;
+            const auto bx = xy[2 * j] - x0, by = xy[2 * j + 1] - y0;
+            const auto ex = bx - ax, ey = by - ay;
+            const auto len2 = ex * ex + ey * ey;
+            const auto cross = ax * by - ay * bx;
+            if (len2 == 0 || fabs(cross) <= 1e-12 * len2) continue; // edge line passes through the center
+            const auto t = -(ax * ex + ay * ey) / len2;
+            const auto fx = ax + t * ex, fy = ay + t * ey; // foot of perpendicular
+            const auto d2 = fx * fx + fy * fy;
+            const auto sa = (fx * ay - fy * ax) / d2; // tangent of angle wrt perpendicular
+            const auto sb = (fx * by - fy * bx) / d2;
+            const auto h = sqrt(d2) / sigma;
+            sum += (atan(sb) - atan(sa)) / TMath::TwoPi() - (owensT(h, sb) - owensT(h, sa));
+        }
+        return std::max(0.0, sum);
+    }
+
+    // keeps part of convex polygon with ux*x+uy*y<=limit
+    void clipHalfPlane(const std::vector<double> &in, double ux, double uy, double limit, std::vector<double> &out) {
+        out.clear();
+        const auto n = in.size() / 2;
+        for (auto i = 0u; i < n; i++) {
+            const auto j = (i + 1) % n;
+            const auto di = ux * in[2 * i] + uy * in[2 * i + 1] - limit;
+            const auto dj = ux * in[2 * j] + uy * in[2 * j + 1] - limit;
+            if (di <= 0) {
+                out.push_back(in[2 * i]);
+                out.push_back(in[2 * i + 1]);
+            }
+            if ((di < 0 && dj > 0) || (di > 0 && dj < 0)) {
+                const auto f = di / (di - dj);
+                out.push_back(in[2 * i] + f * (in[2 * j] - in[2 * i]));
+                out.push_back(in[2 * i + 1] + f * (in[2 * j + 1] - in[2 * i + 1]));
+            }
+        }
+    }
+
+    // calls task(i) for i=[0, n-1] using blocks of consecutive indices distributed among threads
+    void parallelFor(size_t n, unsigned int nthreads, const std::function<void(size_t)> &task) {
+        if (nthreads == 0) nthreads = std::max(1u, std::thread::hardware_concurrency());
+        nthreads = std::min<size_t>(nthreads, std::max<size_t>(1, n));
+        const size_t block = std::max<size_t>(1, n / (8 * nthreads));
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t first = next.fetch_add(block); first < n; first = next.fetch_add(block)) {
+                const auto last = std::min(n, first + block);
+                for (auto i = first; i < last; i++) task(i);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (auto ithread = 1u; ithread < nthreads; ithread++) threads.emplace_back(worker);
+        worker();
+        for (auto &t: threads) t.join();
+    }
+}
+
 StripResponseCalculator::StripResponseCalculator(std::shared_ptr<GeometryTPC> aGeometryPtr,
                                                  int delta_strips, // consider +/- neighbour strips
                                                  int delta_timecells, // consider +/- neighbour time cells
@@ -50,7 +153,8 @@ StripResponseCalculator::StripResponseCalculator(std::shared_ptr<GeometryTPC> aG
         std::cout << __FUNCTION__ << KRED << ": Wrong AGET peaking time parameter!" << RST << std::endl;
         exit(-1);
     }
-    if (fname && strlen(fname) > 0 && !loadHistograms(fname)) {
+    if (fname && strlen(fname) > 0 &&
+        !(StripResponseTable::isResponseTableFile(fname) ? loadResponseTable(fname) : loadHistograms(fname))) {
         std::cout << __FUNCTION__ << KRED << ": Wrong input file!" << RST << std::endl;
         exit(-1);
     }
@@ -148,6 +252,7 @@ bool StripResponseCalculator::loadHistograms(const char *fname) {
     }
 
     f.Close();
+    updateResponseTable();
 
     ////// DEBUG
     if (debug_flag) {
@@ -197,6 +302,178 @@ bool StripResponseCalculator::saveHistograms(const char *fname) {
     return true;
 }
 
+StripResponseTable::Parameters StripResponseCalculator::getResponseTableParameters() const {
+    StripResponseTable::Parameters par;
+    par.nStrips = Nstrips;
+    par.nTimecells = Ntimecells;
+    par.nPads = Npads;
+    par.sigmaXY = sigma_xy;
+    par.sigmaZ = sigma_z;
+    par.peakingTime = peaking_time;
+    par.samplingRate = myGeometryPtr->GetSamplingRate();
+    par.driftVelocity = myGeometryPtr->GetDriftVelocity();
+    par.padSize = myGeometryPtr->GetPadSize();
+    par.padPitch = myGeometryPtr->GetPadPitch();
+    return par;
+}
+
+namespace {
+    StripResponseTable::Entry makeEntry(const TH2D *hist) {
+        StripResponseTable::Entry e;
+        e.nx = hist->GetNbinsX();
+        e.ny = hist->GetNbinsY();
+        e.xmin = hist->GetXaxis()->GetXmin();
+        e.xmax = hist->GetXaxis()->GetXmax();
+        e.ymin = hist->GetYaxis()->GetXmin();
+        e.ymax = hist->GetYaxis()->GetXmax();
+        e.content.reserve(e.nx * e.ny);
+        for (auto iy = 1; iy <= e.ny; iy++) {
+            for (auto ix = 1; ix <= e.nx; ix++) {
+                e.content.push_back(hist->GetBinContent(ix, iy));
+            }
+        }
+        return e;
+    }
+
+    StripResponseTable::Entry makeEntry(const TH1D *hist) {
+        StripResponseTable::Entry e;
+        e.kind = StripResponseTable::Kind::Timecell;
+        e.nx = hist->GetNbinsX();
+        e.xmin = hist->GetXaxis()->GetXmin();
+        e.xmax = hist->GetXaxis()->GetXmax();
+        e.content.reserve(e.nx);
+        for (auto ix = 1; ix <= e.nx; ix++) {
+            e.content.push_back(hist->GetBinContent(ix));
+        }
+        return e;
+    }
+
+    StripResponseTable::Entry makeEntry(const StripResponseTable::Grid2D &grid) {
+        StripResponseTable::Entry e;
+        e.nx = grid.nx;
+        e.ny = grid.ny;
+        e.xmin = grid.xmin;
+        e.xmax = grid.xmax;
+        e.ymin = grid.ymin;
+        e.ymax = grid.ymax;
+        e.content.assign(grid.data, grid.data + grid.nx * grid.ny);
+        return e;
+    }
+
+    StripResponseTable::Entry makeEntry(const StripResponseTable::Grid1D &grid) {
+        StripResponseTable::Entry e;
+        e.kind = StripResponseTable::Kind::Timecell;
+        e.nx = grid.nx;
+        e.xmin = grid.xmin;
+        e.xmax = grid.xmax;
+        e.content.assign(grid.data, grid.data + grid.nx);
+        return e;
+    }
+}
+
+// re-create flat response tables from current histograms,
+// entries without histograms (e.g. loaded from binary file) are copied from previous tables
+void StripResponseCalculator::updateResponseTable() {
+    std::vector<StripResponseTable::Entry> entries;
+    if (!responseMapPerMergedStrip.empty()) {
+        for (auto &it: responseMapPerMergedStrip) {
+            entries.push_back(makeEntry(it.second));
+            entries.back().kind = StripResponseTable::Kind::MergedStrip;
+            entries.back().key1 = std::get<0>(it.first);
+            entries.back().key2 = std::get<1>(it.first);
+        }
+        for (auto &it: responseMapPerStripSectionStart) {
+            entries.push_back(makeEntry(it.second));
+            entries.back().kind = StripResponseTable::Kind::StripSectionStart;
+            entries.back().key1 = std::get<0>(it.first);
+            entries.back().key2 = std::get<1>(it.first);
+            entries.back().key3 = std::get<2>(it.first);
+        }
+    } else if (responseTable) {
+        for (auto i = 0u; i < responseTable->getGrids2D().size(); i++) {
+            const auto &key = responseTable->getKeys2D()[i];
+            entries.push_back(makeEntry(responseTable->getGrids2D()[i]));
+            entries.back().kind = key.kind;
+            entries.back().key1 = key.key1;
+            entries.back().key2 = key.key2;
+            entries.back().key3 = key.key3;
+        }
+    }
+    if (!responseMapPerTimecell.empty()) {
+        for (auto &it: responseMapPerTimecell) {
+            entries.push_back(makeEntry(it.second));
+            entries.back().key1 = it.first;
+        }
+    } else if (responseTable) {
+        for (auto i = 0u; i < responseTable->getGrids1D().size(); i++) {
+            entries.push_back(makeEntry(responseTable->getGrids1D()[i]));
+            entries.back().key1 = responseTable->getKeys1D()[i];
+        }
+    }
+    attachResponseTable(StripResponseTable::create(getResponseTableParameters(), entries));
+}
+
+bool StripResponseCalculator::attachResponseTable(std::shared_ptr<const StripResponseTable> aTable) {
+    if (!aTable) return false;
+    responseTable = aTable;
+    gridsPerMergedStrip.clear();
+    gridsPerStripSectionStart.clear();
+    gridsPerTimecell.clear();
+    const auto &keys2D = responseTable->getKeys2D();
+    const auto &grids2D = responseTable->getGrids2D();
+    for (auto i = 0u; i < keys2D.size(); i++) {
+        if (keys2D[i].kind == StripResponseTable::Kind::MergedStrip) {
+            gridsPerMergedStrip.push_back(std::make_pair(MultiKey2(keys2D[i].key1, keys2D[i].key2), &grids2D[i]));
+        } else {
+            gridsPerStripSectionStart[MultiKey3(keys2D[i].key1, keys2D[i].key2, keys2D[i].key3)] = &grids2D[i];
+        }
+    }
+    const auto &keys1D = responseTable->getKeys1D();
+    const auto &grids1D = responseTable->getGrids1D();
+    for (auto i = 0u; i < keys1D.size(); i++) {
+        gridsPerTimecell.push_back(std::make_pair(keys1D[i], &grids1D[i]));
+    }
+    return true;
+}
+
+bool StripResponseCalculator::saveResponseTable(const char *fname) const {
+    if (!responseTable || !responseTable->save(fname)) {
+        if (debug_flag)
+            std::cout << __FUNCTION__ << KRED << ": Cannot write response table: " << fname << "!" << RST
+                      << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool StripResponseCalculator::loadResponseTable(const char *fname) {
+    auto aTable = StripResponseTable::open(fname, debug_flag);
+    if (!aTable) return false;
+    if (!aTable->getParameters().isCompatible(getResponseTableParameters()) ||
+        aTable->getNgrids1D() != (size_t) (2 * Ntimecells + 1)) {
+        if (debug_flag)
+            std::cout << __FUNCTION__ << KRED << ": Response table " << fname
+                      << " does not match current settings!" << RST << std::endl;
+        return false;
+    }
+
+    // histograms are not needed anymore, they can be re-created on demand from the tables
+    for (auto &it: responseMapPerMergedStrip) {
+        if (it.second) delete it.second;
+    }
+    responseMapPerMergedStrip.clear();
+    for (auto &it: responseMapPerStripSectionStart) {
+        if (it.second) delete it.second;
+    }
+    responseMapPerStripSectionStart.clear();
+    for (auto &it: responseMapPerTimecell) {
+        if (it.second) delete it.second;
+    }
+    responseMapPerTimecell.clear();
+
+    return attachResponseTable(aTable);
+}
+
 // declare new array of UZ/VZ/WZ histograms to be filled (channel vs time cell)
 bool StripResponseCalculator::setUVWprojectionsRaw(std::vector<TH2D *> aUVWprojectionsRaw) {
     has_UVWprojectionsRaw = false;
@@ -301,17 +578,16 @@ StripResponseCalculator::addCharge(double x, double y, double z, double charge,
 
     // fill all declared UZ, VZ, WZ projection histograms
     err = false;
-    for (auto &respXY: responseMapPerMergedStrip) {
+    for (auto &respXY: gridsPerMergedStrip) {
         const auto smeared_strip_dir = std::get<0>(respXY.first); // DIR index
         const auto smeared_strip_num = refStrips[smeared_strip_dir] + std::get<1>(respXY.first); // STRIP index
         const auto smeared_pos = myGeometryPtr->Strip2posUVW(smeared_strip_dir, smeared_strip_num, err);
         if (err) continue;
 
 #if(USE_XYDET_INTERPOLATION)
-        const auto smeared_fractionXY = respXY.second->Interpolate(dx, dy);
+        const auto smeared_fractionXY = respXY.second->interpolate(dx, dy);
 #else
-	const auto smeared_bin = respXY.second->FindBin(dx, dy);
-        const auto smeared_fractionXY = respXY.second->GetBinContent(smeared_bin);
+        const auto smeared_fractionXY = respXY.second->value(dx, dy);
 #endif
         if (smeared_fractionXY < Utils::NUMERICAL_TOLERANCE) continue; // speeds up filling
 
@@ -405,15 +681,17 @@ StripResponseCalculator::addCharge(double x, double y, double z, double charge,
                 continue; // delta_pads is outside mapping range
             }
             // delta_pads is inside [-Npads, Npads+eps]
-            const auto it2 = responseMapPerStripSectionStart.find(
+            const auto it2 = gridsPerStripSectionStart.find(
                     MultiKey3(smeared_strip_dir, smeared_strip_num - refStrips[smeared_strip_dir], delta_pads));
+            if (it2 == gridsPerStripSectionStart.end()) continue; // response not tabulated
 
-            if (it.previous != GeometryTPC::outside_section) {
 #if(USE_XYDET_INTERPOLATION)
-	        fractionPerSectionMap[it.previous] -= smeared_fractionXY - it2->second->Interpolate(dx, dy);
+            const auto section_fractionXY = it2->second->interpolate(dx, dy);
 #else
-	        fractionPerSectionMap[it.previous] -= smeared_fractionXY - it2->second->GetBinContent(smeared_bin);
+            const auto section_fractionXY = it2->second->value(dx, dy);
 #endif
+            if (it.previous != GeometryTPC::outside_section) {
+	        fractionPerSectionMap[it.previous] -= smeared_fractionXY - section_fractionXY;
                 ////// DEBUG
                 if (debug_flag)
                     std::cout << __FUNCTION__ << ": Unmerged strip "
@@ -427,11 +705,7 @@ StripResponseCalculator::addCharge(double x, double y, double z, double charge,
                 ////// DEBUG
             }
             if (it.next != GeometryTPC::outside_section) {
-#if(USE_XYDET_INTERPOLATION)
-	        fractionPerSectionMap[it.next] -= it2->second->Interpolate(dx, dy);
-#else
- 	        fractionPerSectionMap[it.next] -= it2->second->GetBinContent(smeared_bin);
-#endif
+	        fractionPerSectionMap[it.next] -= section_fractionXY;
                 ////// DEBUG
                 if (debug_flag)
                     std::cout << __FUNCTION__ << ": Unmerged strip "
@@ -474,11 +748,11 @@ StripResponseCalculator::addCharge(double x, double y, double z, double charge,
                       << " (expected 1)" << std::endl;
         ////// DEBUG
 
-        for (auto &respZ: responseMapPerTimecell) {
+        for (auto &respZ: gridsPerTimecell) {
 #if(USE_ZDET_INTERPOLATION)
-            const auto smeared_fractionZ = respZ.second->Interpolate(dz);
+            const auto smeared_fractionZ = respZ.second->interpolate(dz);
 #else
-            const auto smeared_fractionZ = respZ.second->GetBinContent(respZ.second->FindBin(dz));
+            const auto smeared_fractionZ = respZ.second->value(dz);
 #endif
             const auto smeared_charge = charge * smeared_fractionZ * smeared_fractionXY;
             if (smeared_charge < Utils::NUMERICAL_TOLERANCE) continue; // speeds up filling
@@ -533,6 +807,213 @@ StripResponseCalculator::addCharge(double x, double y, double z, double charge,
     }
 }
 
+void StripResponseCalculator::addCharges(const std::vector<TVector3> &positions, const std::vector<double> &charges,
+                                         std::shared_ptr<PEventTPC> aEventPtr) {
+    const auto n = std::min(positions.size(), charges.size());
+    std::vector<double> x(n), y(n), z(n);
+    for (auto i = 0u; i < n; i++) {
+        x[i] = positions[i].X();
+        y[i] = positions[i].Y();
+        z[i] = positions[i].Z();
+    }
+    addCharges(n, x.data(), y.data(), z.data(), charges.data(), aEventPtr);
+}
+
+void StripResponseCalculator::addCharges(size_t n, const double *x, const double *y, const double *z,
+                                         const double *charge, std::shared_ptr<PEventTPC> aEventPtr) {
+
+    if (n == 0 || (!has_UVWprojectionsRaw && !has_UVWprojectionsInMM && !aEventPtr)) return; // nothing to do
+
+    // step-1 - find reference strip node and time cell of each deposit
+    struct Deposit {
+        MultiKey4 node; // {u0, v0, w0, t0}
+        double dx, dy, dz, charge; // wrt reference node / beginning of reference time cell
+        TVector2 nodePos;
+    };
+    std::vector<Deposit> deposits;
+    deposits.reserve(n);
+    for (auto i = 0u; i < n; i++) {
+        if (charge[i] == 0.0) continue;
+        auto refNodePosInMM = TVector2(0, 0);
+        const auto refStrips = getReferenceStripNode(x[i], y[i], &refNodePosInMM);
+        auto err = (refStrips.size() != 3);
+        if (err) continue;
+        const auto refCell = getReferenceTimecell(z[i]);
+        const auto refCellPosInMM = myGeometryPtr->Timecell2pos(refCell, err);
+        if (err) continue;
+        deposits.push_back({MultiKey4(refStrips[0], refStrips[1], refStrips[2], refCell),
+                            x[i] - refNodePosInMM.X(), y[i] - refNodePosInMM.Y(), z[i] - refCellPosInMM, charge[i],
+                            refNodePosInMM});
+    }
+    if (deposits.empty()) return;
+    std::stable_sort(deposits.begin(), deposits.end(),
+                     [](const Deposit &a, const Deposit &b) { return a.node < b.node; });
+
+    // charge accumulated over the whole batch per {strip DIR, strip SECTION, strip NUM, time CELL}
+    std::map<MultiKey4, std::pair<std::shared_ptr<StripTPC>, double> > chargePerStripCell;
+    // charge accumulated per {strip DIR, merged strip NUM, time CELL} for UZ/VZ/WZ projections
+    std::map<std::tuple<int, int, int>, double> chargePerMergedStripCell;
+
+    // section boundary of the merged strip, independent of deposit position within the group
+    struct Boundary {
+        int previous, next; // section slot or -1
+        int outside;        // 0=inside mapping range, -1=below, +1=above
+        const StripResponseTable::Grid2D *grid;
+    };
+    std::vector<Boundary> boundaries;
+    std::vector<std::shared_ptr<StripTPC> > sectionStrips;
+    std::vector<double> fractionPerSection, chargePerSection, chargePerCell;
+    const auto ncells = gridsPerTimecell.size();
+
+    // step-2 - process each group of deposits sharing the same reference node and time cell
+    for (auto first = deposits.begin(); first != deposits.end();) {
+        auto last = first;
+        while (last != deposits.end() && last->node == first->node) ++last;
+        const int refStrips[3] = {std::get<0>(first->node), std::get<1>(first->node), std::get<2>(first->node)};
+        const auto refCell = std::get<3>(first->node);
+        const auto refNodePosInMM = first->nodePos;
+
+        auto err = false;
+        for (auto &respXY: gridsPerMergedStrip) {
+            const auto smeared_strip_dir = std::get<0>(respXY.first); // DIR index
+            const auto delta_strip = std::get<1>(respXY.first);
+            const auto smeared_strip_num = refStrips[smeared_strip_dir] + delta_strip; // STRIP index
+            myGeometryPtr->Strip2posUVW(smeared_strip_dir, smeared_strip_num, err);
+            if (err) continue;
+
+            // sections of the merged strip and relative position of their boundaries wrt reference node
+            sectionStrips.clear();
+            boundaries.clear();
+            std::map<int, int> sectionSlot;
+            auto getSlot = [&](int section) {
+                if (section == GeometryTPC::outside_section) return -1;
+                auto it = sectionSlot.find(section);
+                if (it != sectionSlot.end()) return it->second;
+                const int slot = sectionStrips.size();
+                sectionSlot[section] = slot;
+                sectionStrips.push_back(myGeometryPtr->GetStripByDir(smeared_strip_dir, section, smeared_strip_num));
+                return slot;
+            };
+            for (auto &it: myGeometryPtr->GetStripSectionBoundaryList(smeared_strip_dir, smeared_strip_num)) {
+                const auto nextSlot = getSlot(it.next);
+                const auto previousSlot = getSlot(it.previous);
+                Boundary b{previousSlot, nextSlot, 0, nullptr};
+                const auto delta_pads = (int) TMath::Ceil(
+                        ((it.pos - refNodePosInMM) * myGeometryPtr->GetStripUnitVector(smeared_strip_dir)) /
+                        myGeometryPtr->GetPadPitch() + (delta_strip % 2 == 0 ? 0.0 : 0.5));
+                if (delta_pads < -Npads) {
+                    b.outside = -1;
+                } else if (delta_pads > Npads + abs(delta_strip) % 2) {
+                    b.outside = +1;
+                } else {
+                    const auto it2 = gridsPerStripSectionStart.find(
+                            MultiKey3(smeared_strip_dir, delta_strip, delta_pads));
+                    if (it2 == gridsPerStripSectionStart.end()) continue; // response not tabulated
+                    b.grid = it2->second;
+                }
+                boundaries.push_back(b);
+            }
+            const auto nsections = sectionStrips.size();
+            chargePerSection.assign(nsections * ncells, 0.0);
+            chargePerCell.assign(ncells, 0.0);
+
+            // accumulate charge of all deposits of the group in local buffers
+            for (auto dep = first; dep != last; ++dep) {
+#if(USE_XYDET_INTERPOLATION)
+                const auto smeared_fractionXY = respXY.second->interpolate(dep->dx, dep->dy);
+#else
+                const auto smeared_fractionXY = respXY.second->value(dep->dx, dep->dy);
+#endif
+                if (smeared_fractionXY < Utils::NUMERICAL_TOLERANCE) continue; // speeds up filling
+
+                // split merged strip fraction among sections (see addCharge)
+                fractionPerSection.assign(nsections, smeared_fractionXY);
+                for (auto &b: boundaries) {
+                    if (b.outside < 0) {
+                        if (b.previous >= 0) fractionPerSection[b.previous] = 0.0;
+                        continue;
+                    }
+                    if (b.outside > 0) {
+                        if (b.next >= 0) fractionPerSection[b.next] = 0.0;
+                        continue;
+                    }
+#if(USE_XYDET_INTERPOLATION)
+                    const auto section_fractionXY = b.grid->interpolate(dep->dx, dep->dy);
+#else
+                    const auto section_fractionXY = b.grid->value(dep->dx, dep->dy);
+#endif
+                    if (b.previous >= 0) fractionPerSection[b.previous] -= smeared_fractionXY - section_fractionXY;
+                    if (b.next >= 0) fractionPerSection[b.next] -= section_fractionXY;
+                }
+                for (auto &f: fractionPerSection) {
+                    if (f < 0.0) f = 0.0;
+                }
+
+                for (auto icell = 0u; icell < ncells; icell++) {
+#if(USE_ZDET_INTERPOLATION)
+                    const auto smeared_fractionZ = gridsPerTimecell[icell].second->interpolate(dep->dz);
+#else
+                    const auto smeared_fractionZ = gridsPerTimecell[icell].second->value(dep->dz);
+#endif
+                    const auto smeared_charge = dep->charge * smeared_fractionZ * smeared_fractionXY;
+                    if (smeared_charge < Utils::NUMERICAL_TOLERANCE) continue; // speeds up filling
+                    chargePerCell[icell] += smeared_charge;
+                    if (!aEventPtr) continue;
+                    for (auto isec = 0u; isec < nsections; isec++) {
+                        const auto smeared_charge_per_section = dep->charge * smeared_fractionZ * fractionPerSection[isec];
+                        if (smeared_charge_per_section < Utils::NUMERICAL_TOLERANCE) continue; // speeds up filling
+                        chargePerSection[isec * ncells + icell] += smeared_charge_per_section;
+                    }
+                }
+            }
+
+            // merge local buffers
+            for (auto icell = 0u; icell < ncells; icell++) {
+                if (chargePerCell[icell] == 0.0) continue;
+                const auto smeared_timecell = refCell + gridsPerTimecell[icell].first;
+                chargePerMergedStripCell[std::make_tuple(smeared_strip_dir, smeared_strip_num, smeared_timecell)] +=
+                        chargePerCell[icell];
+                if (has_UVWprojectionsInMM) { // same as addCharge: time cells without Z-position are not added to the event
+                    myGeometryPtr->Timecell2pos(smeared_timecell, err);
+                    if (err) continue;
+                }
+                for (auto isec = 0u; isec < nsections; isec++) {
+                    const auto val = chargePerSection[isec * ncells + icell];
+                    if (val == 0.0 || !sectionStrips[isec]) continue;
+                    auto &entry = chargePerStripCell[MultiKey4(smeared_strip_dir, sectionStrips[isec]->Section(),
+                                                               smeared_strip_num, smeared_timecell)];
+                    entry.first = sectionStrips[isec];
+                    entry.second += val;
+                }
+            }
+        }
+        first = last;
+    }
+
+    // step-3 - commit accumulated charges
+    auto err = false;
+    for (auto &it: chargePerMergedStripCell) {
+        const auto smeared_strip_dir = std::get<0>(it.first);
+        const auto smeared_strip_num = std::get<1>(it.first);
+        const auto smeared_timecell = std::get<2>(it.first);
+        if (has_UVWprojectionsRaw) {
+            fillUVWprojectionsRaw[smeared_strip_dir]->Fill(smeared_timecell * 1., smeared_strip_num * 1., it.second);
+        }
+        if (has_UVWprojectionsInMM) {
+            const auto smeared_pos = myGeometryPtr->Strip2posUVW(smeared_strip_dir, smeared_strip_num, err);
+            if (err) continue;
+            const auto smeared_z = myGeometryPtr->Timecell2pos(smeared_timecell, err);
+            if (err) continue;
+            fillUVWprojectionsInMM[smeared_strip_dir]->Fill(smeared_z, smeared_pos, it.second);
+        }
+    }
+    if (aEventPtr) {
+        for (auto &it: chargePerStripCell) {
+            aEventPtr->AddValByStrip(it.second.first, std::get<3>(it.first), it.second.second);
+        }
+    }
+}
+
 // returns vector with {u0, v0, w0} triplet corresponding to the nearest node in XY plane
 std::vector<int> StripResponseCalculator::getReferenceStripNode(TVector3 position3d, TVector2 *refNodePosInMM) const {
     return getReferenceStripNode(position3d.X(), position3d.Y(), refNodePosInMM);
@@ -544,7 +1025,7 @@ std::vector<int> StripResponseCalculator::getReferenceStripNode(TVector2 positio
 
 std::vector<int> StripResponseCalculator::getReferenceStripNode(double x, double y, TVector2 *refNodePosInMM) const {
     std::vector<int> result;
-    auto strip = myGeometryPtr->GetTH2PolyStrip(myGeometryPtr->GetTH2Poly()->FindBin(x, y));
+    auto strip = myGeometryPtr->GetStripByPosition(x, y);
     if (!strip) {
         if (debug_flag)
             std::cout << __FUNCTION__
@@ -579,8 +1060,7 @@ std::vector<int> StripResponseCalculator::getReferenceStripNode(double x, double
         for (auto isign = -1; isign <= 1; isign += 2) { // probe 2 adjacent pads for each direction index
             const auto checkPos =
                     nodePos + myGeometryPtr->GetStripUnitVector(check_dir) * 0.5 * myGeometryPtr->GetPadPitch() * isign;
-            const auto check_strip = myGeometryPtr->GetTH2PolyStrip(
-                    myGeometryPtr->GetTH2Poly()->FindBin(checkPos.X(), checkPos.Y()));
+            const auto check_strip = myGeometryPtr->GetStripByPosition(checkPos.X(), checkPos.Y());
             if (!check_strip) continue;
             stripMap[check_dir] = check_strip->Num();
 
@@ -630,7 +1110,7 @@ void StripResponseCalculator::initializeStripResponse(unsigned long NpointsXY, i
     // Each histogram corresponds to a single strip given by {relative strip index wrt reference node, strip direction} pair.
     // Center of each bin corresponds to the mean XY position [mm] wrt reference node of 2D normal distribution with spread sigmaXY.
     // Fill each bin with fraction of the charge corresponding to the total strip area.
-    // Integration is done using Monte Carlo technique.
+    // Integration is done using Monte Carlo technique (default) or analytically (see setInitMode).
     //
     // create empty 2D response histograms
     for (int istrip = -Nstrips; istrip <= Nstrips; istrip++) {
@@ -697,85 +1177,164 @@ void StripResponseCalculator::initializeStripResponse(unsigned long NpointsXY, i
         exit(-1);
     }
 
-    // generate random points around central node from 2D normal distribution
-    // and fill 2D response histograms
-    TF2 gauss2d("f_gauss2d", [](double *x, double *p) {
-                    return 1. / TMath::TwoPi() / p[0] / p[0] * exp(-0.5 * (x[0] * x[0] + x[1] * x[1]) / p[0] / p[0]);
-                },
-                -5 * sigma_xy, 5 * sigma_xy,
-                -5 * sigma_xy, 5 * sigma_xy, 1, 2); // 1 parameter, 2 dimensions
-    gauss2d.SetParameter(0, sigma_xy);
-    gauss2d.SetNpx(NbinsXY * 10);
-    gauss2d.SetNpy(NbinsXY * 10);
-    const auto weight = 1. / (double) NpointsXY;
-    const auto hist = responseMapPerMergedStrip.begin()->second;
+    // flat accumulators: one row per response histogram, one column per XY bin
+    // (each XY bin is processed by exactly one thread, so results do not depend on number of threads)
+    const auto hist = responseMapPerMergedStrip.begin()->second; // same bins for all XY response histograms
+    const auto nbinsX = hist->GetNbinsX();
+    const auto nbinsY = hist->GetNbinsY();
+    const auto nbins = nbinsX * nbinsY;
+    std::map<MultiKey2, int> mergedStripRow;
+    std::map<MultiKey3, int> sectionStartRow;
+    for (auto &it: responseMapPerMergedStrip) {
+        const int irow = mergedStripRow.size();
+        mergedStripRow[it.first] = irow;
+    }
+    for (auto &it: responseMapPerStripSectionStart) {
+        const int irow = sectionStartRow.size();
+        sectionStartRow[it.first] = irow;
+    }
+    std::vector<double> mergedStripContent(mergedStripRow.size() * nbins, 0.0);
+    std::vector<double> sectionStartContent(sectionStartRow.size() * nbins, 0.0);
+
     // calculate optimized acceptance radius (PAD SIZE + epsilon) to speed up initialziation
     const auto R2 = pow(myGeometryPtr->GetPadSize() +
                         sqrt(pow(hist->GetXaxis()->GetBinWidth(1), 2) + pow(hist->GetYaxis()->GetBinWidth(1), 2)),
                         2); // [mm^2]
-    for (unsigned long ipoint = 0L; ipoint < NpointsXY; ipoint++) {
-        double delta_x, delta_y;
-        gauss2d.GetRandom2(delta_x, delta_y);
-        if (debug_flag && ((ipoint < 1000 && ipoint % 100 == 0) ||
-                           ipoint % 1000 == 0)) {
-            std::cout << __FUNCTION__ << ": Generating point=" << ipoint << std::endl;
+    std::vector<int> activeBins; // linear bin index = (ibin2-1)*nbinsX + (ibin1-1)
+    for (auto ibin2 = 1; ibin2 <= nbinsY; ibin2++) {
+        const auto c2 = hist->GetYaxis()->GetBinCenter(ibin2);
+        for (auto ibin1 = 1; ibin1 <= nbinsX; ibin1++) {
+            const auto c1 = hist->GetXaxis()->GetBinCenter(ibin1);
+            if (c1 * c1 + c2 * c2 > R2) continue; // stay within radius of (PAD SIZE + epsilon)
+            activeBins.push_back((ibin2 - 1) * nbinsX + (ibin1 - 1));
         }
-        for (auto ibin1 = 1; ibin1 <= hist->GetNbinsX(); ibin1++) {
-            double c1 = hist->GetXaxis()->GetBinCenter(ibin1);
-            for (auto ibin2 = 1; ibin2 <= hist->GetNbinsY(); ibin2++) {
-                double c2 = hist->GetYaxis()->GetBinCenter(ibin2);
-                if (c1 * c1 + c2 * c2 > R2) continue; // stay within radius of (PAD SIZE + epsilon)
-                const auto x = c1 + delta_x; // [mm] wrt reference strip node
-                const auto y = c2 + delta_y; // [mm] wrt reference strip node
-                const auto strip = myGeometryPtr->GetTH2PolyStrip(
-                        myGeometryPtr->GetTH2Poly()->FindBin(refNodePosInMM.X() + x, refNodePosInMM.Y() + y));
-                if (!strip) continue;
-
-                // fill charge fraction for merged strips
-                const auto it = responseMapPerMergedStrip.find(
-                        MultiKey2(strip->Dir(), strip->Num() - refStrips[strip->Dir()]));
-                if (it == responseMapPerMergedStrip.end()) continue;
-                it->second->Fill(c1, c2, weight);
-
-                // fill charge fraction contained in the 1st section wrt total charge of the merged strip (two sections)
-                // when the 1st section ends / 2nd section starts between -Npads and +Npads from the reference strip node postion:
-                // * step-1 - each random hit is projected onto the reference strip axis
-                // * step-2 - relative pad number is computed (delta_pad) for each relative strip index
-                // * step-3A - EVEN relative strip index: delta_pad=0 if projection of the start of the 1st pad of the next section
-                //   is loacated at the reference node position
-                // * step-3B - ODD relative strip index: delta_pad=0 if projection of the centre of 1st pad of the next section
-                //   is located at the reference node position (i.e. shift by 0.5*pad_length towards lower pad numbers of a given strip)
-                // * step-4 - populate histograms with section's starting pad postion ranging from MAX(delta_pad, -Npads) to (Npads+eps),
-                //   where: eps=0 for EVEN relative strip index. 1 for ODD relative strip index
-                /*
-                      ___+3         ___+3    Nstrips=1 x Npads=2 case:
-                     /\      ___+2 /\
-                     \/__+2 /\     \/__+2    REF strip node point is at
-                     /\     \/     /\        (relative strip index)=0, (relative pad start index)=0
-                     \/     /\     \/
-                     /\     \/__0  /\
-                     \/__0  /\ REF \/__0
-                     /\     \/     /\         A  strip_unit_vector
-                     \/     /\     \/         |
-                     /\     \/__-2 /\         |
-                     \/__-2        \/__-2     |
-                                              +------->>  strip_pitch_vector
-                     odd    even   odd
-                     N-1    N+0    N+1
-                */
-                const auto delta_pads = (int) TMath::Ceil(
-                        (TVector2(x, y) * myGeometryPtr->GetStripUnitVector(strip->Dir())) /
-                        myGeometryPtr->GetPadPitch()
-                        + ((strip->Num() - refStrips[strip->Dir()]) % 2 == 0 ? 0.0 : 0.5));
-                for (auto ipad = std::max(-Npads, delta_pads);
-                     ipad <= Npads + abs(strip->Num() - refStrips[strip->Dir()]) % 2; ipad++) {
-                    const auto it2 = responseMapPerStripSectionStart.find(
-                            MultiKey3(strip->Dir(), strip->Num() - refStrips[strip->Dir()], ipad));
-                    if (it2 == responseMapPerStripSectionStart.end()) continue;
-                    it2->second->Fill(c1, c2, weight);
-                }
+    }
+
+    // Fill charge fraction contained in the 1st section wrt total charge of the merged strip (two sections)
+    // when the 1st section ends / 2nd section starts between -Npads and +Npads from the reference strip node postion:
+    // * step-1 - each random hit is projected onto the reference strip axis
+    // * step-2 - relative pad number is computed (delta_pad) for each relative strip index
+    // * step-3A - EVEN relative strip index: delta_pad=0 if projection of the start of the 1st pad of the next section
+    //   is loacated at the reference node position
+    // * step-3B - ODD relative strip index: delta_pad=0 if projection of the centre of 1st pad of the next section
+    //   is located at the reference node position (i.e. shift by 0.5*pad_length towards lower pad numbers of a given strip)
+    // * step-4 - populate histograms with section's starting pad postion ranging from MAX(delta_pad, -Npads) to (Npads+eps),
+    //   where: eps=0 for EVEN relative strip index. 1 for ODD relative strip index
+    /*
+          ___+3         ___+3    Nstrips=1 x Npads=2 case:
+         /\      ___+2 /\
+         \/__+2 /\     \/__+2    REF strip node point is at
+         /\     \/     /\        (relative strip index)=0, (relative pad start index)=0
+         \/     /\     \/
+         /\     \/__0  /\
+         \/__0  /\ REF \/__0
+         /\     \/     /\         A  strip_unit_vector
+         \/     /\     \/         |
+         /\     \/__-2 /\         |
+         \/__-2        \/__-2     |
+                                  +------->>  strip_pitch_vector
+         odd    even   odd
+         N-1    N+0    N+1
+    */
+
+    // returns relative section start index for charge at relative position {x, y} [mm] wrt reference node
+    auto getDeltaPads = [&](double x, double y, int dir, int delta_strip) {
+        return (int) TMath::Ceil((TVector2(x, y) * myGeometryPtr->GetStripUnitVector(dir)) /
+                                 myGeometryPtr->GetPadPitch() + (delta_strip % 2 == 0 ? 0.0 : 0.5));
+    };
+
+    // Monte Carlo: generate random points around each bin center from 2D normal distribution,
+    // point i is drawn from counter-based RNG stream {seed, i} and it is the same for every bin
+    const auto weight = 1. / (double) NpointsXY;
+    auto sampleBin = [&](int ibin) {
+        const auto c1 = hist->GetXaxis()->GetBinCenter(ibin % nbinsX + 1);
+        const auto c2 = hist->GetYaxis()->GetBinCenter(ibin / nbinsX + 1);
+        for (unsigned long ipoint = 0L; ipoint < NpointsXY; ipoint++) {
+            double delta_x, delta_y;
+            gaussianPair(random_seed, ipoint, sigma_xy, delta_x, delta_y);
+            const auto x = c1 + delta_x; // [mm] wrt reference strip node
+            const auto y = c2 + delta_y; // [mm] wrt reference strip node
+            const auto strip = myGeometryPtr->GetStripByPosition(refNodePosInMM.X() + x, refNodePosInMM.Y() + y);
+            if (!strip) continue;
+
+            // fill charge fraction for merged strips
+            const auto delta_strip = strip->Num() - refStrips[strip->Dir()];
+            const auto it = mergedStripRow.find(MultiKey2(strip->Dir(), delta_strip));
+            if (it == mergedStripRow.end()) continue;
+            mergedStripContent[it->second * nbins + ibin] += weight;
+
+            // fill charge fraction contained in the 1st section for all section starts at or above delta_pads
+            const auto delta_pads = getDeltaPads(x, y, strip->Dir(), delta_strip);
+            for (auto ipad = std::max(-Npads, delta_pads); ipad <= Npads + abs(delta_strip) % 2; ipad++) {
+                const auto it2 = sectionStartRow.find(MultiKey3(strip->Dir(), delta_strip, ipad));
+                if (it2 == sectionStartRow.end()) continue;
+                sectionStartContent[it2->second * nbins + ibin] += weight;
+            }
+        }
+    };
+
+    // Analytic: integrate 2D normal distribution centered at each bin center over every pad polygon,
+    // section starts are handled by clipping pads with half-plane: delta_pads <= ipad
+    const auto &index = myGeometryPtr->GetStripIndex();
+    auto integrateBin = [&](int ibin) {
+        const auto c1 = hist->GetXaxis()->GetBinCenter(ibin % nbinsX + 1);
+        const auto c2 = hist->GetYaxis()->GetBinCenter(ibin / nbinsX + 1);
+        const auto x0 = refNodePosInMM.X() + c1;
+        const auto y0 = refNodePosInMM.Y() + c2;
+        const auto R = 6 * sigma_xy; // [mm] integration range
+        std::vector<unsigned int> pads;
+        std::vector<double> xy, clipped;
+        index.GetPolygonsInBox(x0 - R, x0 + R, y0 - R, y0 + R, pads);
+        for (auto ipoly: pads) {
+            const auto strip = myGeometryPtr->GetTH2PolyStrip(index.GetPolygonId(ipoly));
+            if (!strip) continue;
+            const auto delta_strip = strip->Num() - refStrips[strip->Dir()];
+            const auto it = mergedStripRow.find(MultiKey2(strip->Dir(), delta_strip));
+            if (it == mergedStripRow.end()) continue;
+            index.GetPolygonVertices(ipoly, xy);
+            const auto fraction = gaussianPolygonIntegral(xy, x0, y0, sigma_xy);
+            if (fraction <= 0.0) continue;
+            mergedStripContent[it->second * nbins + ibin] += fraction;
+
+            const auto unit = myGeometryPtr->GetStripUnitVector(strip->Dir());
+            for (auto ipad = -Npads; ipad <= Npads + abs(delta_strip) % 2; ipad++) {
+                const auto it2 = sectionStartRow.find(MultiKey3(strip->Dir(), delta_strip, ipad));
+                if (it2 == sectionStartRow.end()) continue;
+                // Ceil(t)<=ipad <=> t<=ipad, where t=(pos-refNode)*unit/pitch+offset
+                const auto limit = (ipad - (delta_strip % 2 == 0 ? 0.0 : 0.5)) * myGeometryPtr->GetPadPitch() +
+                                   refNodePosInMM * unit;
+                clipHalfPlane(xy, unit.X(), unit.Y(), limit, clipped);
+                if (clipped.size() < 6) continue;
+                sectionStartContent[it2->second * nbins + ibin] += gaussianPolygonIntegral(clipped, x0, y0, sigma_xy);
             }
         }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    if (init_mode == InitMode::Analytic) {
+        parallelFor(activeBins.size(), nthreads, [&](size_t i) { integrateBin(activeBins[i]); });
+    } else {
+        parallelFor(activeBins.size(), nthreads, [&](size_t i) { sampleBin(activeBins[i]); });
+    }
+    if (debug_flag) {
+        std::cout << __FUNCTION__ << ": Filled " << activeBins.size() << " bins x "
+                  << mergedStripRow.size() + sectionStartRow.size() << " histograms in "
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s ("
+                  << (init_mode == InitMode::Analytic ? "analytic" : "Monte Carlo") << ")" << std::endl;
+    }
+
+    // copy results to histograms
+    for (auto &it: mergedStripRow) {
+        auto h = responseMapPerMergedStrip[it.first];
+        for (auto ibin: activeBins) {
+            h->SetBinContent(ibin % nbinsX + 1, ibin / nbinsX + 1, mergedStripContent[it.second * nbins + ibin]);
+        }
+    }
+    for (auto &it: sectionStartRow) {
+        auto h = responseMapPerStripSectionStart[it.first];
+        for (auto ibin: activeBins) {
+            h->SetBinContent(ibin % nbinsX + 1, ibin / nbinsX + 1, sectionStartContent[it.second * nbins + ibin]);
+        }
     }
 
     ////// DEBUG
@@ -812,6 +1371,8 @@ void StripResponseCalculator::initializeStripResponse(unsigned long NpointsXY, i
                   << " horizontal response 2D histograms (section start position)." << std::endl;
     }
     ////// DEBUG
+
+    updateResponseTable();
 }
 
 // re-generate time response histograms with arbitrary granularity
@@ -903,33 +1464,67 @@ void StripResponseCalculator::initializeTimeResponse(unsigned long NpointsPeakin
             it.second->Reset(); // reset all content
         }
 
-        // perform convolution using random sampling technique
-        for (unsigned long ipoint = 0L; ipoint < NpointsPeakingTime; ipoint++) {
-            if (debug_flag && ((ipoint < 1000 && ipoint % 100 == 0) ||
-                               ipoint % 1000 == 0)) {
-                std::cout << __FUNCTION__ << ": Generating point=" << ipoint << std::endl;
+        if (init_mode == InitMode::Analytic) {
+            // perform convolution using cumulative distribution of the response function (trapezoidal rule)
+            const auto npx = 10000;
+            const auto tmax = responseShape1d.GetXmax(); // [ns]
+            std::vector<double> cdf(npx + 1, 0.0);
+            for (auto i = 1; i <= npx; i++) {
+                cdf[i] = cdf[i - 1] + 0.5 * (responseShape1d.Eval((i - 1) * tmax / npx) +
+                                             responseShape1d.Eval(i * tmax / npx)) * tmax / npx;
             }
-            // get relative smeared position
-            auto delta_z_mm = factor_ns2mm * responseShape1d.GetRandom(); // [mm]
+            for (auto &it: cdf) it /= cdf.back();
+            auto smearingCDF = [&](double delta_z_mm) { // probability of smearing below delta_z_mm
+                const auto f = delta_z_mm / factor_ns2mm / tmax * npx;
+                if (f <= 0) return 0.0;
+                if (f >= npx) return 1.0;
+                const auto i = (int) f;
+                return cdf[i] + (f - i) * (cdf[i + 1] - cdf[i]);
+            };
             for (auto &it: responseMapPerTimecell) {
                 auto hist = it.second; // original histogram (without GET electronics effects)
                 for (auto ibin = 1; ibin <= hist->GetNbinsX(); ibin++) {
                     auto c = hist->GetBinCenter(ibin);
                     auto charge_frac = hist->GetBinContent(ibin); // amount of charge to be smeared
-                    const auto weight =
-                            charge_frac / (double) NpointsPeakingTime; // contribution of a single sampling point
-                    // determine relative time cell index and corresponding histogram (with GET electronics effects)
-                    auto index_fill = (int) ((c + delta_z_mm) / myGeometryPtr->GetTimeBinWidth()); // relative time cell
-                    if (responseMapPerTimecellWithPeakingTime.find(index_fill) !=
-                        responseMapPerTimecellWithPeakingTime.end()) {
-                        responseMapPerTimecellWithPeakingTime[index_fill]->Fill(c, weight);
-                        //// DEBUG
-                        // if(debug_flag && ( (ipoint<1000 && ipoint%100==0) ||
-                        // 		       ipoint%1000==0 )) {
-                        //   auto index=it.first; // relative time cell
-                        //   std::cout << __FUNCTION__ << ": Generating point: " << ipoint << ": Original [cell, pos]=[" << index << ", " << c << "], Smeared cell=" << index_fill << std::endl;
-                        // }
-                        //// DEBUG
+                    // charge lands in relative time cell k=floor((c + delta_z_mm) / time_bin_width),
+                    // i.e. for delta_z_mm in [k * time_bin_width - c, (k + 1) * time_bin_width - c)
+                    for (auto &it2: responseMapPerTimecellWithPeakingTime) {
+                        const auto a = it2.first * myGeometryPtr->GetTimeBinWidth() - c;
+                        const auto b = a + myGeometryPtr->GetTimeBinWidth();
+                        it2.second->Fill(c, charge_frac * (smearingCDF(b) - smearingCDF(a)));
+                    }
+                }
+            }
+        } else {
+            // perform convolution using random sampling technique
+            for (unsigned long ipoint = 0L; ipoint < NpointsPeakingTime; ipoint++) {
+                if (debug_flag && ((ipoint < 1000 && ipoint % 100 == 0) ||
+                                   ipoint % 1000 == 0)) {
+                    std::cout << __FUNCTION__ << ": Generating point=" << ipoint << std::endl;
+                }
+                // get relative smeared position
+                auto delta_z_mm = factor_ns2mm * responseShape1d.GetRandom(); // [mm]
+                for (auto &it: responseMapPerTimecell) {
+                    auto hist = it.second; // original histogram (without GET electronics effects)
+                    for (auto ibin = 1; ibin <= hist->GetNbinsX(); ibin++) {
+                        auto c = hist->GetBinCenter(ibin);
+                        auto charge_frac = hist->GetBinContent(ibin); // amount of charge to be smeared
+                        const auto weight =
+                                charge_frac / (double) NpointsPeakingTime; // contribution of a single sampling point
+                        // determine relative time cell index and corresponding histogram (with GET electronics effects)
+                        // relative time cell, same rule as in the analytic mode
+                        auto index_fill = (int) std::floor((c + delta_z_mm) / myGeometryPtr->GetTimeBinWidth());
+                        if (responseMapPerTimecellWithPeakingTime.find(index_fill) !=
+                            responseMapPerTimecellWithPeakingTime.end()) {
+                            responseMapPerTimecellWithPeakingTime[index_fill]->Fill(c, weight);
+                            //// DEBUG
+                            // if(debug_flag && ( (ipoint<1000 && ipoint%100==0) ||
+                            // 		       ipoint%1000==0 )) {
+                            //   auto index=it.first; // relative time cell
+                            //   std::cout << __FUNCTION__ << ": Generating point: " << ipoint << ": Original [cell, pos]=[" << index << ", " << c << "], Smeared cell=" << index_fill << std::endl;
+                            // }
+                            //// DEBUG
+                        }
                     }
                 }
             }
@@ -957,11 +1552,43 @@ void StripResponseCalculator::initializeTimeResponse(unsigned long NpointsPeakin
                   << " vertical response 1D histograms (GAUSS + PEAKING TIME)." << std::endl;
     }
     ////// DEBUG
+
+    updateResponseTable();
+}
+
+namespace {
+    // re-creates histogram from flat response table (e.g. after loading binary file)
+    std::shared_ptr<TH2D> makeHistogram(const char *name, const StripResponseTable::Grid2D *grid) {
+        if (!grid) return std::shared_ptr<TH2D>();
+        auto hist = std::make_shared<TH2D>(name, name, grid->nx, grid->xmin, grid->xmax, grid->ny, grid->ymin,
+                                           grid->ymax);
+        hist->SetDirectory(0);
+        for (auto iy = 0; iy < grid->ny; iy++) {
+            for (auto ix = 0; ix < grid->nx; ix++) {
+                hist->SetBinContent(ix + 1, iy + 1, grid->data[iy * grid->nx + ix]);
+            }
+        }
+        return hist;
+    }
+
+    std::shared_ptr<TH1D> makeHistogram(const char *name, const StripResponseTable::Grid1D *grid) {
+        if (!grid) return std::shared_ptr<TH1D>();
+        auto hist = std::make_shared<TH1D>(name, name, grid->nx, grid->xmin, grid->xmax);
+        hist->SetDirectory(0);
+        for (auto ix = 0; ix < grid->nx; ix++) {
+            hist->SetBinContent(ix + 1, grid->data[ix]);
+        }
+        return hist;
+    }
 }
 
 std::shared_ptr<TH2D> StripResponseCalculator::getStripResponseHistogram(int dir, int delta_strip) {
     const auto it = responseMapPerMergedStrip.find(MultiKey2(dir, delta_strip));
-    if (it == responseMapPerMergedStrip.end()) return std::shared_ptr<TH2D>();
+    if (it == responseMapPerMergedStrip.end()) {
+        if (!responseTable) return std::shared_ptr<TH2D>();
+        return makeHistogram(getStripResponseHistogramName(dir, delta_strip),
+                             responseTable->findMergedStrip(dir, delta_strip));
+    }
     TH2D *hist = (TH2D *) (it->second->Clone());
     hist->SetDirectory(0); // do not associate this clone with any TFile dir to prevent memory leaks
     std::shared_ptr<TH2D> result(hist);
@@ -974,7 +1601,11 @@ std::shared_ptr<TH2D> StripResponseCalculator::getStripResponseHistogram(int dir
 std::shared_ptr<TH2D>
 StripResponseCalculator::getStripSectionStartResponseHistogram(int dir, int delta_strip, int delta_pad) {
     const auto it = responseMapPerStripSectionStart.find(MultiKey3(dir, delta_strip, delta_pad));
-    if (it == responseMapPerStripSectionStart.end()) return std::shared_ptr<TH2D>();
+    if (it == responseMapPerStripSectionStart.end()) {
+        if (!responseTable) return std::shared_ptr<TH2D>();
+        return makeHistogram(getStripSectionStartResponseHistogramName(dir, delta_strip, delta_pad),
+                             responseTable->findStripSectionStart(dir, delta_strip, delta_pad));
+    }
     TH2D *hist = (TH2D *) (it->second->Clone());
     hist->SetDirectory(0); // do not associate this clone with any TFile dir to prevent memory leaks
     std::shared_ptr<TH2D> result(hist);
@@ -986,7 +1617,11 @@ StripResponseCalculator::getStripSectionStartResponseHistogram(int dir, int delt
 
 std::shared_ptr<TH1D> StripResponseCalculator::getTimeResponseHistogram(int delta_timecell) {
     const auto it = responseMapPerTimecell.find(delta_timecell);
-    if (it == responseMapPerTimecell.end()) return std::shared_ptr<TH1D>();
+    if (it == responseMapPerTimecell.end()) {
+        if (!responseTable) return std::shared_ptr<TH1D>();
+        return makeHistogram(getTimeResponseHistogramName(delta_timecell),
+                             responseTable->findTimecell(delta_timecell));
+    }
     TH1D *hist = (TH1D *) (it->second->Clone());
     hist->SetDirectory(0); // do not associate this clone with any TFile dir to prevent memory leaks
     std::shared_ptr<TH1D> result(hist);
@@ -1030,3 +1665,10 @@ StripResponseCalculator::generateRootFileName(int nStrips, int nCells, int nPads
     }
     return result;
 }
+
+std::string
+StripResponseCalculator::generateBinaryFileName(int nStrips, int nCells, int nPads, double sigmaXY, double sigmaZ,
+                                                double peakingTime, double samplingRate, double vDrift) {
+    auto result = generateRootFileName(nStrips, nCells, nPads, sigmaXY, sigmaZ, peakingTime, samplingRate, vDrift);
+    return result.substr(0, result.size() - std::string(".root").size()) + ".srt";
+}
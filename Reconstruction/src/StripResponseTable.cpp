@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TPCReco/StripResponseTable.h"
+#include "TPCReco/colorText.h"
+
+namespace {
+
+    const char tableMagic[8] = {'T', 'P', 'C', 'S', 'R', 'T', 'B', '\0'};
+    const uint32_t endianTag{0x01020304};
+    const size_t dataAlignment{64}; // [bytes] alignment of each float array
+
+    // on-disk file header (native endianness, verified by endianTag)
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t endian;
+        int32_t nStrips;
+        int32_t nTimecells;
+        int32_t nPads;
+        int32_t nEntries;
+        double sigmaXY;
+        double sigmaZ;
+        double peakingTime;
+        double samplingRate;
+        double driftVelocity;
+        double padSize;
+        double padPitch;
+        uint64_t dataOffset; // [bytes] start of first float array
+        uint64_t totalSize;  // [bytes] size of entire image
+    };
+
+    // on-disk descriptor of single response histogram
+    struct FileEntry {
+        int32_t kind;
+        int32_t key1, key2, key3;
+        int32_t nx, ny;
+        double xmin, xmax, ymin, ymax;
+        uint64_t offset; // [bytes] wrt beginning of image
+    };
+
+    static_assert(sizeof(FileHeader) == 104, "Unexpected padding of StripResponseTable file header");
+    static_assert(sizeof(FileEntry) == 64, "Unexpected padding of StripResponseTable file entry");
+
+    inline size_t alignUp(size_t n) { return (n + dataAlignment - 1) / dataAlignment * dataAlignment; }
+
+    inline bool sameValue(double a, double b) {
+        return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::max(std::fabs(a), std::fabs(b)));
+    }
+
+    // process-wide registry of mapped files to share them between calculators/threads
+    std::mutex openTablesMutex;
+    std::map<std::string, std::weak_ptr<const StripResponseTable> > openTables;
+
+} // namespace
+
+bool StripResponseTable::Parameters::isCompatible(const Parameters &other) const {
+    return nStrips == other.nStrips && nTimecells == other.nTimecells && nPads == other.nPads &&
+           sameValue(sigmaXY, other.sigmaXY) && sameValue(sigmaZ, other.sigmaZ) &&
+           sameValue(peakingTime, other.peakingTime) &&
+           sameValue(samplingRate, other.samplingRate) && sameValue(driftVelocity, other.driftVelocity) &&
+           sameValue(padSize, other.padSize) && sameValue(padPitch, other.padPitch);
+}
+
+StripResponseTable::~StripResponseTable() {
+    if (mapAddress) munmap(mapAddress, mapSize);
+}
+
+std::shared_ptr<const StripResponseTable>
+StripResponseTable::create(const Parameters &par, const std::vector<Entry> &entries) {
+
+    // sort entries by {kind, key1, key2, key3} to get deterministic layout
+    std::vector<const Entry *> sorted;
+    for (auto &it: entries) sorted.push_back(&it);
+    std::sort(sorted.begin(), sorted.end(), [](const Entry *a, const Entry *b) {
+        return std::make_tuple((int) a->kind, a->key1, a->key2, a->key3) <
+               std::make_tuple((int) b->kind, b->key1, b->key2, b->key3);
+    });
+
+    // compute layout
+    const size_t descOffset = sizeof(FileHeader);
+    size_t offset = alignUp(descOffset + sorted.size() * sizeof(FileEntry));
+    const size_t dataOffset = offset;
+    std::vector<FileEntry> desc(sorted.size());
+    for (auto i = 0u; i < sorted.size(); i++) {
+        const auto &e = *sorted[i];
+        if (e.nx <= 0 || e.ny <= 0 || (size_t) e.nx * e.ny != e.content.size() ||
+            !(e.xmax > e.xmin) || !(e.ymax > e.ymin)) {
+            std::cout << __FUNCTION__ << KRED << ": Invalid response table entry!" << RST << std::endl;
+            return std::shared_ptr<const StripResponseTable>();
+        }
+        desc[i].kind = (int32_t) e.kind;
+        desc[i].key1 = e.key1;
+        desc[i].key2 = e.key2;
+        desc[i].key3 = e.key3;
+        desc[i].nx = e.nx;
+        desc[i].ny = e.ny;
+        desc[i].xmin = e.xmin;
+        desc[i].xmax = e.xmax;
+        desc[i].ymin = e.ymin;
+        desc[i].ymax = e.ymax;
+        desc[i].offset = offset;
+        offset = alignUp(offset + e.content.size() * sizeof(float));
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, tableMagic, sizeof(tableMagic));
+    header.version = formatVersion;
+    header.endian = endianTag;
+    header.nStrips = par.nStrips;
+    header.nTimecells = par.nTimecells;
+    header.nPads = par.nPads;
+    header.nEntries = (int32_t) sorted.size();
+    header.sigmaXY = par.sigmaXY;
+    header.sigmaZ = par.sigmaZ;
+    header.peakingTime = par.peakingTime;
+    header.samplingRate = par.samplingRate;
+    header.driftVelocity = par.driftVelocity;
+    header.padSize = par.padSize;
+    header.padPitch = par.padPitch;
+    header.dataOffset = dataOffset;
+    header.totalSize = offset;
+
+    std::shared_ptr<StripResponseTable> table(new StripResponseTable());
+    table->ownedImage.assign(offset, 0);
+    char *buf = table->ownedImage.data();
+    std::memcpy(buf, &header, sizeof(header));
+    if (!desc.empty()) std::memcpy(buf + descOffset, desc.data(), desc.size() * sizeof(FileEntry));
+    for (auto i = 0u; i < sorted.size(); i++) {
+        std::memcpy(buf + desc[i].offset, sorted[i]->content.data(), sorted[i]->content.size() * sizeof(float));
+    }
+    if (!table->attach(buf, offset, true)) return std::shared_ptr<const StripResponseTable>();
+    return table;
+}
+
+bool StripResponseTable::isResponseTableFile(const std::string &fname) {
+    std::ifstream f(fname, std::ios::binary);
+    char magic[sizeof(tableMagic)];
+    if (!f.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, tableMagic, sizeof(tableMagic)) == 0;
+}
+
+std::shared_ptr<const StripResponseTable> StripResponseTable::open(const std::string &fname, bool debug_flag) {
+
+    const int fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (debug_flag)
+            std::cout << __FUNCTION__ << KRED << ": Cannot open file: " << fname << "!" << RST << std::endl;
+        return std::shared_ptr<const StripResponseTable>();
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(FileHeader)) {
+        if (debug_flag)
+            std::cout << __FUNCTION__ << KRED << ": Invalid file: " << fname << "!" << RST << std::endl;
+        ::close(fd);
+        return std::shared_ptr<const StripResponseTable>();
+    }
+
+    // reuse mapping of the same file (same inode and modification time) within this process
+    std::ostringstream id;
+    id << st.st_dev << ":" << st.st_ino << ":" << st.st_size << ":" << st.st_mtime;
+    std::lock_guard<std::mutex> lock(openTablesMutex);
+    auto it = openTables.find(id.str());
+    if (it != openTables.end()) {
+        auto table = it->second.lock();
+        if (table) {
+            ::close(fd);
+            return table;
+        }
+    }
+
+    void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // mapping stays valid
+    if (addr == MAP_FAILED) {
+        if (debug_flag)
+            std::cout << __FUNCTION__ << KRED << ": Cannot map file: " << fname << "!" << RST << std::endl;
+        return std::shared_ptr<const StripResponseTable>();
+    }
+    std::shared_ptr<StripResponseTable> table(new StripResponseTable());
+    table->mapAddress = addr;
+    table->mapSize = st.st_size;
+    if (!table->attach(static_cast<const char *>(addr), st.st_size, debug_flag)) {
+        if (debug_flag)
+            std::cout << __FUNCTION__ << KRED << ": Corrupted or incompatible file: " << fname << "!" << RST
+                      << std::endl;
+        return std::shared_ptr<const StripResponseTable>();
+    }
+    openTables[id.str()] = table;
+    return table;
+}
+
+bool StripResponseTable::save(const std::string &fname) const {
+    if (!image) return false;
+    std::ostringstream tmpName;
+    tmpName << fname << ".tmp" << getpid();
+    {
+        std::ofstream f(tmpName.str(), std::ios::binary | std::ios::trunc);
+        if (!f.write(image, imageSize)) {
+            std::remove(tmpName.str().c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpName.str().c_str(), fname.c_str()) != 0) {
+        std::remove(tmpName.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool StripResponseTable::attach(const char *data, size_t size, bool debug_flag) {
+    if (size < sizeof(FileHeader)) return false;
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, tableMagic, sizeof(tableMagic)) != 0) return false;
+    if (header.endian != endianTag || header.version != formatVersion) {
+        if (debug_flag)
+            std::cout << __FUNCTION__ << KRED << ": Unsupported response table version=" << header.version
+                      << RST << std::endl;
+        return false;
+    }
+    if (header.nEntries < 0 || header.totalSize != size ||
+        sizeof(FileHeader) + (size_t) header.nEntries * sizeof(FileEntry) > size) {
+        return false;
+    }
+
+    par.nStrips = header.nStrips;
+    par.nTimecells = header.nTimecells;
+    par.nPads = header.nPads;
+    par.sigmaXY = header.sigmaXY;
+    par.sigmaZ = header.sigmaZ;
+    par.peakingTime = header.peakingTime;
+    par.samplingRate = header.samplingRate;
+    par.driftVelocity = header.driftVelocity;
+    par.padSize = header.padSize;
+    par.padPitch = header.padPitch;
+
+    keys2D.clear();
+    grids2D.clear();
+    keys1D.clear();
+    grids1D.clear();
+    for (int i = 0; i < header.nEntries; i++) {
+        FileEntry e;
+        std::memcpy(&e, data + sizeof(FileHeader) + i * sizeof(FileEntry), sizeof(e));
+        if (e.nx <= 0 || e.ny <= 0 || e.offset % sizeof(float) != 0 ||
+            e.offset + (uint64_t) e.nx * e.ny * sizeof(float) > size ||
+            !(e.xmax > e.xmin) || !(e.ymax > e.ymin)) {
+            return false;
+        }
+        const auto values = reinterpret_cast<const float *>(data + e.offset);
+        switch ((Kind) e.kind) {
+            case Kind::MergedStrip:
+            case Kind::StripSectionStart: {
+                Grid2D g;
+                g.nx = e.nx;
+                g.ny = e.ny;
+                g.xmin = e.xmin;
+                g.xmax = e.xmax;
+                g.ymin = e.ymin;
+                g.ymax = e.ymax;
+                g.inv_dx = e.nx / (e.xmax - e.xmin);
+                g.inv_dy = e.ny / (e.ymax - e.ymin);
+                g.data = values;
+                keys2D.push_back({(Kind) e.kind, e.key1, e.key2, e.key3});
+                grids2D.push_back(g);
+                break;
+            }
+            case Kind::Timecell: {
+                if (e.ny != 1) return false;
+                Grid1D g;
+                g.nx = e.nx;
+                g.xmin = e.xmin;
+                g.xmax = e.xmax;
+                g.inv_dx = e.nx / (e.xmax - e.xmin);
+                g.data = values;
+                keys1D.push_back(e.key1);
+                grids1D.push_back(g);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    image = data;
+    imageSize = size;
+    return true;
+}
+
+const StripResponseTable::Grid2D *StripResponseTable::findMergedStrip(int dir, int delta_strip) const {
+    for (auto i = 0u; i < keys2D.size(); i++) {
+        const auto &k = keys2D[i];
+        if (k.kind == Kind::MergedStrip && k.key1 == dir && k.key2 == delta_strip) return &grids2D[i];
+    }
+    return nullptr;
+}
+
+const StripResponseTable::Grid2D *
+StripResponseTable::findStripSectionStart(int dir, int delta_strip, int delta_pad) const {
+    for (auto i = 0u; i < keys2D.size(); i++) {
+        const auto &k = keys2D[i];
+        if (k.kind == Kind::StripSectionStart && k.key1 == dir && k.key2 == delta_strip && k.key3 == delta_pad)
+            return &grids2D[i];
+    }
+    return nullptr;
+}
+
+const StripResponseTable::Grid1D *StripResponseTable::findTimecell(int delta_timecell) const {
+    for (auto i = 0u; i < keys1D.size(); i++) {
+        if (keys1D[i] == delta_timecell) return &grids1D[i];
+    }
+    return nullptr;
+}
@@ -135,13 +135,14 @@ void TrackBuilder::reconstruct(){
 
   hTimeProjection.Reset();  
   for(int iDir=definitions::projection_type::DIR_U;iDir<=definitions::projection_type::DIR_W;++iDir){
+    if(isCancelled()) return;
     makeRecHits(iDir);
     fillHoughAccumulator(iDir);
     my2DSeeds[iDir] = findSegment2DCollection(iDir);    
   }
   myZRange = getTimeProjectionEdges();
   myTrack3DSeed = buildSegment3D();
-  if(myTrack3DSeed.getLength()<1) return;
+  if(myTrack3DSeed.getLength()<1 || isCancelled()) return;
   
   Track3D aTrackCandidate;
   aTrackCandidate.addSegment(myTrack3DSeed);
@@ -150,6 +151,7 @@ void TrackBuilder::reconstruct(){
   aTrackCandidate.extendToChamberRange(xyRange, myZRange);
 
   aTrackCandidate = fitTrack3D(aTrackCandidate);
+  if(isCancelled()) return;
   aTrackCandidate = fitEventHypothesis(aTrackCandidate);
   myFittedTrack = aTrackCandidate;
 }
@@ -0,0 +1,229 @@
+#include "TPCReco/StripResponseCalculator.h"
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/CommonDefinitions.h"
+#include "TPCReco/PEventTPC.h"
+#include "gtest/gtest.h"
+#include <TH1D.h>
+#include <TH2D.h>
+#include <TRandom.h>
+#include <TRandom3.h>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+class StripResponseCalculatorTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() {
+    TH1::AddDirectory(false);
+    geometry = std::make_shared<GeometryTPC>(
+        (std::string(TPCRECO_RESOURCE_DIR) + "/geometry_ELITPC.dat").c_str(), false);
+  }
+
+  static void TearDownTestSuite() { geometry.reset(); }
+
+  // small response model, initialized with default settings by the constructor
+  static std::unique_ptr<StripResponseCalculator> makeCalculator(double peakingTime = 0) {
+    return std::unique_ptr<StripResponseCalculator>(
+        new StripResponseCalculator(geometry, 1, 2, 2, 0.8, 1.0, peakingTime));
+  }
+
+  // contents of all merged strip and section start histograms, in fixed order
+  static std::vector<double> stripResponse(StripResponseCalculator &calculator) {
+    std::vector<double> result;
+    auto append = [&result](const std::shared_ptr<TH2D> &hist) {
+      if (!hist) return;
+      for (int ix = 1; ix <= hist->GetNbinsX(); ix++) {
+        for (int iy = 1; iy <= hist->GetNbinsY(); iy++) {
+          result.push_back(hist->GetBinContent(ix, iy));
+        }
+      }
+    };
+    for (auto dir : {definitions::projection_type::DIR_U, definitions::projection_type::DIR_V,
+                     definitions::projection_type::DIR_W}) {
+      for (int strip = -calculator.getDeltaStrips(); strip <= calculator.getDeltaStrips(); strip++) {
+        append(calculator.getStripResponseHistogram(dir, strip));
+        for (int pad = -calculator.getDeltaPads(); pad <= calculator.getDeltaPads() + 1; pad++) {
+          append(calculator.getStripSectionStartResponseHistogram(dir, strip, pad));
+        }
+      }
+    }
+    return result;
+  }
+
+  static std::vector<double> timeResponse(StripResponseCalculator &calculator) {
+    std::vector<double> result;
+    for (int cell = -calculator.getDeltaTimecells(); cell <= calculator.getDeltaTimecells(); cell++) {
+      auto hist = calculator.getTimeResponseHistogram(cell);
+      if (!hist) continue;
+      for (int ibin = 1; ibin <= hist->GetNbinsX(); ibin++) result.push_back(hist->GetBinContent(ibin));
+    }
+    return result;
+  }
+
+  static std::shared_ptr<GeometryTPC> geometry;
+};
+
+std::shared_ptr<GeometryTPC> StripResponseCalculatorTest::geometry;
+
+TEST_F(StripResponseCalculatorTest, MonteCarloIndependentOfThreads) {
+  ASSERT_TRUE(geometry->IsOK());
+  auto calculator = makeCalculator();
+  calculator->setInitMode(StripResponseCalculator::InitMode::MonteCarlo);
+  calculator->setRandomSeed(7);
+
+  calculator->setNthreads(1);
+  calculator->initializeStripResponse(5000, 6);
+  const auto single = stripResponse(*calculator);
+  ASSERT_FALSE(single.empty());
+
+  calculator->setNthreads(4);
+  calculator->initializeStripResponse(5000, 6);
+  EXPECT_EQ(stripResponse(*calculator), single);
+
+  calculator->setRandomSeed(8);
+  calculator->initializeStripResponse(5000, 6);
+  EXPECT_NE(stripResponse(*calculator), single);
+}
+
+TEST_F(StripResponseCalculatorTest, AnalyticAgreesWithMonteCarlo) {
+  ASSERT_TRUE(geometry->IsOK());
+  auto calculator = makeCalculator(232);
+  const unsigned long nPoints = 200000;
+  // statistical error of a charge fraction is below 0.5/sqrt(nPoints)=1.1e-3
+  const double tolerance = 6e-3;
+
+  gRandom->SetSeed(12345); // AGET response is sampled with TF1::GetRandom
+  calculator->setInitMode(StripResponseCalculator::InitMode::MonteCarlo);
+  calculator->setRandomSeed(11);
+  calculator->initializeStripResponse(nPoints, 4);
+  calculator->initializeTimeResponse(nPoints, 8);
+  const auto stripMC = stripResponse(*calculator);
+  const auto timeMC = timeResponse(*calculator);
+
+  calculator->setInitMode(StripResponseCalculator::InitMode::Analytic);
+  calculator->initializeStripResponse(nPoints, 4);
+  calculator->initializeTimeResponse(nPoints, 8);
+  const auto stripAnalytic = stripResponse(*calculator);
+  const auto timeAnalytic = timeResponse(*calculator);
+
+  ASSERT_EQ(stripAnalytic.size(), stripMC.size());
+  ASSERT_FALSE(stripMC.empty());
+  for (size_t i = 0; i < stripMC.size(); i++) {
+    EXPECT_NEAR(stripAnalytic[i], stripMC[i], tolerance) << "strip response value " << i;
+  }
+  ASSERT_EQ(timeAnalytic.size(), timeMC.size());
+  ASSERT_FALSE(timeMC.empty());
+  for (size_t i = 0; i < timeMC.size(); i++) {
+    EXPECT_NEAR(timeAnalytic[i], timeMC[i], tolerance) << "time response value " << i;
+  }
+}
+
+TEST_F(StripResponseCalculatorTest, ResponseTableRoundTrip) {
+  ASSERT_TRUE(geometry->IsOK());
+  auto calculator = makeCalculator(232);
+  calculator->setInitMode(StripResponseCalculator::InitMode::Analytic);
+  calculator->initializeStripResponse(1000, 4);
+  calculator->initializeTimeResponse(1000, 8);
+  const auto strip = stripResponse(*calculator);
+  const auto time = timeResponse(*calculator);
+  ASSERT_FALSE(strip.empty());
+  ASSERT_FALSE(time.empty());
+
+  const std::string fname = "StripResponseCalculator_tst_table.bin";
+  ASSERT_TRUE(calculator->saveResponseTable(fname.c_str()));
+
+  auto loaded = makeCalculator(232);
+  ASSERT_TRUE(loaded->loadResponseTable(fname.c_str()));
+  ASSERT_TRUE(loaded->getResponseTable());
+  EXPECT_TRUE(loaded->getResponseTable()->isMapped());
+  // tables are stored in single precision
+  const auto stripLoaded = stripResponse(*loaded);
+  const auto timeLoaded = timeResponse(*loaded);
+  ASSERT_EQ(stripLoaded.size(), strip.size());
+  for (size_t i = 0; i < strip.size(); i++) {
+    EXPECT_EQ(stripLoaded[i], (double) (float) strip[i]) << "strip response value " << i;
+  }
+  ASSERT_EQ(timeLoaded.size(), time.size());
+  for (size_t i = 0; i < time.size(); i++) {
+    EXPECT_EQ(timeLoaded[i], (double) (float) time[i]) << "time response value " << i;
+  }
+
+  // different diffusion or peaking time
+  std::unique_ptr<StripResponseCalculator> otherSigma(new StripResponseCalculator(geometry, 1, 2, 2, 0.9, 1.0, 232));
+  EXPECT_FALSE(otherSigma->loadResponseTable(fname.c_str()));
+  ASSERT_TRUE(otherSigma->getResponseTable());
+  EXPECT_FALSE(otherSigma->getResponseTable()->isMapped()); // own tables are kept
+  EXPECT_FALSE(makeCalculator(0)->loadResponseTable(fname.c_str()));
+  std::remove(fname.c_str());
+}
+
+TEST_F(StripResponseCalculatorTest, AddChargesSameAsAddCharge) {
+  ASSERT_TRUE(geometry->IsOK());
+  auto calculator = makeCalculator(232);
+  calculator->setInitMode(StripResponseCalculator::InitMode::Analytic);
+  calculator->initializeStripResponse(1000, 4);
+  calculator->initializeTimeResponse(1000, 8);
+
+  // clusters of deposits sharing reference nodes and time cells, some of them
+  // in the first time cell, so that smeared charge reaches cells without Z-position
+  std::vector<double> x, y, z, charge;
+  TRandom3 rand(3);
+  auto err = false;
+  for (auto cell : {0.3, 1.5, 100.2, 100.7, 300.0}) {
+    const auto z0 = geometry->Timecell2pos(cell, err);
+    ASSERT_FALSE(err);
+    const auto x0 = rand.Uniform(-30, 30), y0 = rand.Uniform(-30, 30);
+    for (int i = 0; i < 50; i++) {
+      x.push_back(x0 + rand.Gaus(0, 1.0));
+      y.push_back(y0 + rand.Gaus(0, 1.0));
+      z.push_back(z0 + rand.Gaus(0, 0.5));
+      charge.push_back(rand.Uniform(10, 100));
+    }
+  }
+
+  struct Output {
+    std::vector<std::shared_ptr<TH2D>> raw, inMM;
+    std::shared_ptr<PEventTPC> event{std::make_shared<PEventTPC>()};
+  };
+  auto makeOutput = [](StripResponseCalculator &calc) {
+    Output output;
+    for (int dir = 0; dir < 3; dir++) {
+      output.raw.push_back(std::make_shared<TH2D>("", "", 520, -4, 516, 1200, -0.5, 1199.5));
+      output.inMM.push_back(std::make_shared<TH2D>("", "", 400, -400, 400, 400, -400, 400));
+    }
+    EXPECT_TRUE(calc.setUVWprojectionsRaw(output.raw));
+    EXPECT_TRUE(calc.setUVWprojectionsInMM(output.inMM));
+    return output;
+  };
+
+  const auto single = makeOutput(*calculator);
+  for (size_t i = 0; i < charge.size(); i++) {
+    calculator->addCharge(x[i], y[i], z[i], charge[i], single.event);
+  }
+  const auto batch = makeOutput(*calculator);
+  calculator->addCharges(charge.size(), x.data(), y.data(), z.data(), charge.data(), batch.event);
+
+  auto expectSame = [](const TH2D &a, const TH2D &b) {
+    ASSERT_GT(a.GetSumOfWeights(), 0);
+    for (int bin = 0; bin < a.GetNcells(); bin++) {
+      EXPECT_NEAR(b.GetBinContent(bin), a.GetBinContent(bin), 1e-9 * (1 + std::fabs(a.GetBinContent(bin))))
+          << a.GetName() << " bin " << bin;
+    }
+  };
+  for (int dir = 0; dir < 3; dir++) {
+    expectSame(*single.raw[dir], *batch.raw[dir]);
+    expectSame(*single.inMM[dir], *batch.inMM[dir]);
+  }
+  const auto &singleMap = single.event->GetChargeMap();
+  const auto &batchMap = batch.event->GetChargeMap();
+  ASSERT_FALSE(singleMap.empty());
+  ASSERT_EQ(batchMap.size(), singleMap.size());
+  for (const auto &it : singleMap) {
+    const auto it2 = batchMap.find(it.first);
+    ASSERT_NE(it2, batchMap.end());
+    EXPECT_NEAR(it2->second, it.second, 1e-9 * (1 + std::fabs(it.second)));
+    EXPECT_GE(std::get<3>(it.first), 0); // time cells without Z-position are skipped
+  }
+}
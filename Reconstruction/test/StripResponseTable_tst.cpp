@@ -0,0 +1,217 @@
+#include "TPCReco/StripResponseTable.h"
+#include "gtest/gtest.h"
+#include <TH1D.h>
+#include <TH2D.h>
+#include <TRandom3.h>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+StripResponseTable::Parameters makeParameters() {
+  StripResponseTable::Parameters par;
+  par.nStrips = 1;
+  par.nTimecells = 1;
+  par.nPads = 2;
+  par.sigmaXY = 0.8;
+  par.sigmaZ = 1.0;
+  par.peakingTime = 232;
+  par.samplingRate = 25;
+  par.driftVelocity = 0.65;
+  par.padSize = 2.0;
+  par.padPitch = 1.73;
+  return par;
+}
+
+// histograms and table entries with the same (float) content
+struct TestContent {
+  std::vector<StripResponseTable::Entry> entries;
+  std::vector<std::shared_ptr<TH2D>> hists2D; // same order as StripResponseTable::getGrids2D()
+  std::vector<std::shared_ptr<TH1D>> hists1D; // same order as StripResponseTable::getGrids1D()
+};
+
+TestContent makeContent() {
+  TH1::AddDirectory(false);
+  TRandom3 rand(2024);
+  TestContent result;
+  for (int strip = -1; strip <= 1; strip++) {
+    StripResponseTable::Entry e;
+    e.kind = StripResponseTable::Kind::MergedStrip;
+    e.key1 = 0;
+    e.key2 = strip;
+    e.nx = 7;
+    e.ny = 5;
+    e.xmin = -2.0;
+    e.xmax = 2.0;
+    e.ymin = -1.5;
+    e.ymax = 2.5;
+    auto hist = std::make_shared<TH2D>(Form("h2_%d", strip), "", e.nx, e.xmin, e.xmax, e.ny, e.ymin, e.ymax);
+    for (int iy = 0; iy < e.ny; iy++) {
+      for (int ix = 0; ix < e.nx; ix++) {
+        const float value = rand.Uniform();
+        e.content.push_back(value);
+        hist->SetBinContent(ix + 1, iy + 1, value);
+      }
+    }
+    result.entries.push_back(e);
+    result.hists2D.push_back(hist);
+  }
+  for (int cell = -1; cell <= 1; cell++) {
+    StripResponseTable::Entry e;
+    e.kind = StripResponseTable::Kind::Timecell;
+    e.key1 = cell;
+    e.nx = 9;
+    e.xmin = 0;
+    e.xmax = 2.6;
+    auto hist = std::make_shared<TH1D>(Form("h1_%d", cell), "", e.nx, e.xmin, e.xmax);
+    for (int ix = 0; ix < e.nx; ix++) {
+      const float value = rand.Uniform();
+      e.content.push_back(value);
+      hist->SetBinContent(ix + 1, value);
+    }
+    result.entries.push_back(e);
+    result.hists1D.push_back(hist);
+  }
+  return result;
+}
+
+std::string tempFileName() {
+  return (boost::filesystem::temp_directory_path() /
+          boost::filesystem::unique_path("StripResponseTable_tst-%%%%-%%%%.bin"))
+      .string();
+}
+
+std::vector<char> readFile(const std::string &fname) {
+  std::ifstream f(fname, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string &fname, const std::vector<char> &data) {
+  std::ofstream f(fname, std::ios::binary | std::ios::trunc);
+  f.write(data.data(), data.size());
+}
+
+} // namespace
+
+TEST(StripResponseTableTest, SaveAndMap) {
+  const auto content = makeContent();
+  auto table = StripResponseTable::create(makeParameters(), content.entries);
+  ASSERT_TRUE(table);
+  EXPECT_FALSE(table->isMapped());
+  const auto fname = tempFileName();
+  ASSERT_TRUE(table->save(fname));
+  EXPECT_TRUE(StripResponseTable::isResponseTableFile(fname));
+
+  auto mapped = StripResponseTable::open(fname);
+  ASSERT_TRUE(mapped);
+  EXPECT_TRUE(mapped->isMapped());
+  EXPECT_TRUE(mapped->getParameters().isCompatible(makeParameters()));
+  EXPECT_EQ(StripResponseTable::open(fname), mapped); // one mapping per file
+  ASSERT_EQ(mapped->getNgrids2D(), content.hists2D.size());
+  ASSERT_EQ(mapped->getNgrids1D(), content.hists1D.size());
+  for (int strip = -1; strip <= 1; strip++) {
+    const auto grid = mapped->findMergedStrip(0, strip);
+    ASSERT_TRUE(grid);
+    const auto &expected = content.entries[strip + 1].content;
+    EXPECT_EQ(std::vector<float>(grid->data, grid->data + grid->nx * grid->ny), expected);
+  }
+  EXPECT_FALSE(mapped->findMergedStrip(1, 0));
+  EXPECT_FALSE(mapped->findStripSectionStart(0, 0, 0));
+  for (int cell = -1; cell <= 1; cell++) {
+    const auto grid = mapped->findTimecell(cell);
+    ASSERT_TRUE(grid);
+    const auto &expected = content.entries[cell + 4].content;
+    EXPECT_EQ(std::vector<float>(grid->data, grid->data + grid->nx), expected);
+  }
+  EXPECT_FALSE(mapped->findTimecell(2));
+  boost::filesystem::remove(fname);
+}
+
+TEST(StripResponseTableTest, RejectsInvalidFiles) {
+  auto table = StripResponseTable::create(makeParameters(), makeContent().entries);
+  ASSERT_TRUE(table);
+  const auto fname = tempFileName();
+  ASSERT_TRUE(table->save(fname));
+  const auto image = readFile(fname);
+  boost::filesystem::remove(fname);
+  ASSERT_GT(image.size(), 16u);
+
+  // file header starts with: char magic[8], uint32_t version, uint32_t endian tag
+  auto badMagic = image;
+  badMagic[0] = 'X';
+  const auto badMagicName = tempFileName();
+  writeFile(badMagicName, badMagic);
+  EXPECT_FALSE(StripResponseTable::isResponseTableFile(badMagicName));
+  EXPECT_FALSE(StripResponseTable::open(badMagicName));
+
+  auto badVersion = image;
+  const uint32_t version = StripResponseTable::formatVersion + 1;
+  std::memcpy(badVersion.data() + 8, &version, sizeof(version));
+  const auto badVersionName = tempFileName();
+  writeFile(badVersionName, badVersion);
+  EXPECT_TRUE(StripResponseTable::isResponseTableFile(badVersionName));
+  EXPECT_FALSE(StripResponseTable::open(badVersionName));
+
+  auto badEndian = image;
+  std::swap(badEndian[12], badEndian[15]);
+  std::swap(badEndian[13], badEndian[14]);
+  const auto badEndianName = tempFileName();
+  writeFile(badEndianName, badEndian);
+  EXPECT_FALSE(StripResponseTable::open(badEndianName));
+
+  auto truncated = image;
+  truncated.resize(image.size() - 4);
+  const auto truncatedName = tempFileName();
+  writeFile(truncatedName, truncated);
+  EXPECT_FALSE(StripResponseTable::open(truncatedName));
+
+  EXPECT_FALSE(StripResponseTable::open(tempFileName())); // missing file
+
+  for (const auto &name : {badMagicName, badVersionName, badEndianName, truncatedName}) {
+    boost::filesystem::remove(name);
+  }
+}
+
+TEST(StripResponseTableTest, LookupSameAsHistograms) {
+  const auto content = makeContent();
+  auto table = StripResponseTable::create(makeParameters(), content.entries);
+  ASSERT_TRUE(table);
+  const auto fname = tempFileName();
+  ASSERT_TRUE(table->save(fname));
+  auto mapped = StripResponseTable::open(fname);
+  ASSERT_TRUE(mapped);
+
+  TRandom3 rand(7);
+  for (size_t i = 0; i < content.hists2D.size(); i++) {
+    const auto &hist = *content.hists2D[i];
+    const auto &grid = mapped->getGrids2D()[i];
+    const auto xmin = hist.GetXaxis()->GetXmin(), xmax = hist.GetXaxis()->GetXmax();
+    const auto ymin = hist.GetYaxis()->GetXmin(), ymax = hist.GetYaxis()->GetXmax();
+    for (int ipoint = 0; ipoint < 2000; ipoint++) {
+      // inside the domain, including the half bins beyond the outermost bin centers
+      const double x = rand.Uniform(xmin, xmax);
+      const double y = rand.Uniform(ymin, ymax);
+      EXPECT_NEAR(grid.interpolate(x, y), hist.Interpolate(x, y), 1e-12);
+      EXPECT_EQ(grid.value(x, y), hist.GetBinContent(hist.FindBin(x, y)));
+    }
+    EXPECT_EQ(grid.value(xmax + 1, 0), 0.0);
+    EXPECT_EQ(grid.interpolate(xmin - 1, 0), 0.0);
+  }
+  for (size_t i = 0; i < content.hists1D.size(); i++) {
+    const auto &hist = *content.hists1D[i];
+    const auto &grid = mapped->getGrids1D()[i];
+    const auto xmin = hist.GetXaxis()->GetXmin(), xmax = hist.GetXaxis()->GetXmax();
+    for (int ipoint = 0; ipoint < 2000; ipoint++) {
+      // also beyond the domain, where TH1D::Interpolate takes the first/last bin
+      const double x = rand.Uniform(xmin - 0.5, xmax + 0.5);
+      EXPECT_NEAR(grid.interpolate(x), hist.Interpolate(x), 1e-12);
+      EXPECT_EQ(grid.value(x), hist.GetBinContent(hist.FindBin(x)));
+    }
+  }
+  boost::filesystem::remove(fname);
+}
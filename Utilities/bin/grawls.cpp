@@ -46,6 +46,38 @@ referencePointHelper(const std::string &input,
   return std::make_pair(point, fileId);
 }
 
+int listEventFiles(const std::string &input, unsigned long eventId,
+                   const boost::program_options::variable_value &directory,
+                   const std::string &separator) {
+  try {
+    long runId;
+    boost::filesystem::path dir;
+    try {
+      runId = RunIdParser(input).runId();
+      auto inputPath = boost::filesystem::path(input);
+      dir = inputPath.has_parent_path() ? inputPath.parent_path()
+                                        : boost::filesystem::current_path();
+    } catch (const RunIdParser::ParseError &e) {
+      runId = std::stol(input);
+      if (directory.empty()) {
+        throw std::logic_error(
+            "input in form of run id requires providing directory");
+      }
+    }
+    if (!directory.empty()) {
+      dir = boost::filesystem::path(directory.as<std::string>());
+    }
+    std::vector<std::string> output;
+    InputFileHelper::discoverEventFiles(dir.string(), runId, eventId,
+                                        std::back_inserter(output));
+    std::cout << InputFileHelper::join(output, separator) << std::endl;
+  } catch (const std::exception &e) {
+    std::cerr << "grawls: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
 boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv) {
   boost::program_options::options_description cmdLineOptDesc("Allowed options");
   cmdLineOptDesc.add_options()("help", "produce help message")(
@@ -57,8 +89,11 @@ boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv) {
       "string - separator")(
       "directory,d", boost::program_options::value<std::string>(),
       "string - directory to browse. Mutually exclusive with \"files\"")(
-      "ms", boost::program_options::value<int>()->required(),
-      "int - delay in ms")(
+      "ms", boost::program_options::value<int>(),
+      "int - delay in ms. Required unless \"event\" is given")(
+      "event", boost::program_options::value<unsigned long>(),
+      "uint - list files holding this event id, found with the run catalog "
+      "of the directory")(
       "files,f",
       boost::program_options::value<std::vector<std::string>>()->multitoken(),
       "strings - list of files to browse. Mutually "
@@ -90,6 +125,10 @@ boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv) {
 
     boost::program_options::notify(varMap);
     conflicting_options(varMap, "files", "directory");
+    conflicting_options(varMap, "files", "event");
+    if (!varMap.count("ms") && !varMap.count("event")) {
+      throw std::logic_error("the option '--ms' is required but missing");
+    }
 
   } catch (const std::exception &e) {
     std::cerr << e.what() << '\n';
@@ -103,8 +142,12 @@ boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv) {
 int main(int argc, char **argv) {
   auto varMap = parseCmdLineArgs(argc, argv);
   auto input = varMap["input"].as<std::string>();
-  auto delay = std::chrono::milliseconds(varMap["ms"].as<int>());
   auto separator = varMap["separator"].as<std::string>();
+  if (varMap.count("event")) {
+    return listEventFiles(input, varMap["event"].as<unsigned long>(),
+                          varMap["directory"], separator);
+  }
+  auto delay = std::chrono::milliseconds(varMap["ms"].as<int>());
 
   std::set<std::string> extensionsSet;
   {
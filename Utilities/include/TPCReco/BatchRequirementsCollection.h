@@ -0,0 +1,135 @@
+#ifndef TPCRECO_UTILITIES_BATCH_REQUIREMENTS_COLLECTION_H_
+#define TPCRECO_UTILITIES_BATCH_REQUIREMENTS_COLLECTION_H_
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "TPCReco/colorText.h"
+
+// Columnar counterpart of RequirementsCollection.
+// Each requirement is called once for the whole data set (e.g. structure of
+// arrays) and writes one pass flag per event. Flags are packed into a mask
+// per event, bit k is set if the event passed requirement k.
+// Flags of every requirement are cached: after replacing one requirement
+// (e.g. while tuning its parameters) only that one is evaluated again.
+template <class Columns> class BatchRequirementsCollection {
+public:
+  using Flags = std::vector<unsigned char>;
+  using Requirement = std::function<void(const Columns &, Flags &)>;
+  using Mask = uint32_t;
+  static const size_t maxSize = 8 * sizeof(Mask);
+
+  BatchRequirementsCollection() = default;
+
+  BatchRequirementsCollection(std::initializer_list<Requirement> requirements) {
+    for (auto &requirement : requirements) {
+      push_back(requirement);
+    }
+  }
+
+  void push_back(Requirement requirement) {
+    if (requirements.size() == maxSize) {
+      std::cout << KRED << __FUNCTION__ << RST << ": too many requirements, maximum is "
+                << maxSize << std::endl;
+      exit(-1);
+    }
+    requirements.push_back(requirement);
+    flags.emplace_back();
+    isValid.push_back(false);
+  }
+
+  // replaces requirement k, only this one is re-evaluated by next evaluate()
+  void replace(size_t k, Requirement requirement) {
+    requirements.at(k) = requirement;
+    isValid[k] = false;
+  }
+
+  // drops cached flags, must be called when content of the columns changes
+  void invalidate() {
+    std::fill(isValid.begin(), isValid.end(), false);
+  }
+
+  // evaluates requirements which are not cached yet, returns mask per event
+  const std::vector<Mask> &evaluate(const Columns &columns) {
+    auto nEvents = columns.size();
+    if (&columns != lastColumns || nEvents != masks.size()) {
+      invalidate();
+      lastColumns = &columns;
+    }
+    for (size_t k = 0; k < requirements.size(); ++k) {
+      if (isValid[k]) {
+        continue;
+      }
+      flags[k].assign(nEvents, 0);
+      requirements[k](columns, flags[k]);
+      if (flags[k].size() != nEvents) {
+        std::cout << KRED << __FUNCTION__ << RST << ": requirement " << k
+                  << " returned wrong number of flags" << std::endl;
+        exit(-1);
+      }
+      isValid[k] = true;
+    }
+    masks.assign(nEvents, 0);
+    for (size_t k = 0; k < requirements.size(); ++k) {
+      const auto *f = flags[k].data();
+      auto *m = masks.data();
+      for (size_t i = 0; i < nEvents; ++i) {
+        m[i] |= Mask(f[i] != 0) << k;
+      }
+    }
+    return masks;
+  }
+
+  // results of the last evaluate()
+  const std::vector<Mask> &getMasks() const noexcept { return masks; }
+  Mask getPassingMask() const noexcept {
+    return requirements.size() == maxSize ? ~Mask(0)
+                                          : (Mask(1) << requirements.size()) - 1;
+  }
+  bool isPassing(size_t event) const { return masks.at(event) == getPassingMask(); }
+
+  // number of events passing requirements 0..k, i.e. the same as the count of
+  // CountedRequirement k in a RequirementsCollection evaluated event by event
+  size_t getCount(size_t k) const {
+    Mask required = k + 1 >= maxSize ? ~Mask(0) : (Mask(1) << (k + 1)) - 1;
+    size_t count = 0;
+    for (auto mask : masks) {
+      count += (mask & required) == required;
+    }
+    return count;
+  }
+
+  // indices of events passing all requirements
+  std::vector<size_t> getSelected() const {
+    std::vector<size_t> selected;
+    auto passing = getPassingMask();
+    for (size_t i = 0; i < masks.size(); ++i) {
+      if (masks[i] == passing) {
+        selected.push_back(i);
+      }
+    }
+    return selected;
+  }
+
+  void clear() noexcept {
+    requirements.clear();
+    flags.clear();
+    isValid.clear();
+    masks.clear();
+    lastColumns = nullptr;
+  }
+
+  size_t size() const noexcept { return requirements.size(); }
+
+private:
+  std::vector<Requirement> requirements;
+  std::vector<Flags> flags;
+  std::vector<bool> isValid;
+  std::vector<Mask> masks;
+  const Columns *lastColumns = nullptr;
+};
+
+#endif // TPCRECO_UTILITIES_BATCH_REQUIREMENTS_COLLECTION_H_
@@ -4,7 +4,9 @@
 #include <TRotation.h>
 #include <TVector3.h>
 #include <TLorentzVector.h>
+#include <cstddef>
 #include <ostream>
+#include <vector>
 
 /*
 3D Rotation is made using the Euler angles in the X-convention:
@@ -30,8 +32,26 @@ public:
   TVector3 beamToDetWithOffset(const TVector3 &vector) const; // only valid for point positions
   TLorentzVector beamToDet(const TLorentzVector &vector) const;
 
+  // Batch versions for n vectors stored as separate arrays of X, Y and Z components.
+  // Output arrays may be the same as the input ones (in-place transformation).
+  void detToBeam(size_t n, const double *x, const double *y, const double *z,
+                 double *xOut, double *yOut, double *zOut) const;
+  void beamToDet(size_t n, const double *x, const double *y, const double *z,
+                 double *xOut, double *yOut, double *zOut) const;
+  void detToBeam(const std::vector<TVector3> &vectors, std::vector<TVector3> &result) const;
+  void beamToDet(const std::vector<TVector3> &vectors, std::vector<TVector3> &result) const;
+
+  // Angles in BEAM coordinates of n directions or momenta given in DET coordinates,
+  // LAB or CMS frame follows from the input vectors. Conventions of TVector3::Phi(),
+  // Theta() and CosTheta(). Null output arrays are not filled.
+  void detToBeamAngles(size_t n, const double *x, const double *y, const double *z,
+                       double *phi, double *theta, double *cosTheta) const;
+
 private:
   TRotation rotation; // rotation matrix from DET coordinates to BEAM coordinates
+  TRotation inverseRotation; // rotation matrix from BEAM coordinates to DET coordinates
+  double detToBeamMatrix[9]; // rotation matrix elements, row by row, for batch transformations
+  double beamToDetMatrix[9];
   TVector3 beamOriginInDet; // position [mm] of the origin of the BEAM coordinate system expressed in DET coordinates
 };
 
@@ -0,0 +1,36 @@
+#ifndef _CounterRandom_H_
+#define _CounterRandom_H_
+
+#include <cmath>
+#include <cstdint>
+
+// Counter-based random numbers: the deviate number "counter" of stream "seed" is a pure
+// function of the {seed, counter} pair. No generator state is kept, so any subset of
+// a stream can be drawn in any order, e.g. by several threads, with identical results.
+namespace tpcreco {
+  namespace utilities {
+
+    // splitmix64 finalizer
+    inline uint64_t mix64(uint64_t z) {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    // uniform deviate in (0, 1) for given {seed, counter} pair
+    inline double uniform01(uint64_t seed, uint64_t counter) {
+      return ((mix64(mix64(seed) + 0x9e3779b97f4a7c15ULL * (counter + 1)) >> 11) + 0.5) / 9007199254740992.0; // 2^53
+    }
+
+    // pair of independent normal deviates N(0, sigma) (Box-Muller) for given {seed, index} pair,
+    // uses counters 2*index and 2*index+1
+    inline void gaussianPair(uint64_t seed, uint64_t index, double sigma, double &x, double &y) {
+      const double r = sigma * std::sqrt(-2.0 * std::log(uniform01(seed, 2 * index)));
+      const double phi = 6.283185307179586 * uniform01(seed, 2 * index + 1);
+      x = r * std::cos(phi);
+      y = r * std::sin(phi);
+    }
+
+  } // namespace utilities
+} // namespace tpcreco
+#endif
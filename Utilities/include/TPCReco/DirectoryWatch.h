@@ -1,6 +1,9 @@
 #ifndef DirectoryWatch_H
 #define DirectoryWatch_H
 
+#include <atomic>
+#include <string>
+
 #include <TQObject.h>
 #include <RQ_OBJECT.h>
 
@@ -12,12 +15,14 @@ public:
   
   DirectoryWatch();
   void setUpdateInterval(int aInterval); //[ms]
-  virtual ~DirectoryWatch(){};
+  virtual ~DirectoryWatch();
   void watch(const std::string & dirName);
+  void stop(); // makes watch() return, can be called from any thread
 
 private:
 
-  int updateInterval;// [ms]
+  std::atomic<int> updateInterval;// [ms] minimal time between two Message() calls
+  int stopDescriptor;// eventfd waking up watch() on stop()
 
 };
 
@@ -0,0 +1,40 @@
+#ifndef UTILITIES_GRAW_FRAME_HEADER_H_
+#define UTILITIES_GRAW_FRAME_HEADER_H_
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+// Decoding of the MFM frame headers of GRAW files from raw bytes,
+// without the GET software and without reading the frame items.
+namespace GrawFrameHeader {
+
+const unsigned int primaryHeaderSize = 8;
+const unsigned int coboHeaderSize = 75; // bytes up to multip_3
+
+struct CoboHeader {
+  unsigned int eventIdx;
+  unsigned int coboIdx;
+  unsigned int asadIdx;
+  uint64_t eventTime;              // CoBo clock ticks (10 ns)
+  unsigned int multiplicity[4];    // number of hit channels per AGET
+  std::bitset<68> hitPattern[4];   // hit channels per AGET, raw channel numbering
+};
+
+// size in bytes and type of a frame from its 8 byte MFM primary header,
+// returns false for a corrupted header
+bool decodePrimaryHeader(const unsigned char *header, uint64_t &frameBytes,
+                         uint16_t &frameType);
+
+// true for the frame types holding CoBo data (partial and full readout)
+inline bool isCoboFrame(uint16_t frameType) {
+  return frameType == 0x1 || frameType == 0x2;
+}
+
+// event, board and hit pattern fields of a CoBo frame header,
+// size is the number of bytes available from the start of the frame
+bool decodeCoboHeader(const unsigned char *header, size_t size,
+                      CoboHeader &aHeader);
+
+} // namespace GrawFrameHeader
+
+#endif // UTILITIES_GRAW_FRAME_HEADER_H_
@@ -0,0 +1,76 @@
+#ifndef UTILITIES_GRAW_RUN_CATALOG_H_
+#define UTILITIES_GRAW_RUN_CATALOG_H_
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// Catalog of the GRAW files of a data directory with the event id and
+// timestamp ranges of every file. The ranges are taken from the first and
+// the last CoBo frame headers only, the files are scanned in parallel.
+// The catalog is cached in a text file (by default .grawcatalog in the
+// data directory), a file is scanned again only when its size or
+// modification time changed.
+class GrawRunCatalog {
+public:
+  struct Entry {
+    std::string path;
+    uintmax_t size = 0;
+    std::time_t mtime = 0;
+    long runId = 0;         // 0 if the file name could not be parsed
+    unsigned long fileId = 0;
+    int CoBoId = -1;        // -1 if no information
+    int AsAdId = -1;        // -1 if no information
+    unsigned long nFrames = 0; // number of complete CoBo frames
+    unsigned long firstEventId = 0, lastEventId = 0;
+    uint64_t firstEventTime = 0, lastEventTime = 0; // CoBo clock ticks (10 ns)
+
+    inline bool hasEvents() const noexcept { return nFrames > 0; }
+    inline bool containsEvent(unsigned long eventId) const noexcept {
+      return hasEvents() && eventId >= firstEventId && eventId <= lastEventId;
+    }
+  };
+
+  static const std::string defaultCacheName;
+
+  // empty cacheFile means defaultCacheName in the data directory
+  GrawRunCatalog(const std::string &directory,
+                 const std::string &cacheFile = "");
+
+  // reads the cache, scans new and modified files, drops removed files and
+  // writes back the cache if anything changed; nThreads=0 means one thread
+  // per hardware core. Throws std::runtime_error if the directory is missing.
+  void update(unsigned int nThreads = 0);
+
+  // sorted by runId, fileId, CoBoId and AsAdId
+  inline const std::vector<Entry> &entries() const noexcept {
+    return entries_;
+  }
+
+  // files of the run holding the event, one per board
+  std::vector<Entry> findEvent(long runId, unsigned long eventId) const;
+
+  // all files of the run
+  std::vector<Entry> findRun(long runId) const;
+
+  // number of files read from disk during the last update()
+  inline unsigned long scannedFiles() const noexcept { return scannedFiles_; }
+
+  inline const std::string &cacheFile() const noexcept { return cacheFile_; }
+
+  // event ranges of a single file, reads only the frame headers
+  static Entry scanFile(const std::string &path);
+
+  bool load();
+  bool save() const;
+
+private:
+  std::vector<Entry>::const_iterator lowerBound(long runId) const;
+
+  std::string directory_;
+  std::string cacheFile_;
+  std::vector<Entry> entries_;
+  unsigned long scannedFiles_ = 0;
+};
+
+#endif // UTILITIES_GRAW_RUN_CATALOG_H_
@@ -0,0 +1,96 @@
+#ifndef _HistogramRegistry_H_
+#define _HistogramRegistry_H_
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "TPCReco/colorText.h"
+
+// Flat storage of histograms addressed by integer handles.
+// Names are resolved to handles once (at booking time), afterwards histograms are
+// accessed by plain vector indexing, without string hashing or comparison per fill.
+// Handles 0..N-1 can be reserved up front for a list of names (e.g. generated together
+// with an enumeration), which turns the enumerators into compile-time handles.
+// Histograms are not owned by the registry (ROOT directory keeps ownership).
+template<class T>
+class HistogramRegistry{
+
+ public:
+
+  typedef unsigned int Handle;
+  typedef typename std::vector<T*>::const_iterator const_iterator;
+
+  HistogramRegistry() = default;
+
+  // reserves handles 0..N-1 for given histogram names, in order
+  explicit HistogramRegistry(const std::vector<std::string> &reservedNames){
+    for(auto &name: reservedNames) reserve(name);
+  }
+
+  // reserves next free handle for a histogram name that will be booked later
+  Handle reserve(const std::string &name){
+    auto it=myHandles.find(name);
+    if(it!=myHandles.end()) return it->second;
+    myHistos.push_back(nullptr);
+    myNames.push_back(name);
+    return myHandles[name]=myHistos.size()-1;
+  }
+
+  // adds histogram under its own name, takes reserved handle if there is one
+  Handle add(T *aHisto){
+    if(!aHisto){
+      std::cout<<KRED<<__FUNCTION__<<RST<<": NULL histogram pointer!"<<std::endl;
+      exit(-1);
+    }
+    auto handle=reserve(aHisto->GetName());
+    if(myHistos[handle]){
+      std::cout<<KRED<<__FUNCTION__<<RST<<": histogram "<<aHisto->GetName()<<" booked twice!"<<std::endl;
+      exit(-1);
+    }
+    myHistos[handle]=aHisto;
+    return handle;
+  }
+
+  // name to handle lookup, meant for initialization only
+  Handle getHandle(const std::string &name) const{
+    auto it=myHandles.find(name);
+    if(it==myHandles.end() || !myHistos[it->second]){
+      std::cout<<KRED<<__FUNCTION__<<RST<<": histogram "<<name<<" is not booked!"<<std::endl;
+      exit(-1);
+    }
+    return it->second;
+  }
+
+  // checks that every reserved handle got a histogram, prints missing names
+  bool isComplete() const{
+    bool result=true;
+    for(Handle handle=0; handle<myHistos.size(); ++handle){
+      if(myHistos[handle]) continue;
+      std::cout<<KRED<<__FUNCTION__<<RST<<": histogram "<<myNames[handle]<<" is reserved but not booked!"<<std::endl;
+      result=false;
+    }
+    return result;
+  }
+
+  inline T* operator[](Handle handle) const { return myHistos[handle]; }
+  inline const std::string & getName(Handle handle) const { return myNames[handle]; }
+  inline size_t size() const { return myHistos.size(); }
+  inline const_iterator begin() const { return myHistos.begin(); }
+  inline const_iterator end() const { return myHistos.end(); }
+
+  void clear(){
+    myHistos.clear();
+    myNames.clear();
+    myHandles.clear();
+  }
+
+ private:
+
+  std::vector<T*> myHistos;
+  std::vector<std::string> myNames;
+  std::map<std::string, Handle> myHandles;
+};
+#endif
@@ -1,5 +1,6 @@
 #ifndef UTILITIES_INPUT_FILE_HELPER_H_
 #define UTILITIES_INPUT_FILE_HELPER_H_
+#include "TPCReco/GrawRunCatalog.h"
 #include "TPCReco/RunIdParser.h"
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
@@ -95,6 +96,19 @@ std::string discoverFilesCSV(const std::string &input,
   return join(files, separator);
 }
 
+// files of the run holding the event, looked up in the run catalog
+// of the directory instead of opening the files
+template <class OutputIterator>
+void discoverEventFiles(const std::string &directory, RunId runId,
+                        unsigned long eventId, OutputIterator output) {
+  GrawRunCatalog catalog(directory);
+  catalog.update();
+  for (const auto &entry : catalog.findEvent(runId, eventId)) {
+    (*output) = entry.path;
+    ++output;
+  }
+}
+
 template <class FilesIterator, class ExtensionsContainer>
 FilesIterator filterExtensions(FilesIterator first, FilesIterator last,
                                const ExtensionsContainer &extensions) {
@@ -0,0 +1,68 @@
+#ifndef _IonEnergyLossTable_H_
+#define _IonEnergyLossTable_H_
+
+#include <vector>
+
+#include "TPCReco/CommonDefinitions.h"
+
+// Cumulative energy loss of an ion vs its residual range (distance to the stopping point)
+// tabulated on a uniform grid for fixed {ion, gas, p, T}. The shape of the Bragg curve
+// vs residual range does not depend on the initial energy, so a single table serves all tracks.
+// Both directions of the mapping are O(1): direct lookup with linear interpolation
+// and inverse lookup through a coarse uniform energy index.
+class IonEnergyLossTable{
+
+ public:
+
+  IonEnergyLossTable() = default;
+
+  // cumulativeEnergy_MeV[i] = energy [MeV] deposited over the last i*step_mm [mm] of the track
+  IonEnergyLossTable(pid_type ion, gas_mixture_type gas, double p_mbar, double T_Kelvin,
+		     double step_mm, const std::vector<double> &cumulativeEnergy_MeV);
+
+  inline bool IsOK() const { return cumulative.size()>1; }
+
+  inline pid_type getIon() const { return myIon; }
+  inline gas_mixture_type getGasMixture() const { return myGasMixture; }
+  inline double getGasPressure() const { return myGasPressure; } // [mbar]
+  inline double getGasTemperature() const { return myGasTemperature; } // [K]
+  inline double getStepMM() const { return step; }
+  inline double getMaxResidualRangeMM() const { return step*(cumulative.size()-1); }
+  inline double getMaxEnergyMeV() const { return cumulative.empty() ? 0.0 : cumulative.back(); }
+
+  // energy [MeV] deposited over the last residual_range_mm [mm] of the track,
+  // beyond the table range dE/dx is assumed to be constant
+  inline double getCumulativeEnergyMeV(double residual_range_mm) const {
+    if(!(residual_range_mm>0.0) || !IsOK()) return 0.0;
+    const double f=residual_range_mm*inv_step;
+    const auto n=cumulative.size()-1;
+    if(f>=n) return cumulative[n]+(f-n)*step*tailSlope;
+    const auto i=static_cast<size_t>(f);
+    return cumulative[i]+(f-i)*(cumulative[i+1]-cumulative[i]);
+  }
+
+  // energy [MeV] deposited between residual ranges r1 and r2 [mm]
+  inline double getEnergyDepositMeV(double r1_mm, double r2_mm) const {
+    return getCumulativeEnergyMeV(r2_mm)-getCumulativeEnergyMeV(r1_mm);
+  }
+
+  // inverse of getCumulativeEnergyMeV: residual range [mm] over which given energy [MeV] is deposited
+  double getResidualRangeMM(double E_MeV) const;
+
+  // energy deposits [MeV] of n equal steps along the track of given length [mm], from start to stop
+  void getEnergyDeposits(double length_mm, int n, std::vector<double> &deposits_MeV) const;
+
+ private:
+
+  pid_type myIon{pid_type::UNKNOWN};
+  gas_mixture_type myGasMixture{gas_mixture_type::GAS_MIN};
+  double myGasPressure{0}; // mbar
+  double myGasTemperature{0}; // Kelvins
+  double step{0}, inv_step{0}; // [mm]
+  double tailSlope{0}; // [MeV/mm] dE/dx at maximal residual range
+  std::vector<double> cumulative; // [MeV] at residual range i*step
+  double inv_energyStep{0}; // [1/MeV]
+  std::vector<unsigned int> energyIndex; // largest i with cumulative[i]<=j*energyStep
+};
+
+#endif
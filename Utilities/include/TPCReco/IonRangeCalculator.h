@@ -2,6 +2,7 @@
 #define _IonRangeCalculator_H_
 
 #include <string>
+#include <memory>
 #include <vector>
 #include <map>
 #include <tuple>
@@ -10,6 +11,8 @@
 #include <TGraph.h>
 #include "TPCReco/CommonDefinitions.h"
 #include "TPCReco/IonProperties.h"
+#include "TPCReco/IonEnergyLossTable.h"
+#include "TPCReco/UniformSplineTable.h"
 
 class IonRangeCalculator{
 
@@ -45,12 +48,20 @@ class IonRangeCalculator{
 
   double getIonEnergyMeV(pid_type ion, double range_mm); // interpolated result in [MeV] for the current {gas, p, T}
 
+  void getIonRangeMM(pid_type ion, const std::vector<double> &E_MeV, std::vector<double> &range_mm); // batch version, result is resized
+
+  void getIonEnergyMeV(pid_type ion, const std::vector<double> &range_mm, std::vector<double> &E_MeV); // batch version, result is resized
+
   double getIonMassMeV(pid_type ion); // particle or isotope mass in [MeV/c^2]
 
-  TGraph getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, int Npoints=1000); // dE/dx curve in [MeV/mm] for the current {gas, p, T}
+  std::shared_ptr<const TGraph> getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, int Npoints=1000); // dE/dx curve in [MeV/mm] for the current {gas, p, T}
 
   double getIonBraggCurveIntegralMeV(pid_type ion, double E_MeV, int Npoints=1000); // integral of dE/dx curve for the current {gas, p, T}
 
+  void setBraggCurveCacheBinMeV(double binWidth_MeV); // Bragg curves are cached per energy bin, 0 = last exact energy only (default)
+
+  IonEnergyLossTable getIonEnergyLossTable(pid_type ion, double step_mm=0.01); // cumulative energy loss vs residual range for the current {gas, p, T}
+
   double getEffectiveLengthCorrectionScale(pid_type ion);
 
   double getEffectiveLengthCorrectionOffsetMM(pid_type ion);
@@ -69,6 +80,26 @@ class IonRangeCalculator{
   std::map<std::tuple<gas_mixture_type,pid_type>, double>  refBraggPressureMap;       // reference pressure for dE/dx(x) curve at given {gas, ion}
   std::map<std::tuple<gas_mixture_type,pid_type>, double>  refBraggTemperatureMap;    // reference temperature for dE/dx(x) curve at given {gas, ion}
 
+  // immutable once built, shared by copies of the calculator
+  std::map<std::tuple<gas_mixture_type,pid_type>, std::shared_ptr<const UniformSplineTable> > refGasRangeTableMap; //! tabulated Range(E_kin) curve at given {gas, ion}
+  std::map<std::tuple<gas_mixture_type,pid_type>, std::shared_ptr<const UniformSplineTable> > refEnergyTableMap;   //! tabulated inverted Range(E_kin) curve at given {gas, ion}
+  std::map<std::tuple<gas_mixture_type,pid_type>, UniformSplineTable> refBraggTableMap;    //! tabulated dE/dx(x) curve at given {gas, ion}
+
+  // per particle/ion Id conversions for the current {gas, p, T}, no map lookups per call
+  struct IonConversion {
+    std::shared_ptr<const UniformSplineTable> rangeTable;  // reference Range(E_kin)
+    std::shared_ptr<const UniformSplineTable> energyTable; // reference E_kin(Range)
+    double rangeScale{1.0};                   // reference range -> range at current {p, T}
+    double inverseRangeScale{1.0};            // range at current {p, T} -> reference range
+    double lengthScale{1.0}, lengthOffset_mm{0.0}; // effective length correction
+  };
+  std::vector<IonConversion> currentConversions; //!
+  void updateConversions();
+  const IonConversion &getConversion(pid_type ion, const char *caller);
+
+  std::map<std::tuple<pid_type, int, double>, std::shared_ptr<const TGraph> > braggCurveCache; //! [ion, Npoints, energy bin]
+  double braggCurveCacheBin_MeV{0.0};
+
   gas_mixture_type myGasMixture{gas_mixture_type::GAS_MIN};   // GAS index 
   std::map<pid_type, std::tuple<double, double> > effectiveLengthCorrectionMap; // effective length correction (scale & offset [mm]) per particle/ion Id
   std::shared_ptr<IonProperties> ionProp;
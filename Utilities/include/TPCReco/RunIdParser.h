@@ -4,7 +4,8 @@
 #include <array>
 #include <chrono>
 #include <exception>
-#include <regex>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 class RunId {
@@ -68,30 +69,6 @@ private:
   int AsAdId_ = -1;
   int CoBoId_ = -1;
   time_point exactTimePoint_;
-
-  class Positions {
-  public:
-    Positions(size_t year, size_t month, size_t day, size_t hour,
-              size_t minutes, size_t seconds, size_t miliseconds, size_t fileId,
-              size_t cobo, size_t asad);
-    const size_t year;
-    const size_t month;
-    const size_t day;
-    const size_t hour;
-    const size_t minutes;
-    const size_t seconds;
-    const size_t miliseconds;
-    const size_t fileId;
-    const size_t cobo;
-    const size_t asad;
-    inline size_t max() const noexcept { return max_; }
-
-  private:
-    size_t max_;
-  };
-
-  static const std::array<std::pair<std::regex, Positions>, 2> regexes;
-  void matchResults(const std::smatch &match, const Positions &positions);
 };
 
 #endif // RUN_ID_PARSER_H_
\ No newline at end of file
@@ -8,10 +8,12 @@
 #include <boost/range/combine.hpp>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 namespace tpcreco {
 namespace utilities {
 
-auto getTreeIndexRange(TTree *tree) {
+inline auto getTreeIndexRange(TTree *tree) {
   auto *treeIndex = static_cast<TTreeIndex *>(tree->GetTreeIndex());
   if (!treeIndex) {
     throw std::logic_error("Invalid TTreeIndex");
@@ -57,11 +59,11 @@ auto filterDuplicates(ZipRange &&range, bool verbose = false) {
   return range | boost::adaptors::reversed | unique_view(verbose)| element_view<0>();
 }
 
-auto filterDuplicates(TTree *tree, bool verbose = false) {
+inline auto filterDuplicates(TTree *tree, bool verbose = false) {
   return filterDuplicates(getTreeIndexRange(tree), verbose);
 }
 
-TTree *cloneUnique(TTree *tree, TFile *file, bool verbose = false) {
+inline TTree *cloneUnique(TTree *tree, TFile *file, bool verbose = false) {
   if (file) {
     file->cd();
   }
@@ -73,6 +75,90 @@ TTree *cloneUnique(TTree *tree, TFile *file, bool verbose = false) {
   return clonedTree;
 }
 
+// Index-free processing of trees sorted by (major, minor) key, e.g. (runId, eventId).
+// Keys are read once, sequentially, and only branches used by key expressions are
+// read. Trees which are already sorted are then processed in one sequential pass.
+// Unsorted trees are first copied in key order with external merge sort, which
+// reads the input tree sequentially once, instead of random access via TTreeIndex.
+
+struct EntryKey {
+  Long64_t major;
+  Long64_t minor;
+  Long64_t entry;
+  bool sameKey(const EntryKey &other) const {
+    return major == other.major && minor == other.minor;
+  }
+  // ties are ordered by entry, i.e. younger entries come later
+  bool operator<(const EntryKey &other) const {
+    return major != other.major ? major < other.major
+           : minor != other.minor ? minor < other.minor
+                                  : entry < other.entry;
+  }
+};
+
+// keys of all entries in storage order
+std::vector<EntryKey> readEntryKeys(TTree *tree, const std::string &majorName,
+                                    const std::string &minorName);
+
+// checks if keys in storage order are non-decreasing
+bool isSorted(const std::vector<EntryKey> &keys);
+
+// number of distinct keys
+size_t countUnique(const std::vector<EntryKey> &keys);
+
+// Fills outputTree (e.g. CloneTree(0) of the input tree, sharing branch addresses)
+// with entries of the tree in key order, keys are given in storage order.
+// With unique=true only the last (younger) entry of each key is kept.
+// Temporary sorted runs of at most chunkSize entries are kept in a temporary file.
+// Returns keys of the output tree.
+std::vector<EntryKey> fillSorted(TTree *tree, TTree *outputTree,
+                                 const std::vector<EntryKey> &keys,
+                                 bool unique = false, bool verbose = false,
+                                 Long64_t chunkSize = 20000);
+
+// index-free version of cloneUnique(), entries are written in key order
+TTree *cloneUniqueSorted(TTree *tree, TFile *file, const std::string &majorName,
+                         const std::string &minorName, bool verbose = false,
+                         Long64_t chunkSize = 20000);
+
+// Persistent replacement of TTreeIndex: sorted keys are stored once, as a small
+// tree with (major, minor, entry) branches, next to the indexed tree.
+// Reading it back does not touch the indexed tree.
+void writeEntryKeys(const std::vector<EntryKey> &sortedKeys,
+                    const std::string &name, TDirectory *directory);
+
+// returns empty vector if there is no stored index with the given name
+std::vector<EntryKey> readStoredEntryKeys(TDirectory *directory,
+                                          const std::string &name);
+
+// binary search in sorted keys; for duplicated keys the last (younger) entry
+// is returned, -1 if the key is not found
+Long64_t findEntry(const std::vector<EntryKey> &sortedKeys, Long64_t major,
+                   Long64_t minor);
+
+// (entry, minor) pairs of sorted keys, same layout as getTreeIndexRange(),
+// to be used with diffDispatcher()
+class SortedKeyRange {
+public:
+  SortedKeyRange(const std::vector<EntryKey> &keys) {
+    entries.reserve(keys.size());
+    values.reserve(keys.size());
+    for (const auto &key : keys) {
+      entries.push_back(key.entry);
+      values.push_back(key.minor);
+    }
+  }
+  auto range() {
+    return boost::combine(
+        boost::make_iterator_range(entries.data(), entries.data() + entries.size()),
+        boost::make_iterator_range(values.data(), values.data() + values.size()));
+  }
+
+private:
+  std::vector<Long64_t> entries;
+  std::vector<Long64_t> values;
+};
+
 template <int n, class T> struct Dispatched {
   static_assert(n == 0 || n == 1, "");
   T data;
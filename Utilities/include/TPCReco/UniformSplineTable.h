@@ -0,0 +1,52 @@
+#ifndef _UniformSplineTable_H_
+#define _UniformSplineTable_H_
+
+#include <cstddef>
+#include <vector>
+
+// Linear spline through the input points, i.e. the same curve as TGraph::Eval gives,
+// including linear extrapolation beyond the first and the last point.
+// Evaluation is O(1): a uniform grid of nodes stores the segment found at each node,
+// so the segment of x is computed directly from x, without a binary search.
+class UniformSplineTable{
+
+ public:
+
+  UniformSplineTable() = default;
+
+  // x, y - input points (any order), nNodes - number of uniform grid nodes in [min(x), max(x)]
+  UniformSplineTable(const std::vector<double> &x, const std::vector<double> &y, unsigned int nNodes=4096);
+
+  inline bool IsOK() const { return xs.size()>1; }
+
+  inline double getMinX() const { return x0; }
+  inline double getMaxX() const { return xs.empty() ? x0 : xs.back(); }
+  inline double getStep() const { return step; }
+  inline unsigned int getNumberOfNodes() const { return segments.size(); }
+
+  inline double eval(double x) const {
+    if(!IsOK()) return 0.0;
+    const auto n=xs.size()-1;
+    if(!(x>x0)) return (x==x0 ? ys[0] : interpolate(x, 1, 0)); // also NaN
+    if(!(x<xs[n])) return (x==xs[n] ? ys[n] : interpolate(x, n, n-1));
+    auto i=segments[static_cast<size_t>((x-x0)*inv_step)];
+    while(xs[i+1]<=x) ++i; // at most a few points per grid cell
+    return (x==xs[i] ? ys[i] : interpolate(x, i+1, i));
+  }
+
+  // batch evaluation, result is resized to the size of x
+  void eval(const std::vector<double> &x, std::vector<double> &result) const;
+
+ private:
+
+  // same arithmetic as TGraph::Eval
+  inline double interpolate(double x, size_t up, size_t low) const {
+    return ys[up]+(x-xs[up])*(ys[low]-ys[up])/(xs[low]-xs[up]);
+  }
+
+  double x0{0}, step{0}, inv_step{0};
+  std::vector<double> xs, ys;    // input points sorted by x, without repeated x
+  std::vector<size_t> segments;  // last point with x<=node at each grid node
+};
+
+#endif
@@ -1,5 +1,54 @@
 #include "TPCReco/CoordinateConverter.h"
 #include "TPCReco/colorText.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+////////////////////////////////////////////
+////////////////////////////////////////////
+void fillMatrix(const TRotation &aRotation, double *matrix) {
+  const double elements[9] = {aRotation.XX(), aRotation.XY(), aRotation.XZ(),
+                              aRotation.YX(), aRotation.YY(), aRotation.YZ(),
+                              aRotation.ZX(), aRotation.ZY(), aRotation.ZZ()};
+  std::copy(elements, elements + 9, matrix);
+}
+
+////////////////////////////////////////////
+// Inputs are loaded before the outputs are written, so in-place
+// transformation is allowed; no branches keep the loop vectorisable.
+////////////////////////////////////////////
+void rotate(const double *m, size_t n, const double *x, const double *y,
+            const double *z, double *xOut, double *yOut, double *zOut) {
+  const double m00 = m[0], m01 = m[1], m02 = m[2];
+  const double m10 = m[3], m11 = m[4], m12 = m[5];
+  const double m20 = m[6], m21 = m[7], m22 = m[8];
+  for (size_t i = 0; i < n; ++i) {
+    const double vx = x[i], vy = y[i], vz = z[i];
+    xOut[i] = m00 * vx + m01 * vy + m02 * vz;
+    yOut[i] = m10 * vx + m11 * vy + m12 * vz;
+    zOut[i] = m20 * vx + m21 * vy + m22 * vz;
+  }
+}
+
+////////////////////////////////////////////
+////////////////////////////////////////////
+void rotate(const double *m, const std::vector<TVector3> &vectors,
+            std::vector<TVector3> &result) {
+  const auto n = vectors.size();
+  std::vector<double> components(3 * n);
+  double *x = components.data(), *y = x + n, *z = y + n;
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = vectors[i].X();
+    y[i] = vectors[i].Y();
+    z[i] = vectors[i].Z();
+  }
+  rotate(m, n, x, y, z, x, y, z);
+  result.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    result[i].SetXYZ(x[i], y[i], z[i]);
+  }
+}
+} // namespace
 
 ////////////////////////////////////////////
 ////////////////////////////////////////////
@@ -12,7 +61,10 @@ CoordinateConverter::CoordinateConverter(EulerAngles nominal,
   auto nominalToActualBeamRotation = TRotation{}.SetXEulerAngles(
       correction.phi, correction.theta, correction.psi);
   rotation = nominalToActualBeamRotation * detToNominalBeamRotation;
+  inverseRotation = rotation.Inverse();
   beamOriginInDet = offset;
+  fillMatrix(rotation, detToBeamMatrix);
+  fillMatrix(inverseRotation, beamToDetMatrix);
 }
 
 ////////////////////////////////////////////
@@ -36,19 +88,75 @@ TLorentzVector CoordinateConverter::detToBeam(const TLorentzVector &vector) cons
 ////////////////////////////////////////////
 ////////////////////////////////////////////
 TVector3 CoordinateConverter::beamToDet(const TVector3 &vector) const {
-  return rotation.Inverse() * vector;
+  return inverseRotation * vector;
 }
 
 ////////////////////////////////////////////
 ////////////////////////////////////////////
 TVector3 CoordinateConverter::beamToDetWithOffset(const TVector3 &vector) const {
-  return rotation.Inverse() * vector + beamOriginInDet;
+  return inverseRotation * vector + beamOriginInDet;
 }
 
 ////////////////////////////////////////////
 ////////////////////////////////////////////
 TLorentzVector CoordinateConverter::beamToDet(const TLorentzVector &vector) const {
-  return TLorentzVector{rotation.Inverse() * vector.Vect(), vector.T()};
+  return TLorentzVector{inverseRotation * vector.Vect(), vector.T()};
+}
+
+////////////////////////////////////////////
+////////////////////////////////////////////
+void CoordinateConverter::detToBeam(size_t n, const double *x, const double *y,
+                                    const double *z, double *xOut,
+                                    double *yOut, double *zOut) const {
+  rotate(detToBeamMatrix, n, x, y, z, xOut, yOut, zOut);
+}
+
+////////////////////////////////////////////
+////////////////////////////////////////////
+void CoordinateConverter::beamToDet(size_t n, const double *x, const double *y,
+                                    const double *z, double *xOut,
+                                    double *yOut, double *zOut) const {
+  rotate(beamToDetMatrix, n, x, y, z, xOut, yOut, zOut);
+}
+
+////////////////////////////////////////////
+////////////////////////////////////////////
+void CoordinateConverter::detToBeam(const std::vector<TVector3> &vectors,
+                                    std::vector<TVector3> &result) const {
+  rotate(detToBeamMatrix, vectors, result);
+}
+
+////////////////////////////////////////////
+////////////////////////////////////////////
+void CoordinateConverter::beamToDet(const std::vector<TVector3> &vectors,
+                                    std::vector<TVector3> &result) const {
+  rotate(beamToDetMatrix, vectors, result);
+}
+
+////////////////////////////////////////////
+////////////////////////////////////////////
+void CoordinateConverter::detToBeamAngles(size_t n, const double *x,
+                                          const double *y, const double *z,
+                                          double *phi, double *theta,
+                                          double *cosTheta) const {
+  const double *m = detToBeamMatrix;
+  for (size_t i = 0; i < n; ++i) {
+    const double vx = x[i], vy = y[i], vz = z[i];
+    const double bx = m[0] * vx + m[1] * vy + m[2] * vz;
+    const double by = m[3] * vx + m[4] * vy + m[5] * vz;
+    const double bz = m[6] * vx + m[7] * vy + m[8] * vz;
+    const double perp2 = bx * bx + by * by;
+    if (phi) {
+      phi[i] = (bx == 0.0 && by == 0.0) ? 0.0 : std::atan2(by, bx);
+    }
+    if (theta) {
+      theta[i] = (perp2 == 0.0 && bz == 0.0) ? 0.0 : std::atan2(std::sqrt(perp2), bz);
+    }
+    if (cosTheta) {
+      const double mag = std::sqrt(perp2 + bz * bz);
+      cosTheta[i] = mag == 0.0 ? 1.0 : bz / mag;
+    }
+  }
 }
 
 ////////////////////////////////////////////
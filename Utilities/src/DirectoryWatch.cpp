@@ -1,9 +1,15 @@
 #include <cstdlib>
+#include <cstdint>
+#include <cerrno>
+#include <algorithm>
+#include <climits>
 #include <iostream>
 #include <chrono>
-#include <thread>
 #include <sys/inotify.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include <set>
 
 #include "TPCReco/colorText.h"
@@ -14,117 +20,129 @@
 DirectoryWatch::DirectoryWatch(){
 
   updateInterval = 3000;
-  
+  stopDescriptor = eventfd(0, EFD_NONBLOCK);
+}
+////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+DirectoryWatch::~DirectoryWatch(){
+
+  if(stopDescriptor>=0) close(stopDescriptor);
 }
 ////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 void DirectoryWatch::setUpdateInterval(int aInterval){
-  if(aInterval<1000){
+  if(aInterval<0){
     std::cout<<KRED<<"Time interval: "<<aInterval<<" too low. "
-	     <<RST<<"Setting to 1000 ms."<<std::endl;
-    aInterval = 1000;
+	     <<RST<<"Setting to 0 ms."<<std::endl;
+    aInterval = 0;
   }
   updateInterval = aInterval;
 }
 ////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void DirectoryWatch::stop(){
+
+  uint64_t one = 1;
+  if(write(stopDescriptor, &one, sizeof(one))<0) std::cerr<<"Couldn't stop the directory watch"<<std::endl;
+}
+////////////////////////////////////////////////////////
+// Waits for inotify events with epoll, no polling.
+// Files modified within updateInterval after the previous Message()
+// are collected and reported together when the interval expires.
+/////////////////////////////////////////////////////////
 void DirectoryWatch::watch(const std::string & dirName){
 
-  std::string fName, fullPath;
-  int MAX_EVENTS = (4L/* MAX expected number of GRAW streams */
-		    *100L/* MAX expected rate in Hz */
-		    *updateInterval/1000L/* interval in seconds */
-		    ); //  32; /*Max. number of events to process at one go*/
-  int LEN_NAME = 50; /*Assuming that the length of the filename won't exceed 16 bytes*/
-  int EVENT_SIZE = ( sizeof (struct inotify_event) ); /*size of one event*/
-  int BUF_LEN =    ( MAX_EVENTS * ( EVENT_SIZE + LEN_NAME )); /*buffer to store the data of events*/  
   //#ifdef DEBUG
   //  uint32_t inotifyEventMask = IN_MODIFY | IN_ATTRIB; // MC : for test purpose ONLY with "touch" command line !!!!
   //#else
-  uint32_t inotifyEventMask = IN_MODIFY;
+  uint32_t inotifyEventMask = IN_MODIFY | IN_CLOSE_WRITE;
   //#endif
-  
-  int fileDescriptor = inotify_init();
+
+  int fileDescriptor = inotify_init1(IN_NONBLOCK);
   if(fileDescriptor < 0) {
     std::cerr<<"Couldn't initialize inotify"<<std::endl;
+    return;
   }
   int wd = inotify_add_watch(fileDescriptor, dirName.c_str(), inotifyEventMask);
   if(wd == -1) std::cerr<<"Couldn't add watch to "<<dirName<<std::endl;
 
-  char buffer[BUF_LEN];
+  int epollDescriptor = epoll_create1(0);
+  struct epoll_event anEvent;
+  anEvent.events = EPOLLIN;
+  anEvent.data.fd = fileDescriptor;
+  epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, fileDescriptor, &anEvent);
+  anEvent.data.fd = stopDescriptor;
+  epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, stopDescriptor, &anEvent);
 
-#ifdef DIRECTORYWATCH_ONE_MESSAGE_DISABLE
-  //
-  // begin of separate Message() calls for individual files
-  //
-  while(true){
-    int nbytesRead = read(fileDescriptor, buffer, BUF_LEN);
-    if(nbytesRead<0) std::cerr<<"Problem reading the inotify state"<<std::endl;
-    int eventIndex = 0;
-    while(eventIndex < nbytesRead) {
-      struct inotify_event *event = ( struct inotify_event * ) &buffer[eventIndex];
-      if(event->len && !(event->mask & IN_ISDIR)){
-	  fName = std::string(event->name);
-	  if(fName.substr(fName.find_last_of(".") + 1) == "graw"){
-	    fullPath = dirName+"/"+fName;
-#ifdef DEBUG
-	    std::cout << __FUNCTION__ << ": Message=" << fullPath.c_str() << std::endl; 
-#endif
-	    Message(fullPath.c_str());
-	  }
-      }
-      eventIndex += EVENT_SIZE + event->len;
+  const int BUF_LEN = 64*(sizeof(struct inotify_event) + NAME_MAX + 1); /*enough for at least 64 events*/
+  alignas(struct inotify_event) char buffer[BUF_LEN];
+
+  typedef std::chrono::steady_clock clock;
+  auto lastMessageTime = clock::now() - std::chrono::hours(1);
+  std::set<std::string> uniqueFnameList{};
+  bool isStopped = false;
+
+  while(!isStopped){
+    int interval = updateInterval;
+    int timeout = -1; // nothing to report, wait for inotify
+    if(uniqueFnameList.size()){
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - lastMessageTime).count();
+      timeout = std::max(0L, (long)(interval - elapsed));
     }
-#ifdef DEBUG
-    std::cout << __FUNCTION__ << ": Entering sleep for " << updateInterval << " msec." << std::endl;
-#endif
-    std::this_thread::sleep_for(std::chrono::milliseconds(updateInterval));	  
-  }
-  //
-  // end of separate Message() calls for individual files
-  //  
-#else
-  //
-  // begin of single Message() for all files
-  //
-  while(true){
-    int nbytesRead = read(fileDescriptor, buffer, BUF_LEN);
-    if(nbytesRead<0) std::cerr<<"Problem reading the inotify state"<<std::endl;
-    int eventIndex = 0;
-    bool is_first=true;
-    fullPath="";
-    std::set<std::string> uniqueFnameList{};
-    while(eventIndex < nbytesRead) {
-      struct inotify_event *event = ( struct inotify_event * ) &buffer[eventIndex];
-      if(event->len && !(event->mask & IN_ISDIR)){
-	  fName = std::string(event->name);
-	  if(fName.substr(fName.find_last_of(".") + 1) == "graw" &&
-	     uniqueFnameList.find(fName)==uniqueFnameList.end()){
-	    if(is_first) is_first=false; else fullPath += ","; // comma separated list of file names
-	    fullPath += dirName+"/"+fName;
-	    uniqueFnameList.insert(fName);
+    struct epoll_event readyEvents[2];
+    int nReady = epoll_wait(epollDescriptor, readyEvents, 2, timeout);
+    if(nReady<0){
+      if(errno==EINTR) continue;
+      std::cerr<<"Problem waiting for the inotify state"<<std::endl;
+      break;
+    }
+    for(int iReady=0;iReady<nReady;++iReady){
+      if(readyEvents[iReady].data.fd==stopDescriptor){
+	isStopped = true;
+	continue;
+      }
+      int nbytesRead = 0;
+      while((nbytesRead = read(fileDescriptor, buffer, BUF_LEN))>0){
+	int eventIndex = 0;
+	while(eventIndex < nbytesRead) {
+	  struct inotify_event *event = ( struct inotify_event * ) &buffer[eventIndex];
+	  if(event->len && !(event->mask & IN_ISDIR)){
+	    std::string fName = std::string(event->name);
+	    if(fName.substr(fName.find_last_of(".") + 1) == "graw") uniqueFnameList.insert(dirName+"/"+fName);
 	  }
+	  eventIndex += sizeof(struct inotify_event) + event->len;
+	}
       }
-      eventIndex += EVENT_SIZE + event->len;
+      if(nbytesRead<0 && errno!=EAGAIN && errno!=EWOULDBLOCK) std::cerr<<"Problem reading the inotify state"<<std::endl;
     }
-    if(fullPath.size()) {
+    if(isStopped || uniqueFnameList.empty()) continue;
+    if(clock::now() - lastMessageTime < std::chrono::milliseconds(interval)) continue;
+
+#ifdef DIRECTORYWATCH_ONE_MESSAGE_DISABLE
+    // separate Message() calls for individual files
+    for(auto & fullPath: uniqueFnameList){
 #ifdef DEBUG
-      std::cout << __FUNCTION__ << ": Message=" << fullPath.c_str() << std::endl; 
+      std::cout << __FUNCTION__ << ": Message=" << fullPath.c_str() << std::endl;
 #endif
       Message(fullPath.c_str());
     }
+#else
+    // single Message() for all files
+    std::string fullPath;
+    for(auto & fName: uniqueFnameList){
+      if(fullPath.size()) fullPath += ","; // comma separated list of file names
+      fullPath += fName;
+    }
 #ifdef DEBUG
-    std::cout << __FUNCTION__ << ": Entering sleep for " << updateInterval << " msec." << std::endl;
+    std::cout << __FUNCTION__ << ": Message=" << fullPath.c_str() << std::endl;
 #endif
-    std::this_thread::sleep_for(std::chrono::milliseconds(updateInterval));	  
-  }
-  //
-  // end of single Message() for all files
-  //
+    Message(fullPath.c_str());
 #endif
+    uniqueFnameList.clear();
+    lastMessageTime = clock::now();
+  }
+  close(epollDescriptor);
+  close(fileDescriptor);
 }
 ////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
-
-
-
@@ -0,0 +1,56 @@
+#include "TPCReco/GrawFrameHeader.h"
+
+namespace {
+// unsigned integer of nBytes bytes
+uint64_t readUnsigned(const unsigned char *data, size_t nBytes,
+                      bool isLittleEndian) {
+  uint64_t value = 0;
+  for (size_t iByte = 0; iByte < nBytes; ++iByte) {
+    value = (value << 8) | data[isLittleEndian ? nBytes - 1 - iByte : iByte];
+  }
+  return value;
+}
+} // namespace
+
+// MFM primary header:
+// metaType (1 byte: bit 7 - little endian, bits 0-3 - log2 of the block size),
+// frameSize (3 bytes, in blocks), dataSource (1 byte), frameType (2 bytes),
+// revision (1 byte)
+bool GrawFrameHeader::decodePrimaryHeader(const unsigned char *header,
+                                          uint64_t &frameBytes,
+                                          uint16_t &frameType) {
+  bool isLittleEndian = header[0] & 0x80;
+  uint64_t blockBytes = 1UL << (header[0] & 0x0F);
+  frameBytes = readUnsigned(header + 1, 3, isLittleEndian) * blockBytes;
+  frameType = readUnsigned(header + 5, 2, isLittleEndian);
+  return frameBytes >= primaryHeaderSize;
+}
+
+// CoBo frame header following the primary header:
+// headerSize (2), itemSize (2), nItems (4), eventTime (6), eventIdx (4),
+// coboIdx (1), asadIdx (1), readOffset (2), status (1),
+// hitPat_0..3 (9 each, bit n = channel n), multip_0..3 (2 each)
+bool GrawFrameHeader::decodeCoboHeader(const unsigned char *header,
+                                       size_t size, CoboHeader &aHeader) {
+  if (size < coboHeaderSize) {
+    return false;
+  }
+  bool isLittleEndian = header[0] & 0x80;
+  aHeader.eventTime = readUnsigned(header + 16, 6, isLittleEndian);
+  aHeader.eventIdx = readUnsigned(header + 22, 4, isLittleEndian);
+  aHeader.coboIdx = header[26];
+  aHeader.asadIdx = header[27];
+  for (int agetIdx = 0; agetIdx < 4; ++agetIdx) {
+    const unsigned char *hitPattern = header + 31 + 9 * agetIdx;
+    aHeader.hitPattern[agetIdx].reset();
+    for (size_t chanIdx = 0; chanIdx < aHeader.hitPattern[agetIdx].size();
+         ++chanIdx) {
+      size_t iByte = isLittleEndian ? chanIdx / 8 : 8 - chanIdx / 8;
+      aHeader.hitPattern[agetIdx][chanIdx] =
+          (hitPattern[iByte] >> (chanIdx % 8)) & 1;
+    }
+    aHeader.multiplicity[agetIdx] =
+        readUnsigned(header + 67 + 2 * agetIdx, 2, isLittleEndian);
+  }
+  return true;
+}
@@ -0,0 +1,258 @@
+#include "TPCReco/GrawRunCatalog.h"
+#include "TPCReco/GrawFrameHeader.h"
+#include "TPCReco/RunIdParser.h"
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+namespace {
+const std::string cacheHeader = "# GrawRunCatalog 1";
+
+auto sortKey(const GrawRunCatalog::Entry &entry) {
+  return std::tie(entry.runId, entry.fileId, entry.CoBoId, entry.AsAdId,
+                  entry.path);
+}
+} // namespace
+
+const std::string GrawRunCatalog::defaultCacheName = ".grawcatalog";
+
+GrawRunCatalog::GrawRunCatalog(const std::string &directory,
+                               const std::string &cacheFile)
+    : directory_(directory), cacheFile_(cacheFile) {
+  if (cacheFile_.empty()) {
+    cacheFile_ =
+        (boost::filesystem::path(directory_) / defaultCacheName).string();
+  }
+}
+
+GrawRunCatalog::Entry GrawRunCatalog::scanFile(const std::string &path) {
+  Entry entry;
+  entry.path = path;
+  boost::system::error_code error;
+  entry.size = boost::filesystem::file_size(path, error);
+  if (error) {
+    return entry;
+  }
+  entry.mtime = boost::filesystem::last_write_time(path, error);
+  try {
+    auto id = RunIdParser(boost::filesystem::path(path).filename().string());
+    entry.runId = id.runId();
+    entry.fileId = id.fileId();
+    entry.CoBoId = id.CoBoId();
+    entry.AsAdId = id.AsAdId();
+  } catch (const RunIdParser::ParseError &e) {
+  }
+
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file) {
+    return entry;
+  }
+  // Frames have variable size, the last frame is found by walking
+  // the primary headers (8 bytes per frame) up to the last complete frame.
+  unsigned char header[GrawFrameHeader::coboHeaderSize];
+  GrawFrameHeader::CoboHeader cobo;
+  uintmax_t offset = 0, lastCoboOffset = 0;
+  while (offset + GrawFrameHeader::primaryHeaderSize <= entry.size) {
+    file.seekg(offset);
+    file.read(reinterpret_cast<char *>(header),
+              GrawFrameHeader::primaryHeaderSize);
+    uint64_t frameBytes = 0;
+    uint16_t frameType = 0;
+    if (!file ||
+        !GrawFrameHeader::decodePrimaryHeader(header, frameBytes, frameType) ||
+        offset + frameBytes > entry.size) {
+      break; // corrupted or not written completely yet
+    }
+    if (GrawFrameHeader::isCoboFrame(frameType) &&
+        frameBytes >= GrawFrameHeader::coboHeaderSize) {
+      if (entry.nFrames == 0) {
+        file.read(reinterpret_cast<char *>(header) +
+                      GrawFrameHeader::primaryHeaderSize,
+                  GrawFrameHeader::coboHeaderSize -
+                      GrawFrameHeader::primaryHeaderSize);
+        if (!file || !GrawFrameHeader::decodeCoboHeader(
+                         header, GrawFrameHeader::coboHeaderSize, cobo)) {
+          break;
+        }
+        entry.firstEventId = cobo.eventIdx;
+        entry.firstEventTime = cobo.eventTime;
+      }
+      ++entry.nFrames;
+      lastCoboOffset = offset;
+    }
+    offset += frameBytes;
+  }
+  entry.lastEventId = entry.firstEventId;
+  entry.lastEventTime = entry.firstEventTime;
+  if (entry.nFrames > 1) {
+    file.clear();
+    file.seekg(lastCoboOffset);
+    file.read(reinterpret_cast<char *>(header),
+              GrawFrameHeader::coboHeaderSize);
+    if (file && GrawFrameHeader::decodeCoboHeader(
+                    header, GrawFrameHeader::coboHeaderSize, cobo)) {
+      entry.lastEventId = cobo.eventIdx;
+      entry.lastEventTime = cobo.eventTime;
+    }
+  }
+  return entry;
+}
+
+void GrawRunCatalog::update(unsigned int nThreads) {
+  if (!boost::filesystem::is_directory(directory_)) {
+    throw std::runtime_error("GrawRunCatalog: no such directory: " +
+                             directory_);
+  }
+  if (entries_.empty()) {
+    load();
+  }
+  std::map<std::string, const Entry *> cached;
+  for (const auto &entry : entries_) {
+    cached[entry.path] = &entry;
+  }
+
+  std::vector<Entry> updated;
+  std::vector<std::string> toScan;
+  for (const auto &item :
+       boost::filesystem::directory_iterator(directory_)) {
+    const auto &path = item.path();
+    if (path.extension() != ".graw" ||
+        !boost::filesystem::is_regular_file(item.status())) {
+      continue;
+    }
+    boost::system::error_code error;
+    auto size = boost::filesystem::file_size(path, error);
+    auto mtime = boost::filesystem::last_write_time(path, error);
+    auto it = cached.find(path.string());
+    if (!error && it != cached.end() && it->second->size == size &&
+        it->second->mtime == mtime) {
+      updated.push_back(*it->second);
+    } else {
+      toScan.push_back(path.string());
+    }
+  }
+
+  std::vector<Entry> scanned(toScan.size());
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t index = next++; index < toScan.size(); index = next++) {
+      scanned[index] = scanFile(toScan[index]);
+    }
+  };
+  if (nThreads == 0) {
+    nThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  nThreads = std::min<size_t>(nThreads, toScan.size());
+  std::vector<std::thread> workers;
+  for (unsigned int iThread = 1; iThread < nThreads; ++iThread) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto &aThread : workers) {
+    aThread.join();
+  }
+
+  bool isModified =
+      !scanned.empty() || updated.size() != entries_.size();
+  updated.insert(updated.end(), scanned.begin(), scanned.end());
+  std::sort(updated.begin(), updated.end(),
+            [](const Entry &lhs, const Entry &rhs) {
+              return sortKey(lhs) < sortKey(rhs);
+            });
+  entries_.swap(updated);
+  scannedFiles_ = scanned.size();
+  if (isModified) {
+    save();
+  }
+}
+
+std::vector<GrawRunCatalog::Entry>::const_iterator
+GrawRunCatalog::lowerBound(long runId) const {
+  return std::lower_bound(
+      entries_.begin(), entries_.end(), runId,
+      [](const Entry &entry, long value) { return entry.runId < value; });
+}
+
+std::vector<GrawRunCatalog::Entry>
+GrawRunCatalog::findEvent(long runId, unsigned long eventId) const {
+  std::vector<Entry> result;
+  for (auto it = lowerBound(runId); it != entries_.end() && it->runId == runId;
+       ++it) {
+    if (it->containsEvent(eventId)) {
+      result.push_back(*it);
+    }
+  }
+  return result;
+}
+
+std::vector<GrawRunCatalog::Entry>
+GrawRunCatalog::findRun(long runId) const {
+  std::vector<Entry> result;
+  for (auto it = lowerBound(runId); it != entries_.end() && it->runId == runId;
+       ++it) {
+    result.push_back(*it);
+  }
+  return result;
+}
+
+// One tab separated line per file, the path is relative to the directory.
+bool GrawRunCatalog::load() {
+  std::ifstream input(cacheFile_);
+  std::string line;
+  if (!input || !std::getline(input, line) || line != cacheHeader) {
+    return false;
+  }
+  std::vector<Entry> loaded;
+  while (std::getline(input, line)) {
+    std::istringstream stream(line);
+    std::string name;
+    Entry entry;
+    if (std::getline(stream, name, '\t') &&
+        stream >> entry.size >> entry.mtime >> entry.runId >> entry.fileId >>
+            entry.CoBoId >> entry.AsAdId >> entry.nFrames >>
+            entry.firstEventId >> entry.lastEventId >> entry.firstEventTime >>
+            entry.lastEventTime) {
+      entry.path = (boost::filesystem::path(directory_) / name).string();
+      loaded.push_back(entry);
+    }
+  }
+  std::sort(loaded.begin(), loaded.end(),
+            [](const Entry &lhs, const Entry &rhs) {
+              return sortKey(lhs) < sortKey(rhs);
+            });
+  entries_.swap(loaded);
+  return true;
+}
+
+// Written to a temporary file first, concurrent readers never see
+// a partial catalog.
+bool GrawRunCatalog::save() const {
+  auto tmpFile = cacheFile_ + ".tmp";
+  {
+    std::ofstream output(tmpFile);
+    if (!output) {
+      return false;
+    }
+    output << cacheHeader << '\n';
+    for (const auto &entry : entries_) {
+      output << boost::filesystem::path(entry.path).filename().string()
+             << '\t' << entry.size << '\t' << entry.mtime << '\t'
+             << entry.runId << '\t' << entry.fileId << '\t' << entry.CoBoId
+             << '\t' << entry.AsAdId << '\t' << entry.nFrames << '\t'
+             << entry.firstEventId << '\t' << entry.lastEventId << '\t'
+             << entry.firstEventTime << '\t' << entry.lastEventTime << '\n';
+    }
+    if (!output) {
+      return false;
+    }
+  }
+  boost::system::error_code error;
+  boost::filesystem::rename(tmpFile, cacheFile_, error);
+  return !error;
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "TPCReco/IonEnergyLossTable.h"
+
+///////////////////////////////
+///////////////////////////////
+IonEnergyLossTable::IonEnergyLossTable(pid_type ion, gas_mixture_type gas, double p_mbar, double T_Kelvin,
+				       double step_mm, const std::vector<double> &cumulativeEnergy_MeV) :
+  myIon(ion), myGasMixture(gas), myGasPressure(p_mbar), myGasTemperature(T_Kelvin),
+  step(step_mm), cumulative(cumulativeEnergy_MeV) {
+
+  if(!(step>0.0) || cumulative.size()<2) {
+    std::cerr<<__FUNCTION__<<": ERROR: Wrong step size or too few points in energy loss table!"<<std::endl;
+    cumulative.clear();
+    step=0.0;
+    return;
+  }
+  inv_step=1.0/step;
+
+  // enforce monotonic cumulative energy (protects inverse lookup against numerical noise)
+  cumulative[0]=0.0;
+  for(auto i=1u; i<cumulative.size(); ++i) cumulative[i]=std::max(cumulative[i], cumulative[i-1]);
+
+  const auto n=cumulative.size()-1;
+  tailSlope=(cumulative[n]-cumulative[n-1])*inv_step;
+
+  // coarse uniform energy grid with the same number of points as range grid,
+  // so that inverse lookup requires on average O(1) forward steps
+  if(cumulative[n]>0.0) {
+    inv_energyStep=n/cumulative[n];
+    energyIndex.resize(n+1);
+    auto i=0u;
+    for(auto j=0u; j<=n; ++j) {
+      const double E=j/inv_energyStep;
+      while(i<n && cumulative[i+1]<=E) ++i;
+      energyIndex[j]=i;
+    }
+  }
+}
+///////////////////////////////
+///////////////////////////////
+double IonEnergyLossTable::getResidualRangeMM(double E_MeV) const {
+
+  if(!(E_MeV>0.0) || !IsOK()) return 0.0;
+  const auto n=cumulative.size()-1;
+  if(E_MeV>=cumulative[n]) {
+    return tailSlope>0.0 ? getMaxResidualRangeMM()+(E_MeV-cumulative[n])/tailSlope : getMaxResidualRangeMM();
+  }
+  auto i=energyIndex[std::min(static_cast<size_t>(E_MeV*inv_energyStep), n)];
+  while(i<n && cumulative[i+1]<=E_MeV) ++i;
+  const double dE=cumulative[i+1]-cumulative[i];
+  const double t=(dE>0.0 ? (E_MeV-cumulative[i])/dE : 0.0);
+  return (i+t)*step;
+}
+///////////////////////////////
+///////////////////////////////
+void IonEnergyLossTable::getEnergyDeposits(double length_mm, int n, std::vector<double> &deposits_MeV) const {
+
+  deposits_MeV.assign(std::max(n, 0), 0.0);
+  if(n<1 || !(length_mm>0.0) || !IsOK()) return;
+
+  // walk from the start of the track (residual range=length) towards the stopping point
+  const double dx=length_mm/n;
+  double previous=getCumulativeEnergyMeV(length_mm);
+  for(int i=0; i<n; ++i) {
+    const double current=(i==n-1 ? 0.0 : getCumulativeEnergyMeV(length_mm-(i+1)*dx));
+    deposits_MeV[i]=previous-current;
+    previous=current;
+  }
+}
+///////////////////////////////
+///////////////////////////////
@@ -1,6 +1,16 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <tuple>
 #include "TPCReco/IonRangeCalculator.h"
+
+namespace {
+  // uniform grid lookup table with the same values as TGraph::Eval
+  UniformSplineTable makeTable(const TGraph &aGraph, unsigned int nNodes=4096){
+    return UniformSplineTable(std::vector<double>(aGraph.GetX(), aGraph.GetX()+aGraph.GetN()),
+			      std::vector<double>(aGraph.GetY(), aGraph.GetY()+aGraph.GetN()), nNodes);
+  }
+}
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
 IonRangeCalculator::IonRangeCalculator(gas_mixture_type gas, double p_mbar, double T_Kelvin, bool debug_flag)
@@ -68,6 +78,7 @@ void IonRangeCalculator::setGasMixture(gas_mixture_type gas){ // GAS index
   resetEffectiveLengthCorrections();
 
   myGasMixture=gas;
+  updateConversions();
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
@@ -80,6 +91,7 @@ void IonRangeCalculator::setGasPressure(double p_mbar){ // pressure [mbar]
 
   // Reset effective length corrections
   resetEffectiveLengthCorrections();
+  updateConversions();
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
@@ -92,6 +104,7 @@ void IonRangeCalculator::setGasTemperature(double T_Kelvin){ // temperature [K]
 
   // Reset effective length corrections
   resetEffectiveLengthCorrections();
+  updateConversions();
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
@@ -122,71 +135,115 @@ std::tuple<gas_mixture_type, double, double> IonRangeCalculator::getGasCondition
 double IonRangeCalculator::getIonRangeMM(pid_type ion, double E_MeV){ // interpolated result in [mm] for current {gas, p, T}
 
   // sanity checks
-  auto it=refGasRangeCurveMap.find(std::make_tuple(myGasMixture, ion));
-  if(it==refGasRangeCurveMap.end()) {
-    std::cerr<<__FUNCTION__<<": ERROR: Reference range/energy curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
-    exit(-1);
-  }
+  const auto &conversion=getConversion(ion, __FUNCTION__);
   if(E_MeV<0.0) {
     std::cerr<<__FUNCTION__<<": ERROR: Wrong energy="<<E_MeV<<" MeV!"<<std::endl;
     exit(-1);
   }
 
   // rescale output range to current {p, T} values assuming ideal gas pV=nRT formula
-  double ref_range=(it->second)->Eval(E_MeV); // mm
+  double ref_range=conversion.rangeTable->eval(E_MeV); // mm
 
   // DEBUG
   if(_debug) {
+    auto key=std::make_tuple(myGasMixture, ion);
     std::cout<<__FUNCTION__<<": non-scaled range="<<ref_range<<" mm, "
-	     <<"T_ref="<<refGasRangeTemperatureMap[it->first]<<" K, "
-	     <<"p_ref="<<refGasRangePressureMap[it->first]<<" mbar"<<std::endl;
+	     <<"T_ref="<<refGasRangeTemperatureMap[key]<<" K, "
+	     <<"p_ref="<<refGasRangePressureMap[key]<<" mbar"<<std::endl;
   }
   // DEBUG
 
-  auto range_mm = ref_range*(myGasTemperature/refGasRangeTemperatureMap[it->first])*(refGasRangePressureMap[it->first]/myGasPressure); // result in [mm]
+  auto range_mm = ref_range*conversion.rangeScale; // result in [mm]
 
   // apply effective range correction for the current gas conditions (if any)
-  auto range_corr_mm=range_mm;
-  auto it2=effectiveLengthCorrectionMap.find(ion);
-  if(it2!=effectiveLengthCorrectionMap.end()) {
-    range_corr_mm = std::get<0>(it2->second)*range_mm + std::get<1>(it2->second);
-  }
-
-  return range_corr_mm;
+  return conversion.lengthScale*range_mm + conversion.lengthOffset_mm;
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
 double IonRangeCalculator::getIonEnergyMeV(pid_type ion, double range_mm){ // interpolated result in [MeV] for current {gas, p, T}
 
   // sanity checks
-  auto it=refEnergyCurveMap.find(std::make_tuple(myGasMixture, ion));
-  if(it==refEnergyCurveMap.end()) {
-    std::cerr<<__FUNCTION__<<": ERROR: Reference range/energy curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
-    exit(-1);
-  }
+  const auto &conversion=getConversion(ion, __FUNCTION__);
   if(range_mm<0.0) {
     std::cerr<<__FUNCTION__<<": ERROR: Wrong range="<<range_mm<<" mm!"<<std::endl;
     exit(-1);
   }
 
   // apply effective range correction for the current gas conditions (if any)
-  auto range_corr_mm=range_mm;
-  auto it2=effectiveLengthCorrectionMap.find(ion);
-  if(it2!=effectiveLengthCorrectionMap.end()) {
-    range_corr_mm = std::get<0>(it2->second)*range_mm + std::get<1>(it2->second);
-  }
+  auto range_corr_mm = conversion.lengthScale*range_mm + conversion.lengthOffset_mm;
+
   // rescale input range to reference {p_ref, T_ref} values assuming ideal gas pV=nRT formula
-  double ref_range=range_corr_mm*(refGasRangeTemperatureMap[it->first]/myGasTemperature)*(myGasPressure/refGasRangePressureMap[it->first]); // mm
+  double ref_range=range_corr_mm*conversion.inverseRangeScale; // mm
 
   // DEBUG
   if(_debug) {
+    auto key=std::make_tuple(myGasMixture, ion);
     std::cout<<__FUNCTION__<<": non-scaled range="<<ref_range<<" mm, "
-	     <<"T_ref="<<refGasRangeTemperatureMap[it->first]<<" K, "
-	     <<"p_ref="<<refGasRangePressureMap[it->first]<<" mbar"<<std::endl;
+	     <<"T_ref="<<refGasRangeTemperatureMap[key]<<" K, "
+	     <<"p_ref="<<refGasRangePressureMap[key]<<" mbar"<<std::endl;
   }
   // DEBUG
 
-  return (it->second)->Eval(ref_range); // result in [MeV]
+  return conversion.energyTable->eval(ref_range); // result in [MeV]
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+void IonRangeCalculator::getIonRangeMM(pid_type ion, const std::vector<double> &E_MeV, std::vector<double> &range_mm){
+
+  const auto &conversion=getConversion(ion, __FUNCTION__);
+  range_mm.resize(E_MeV.size());
+  for(size_t i=0; i<E_MeV.size(); ++i){
+    if(E_MeV[i]<0.0) {
+      std::cerr<<__FUNCTION__<<": ERROR: Wrong energy="<<E_MeV[i]<<" MeV!"<<std::endl;
+      exit(-1);
+    }
+    range_mm[i]=conversion.lengthScale*conversion.rangeTable->eval(E_MeV[i])*conversion.rangeScale + conversion.lengthOffset_mm;
+  }
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+void IonRangeCalculator::getIonEnergyMeV(pid_type ion, const std::vector<double> &range_mm, std::vector<double> &E_MeV){
+
+  const auto &conversion=getConversion(ion, __FUNCTION__);
+  E_MeV.resize(range_mm.size());
+  for(size_t i=0; i<range_mm.size(); ++i){
+    if(range_mm[i]<0.0) {
+      std::cerr<<__FUNCTION__<<": ERROR: Wrong range="<<range_mm[i]<<" mm!"<<std::endl;
+      exit(-1);
+    }
+    E_MeV[i]=conversion.energyTable->eval((conversion.lengthScale*range_mm[i] + conversion.lengthOffset_mm)*conversion.inverseRangeScale);
+  }
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+const IonRangeCalculator::IonConversion &IonRangeCalculator::getConversion(pid_type ion, const char *caller){
+
+  if(ion<0 || ion>=(int)currentConversions.size() || !currentConversions[ion].rangeTable) {
+    std::cerr<<caller<<": ERROR: Reference range/energy curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
+    exit(-1);
+  }
+  return currentConversions[ion];
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+void IonRangeCalculator::updateConversions(){ // called on every change of {gas, p, T} and of the length corrections
+
+  currentConversions.assign(pid_type::PID_MAX+1, IonConversion());
+  for(const auto &item: refGasRangeTableMap) {
+    if(std::get<0>(item.first)!=myGasMixture) continue;
+    auto ion=std::get<1>(item.first);
+    auto &conversion=currentConversions.at(ion);
+    conversion.rangeTable=item.second;
+    conversion.energyTable=refEnergyTableMap.at(item.first);
+    conversion.rangeScale=(myGasTemperature/refGasRangeTemperatureMap[item.first])*(refGasRangePressureMap[item.first]/myGasPressure);
+    conversion.inverseRangeScale=(refGasRangeTemperatureMap[item.first]/myGasTemperature)*(myGasPressure/refGasRangePressureMap[item.first]);
+    auto it=effectiveLengthCorrectionMap.find(ion);
+    if(it!=effectiveLengthCorrectionMap.end()) {
+      conversion.lengthScale=std::get<0>(it->second);
+      conversion.lengthOffset_mm=std::get<1>(it->second);
+    }
+  }
+  braggCurveCache.clear();
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
@@ -227,6 +284,8 @@ void IonRangeCalculator::addIonRangeCurve(pid_type ion, gas_mixture_type gas, do
       }
     refGasRangePressureMap[key]=p_mbar; // reference pressure [mbar]
     refGasRangeTemperatureMap[key]=T_Kelvin; // reference tempereature T[K]
+    refGasRangeTableMap[key]=std::make_shared<const UniformSplineTable>(makeTable(*refGasRangeCurveMap[key]));
+    refEnergyTableMap[key]=std::make_shared<const UniformSplineTable>(makeTable(*refEnergyCurveMap[key]));
 
     // DEBUG
     if(_debug) {
@@ -297,7 +356,7 @@ void IonRangeCalculator::zeroSuppressTGraph(TGraph *aGraph){
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
-TGraph IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, int Npoints){
+std::shared_ptr<const TGraph> IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, int Npoints){
 
   // sanity checks
   if(Npoints<2) {
@@ -319,13 +378,21 @@ TGraph IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV,
     exit(-1);
   }
 
-  TGraph aGraph(Npoints);
+  // reuse the curve computed for the same energy bin
+  const auto E_key_MeV=(braggCurveCacheBin_MeV>0.0 ? (std::floor(E_MeV/braggCurveCacheBin_MeV)+0.5)*braggCurveCacheBin_MeV : E_MeV);
+  const auto cacheKey=std::make_tuple(ion, Npoints, E_key_MeV);
+  auto itCache=braggCurveCache.find(cacheKey);
+  if(itCache!=braggCurveCache.end()) return itCache->second;
+
+  auto result=std::make_shared<TGraph>(Npoints);
+  auto &aGraph=*result;
 
   // multiplicative factor for rescaling current range to the reference {p_ref, T_ref} conditions
   const auto factor=(refBraggTemperatureMap[itB->first]/myGasTemperature)*(myGasPressure/refBraggPressureMap[itB->first]); // Bragg curve reference {p_ref, T_ref}
-  auto range_mm=getIonRangeMM(ion, E_MeV); // current {p, T}
+  auto range_mm=getIonRangeMM(ion, E_key_MeV); // current {p, T}
   double ref_xmax_mm, ref_y;
   itB->second->GetPoint(itB->second->GetN()-1, ref_xmax_mm, ref_y); // Bragg curve reference {p_ref, T_ref}
+  const auto &braggTable=refBraggTableMap[itB->first];
 
   // DEBUG
   if(_debug) {
@@ -335,13 +402,13 @@ TGraph IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV,
   }
   // DEBUG
 
+  // points in ascending order of the distance from the track start,
+  // dE/dx taken at the residual range of each point
   for(int ipoint=0; ipoint<Npoints; ipoint++){
     auto x_mm = range_mm*ipoint/(Npoints-1); // current {p, T}
-    auto ref_x_mm = x_mm * factor; // reference Bragg curve {p_ref, T_ref}
-    aGraph.SetPoint(ipoint, x_mm, itB->second->Eval(ref_xmax_mm-ref_x_mm) * factor ); // current {p, T}
+    auto ref_residual_mm = (range_mm-x_mm) * factor; // reference Bragg curve {p_ref, T_ref}
+    aGraph.SetPoint(ipoint, x_mm, braggTable.eval(ref_xmax_mm-ref_residual_mm) * factor ); // current {p, T}
   }
-  aGraph=horizontalFlipTGraph(aGraph);
-  aGraph.Sort();
 
   // DEBUG
   if(_debug) {
@@ -354,14 +421,28 @@ TGraph IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV,
   }
   // DEBUG
 
-  return aGraph;
+  // exact energies rarely repeat, so only the last curve is kept for them
+  if(braggCurveCacheBin_MeV==0.0 || braggCurveCache.size()>=1000) braggCurveCache.clear(); // keep the cache bounded
+  braggCurveCache.emplace(cacheKey, result);
+  return result;
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+void IonRangeCalculator::setBraggCurveCacheBinMeV(double binWidth_MeV){
+
+  if(binWidth_MeV<0.0) {
+    std::cerr<<__FUNCTION__<<": ERROR: Wrong energy bin width="<<binWidth_MeV<<" MeV!"<<std::endl;
+    exit(-1);
+  }
+  braggCurveCacheBin_MeV=binWidth_MeV;
+  braggCurveCache.clear();
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
 double IonRangeCalculator::getIonBraggCurveIntegralMeV(pid_type ion, double E_MeV, int Npoints){ // integral of dE/dx curve for the current {gas, p, T}
 
   // assume that all dE/dx values are non-negative
-  TGraph aGraph(getIonBraggCurveMeVPerMM(ion, E_MeV, Npoints));
+  TGraph aGraph(*getIonBraggCurveMeVPerMM(ion, E_MeV, Npoints));
   double xmin, xmax, ymin, ymax;
   aGraph.ComputeRange(xmin, ymin, xmax, ymax);
   aGraph.SetPoint(aGraph.GetN(), xmin, 0.0);
@@ -372,6 +453,45 @@ double IonRangeCalculator::getIonBraggCurveIntegralMeV(pid_type ion, double E_Me
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
+IonEnergyLossTable IonRangeCalculator::getIonEnergyLossTable(pid_type ion, double step_mm){ // cumulative energy loss vs residual range for the current {gas, p, T}
+
+  // sanity checks
+  if(step_mm<=0.0) {
+    std::cerr<<__FUNCTION__<<": ERROR: Wrong step size="<<step_mm<<" mm!"<<std::endl;
+    exit(-1);
+  }
+  auto itB=refBraggCurveMap.find(std::make_tuple(myGasMixture,ion));
+  if(itB==refBraggCurveMap.end()) {
+    std::cerr<<__FUNCTION__<<": ERROR: Reference Bragg curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
+    exit(-1);
+  }
+
+  // multiplicative factor for rescaling current range to the reference {p_ref, T_ref} conditions
+  const auto factor=(refBraggTemperatureMap[itB->first]/myGasTemperature)*(myGasPressure/refBraggPressureMap[itB->first]); // Bragg curve reference {p_ref, T_ref}
+  double ref_xmax_mm, ref_y;
+  itB->second->GetPoint(itB->second->GetN()-1, ref_xmax_mm, ref_y); // Bragg curve reference {p_ref, T_ref}
+
+  // same dE/dx(residual range) as in getIonBraggCurveMeVPerMM, integrated with trapezoidal rule
+  const auto Nsteps=std::max(1, (int)std::ceil(ref_xmax_mm/factor/step_mm));
+  std::vector<double> cumulative(Nsteps+1, 0.0);
+  double previous=itB->second->Eval(ref_xmax_mm)*factor;
+  for(int istep=1; istep<=Nsteps; istep++){
+    auto current=itB->second->Eval(ref_xmax_mm-istep*step_mm*factor)*factor; // current {p, T}
+    cumulative[istep]=cumulative[istep-1]+0.5*(std::max(previous, 0.0)+std::max(current, 0.0))*step_mm;
+    previous=current;
+  }
+
+  // DEBUG
+  if(_debug) {
+    std::cout<<__FUNCTION__<<": Gas index="<<getGasMixture()<<", Ion index="<<ion<<", Nsteps="<<Nsteps
+	     <<", max residual range[mm]="<<Nsteps*step_mm<<", max energy[MeV]="<<cumulative.back()<<std::endl;
+  }
+  // DEBUG
+
+  return IonEnergyLossTable(ion, myGasMixture, myGasPressure, myGasTemperature, step_mm, cumulative);
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
 void IonRangeCalculator::addIonBraggCurve(pid_type ion, gas_mixture_type gas, double p_mbar, double T_Kelvin, const std::string &datafile){ // dE/dx(x) corresponding to {gas, p, T}
 
   // sanity checks
@@ -408,6 +528,7 @@ void IonRangeCalculator::addIonBraggCurve(pid_type ion, gas_mixture_type gas, do
     zeroSuppressTGraph(refBraggCurveMap[key]);
     refBraggPressureMap[key]=p_mbar; // reference pressure [mbar]
     refBraggTemperatureMap[key]=T_Kelvin; // reference tempereature T[K]
+    refBraggTableMap[key]=makeTable(*refBraggCurveMap[key]);
 
     // DEBUG
     if(_debug) {
@@ -449,6 +570,7 @@ void IonRangeCalculator::setEffectiveLengthCorrection(pid_type ion, double lengt
     exit(-1);
   }
   effectiveLengthCorrectionMap[ion]=std::make_tuple(lengthScale, lengthOffset_mm);
+  updateConversions();
 
   // DEBUG
   if(_debug) {
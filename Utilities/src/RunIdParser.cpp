@@ -1,5 +1,7 @@
 #include "TPCReco/RunIdParser.h"
 #include <algorithm>
+#include <iterator>
+#include <limits>
 #include <boost/date_time/time_facet.hpp>
 #include <ctime>
 #include <iomanip>
@@ -27,70 +29,156 @@ RunId::time_point RunId::toTimePoint_() const {
   return time_point::clock::from_ptime(ptime);
 }
 
-const std::array<std::pair<std::regex, RunIdParser::Positions>, 2>
-    RunIdParser::regexes = {
-        std::make_pair(
-            std::regex("^.*CoBo(\\d)_AsAd(\\d)_(\\d{4})-(\\d{2})-(\\d{2})T(\\d{"
-                       "2})\\D(\\d{2})\\D(\\d{2})\\.(\\d{3})_(\\d+).*$"),
-            Positions{3, 4, 5, 6, 7, 8, 9, 10, 1, 2}),
-        std::make_pair(std::regex("^.*(\\d{4})-(\\d{2})-(\\d{2})T(\\d{2})\\D("
-                                  "\\d{2})\\D(\\d{2})\\.(\\d{3})_(\\d+).*$"),
-                       Positions{1, 2, 3, 4, 5, 6, 7, 8, 0, 0})
-
+namespace {
+// Hand-written matcher of the file name grammar
+//   .*CoBo(\d)_AsAd(\d)_(\d{4})-(\d{2})-(\d{2})T(\d{2})\D(\d{2})\D(\d{2})\.(\d{3})_(\d+).*
+//   .*(\d{4})-(\d{2})-(\d{2})T(\d{2})\D(\d{2})\D(\d{2})\.(\d{3})_(\d+).*
+// with the semantics of std::regex_match (ECMAScript): the leading .* is
+// greedy, so the last matching position is taken, and . does not match
+// line terminators. Works on the characters in place, without allocations.
+struct Fields {
+  int cobo = -1, asad = -1;
+  int year = 0, month = 0, day = 0, hour = 0, minutes = 0, seconds = 0,
+      miliseconds = 0;
+  const char *fileIdBegin = nullptr, *fileIdEnd = nullptr;
 };
 
-RunIdParser::RunIdParser(const std::string &name) {
-  for (auto &element : regexes) {
-    auto &regex = element.first;
-    auto &positions = element.second;
-    std::smatch match;
-    if (std::regex_match(name, match, regex)) {
-      if (positions.max() >= match.size()) {
-        continue;
-      }
-      matchResults(match, positions);
-      return;
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool isLineTerminator(char c) { return c == '\n' || c == '\r'; }
+
+bool matchChar(const char *&it, const char *end, char c) {
+  if (it == end || *it != c) {
+    return false;
+  }
+  ++it;
+  return true;
+}
+
+bool matchNonDigit(const char *&it, const char *end) {
+  if (it == end || isDigit(*it)) {
+    return false;
+  }
+  ++it;
+  return true;
+}
+
+bool matchText(const char *&it, const char *end, const char *text) {
+  for (; *text; ++text) {
+    if (!matchChar(it, end, *text)) {
+      return false;
     }
   }
-  throw ParseError("RunIdParser: Couldn't parse file name: " + name);
+  return true;
 }
 
-void RunIdParser::matchResults(const std::smatch &match,
-                               const Positions &positions) {
-
-  auto get = [match](size_t pos) { return pos ? std::stoi(match[pos]) : 0; };
-  CoBoId_ = positions.cobo ? std::stoi(match[positions.cobo]) : -1;
-  AsAdId_ = positions.asad ? std::stoi(match[positions.asad]) : -1;
-  auto date = boost::gregorian::date(get(positions.year), get(positions.month),
-                                     get(positions.day));
-  auto duration = boost::posix_time::hours(get(positions.hour)) +
-                  boost::posix_time::minutes(get(positions.minutes)) +
-                  boost::posix_time::seconds(get(positions.seconds));
-  auto ptime = boost::posix_time::ptime(date, duration);
-  auto timePoint = time_point::clock::from_ptime(ptime);
-  exactTimePoint_ =
-      timePoint + std::chrono::milliseconds(get(positions.miliseconds));
-  std::stringstream stream;
-  stream.imbue(std::locale(stream.getloc(), new boost::posix_time::time_facet(
-                                                RunId::facetFormat.c_str())));
-  stream << ptime;
-  stream >> rundId_;
-  fileId_ = std::stoul(match[positions.fileId]);
+bool matchNumber(const char *&it, const char *end, size_t width, int &value) {
+  if (end - it < static_cast<std::ptrdiff_t>(width)) {
+    return false;
+  }
+  value = 0;
+  for (size_t i = 0; i < width; ++i, ++it) {
+    if (!isDigit(*it)) {
+      return false;
+    }
+    value = 10 * value + (*it - '0');
+  }
+  return true;
 }
 
-RunIdParser::Positions::Positions(size_t year, size_t month, size_t day,
-                                  size_t hour, size_t minutes, size_t seconds,
-                                  size_t miliseconds, size_t fileId,
-                                  size_t cobo, size_t asad)
-    : year(year), month(month), day(day), hour(hour), minutes(minutes),
-      seconds(seconds), miliseconds(miliseconds), fileId(fileId), cobo(cobo),
-      asad(asad) {
-  std::array<size_t, 7> elements{year,    month,   day,   hour,
-                                 minutes, seconds, fileId};
-  auto it = std::find_if(elements.begin(), elements.end(),
-                         [](size_t i) { return i > 0; });
-  if (it == elements.end()) {
-    throw std::logic_error("RunIdParser: No non-zero position.");
+// (\d{4})-(\d{2})-(\d{2})T(\d{2})\D(\d{2})\D(\d{2})\.(\d{3})_(\d+)
+bool matchTimestamp(const char *&it, const char *end, Fields &fields) {
+  if (!(matchNumber(it, end, 4, fields.year) && matchChar(it, end, '-') &&
+        matchNumber(it, end, 2, fields.month) && matchChar(it, end, '-') &&
+        matchNumber(it, end, 2, fields.day) && matchChar(it, end, 'T') &&
+        matchNumber(it, end, 2, fields.hour) && matchNonDigit(it, end) &&
+        matchNumber(it, end, 2, fields.minutes) && matchNonDigit(it, end) &&
+        matchNumber(it, end, 2, fields.seconds) && matchChar(it, end, '.') &&
+        matchNumber(it, end, 3, fields.miliseconds) &&
+        matchChar(it, end, '_'))) {
+    return false;
   }
-  max_ = *std::max_element(elements.begin(), elements.end());
+  fields.fileIdBegin = it;
+  while (it != end && isDigit(*it)) {
+    ++it;
+  }
+  fields.fileIdEnd = it;
+  return fields.fileIdBegin != fields.fileIdEnd;
+}
+
+// CoBo(\d)_AsAd(\d)_ followed by the timestamp
+bool matchCoBoAsAd(const char *&it, const char *end, Fields &fields) {
+  return matchText(it, end, "CoBo") && matchNumber(it, end, 1, fields.cobo) &&
+         matchText(it, end, "_AsAd") && matchNumber(it, end, 1, fields.asad) &&
+         matchChar(it, end, '_') && matchTimestamp(it, end, fields);
+}
+
+template <class Matcher>
+bool matchName(const char *begin, const char *end, Matcher matcher,
+               Fields &fields) {
+  // neither .* may span a line terminator
+  auto firstTerminator = std::find_if(begin, end, isLineTerminator);
+  auto lastTerminator =
+      std::find_if(std::reverse_iterator<const char *>(end),
+                   std::reverse_iterator<const char *>(begin),
+                   isLineTerminator)
+          .base();
+  for (auto start = firstTerminator;; --start) {
+    auto it = start;
+    Fields candidate;
+    if (matcher(it, end, candidate) && it >= lastTerminator) {
+      fields = candidate;
+      return true;
+    }
+    if (start == begin) {
+      return false;
+    }
+  }
+}
+
+unsigned long toUnsignedLong(const char *begin, const char *end) {
+  unsigned long value = 0;
+  for (auto it = begin; it != end; ++it) {
+    unsigned long digit = *it - '0';
+    if (value > (std::numeric_limits<unsigned long>::max() - digit) / 10) {
+      throw std::out_of_range("RunIdParser: file id out of range");
+    }
+    value = 10 * value + digit;
+  }
+  return value;
+}
+} // namespace
+
+RunIdParser::RunIdParser(const std::string &name) {
+  const char *begin = name.data();
+  const char *end = begin + name.size();
+  Fields fields;
+  if (!matchName(begin, end, matchCoBoAsAd, fields) &&
+      !matchName(begin, end, matchTimestamp, fields)) {
+    throw ParseError("RunIdParser: Couldn't parse file name: " + name);
+  }
+
+  CoBoId_ = fields.cobo;
+  AsAdId_ = fields.asad;
+  auto date = boost::gregorian::date(fields.year, fields.month, fields.day);
+  auto duration = boost::posix_time::hours(fields.hour) +
+                  boost::posix_time::minutes(fields.minutes) +
+                  boost::posix_time::seconds(fields.seconds);
+  auto ptime = boost::posix_time::ptime(date, duration);
+  auto timePoint = time_point::clock::from_ptime(ptime);
+  exactTimePoint_ =
+      timePoint + std::chrono::milliseconds(fields.miliseconds);
+  // YYYYmmDDHHMMSS of the normalized time, e.g. 25 hours roll over to
+  // the next day
+  auto normalizedDate = ptime.date();
+  auto timeOfDay = ptime.time_of_day();
+  rundId_ = ((((normalizedDate.year() * 100L + normalizedDate.month()) * 100 +
+               normalizedDate.day()) *
+                  100 +
+              timeOfDay.hours()) *
+                 100 +
+             timeOfDay.minutes()) *
+                100 +
+            timeOfDay.seconds();
+  fileId_ = toUnsignedLong(fields.fileIdBegin, fields.fileIdEnd);
 }
@@ -1 +1,259 @@
 #include "TPCReco/TTreeOps.h"
+#include <TROOT.h>
+#include <TTreeFormula.h>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <memory>
+#include <queue>
+#include <utility>
+
+namespace tpcreco {
+namespace utilities {
+
+std::vector<EntryKey> readEntryKeys(TTree *tree, const std::string &majorName,
+                                    const std::string &minorName) {
+  TTreeFormula major("major", majorName.c_str(), tree);
+  TTreeFormula minor("minor", minorName.c_str(), tree);
+  if (!major.GetNdim() || !minor.GetNdim()) {
+    throw std::logic_error("Invalid key: \"" + majorName + "\",\"" +
+                           minorName + "\" on tree " + tree->GetName());
+  }
+  std::vector<EntryKey> keys;
+  keys.reserve(tree->GetEntries());
+  for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+    if (tree->LoadTree(entry) < 0) {
+      throw std::runtime_error(std::string("Can't load entry of tree ") +
+                               tree->GetName());
+    }
+    major.GetNdata();
+    minor.GetNdata();
+    keys.push_back({major.EvalInstance64(), minor.EvalInstance64(), entry});
+  }
+  return keys;
+}
+
+bool isSorted(const std::vector<EntryKey> &keys) {
+  return std::is_sorted(keys.begin(), keys.end());
+}
+
+size_t countUnique(const std::vector<EntryKey> &keys) {
+  auto sorted = keys;
+  if (!isSorted(sorted)) {
+    std::sort(sorted.begin(), sorted.end());
+  }
+  size_t count = 0;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    count += i + 1 == sorted.size() || !sorted[i + 1].sameKey(sorted[i]);
+  }
+  return count;
+}
+
+namespace {
+
+// writes entries of a sorted stream, optionally skipping older duplicates
+class SortedWriter {
+public:
+  SortedWriter(TTree *outputTree, bool unique, bool verbose)
+      : outputTree(outputTree), unique(unique), verbose(verbose) {}
+  // returns false if entry with the key does not have to be loaded
+  bool accept(const EntryKey &key, const EntryKey *next) {
+    if (unique && next && next->sameKey(key)) {
+      if (verbose) {
+        std::cout << "Duplicated index " << key.minor << " (Entry "
+                  << key.entry << ")\n";
+      }
+      return false;
+    }
+    return true;
+  }
+  // to be called after the entry with given key was loaded
+  void fill(const EntryKey &key) {
+    outputTree->Fill();
+    outputKeys.push_back(
+        {key.major, key.minor, static_cast<Long64_t>(outputKeys.size())});
+  }
+  std::vector<EntryKey> &getKeys() { return outputKeys; }
+
+private:
+  TTree *outputTree;
+  bool unique;
+  bool verbose;
+  std::vector<EntryKey> outputKeys;
+};
+
+// Removes a temporary file when leaving the scope, also on exceptions.
+class TemporaryFileGuard {
+public:
+  explicit TemporaryFileGuard(boost::filesystem::path path)
+      : path(std::move(path)) {}
+  TemporaryFileGuard(const TemporaryFileGuard &) = delete;
+  TemporaryFileGuard &operator=(const TemporaryFileGuard &) = delete;
+  ~TemporaryFileGuard() {
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+  }
+
+private:
+  boost::filesystem::path path;
+};
+
+} // namespace
+
+std::vector<EntryKey> fillSorted(TTree *tree, TTree *outputTree,
+                                 const std::vector<EntryKey> &keys,
+                                 bool unique, bool verbose,
+                                 Long64_t chunkSize) {
+  SortedWriter writer(outputTree, unique, verbose);
+  auto nEntries = static_cast<Long64_t>(keys.size());
+  if (isSorted(keys)) {
+    for (Long64_t i = 0; i < nEntries; ++i) {
+      if (writer.accept(keys[i], i + 1 < nEntries ? &keys[i + 1] : nullptr)) {
+        tree->GetEntry(keys[i].entry);
+        writer.fill(keys[i]);
+      }
+    }
+    return std::move(writer.getKeys());
+  }
+
+  // external merge sort:
+  // 1. chunks are read sequentially into memory, sorted and written as runs
+  TDirectory::TContext context; // restores current directory on return
+  auto runPath = boost::filesystem::temp_directory_path() /
+                 boost::filesystem::unique_path("tpcreco-sort-%%%%-%%%%-%%%%.root");
+  TemporaryFileGuard runFileGuard(runPath); // destroyed after runFile
+  std::unique_ptr<TFile> runFile(TFile::Open(runPath.c_str(), "RECREATE"));
+  if (!runFile) {
+    throw std::runtime_error("Can't create temporary file " + runPath.string());
+  }
+  std::vector<TTree *> runs;
+  std::vector<std::vector<EntryKey>> runKeys;
+  chunkSize = std::max(chunkSize, Long64_t(1));
+  for (Long64_t first = 0; first < nEntries; first += chunkSize) {
+    auto last = std::min(first + chunkSize, nEntries);
+    gROOT->cd();
+    std::unique_ptr<TTree> chunk(tree->CloneTree(0)); // memory resident
+    for (auto entry = first; entry < last; ++entry) {
+      tree->GetEntry(keys[entry].entry);
+      chunk->Fill();
+    }
+    std::vector<Long64_t> order(last - first);
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&keys, first](Long64_t a, Long64_t b) {
+      return keys[first + a] < keys[first + b];
+    });
+    runFile->cd();
+    auto run = chunk->CloneTree(0);
+    std::vector<EntryKey> chunkKeys;
+    chunkKeys.reserve(order.size());
+    for (auto i : order) {
+      chunk->GetEntry(i);
+      run->Fill();
+      chunkKeys.push_back(keys[first + i]);
+    }
+    run->FlushBaskets();
+    runs.push_back(run);
+    runKeys.push_back(std::move(chunkKeys));
+  }
+
+  // 2. runs are merged, each of them is read sequentially;
+  //    runs are read directly into branch addresses of the output tree
+  using Head = std::pair<EntryKey, size_t>; // current key, run
+  auto greater = [](const Head &a, const Head &b) { return b.first < a.first; };
+  std::priority_queue<Head, std::vector<Head>, decltype(greater)> heads(greater);
+  std::vector<size_t> positions(runs.size(), 0);
+  for (size_t run = 0; run < runs.size(); ++run) {
+    outputTree->CopyAddresses(runs[run]);
+    heads.push({runKeys[run].front(), run});
+  }
+  while (!heads.empty()) {
+    auto head = heads.top();
+    heads.pop();
+    auto run = head.second;
+    auto position = positions[run]++;
+    if (positions[run] < runKeys[run].size()) {
+      heads.push({runKeys[run][positions[run]], run});
+    }
+    if (writer.accept(head.first, heads.empty() ? nullptr : &heads.top().first)) {
+      runs[run]->GetEntry(position);
+      writer.fill(head.first);
+    }
+  }
+  for (auto run : runs) {
+    outputTree->CopyAddresses(run, true);
+  }
+  runFile->Close();
+  return std::move(writer.getKeys());
+}
+
+TTree *cloneUniqueSorted(TTree *tree, TFile *file, const std::string &majorName,
+                         const std::string &minorName, bool verbose,
+                         Long64_t chunkSize) {
+  auto keys = readEntryKeys(tree, majorName, minorName);
+  if (file) {
+    file->cd();
+  }
+  auto clonedTree = tree->CloneTree(0);
+  fillSorted(tree, clonedTree, keys, true, verbose, chunkSize);
+  return clonedTree;
+}
+
+void writeEntryKeys(const std::vector<EntryKey> &sortedKeys,
+                    const std::string &name, TDirectory *directory) {
+  TDirectory::TContext context(directory);
+  auto indexTree = new TTree(name.c_str(), "sorted (major, minor) -> entry index");
+  EntryKey key;
+  indexTree->Branch("major", &key.major);
+  indexTree->Branch("minor", &key.minor);
+  indexTree->Branch("entry", &key.entry);
+  for (const auto &sortedKey : sortedKeys) {
+    key = sortedKey;
+    indexTree->Fill();
+  }
+  indexTree->Write("", TObject::kOverwrite);
+  delete indexTree;
+}
+
+std::vector<EntryKey> readStoredEntryKeys(TDirectory *directory,
+                                          const std::string &name) {
+  std::vector<EntryKey> keys;
+  TTree *indexTree = nullptr;
+  if (directory) {
+    directory->GetObject(name.c_str(), indexTree);
+  }
+  if (!indexTree) {
+    return keys;
+  }
+  EntryKey key;
+  indexTree->SetBranchAddress("major", &key.major);
+  indexTree->SetBranchAddress("minor", &key.minor);
+  indexTree->SetBranchAddress("entry", &key.entry);
+  keys.reserve(indexTree->GetEntries());
+  for (Long64_t i = 0; i < indexTree->GetEntries(); ++i) {
+    indexTree->GetEntry(i);
+    keys.push_back(key);
+  }
+  delete indexTree;
+  if (!isSorted(keys)) {
+    std::sort(keys.begin(), keys.end());
+  }
+  return keys;
+}
+
+Long64_t findEntry(const std::vector<EntryKey> &sortedKeys, Long64_t major,
+                   Long64_t minor) {
+  auto it = std::upper_bound(
+      sortedKeys.begin(), sortedKeys.end(), std::make_pair(major, minor),
+      [](const std::pair<Long64_t, Long64_t> &value, const EntryKey &key) {
+        return value.first != key.major ? value.first < key.major
+                                        : value.second < key.minor;
+      });
+  if (it == sortedKeys.begin() || !(it - 1)->sameKey({major, minor, 0})) {
+    return -1;
+  }
+  return (it - 1)->entry;
+}
+
+} // namespace utilities
+} // namespace tpcreco
@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <utility>
+#include "TPCReco/UniformSplineTable.h"
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+UniformSplineTable::UniformSplineTable(const std::vector<double> &x, const std::vector<double> &y, unsigned int nNodes){
+
+  const auto nPoints=std::min(x.size(), y.size());
+  if(nPoints<2 || nNodes<2) return;
+  std::vector<std::pair<double, double> > points(nPoints);
+  for(size_t iPoint=0; iPoint<nPoints; ++iPoint) points[iPoint]=std::make_pair(x[iPoint], y[iPoint]);
+  std::stable_sort(points.begin(), points.end(),
+		   [](const std::pair<double, double> &a, const std::pair<double, double> &b){ return a.first<b.first; });
+  if(!(points.back().first>points.front().first)) return;
+
+  // for repeated x TGraph::Eval uses the first point
+  for(const auto &point: points){
+    if(!xs.empty() && point.first==xs.back()) continue;
+    xs.push_back(point.first);
+    ys.push_back(point.second);
+  }
+
+  x0=xs.front();
+  step=(xs.back()-x0)/(nNodes-1);
+  inv_step=1.0/step;
+
+  // segment at each node, single sweep over the sorted points;
+  // the last node is never used (x>=max(x) is extrapolated)
+  segments.resize(nNodes);
+  size_t iPoint=0;
+  for(unsigned int iNode=0; iNode<nNodes; ++iNode){
+    const double xNode=x0+iNode*step;
+    while(iPoint+2<xs.size() && xs[iPoint+1]<=xNode) ++iPoint;
+    segments[iNode]=iPoint;
+  }
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+void UniformSplineTable::eval(const std::vector<double> &x, std::vector<double> &result) const{
+
+  result.resize(x.size());
+  std::transform(x.begin(), x.end(), result.begin(), [this](double value){ return eval(value); });
+}
@@ -0,0 +1,96 @@
+#include "TPCReco/BatchRequirementsCollection.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+using Columns = std::vector<int>;
+using Flags = BatchRequirementsCollection<Columns>::Flags;
+
+class BatchGreaterThan {
+public:
+  BatchGreaterThan(int value, int *nCalls = nullptr)
+      : value(value), nCalls(nCalls) {}
+  void operator()(const Columns &columns, Flags &flags) const {
+    if (nCalls) {
+      ++*nCalls;
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+      flags[i] = columns[i] > value;
+    }
+  }
+
+private:
+  int value;
+  int *nCalls;
+};
+
+TEST(BatchRequirementsCollection, Masks) {
+  BatchRequirementsCollection<Columns> cuts = {
+      BatchGreaterThan{3}, [](const Columns &columns, Flags &flags) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+          flags[i] = columns[i] < 7;
+        }
+      }};
+  EXPECT_EQ(cuts.size(), 2);
+  Columns columns = {2, 4, 9};
+  EXPECT_THAT(cuts.evaluate(columns), ::testing::ElementsAre(2, 3, 1));
+  EXPECT_FALSE(cuts.isPassing(0));
+  EXPECT_TRUE(cuts.isPassing(1));
+  EXPECT_FALSE(cuts.isPassing(2));
+  EXPECT_THAT(cuts.getSelected(), ::testing::ElementsAre(1));
+  cuts.clear();
+  EXPECT_EQ(cuts.size(), 0);
+}
+
+TEST(BatchRequirementsCollection, CountsLikeCountedRequirement) {
+  BatchRequirementsCollection<Columns> cuts;
+  cuts.push_back(BatchGreaterThan{3});
+  cuts.push_back(BatchGreaterThan{5});
+  Columns columns = {0, 4, 7};
+  cuts.evaluate(columns);
+  EXPECT_EQ(cuts.getCount(0), 2);
+  EXPECT_EQ(cuts.getCount(1), 1);
+}
+
+TEST(BatchRequirementsCollection, Caching) {
+  int nCalls1 = 0;
+  int nCalls2 = 0;
+  BatchRequirementsCollection<Columns> cuts;
+  cuts.push_back(BatchGreaterThan{3, &nCalls1});
+  cuts.push_back(BatchGreaterThan{5, &nCalls2});
+  Columns columns = {0, 4, 7};
+  cuts.evaluate(columns);
+  cuts.evaluate(columns);
+  EXPECT_EQ(nCalls1, 1);
+  EXPECT_EQ(nCalls2, 1);
+
+  cuts.replace(1, BatchGreaterThan{1, &nCalls2});
+  EXPECT_THAT(cuts.getSelected(), ::testing::ElementsAre(2));
+  cuts.evaluate(columns);
+  EXPECT_EQ(nCalls1, 1);
+  EXPECT_EQ(nCalls2, 2);
+  EXPECT_THAT(cuts.getSelected(), ::testing::ElementsAre(1, 2));
+
+  columns.push_back(8);
+  cuts.evaluate(columns);
+  EXPECT_EQ(nCalls1, 2);
+  EXPECT_EQ(nCalls2, 3);
+  EXPECT_THAT(cuts.getSelected(), ::testing::ElementsAre(1, 2, 3));
+
+  columns[0] = 10;
+  cuts.invalidate();
+  cuts.evaluate(columns);
+  EXPECT_EQ(nCalls1, 3);
+  EXPECT_THAT(cuts.getSelected(), ::testing::ElementsAre(0, 1, 2, 3));
+}
+
+TEST(BatchRequirementsCollection, TooManyRequirements) {
+  BatchRequirementsCollection<Columns> cuts;
+  for (size_t k = 0; k < BatchRequirementsCollection<Columns>::maxSize; ++k) {
+    cuts.push_back(BatchGreaterThan{0});
+  }
+  Columns columns = {0, 1};
+  cuts.evaluate(columns);
+  EXPECT_THAT(cuts.getSelected(), ::testing::ElementsAre(1));
+  EXPECT_EXIT(cuts.push_back(BatchGreaterThan{0}), ::testing::ExitedWithCode(255), "");
+}
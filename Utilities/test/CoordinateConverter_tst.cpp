@@ -5,6 +5,7 @@
 #include <TVector3.h>
 #include <TLorentzVector.h>
 #include <iostream>
+#include <vector>
 
 
 class CoorindateConverterBaseTest : public ::testing::Test {
@@ -258,3 +259,81 @@ TEST_F(CoorindateConverterCorrectionTest, BEAM2DETz) {
   EXPECT_NEAR(converter.beamToDet(z).Y(), -x.Y(), precision);
   EXPECT_NEAR(converter.beamToDet(z).Z(), -x.Z(), precision);
 }
+
+class CoorindateConverterBatchTest : public CoorindateConverterBaseTest {
+public:
+  CoordinateConverter converter{{-M_PI / 2.0, M_PI / 2.0, 0.0},
+                                {0.011, -0.023, 0.007}};
+  std::vector<double> vx, vy, vz;
+
+  void SetUp() override {
+    for (int i = -3; i <= 3; ++i) {
+      for (int j = -3; j <= 3; ++j) {
+        for (int k = -3; k <= 3; ++k) {
+          vx.push_back(0.7 * i);
+          vy.push_back(-1.3 * j + 0.1 * i);
+          vz.push_back(2.1 * k - 0.2 * j);
+        }
+      }
+    }
+  }
+};
+
+TEST_F(CoorindateConverterBatchTest, DET2BEAM) {
+  const auto n = vx.size();
+  std::vector<double> bx(n), by(n), bz(n);
+  converter.detToBeam(n, vx.data(), vy.data(), vz.data(), bx.data(),
+                      by.data(), bz.data());
+  for (size_t i = 0; i < n; ++i) {
+    auto expected = converter.detToBeam(TVector3(vx[i], vy[i], vz[i]));
+    EXPECT_NEAR(bx[i], expected.X(), precision * 10);
+    EXPECT_NEAR(by[i], expected.Y(), precision * 10);
+    EXPECT_NEAR(bz[i], expected.Z(), precision * 10);
+  }
+  // in place, back to DET
+  converter.beamToDet(n, bx.data(), by.data(), bz.data(), bx.data(),
+                      by.data(), bz.data());
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_NEAR(bx[i], vx[i], precision * 10);
+    EXPECT_NEAR(by[i], vy[i], precision * 10);
+    EXPECT_NEAR(bz[i], vz[i], precision * 10);
+  }
+}
+
+TEST_F(CoorindateConverterBatchTest, BEAM2DET_Vectors) {
+  std::vector<TVector3> vectors, result;
+  for (size_t i = 0; i < vx.size(); ++i) {
+    vectors.emplace_back(vx[i], vy[i], vz[i]);
+  }
+  converter.beamToDet(vectors, result);
+  ASSERT_EQ(result.size(), vectors.size());
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    auto expected = converter.beamToDet(vectors[i]);
+    EXPECT_NEAR(result[i].X(), expected.X(), precision * 10);
+    EXPECT_NEAR(result[i].Y(), expected.Y(), precision * 10);
+    EXPECT_NEAR(result[i].Z(), expected.Z(), precision * 10);
+  }
+  converter.detToBeam(result, result);
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    EXPECT_NEAR(result[i].X(), vectors[i].X(), precision * 10);
+  }
+}
+
+TEST_F(CoorindateConverterBatchTest, DET2BEAMAngles) {
+  const auto n = vx.size();
+  std::vector<double> phi(n), theta(n), cosTheta(n);
+  converter.detToBeamAngles(n, vx.data(), vy.data(), vz.data(), phi.data(),
+                            theta.data(), cosTheta.data());
+  for (size_t i = 0; i < n; ++i) {
+    auto expected = converter.detToBeam(TVector3(vx[i], vy[i], vz[i]));
+    EXPECT_NEAR(phi[i], expected.Phi(), precision * 10);
+    EXPECT_NEAR(theta[i], expected.Theta(), precision * 10);
+    EXPECT_NEAR(cosTheta[i], expected.CosTheta(), precision * 10);
+  }
+  // null vector, as in TVector3
+  double zero = 0.0;
+  converter.detToBeamAngles(1, &zero, &zero, &zero, phi.data(), nullptr,
+                            cosTheta.data());
+  EXPECT_EQ(phi[0], 0.0);
+  EXPECT_EQ(cosTheta[0], 1.0);
+}
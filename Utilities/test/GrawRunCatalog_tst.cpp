@@ -0,0 +1,135 @@
+#include "TPCReco/GrawRunCatalog.h"
+#include "TPCReco/InputFileHelper.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace {
+// big endian MFM frame of 64 byte blocks
+std::vector<char> makeFrame(unsigned int nBlocks, unsigned short frameType,
+                            uint64_t eventTime = 0, unsigned int eventIdx = 0,
+                            unsigned int asadIdx = 0) {
+  std::vector<char> frame(nBlocks * 64, 0);
+  frame[0] = 0x06;
+  frame[1] = (nBlocks >> 16) & 0xFF;
+  frame[2] = (nBlocks >> 8) & 0xFF;
+  frame[3] = nBlocks & 0xFF;
+  frame[5] = (frameType >> 8) & 0xFF;
+  frame[6] = frameType & 0xFF;
+  for (int iByte = 0; iByte < 6; ++iByte) {
+    frame[16 + iByte] = (eventTime >> (8 * (5 - iByte))) & 0xFF;
+  }
+  for (int iByte = 0; iByte < 4; ++iByte) {
+    frame[22 + iByte] = (eventIdx >> (8 * (3 - iByte))) & 0xFF;
+  }
+  frame[27] = asadIdx;
+  return frame;
+}
+} // namespace
+
+class GrawRunCatalogTest : public ::testing::Test {
+public:
+  static std::string directory;
+
+  // events [firstEvent, firstEvent+nEvents) of a single AsAd,
+  // with a partially written frame at the end
+  static std::string createFile(const std::string &name,
+                                unsigned int firstEvent, unsigned int nEvents,
+                                unsigned int asad) {
+    auto file = directory + name;
+    std::ofstream output(file, std::ios::binary);
+    auto header = makeFrame(1, 0x8);
+    output.write(header.data(), header.size());
+    for (unsigned int event = firstEvent; event < firstEvent + nEvents;
+         ++event) {
+      auto frame = makeFrame(2 + event % 3, 0x1, 1000 * event, event, asad);
+      output.write(frame.data(), frame.size());
+    }
+    auto partial = makeFrame(4, 0x1, 0, firstEvent + nEvents, asad);
+    output.write(partial.data(), 100);
+    return file;
+  }
+
+  void SetUp() override {
+    directory = (fs::temp_directory_path() / fs::unique_path()).string() +
+                fs::path::preferred_separator;
+    fs::create_directories(directory);
+    createFile("CoBo0_AsAd0_2021-07-12T12:03:40.978_0000.graw", 0, 50, 0);
+    createFile("CoBo0_AsAd1_2021-07-12T12:03:40.982_0000.graw", 0, 50, 1);
+    createFile("CoBo0_AsAd0_2021-07-12T12:03:40.978_0001.graw", 50, 30, 0);
+    createFile("CoBo0_AsAd1_2021-07-12T12:03:40.982_0001.graw", 50, 30, 1);
+    createFile("CoBo_ALL_AsAd_ALL_2021-07-12T11:02:15.328_0000.graw", 7, 5, 0);
+    std::ofstream{directory + "1.txt"};
+  }
+
+  void TearDown() override { fs::remove_all(directory); }
+};
+
+std::string GrawRunCatalogTest::directory = "";
+
+TEST_F(GrawRunCatalogTest, ScanFile) {
+  auto entry = GrawRunCatalog::scanFile(
+      directory + "CoBo0_AsAd1_2021-07-12T12:03:40.982_0001.graw");
+  EXPECT_EQ(entry.runId, 20210712120340);
+  EXPECT_EQ(entry.fileId, 1);
+  EXPECT_EQ(entry.CoBoId, 0);
+  EXPECT_EQ(entry.AsAdId, 1);
+  EXPECT_EQ(entry.nFrames, 30);
+  EXPECT_EQ(entry.firstEventId, 50);
+  EXPECT_EQ(entry.lastEventId, 79);
+  EXPECT_EQ(entry.firstEventTime, 50000);
+  EXPECT_EQ(entry.lastEventTime, 79000);
+  EXPECT_TRUE(entry.containsEvent(60));
+  EXPECT_FALSE(entry.containsEvent(80));
+}
+
+TEST_F(GrawRunCatalogTest, FindEvent) {
+  GrawRunCatalog catalog(directory);
+  catalog.update(3);
+  EXPECT_EQ(catalog.entries().size(), 5);
+  EXPECT_EQ(catalog.scannedFiles(), 5);
+
+  auto files = catalog.findEvent(20210712120340, 60);
+  ASSERT_EQ(files.size(), 2);
+  EXPECT_EQ(fs::path(files[0].path).filename(),
+            "CoBo0_AsAd0_2021-07-12T12:03:40.978_0001.graw");
+  EXPECT_EQ(fs::path(files[1].path).filename(),
+            "CoBo0_AsAd1_2021-07-12T12:03:40.982_0001.graw");
+  EXPECT_TRUE(catalog.findEvent(20210712120340, 80).empty());
+  EXPECT_EQ(catalog.findEvent(20210712110215, 11).size(), 1);
+  EXPECT_TRUE(catalog.findEvent(20210712110216, 11).empty());
+  EXPECT_EQ(catalog.findRun(20210712120340).size(), 4);
+
+  std::vector<std::string> paths;
+  InputFileHelper::discoverEventFiles(directory, RunId(20210712120340), 10,
+                                      std::back_inserter(paths));
+  EXPECT_EQ(paths.size(), 2);
+}
+
+TEST_F(GrawRunCatalogTest, Cache) {
+  {
+    GrawRunCatalog catalog(directory);
+    catalog.update();
+    EXPECT_EQ(catalog.scannedFiles(), 5);
+  }
+  EXPECT_TRUE(fs::exists(directory + GrawRunCatalog::defaultCacheName));
+
+  GrawRunCatalog catalog(directory);
+  catalog.update();
+  EXPECT_EQ(catalog.scannedFiles(), 0);
+  EXPECT_EQ(catalog.findEvent(20210712120340, 60).size(), 2);
+
+  // the DAQ appended events to one file, another one was removed
+  createFile("CoBo0_AsAd0_2021-07-12T12:03:40.978_0001.graw", 50, 40, 0);
+  fs::remove(directory + "CoBo0_AsAd1_2021-07-12T12:03:40.982_0001.graw");
+  catalog.update();
+  EXPECT_EQ(catalog.scannedFiles(), 1);
+  EXPECT_EQ(catalog.entries().size(), 4);
+  auto files = catalog.findEvent(20210712120340, 85);
+  ASSERT_EQ(files.size(), 1);
+  EXPECT_EQ(files[0].lastEventId, 89);
+}
@@ -0,0 +1,78 @@
+#include "TPCReco/HistogramRegistry.h"
+#include "gtest/gtest.h"
+#include <TH1F.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+class HistogramRegistryTest : public ::testing::Test {
+public:
+  static void SetUpTestSuite() { TH1::AddDirectory(false); }
+  static void TearDownTestSuite() { TH1::AddDirectory(true); }
+
+protected:
+  TH1F *make(const std::string &name) {
+    histos.emplace_back(new TH1F(name.c_str(), "", 10, 0, 10));
+    return histos.back().get();
+  }
+  std::vector<std::unique_ptr<TH1F>> histos;
+};
+
+TEST_F(HistogramRegistryTest, HandlesInBookingOrder) {
+  HistogramRegistry<TH1F> registry;
+  auto h0 = make("h0");
+  auto h1 = make("h1");
+  EXPECT_EQ(registry.add(h0), 0U);
+  EXPECT_EQ(registry.add(h1), 1U);
+  ASSERT_EQ(registry.size(), 2U);
+  EXPECT_EQ(registry[0], h0);
+  EXPECT_EQ(registry[1], h1);
+  EXPECT_EQ(registry.getHandle("h1"), 1U);
+  EXPECT_EQ(registry.getName(0), "h0");
+  EXPECT_TRUE(registry.isComplete());
+}
+
+TEST_F(HistogramRegistryTest, ReservedHandles) {
+  enum { hB, hA, nReserved };
+  HistogramRegistry<TH1F> registry({"hB", "hA"});
+  ASSERT_EQ(registry.size(), static_cast<size_t>(nReserved));
+  EXPECT_FALSE(registry.isComplete());
+  auto a = make("hA");
+  auto c = make("hC");
+  auto b = make("hB");
+  EXPECT_EQ(registry.add(a), static_cast<unsigned int>(hA));
+  EXPECT_EQ(registry.add(c), static_cast<unsigned int>(nReserved));
+  EXPECT_FALSE(registry.isComplete());
+  EXPECT_EQ(registry.add(b), static_cast<unsigned int>(hB));
+  EXPECT_TRUE(registry.isComplete());
+  EXPECT_EQ(registry[hA], a);
+  EXPECT_EQ(registry[hB], b);
+  EXPECT_EQ(registry.getHandle("hC"), static_cast<unsigned int>(nReserved));
+}
+
+TEST_F(HistogramRegistryTest, Iteration) {
+  HistogramRegistry<TH1F> registry;
+  registry.add(make("h0"));
+  registry.add(make("h1"));
+  registry.add(make("h2"));
+  int n = 0;
+  for (auto h : registry) {
+    EXPECT_EQ(h, histos[n++].get());
+  }
+  EXPECT_EQ(n, 3);
+  registry.clear();
+  EXPECT_EQ(registry.size(), 0U);
+}
+
+TEST_F(HistogramRegistryTest, DuplicateNameExits) {
+  HistogramRegistry<TH1F> registry;
+  registry.add(make("h0"));
+  auto duplicate = make("h0");
+  EXPECT_EXIT(registry.add(duplicate), ::testing::ExitedWithCode(255), "");
+}
+
+TEST_F(HistogramRegistryTest, UnknownNameExits) {
+  HistogramRegistry<TH1F> registry({"reserved"});
+  EXPECT_EXIT(registry.getHandle("missing"), ::testing::ExitedWithCode(255), "");
+  EXPECT_EXIT(registry.getHandle("reserved"), ::testing::ExitedWithCode(255), "");
+}
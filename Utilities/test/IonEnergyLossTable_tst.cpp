@@ -0,0 +1,65 @@
+#include "TPCReco/IonEnergyLossTable.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+// cumulative energy E(r)=r^2 [MeV] for dE/dx=2r [MeV/mm], r=[0, 10] mm
+IonEnergyLossTable makeQuadraticTable(double step) {
+  std::vector<double> cumulative;
+  for (int i = 0; i * step <= 10.0 + 1e-9; ++i) {
+    cumulative.push_back(std::pow(i * step, 2));
+  }
+  return IonEnergyLossTable(pid_type::ALPHA, gas_mixture_type::CO2, 250.0,
+                            293.15, step, cumulative);
+}
+} // namespace
+
+TEST(IonEnergyLossTable, Empty) {
+  IonEnergyLossTable table;
+  EXPECT_FALSE(table.IsOK());
+  EXPECT_EQ(table.getCumulativeEnergyMeV(1.0), 0.0);
+  EXPECT_EQ(table.getResidualRangeMM(1.0), 0.0);
+}
+
+TEST(IonEnergyLossTable, CumulativeEnergy) {
+  auto table = makeQuadraticTable(0.01);
+  ASSERT_TRUE(table.IsOK());
+  EXPECT_NEAR(table.getMaxResidualRangeMM(), 10.0, 1e-9);
+  EXPECT_NEAR(table.getMaxEnergyMeV(), 100.0, 1e-9);
+  EXPECT_EQ(table.getCumulativeEnergyMeV(0.0), 0.0);
+  EXPECT_EQ(table.getCumulativeEnergyMeV(-1.0), 0.0);
+  for (double r = 0.005; r < 10.0; r += 0.3) {
+    EXPECT_NEAR(table.getCumulativeEnergyMeV(r), r * r, 1e-4);
+  }
+  // constant dE/dx beyond the table
+  EXPECT_NEAR(table.getEnergyDepositMeV(10.0, 11.0), 19.99, 1e-6);
+}
+
+TEST(IonEnergyLossTable, InverseLookup) {
+  auto table = makeQuadraticTable(0.01);
+  for (double E = 0.01; E < 100.0; E += 0.77) {
+    auto r = table.getResidualRangeMM(E);
+    EXPECT_NEAR(table.getCumulativeEnergyMeV(r), E, 1e-9);
+    EXPECT_NEAR(r, std::sqrt(E), 1e-3);
+  }
+  EXPECT_NEAR(table.getResidualRangeMM(100.0 + 19.99), 11.0, 1e-6);
+}
+
+TEST(IonEnergyLossTable, EnergyDeposits) {
+  auto table = makeQuadraticTable(0.01);
+  std::vector<double> deposits;
+  const double length = 5.0;
+  const int n = 50;
+  table.getEnergyDeposits(length, n, deposits);
+  ASSERT_EQ(deposits.size(), size_t(n));
+  double sum = 0.0;
+  for (int i = 0; i < n; ++i) {
+    sum += deposits[i];
+    if (i > 0) {
+      EXPECT_GT(deposits[i], 0.0);
+      EXPECT_LT(deposits[i], deposits[i - 1]); // dE/dx=2r decreases towards the stop
+    }
+  }
+  EXPECT_NEAR(sum, length * length, 1e-9);
+}
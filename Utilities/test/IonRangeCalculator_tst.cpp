@@ -0,0 +1,264 @@
+#include "TPCReco/IonRangeCalculator.h"
+#include "gtest/gtest.h"
+#include <TGraph.h>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+  // reference curves read the same way as in IonRangeCalculator, evaluated with TGraph::Eval
+  const double refPressure_mbar = 250.0;
+  const double refTemperature_K = 273.15 + 20;
+
+  std::string resourceFile(const std::string &name) { return std::string(TPCRECO_RESOURCE_DIR) + "/" + name; }
+
+  std::string rangeFile(pid_type ion) {
+    switch (ion) {
+    case pid_type::PROTON: return resourceFile("range_corr_thr_1keV_proton_2MeV_CO2_250mbar.dat");
+    case pid_type::ALPHA: return resourceFile("range_corr_thr_1keV_alpha_10MeV_CO2_250mbar.dat");
+    default: return resourceFile("range_corr_thr_1keV_12C_5MeV_CO2_250mbar.dat");
+    }
+  }
+
+  std::string braggFile(pid_type ion) {
+    switch (ion) {
+    case pid_type::PROTON: return resourceFile("dEdx_corr_proton_2MeV_CO2_250mbar.dat");
+    case pid_type::ALPHA: return resourceFile("dEdx_corr_alpha_10MeV_CO2_250mbar.dat");
+    default: return resourceFile("dEdx_corr_12C_5MeV_CO2_250mbar.dat");
+    }
+  }
+
+  struct ReferenceCurves {
+    std::shared_ptr<TGraph> range, energy, bragg;
+  };
+
+  ReferenceCurves readReferenceCurves(pid_type ion) {
+    ReferenceCurves curves;
+    curves.range = std::make_shared<TGraph>(rangeFile(ion).c_str(), "%lg %lg");
+    curves.range->SetPoint(curves.range->GetN(), 0.0, 0.0);
+    curves.range->Sort();
+    curves.energy = std::make_shared<TGraph>(*curves.range);
+    for (int i = 0; i < curves.range->GetN(); i++) {
+      curves.energy->SetPoint(i, curves.range->GetY()[i], curves.range->GetX()[i]);
+    }
+    curves.bragg = std::make_shared<TGraph>(braggFile(ion).c_str(), "%lg %lg");
+    for (int i = 0; i < curves.bragg->GetN(); i++) {
+      curves.bragg->SetPoint(i, curves.bragg->GetX()[i], 1e-3 * curves.bragg->GetY()[i]);
+    }
+    curves.bragg->Sort();
+    if (curves.bragg->GetX()[0] > 0.0) {
+      curves.bragg->SetPoint(curves.bragg->GetN(), 0.0, curves.bragg->GetY()[0]);
+      curves.bragg->Sort();
+    }
+    while (curves.bragg->GetY()[curves.bragg->GetN() - 1] == 0 && curves.bragg->GetY()[curves.bragg->GetN() - 2] == 0) {
+      curves.bragg->RemovePoint(curves.bragg->GetN() - 1);
+    }
+    return curves;
+  }
+} // namespace
+
+// compares tabulated curves with the TGraph::Eval path used before
+class IonRangeCalculatorTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() {
+    calculator.reset(new IonRangeCalculator(std::string(TPCRECO_RESOURCE_DIR) + "/", gas_mixture_type::CO2, 250.0,
+                                            293.15));
+    for (auto ion : ions) {
+      references[ion] = readReferenceCurves(ion);
+    }
+  }
+
+  static void TearDownTestSuite() {
+    calculator.reset();
+    references.clear();
+  }
+
+  static double maxEnergyMeV(pid_type ion) {
+    const auto graph = references.at(ion).range;
+    return graph->GetX()[graph->GetN() - 1];
+  }
+
+  static double lengthCorrectionMM(IonRangeCalculator &c, pid_type ion, double length_mm) {
+    return c.getEffectiveLengthCorrectionScale(ion) * length_mm + c.getEffectiveLengthCorrectionOffsetMM(ion);
+  }
+
+  static double referenceRangeMM(IonRangeCalculator &c, pid_type ion, double E_MeV) {
+    const auto range_mm = references.at(ion).range->Eval(E_MeV) * (c.getGasTemperature() / refTemperature_K) *
+                          (refPressure_mbar / c.getGasPressure());
+    return lengthCorrectionMM(c, ion, range_mm);
+  }
+
+  static double referenceEnergyMeV(IonRangeCalculator &c, pid_type ion, double range_mm) {
+    const auto ref_range = lengthCorrectionMM(c, ion, range_mm) * (refTemperature_K / c.getGasTemperature()) *
+                           (c.getGasPressure() / refPressure_mbar);
+    return references.at(ion).energy->Eval(ref_range);
+  }
+
+  static double referenceRangeMM(pid_type ion, double E_MeV) { return referenceRangeMM(*calculator, ion, E_MeV); }
+
+  static double referenceEnergyMeV(pid_type ion, double range_mm) {
+    return referenceEnergyMeV(*calculator, ion, range_mm);
+  }
+
+  static TGraph referenceBraggCurve(pid_type ion, double E_MeV, int Npoints) {
+    auto &c = *calculator;
+    const auto bragg = references.at(ion).bragg;
+    TGraph aGraph(Npoints);
+    const auto factor = (refTemperature_K / c.getGasTemperature()) * (c.getGasPressure() / refPressure_mbar);
+    const auto range_mm = referenceRangeMM(ion, E_MeV);
+    double ref_xmax_mm, ref_y;
+    bragg->GetPoint(bragg->GetN() - 1, ref_xmax_mm, ref_y);
+    for (int ipoint = 0; ipoint < Npoints; ipoint++) {
+      const auto x_mm = range_mm * ipoint / (Npoints - 1);
+      aGraph.SetPoint(ipoint, x_mm, bragg->Eval(ref_xmax_mm - x_mm * factor) * factor);
+    }
+    // horizontal flip around the middle of the curve
+    double xmin, xmax, ymin, ymax;
+    aGraph.ComputeRange(xmin, ymin, xmax, ymax);
+    const auto xmid = 0.5 * (xmin + xmax);
+    for (int ipoint = 0; ipoint < Npoints; ipoint++) {
+      aGraph.SetPoint(ipoint, 2 * xmid - aGraph.GetX()[ipoint], aGraph.GetY()[ipoint]);
+    }
+    aGraph.Sort();
+    return aGraph;
+  }
+
+  static void compareRangeAndEnergy(pid_type ion) {
+    const auto Emax = maxEnergyMeV(ion);
+    std::vector<double> energies, ranges;
+    for (int i = 1; i <= 2000; i++) {
+      const auto E_MeV = Emax * i / 2000;
+      const auto range_mm = calculator->getIonRangeMM(ion, E_MeV);
+      EXPECT_NEAR(range_mm, referenceRangeMM(ion, E_MeV), tolerance * std::fabs(referenceRangeMM(ion, E_MeV)))
+          << "ion=" << ion << " E=" << E_MeV << " MeV";
+      EXPECT_NEAR(calculator->getIonEnergyMeV(ion, range_mm), referenceEnergyMeV(ion, range_mm),
+                  tolerance * std::fabs(referenceEnergyMeV(ion, range_mm)))
+          << "ion=" << ion << " range=" << range_mm << " mm";
+      energies.push_back(E_MeV);
+      ranges.push_back(range_mm);
+    }
+
+    // batch versions
+    std::vector<double> batchRanges(3, 0.0), batchEnergies;
+    calculator->getIonRangeMM(ion, energies, batchRanges);
+    calculator->getIonEnergyMeV(ion, ranges, batchEnergies);
+    ASSERT_EQ(batchRanges.size(), energies.size());
+    ASSERT_EQ(batchEnergies.size(), ranges.size());
+    for (size_t i = 0; i < energies.size(); i++) {
+      EXPECT_DOUBLE_EQ(batchRanges[i], calculator->getIonRangeMM(ion, energies[i]));
+      EXPECT_DOUBLE_EQ(batchEnergies[i], calculator->getIonEnergyMeV(ion, ranges[i]));
+    }
+  }
+
+  static void compareBraggCurves(pid_type ion) {
+    const int Npoints = 1000;
+    for (auto fraction : {0.05, 0.3, 0.7, 1.0}) {
+      const auto E_MeV = fraction * maxEnergyMeV(ion);
+      const auto &curve = *calculator->getIonBraggCurveMeVPerMM(ion, E_MeV, Npoints);
+      const auto expected = referenceBraggCurve(ion, E_MeV, Npoints);
+      ASSERT_EQ(curve.GetN(), expected.GetN());
+      const auto range_mm = expected.GetX()[Npoints - 1];
+      for (int ipoint = 0; ipoint < Npoints; ipoint++) {
+        EXPECT_NEAR(curve.GetX()[ipoint], expected.GetX()[ipoint], tolerance * range_mm)
+            << "ion=" << ion << " E=" << E_MeV << " MeV, point=" << ipoint;
+        EXPECT_NEAR(curve.GetY()[ipoint], expected.GetY()[ipoint], tolerance * std::fabs(expected.GetY()[ipoint]) + 1e-12)
+            << "ion=" << ion << " E=" << E_MeV << " MeV, point=" << ipoint;
+      }
+    }
+  }
+
+  static std::unique_ptr<IonRangeCalculator> calculator;
+  static std::map<pid_type, ReferenceCurves> references;
+  static constexpr double tolerance = 1e-4;
+  static const std::vector<pid_type> ions;
+};
+
+std::unique_ptr<IonRangeCalculator> IonRangeCalculatorTest::calculator;
+std::map<pid_type, ReferenceCurves> IonRangeCalculatorTest::references;
+constexpr double IonRangeCalculatorTest::tolerance;
+const std::vector<pid_type> IonRangeCalculatorTest::ions = {pid_type::PROTON, pid_type::ALPHA, pid_type::CARBON_12,
+                                                            pid_type::CARBON_14};
+
+TEST_F(IonRangeCalculatorTest, SameAsGraphEvalReferenceConditions) {
+  ASSERT_TRUE(calculator->IsOK());
+  calculator->setGasConditions(gas_mixture_type::CO2, 250.0, 293.15);
+  for (auto ion : ions) {
+    compareRangeAndEnergy(ion);
+    compareBraggCurves(ion);
+  }
+}
+
+TEST_F(IonRangeCalculatorTest, SameAsGraphEvalOtherConditions) {
+  ASSERT_TRUE(calculator->IsOK());
+  calculator->setGasConditions(gas_mixture_type::CO2, 190.0, 300.0);
+  calculator->setEffectiveLengthCorrection(pid_type::ALPHA, 1.05, -0.5);
+  calculator->setEffectiveLengthCorrection(pid_type::CARBON_12, 0.9, 0.2);
+  for (auto ion : ions) {
+    compareRangeAndEnergy(ion);
+    compareBraggCurves(ion);
+  }
+  calculator->resetEffectiveLengthCorrections();
+}
+
+TEST_F(IonRangeCalculatorTest, BraggCurveCache) {
+  ASSERT_TRUE(calculator->IsOK());
+  calculator->setGasConditions(gas_mixture_type::CO2, 250.0, 293.15);
+  const auto E_MeV = 0.5 * maxEnergyMeV(pid_type::ALPHA);
+
+  // default: the last exact energy is reused without a copy
+  const auto first = calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, E_MeV, 500);
+  EXPECT_EQ(calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, E_MeV, 500), first);
+  const auto next = calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, 0.9 * E_MeV, 500);
+  EXPECT_NE(next, first);
+  EXPECT_LT(next->GetX()[499], first->GetX()[499]);
+
+  // energy bins
+  calculator->setBraggCurveCacheBinMeV(0.1);
+  const auto binned = calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, 1.02, 500);
+  EXPECT_EQ(calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, 1.08, 500), binned);
+  EXPECT_NE(calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, 1.12, 500), binned);
+  EXPECT_NE(calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, 1.02, 400), binned);
+  calculator->setBraggCurveCacheBinMeV(0.0);
+
+  // cached curves follow the gas conditions, curves already returned are kept
+  calculator->setGasPressure(190.0);
+  const auto other = calculator->getIonBraggCurveMeVPerMM(pid_type::ALPHA, E_MeV, 500);
+  const auto expected = referenceBraggCurve(pid_type::ALPHA, E_MeV, 500);
+  EXPECT_NEAR(other->GetX()[499], expected.GetX()[499], tolerance * expected.GetX()[499]);
+  EXPECT_GT(other->GetX()[499], first->GetX()[499]);
+  EXPECT_EQ(first->GetN(), 500);
+  calculator->setGasPressure(250.0);
+}
+
+TEST_F(IonRangeCalculatorTest, CopyOutlivesSource) {
+  auto makeSource = [] {
+    std::unique_ptr<IonRangeCalculator> source(
+        new IonRangeCalculator(std::string(TPCRECO_RESOURCE_DIR) + "/", gas_mixture_type::CO2, 190.0, 300.0));
+    source->setEffectiveLengthCorrection(pid_type::ALPHA, 1.05, -0.5);
+    return source;
+  };
+  auto source = makeSource();
+  IonRangeCalculator copy(*source);
+  IonRangeCalculator assigned(std::string(TPCRECO_RESOURCE_DIR) + "/", gas_mixture_type::CO2, 250.0, 293.15);
+  assigned = *source;
+  source.reset();
+  source = makeSource();
+  IonRangeCalculator moved(std::move(*source));
+  source.reset();
+
+  for (auto c : {&copy, &assigned, &moved}) {
+    ASSERT_TRUE(c->IsOK());
+    for (auto ion : ions) {
+      const auto E_MeV = 0.5 * maxEnergyMeV(ion);
+      const auto range_mm = c->getIonRangeMM(ion, E_MeV);
+      EXPECT_NEAR(range_mm, referenceRangeMM(*c, ion, E_MeV), tolerance * range_mm) << "ion=" << ion;
+      EXPECT_NEAR(c->getIonEnergyMeV(ion, range_mm), referenceEnergyMeV(*c, ion, range_mm), tolerance * E_MeV)
+          << "ion=" << ion;
+    }
+    EXPECT_EQ(c->getEffectiveLengthCorrectionScale(pid_type::ALPHA), 1.05);
+    EXPECT_EQ(c->getEffectiveLengthCorrectionOffsetMM(pid_type::ALPHA), -0.5);
+  }
+}
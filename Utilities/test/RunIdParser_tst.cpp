@@ -1,5 +1,52 @@
 #include "TPCReco/RunIdParser.h"
 #include "gtest/gtest.h"
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <tuple>
+
+namespace {
+// regex based parser used before the hand-written one, reference for
+// the property test: returns {runId, fileId, CoBoId, AsAdId, exactTimePoint}
+using ParsedName = std::tuple<long, unsigned long, int, int,
+                              RunIdParser::time_point>;
+ParsedName regexParse(const std::string &name) {
+  static const std::regex withBoards(
+      "^.*CoBo(\\d)_AsAd(\\d)_(\\d{4})-(\\d{2})-(\\d{2})T(\\d{2})\\D(\\d{2})"
+      "\\D(\\d{2})\\.(\\d{3})_(\\d+).*$");
+  static const std::regex withoutBoards(
+      "^.*(\\d{4})-(\\d{2})-(\\d{2})T(\\d{2})\\D(\\d{2})\\D(\\d{2})\\.(\\d{3})_("
+      "\\d+).*$");
+  std::smatch match;
+  int offset = 2, cobo = -1, asad = -1;
+  if (std::regex_match(name, match, withBoards)) {
+    cobo = std::stoi(match[1]);
+    asad = std::stoi(match[2]);
+  } else if (std::regex_match(name, match, withoutBoards)) {
+    offset = 0;
+  } else {
+    throw RunIdParser::ParseError("no match");
+  }
+  auto get = [&match, offset](size_t pos) {
+    return std::stoi(match[offset + pos]);
+  };
+  auto ptime = boost::posix_time::ptime(
+      boost::gregorian::date(get(1), get(2), get(3)),
+      boost::posix_time::hours(get(4)) + boost::posix_time::minutes(get(5)) +
+          boost::posix_time::seconds(get(6)));
+  auto exactTimePoint = RunIdParser::time_point::clock::from_ptime(ptime) +
+                        std::chrono::milliseconds(get(7));
+  std::stringstream stream;
+  stream.imbue(std::locale(stream.getloc(), new boost::posix_time::time_facet(
+                                                RunId::facetFormat.c_str())));
+  stream << ptime;
+  long runId;
+  stream >> runId;
+  return ParsedName{runId, std::stoul(match[offset + 8]), cobo, asad,
+                    exactTimePoint};
+}
+} // namespace
 
 TEST(RunIdParser_Test, IncorrectNames) {
   EXPECT_THROW(
@@ -306,4 +353,58 @@ TEST(RunIdParser_Test, RunIdToTimePointIrregular) {
     EXPECT_EQ(RunId(1).toTimePoint().time_since_epoch().count(), 0);
     EXPECT_EQ(RunId(999999).toTimePoint().time_since_epoch().count(), 0);
     EXPECT_THROW(RunId(9999999).toTimePoint().time_since_epoch().count(), std::exception);
-}
\ No newline at end of file
+}
+
+// random names built from valid ones by small mutations must be parsed
+// as by the regex grammar, or rejected by both parsers
+TEST(RunIdParser_Test, PropertyAgainstRegex) {
+  const std::vector<std::string> seeds = {
+      "CoBo_ALL_AsAd_ALL_2021-09-08T09:25:36.627_0015.graw.gz",
+      "CoBo1_AsAd2_2018-04-19T16:39:05.506_0001.graw",
+      "CoBo_2018-06-06T16 59 32.375_0000.graw",
+      "Reco_EventTPC_2021-06-22T12:01:56.568_1-2.root",
+      "CoBo0_AsAd3_1999-12-31T23-59-59.999_0003.graw",
+      "CoBo12_AsAd3_2021-02-29T25:61:61.000_99999999999999999999.graw",
+      "CoBo0_AsAd1_2021-07-12T12:03:40.982_0000.graw_2021-07-12T12:03:"
+      "40.982_0001.graw"};
+  const std::string alphabet = "0123456789-T:._ CoBAsdx\n\r";
+  std::mt19937 generator(20240117);
+  auto randomIndex = [&generator](size_t size) {
+    return std::uniform_int_distribution<size_t>(0, size - 1)(generator);
+  };
+  auto outcome = [](auto parse) {
+    try {
+      return std::make_pair(true, parse());
+    } catch (const std::logic_error &e) {
+      return std::make_pair(false, ParsedName{});
+    }
+  };
+  unsigned int nParsed = 0;
+  for (int iName = 0; iName < 20000; ++iName) {
+    auto name = seeds[randomIndex(seeds.size())];
+    for (size_t nMutations = randomIndex(4); nMutations > 0; --nMutations) {
+      auto position = randomIndex(name.size());
+      auto c = alphabet[randomIndex(alphabet.size())];
+      switch (randomIndex(3)) {
+      case 0:
+        name[position] = c;
+        break;
+      case 1:
+        name.insert(position, 1, c);
+        break;
+      default:
+        name.erase(position, 1);
+      }
+    }
+    auto expected = outcome([&name]() { return regexParse(name); });
+    auto result = outcome([&name]() {
+      RunIdParser parser(name);
+      return ParsedName{parser.runId(), parser.fileId(), parser.CoBoId(),
+                        parser.AsAdId(), parser.exactTimePoint()};
+    });
+    ASSERT_EQ(result.first, expected.first) << name;
+    ASSERT_TRUE(result.second == expected.second) << name;
+    nParsed += result.first;
+  }
+  EXPECT_GT(nParsed, 1000);
+}
@@ -1,6 +1,9 @@
 #include "TPCReco/TTreeOps.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
 #include <vector>
 
 using namespace tpcreco::utilities;
@@ -67,6 +70,105 @@ TEST_F(TreeDuplicationTest, CloneUnique) {
   }
 }
 
+TEST_F(TreeDuplicationTest, EntryKeys) {
+  auto keys = readEntryKeys(tree, "runId", "eventId");
+  ASSERT_EQ(keys.size(), ids.size());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    EXPECT_EQ(keys[i].major, runId);
+    EXPECT_EQ(keys[i].minor, ids[i].first);
+    EXPECT_EQ(keys[i].entry, i);
+  }
+  EXPECT_FALSE(isSorted(keys));
+  EXPECT_EQ(countUnique(keys), 5);
+  keys.erase(keys.begin() + 7);
+  EXPECT_TRUE(isSorted(keys));
+}
+
+TEST_F(TreeDuplicationTest, FillSorted) {
+  auto keys = readEntryKeys(tree, "runId", "eventId");
+  std::vector<double> expectedData = {.0, .1, .2, .3, .4, .7, .5, .6, .8};
+  for (auto chunkSize : {1, 2, 4, 100}) {
+    std::unique_ptr<TTree> sorted(tree->CloneTree(0));
+    auto sortedKeys = fillSorted(tree, sorted.get(), keys, false, false, chunkSize);
+    EXPECT_TRUE(isSorted(sortedKeys));
+    ASSERT_EQ(sorted->GetEntries(), expectedData.size());
+    ASSERT_EQ(sortedKeys.size(), expectedData.size());
+    for (int i = 0; i < sorted->GetEntries(); ++i) {
+      sorted->GetEntry(i);
+      EXPECT_FLOAT_EQ(data, expectedData[i]);
+      EXPECT_EQ(sortedKeys[i].minor, eventId);
+      EXPECT_EQ(sortedKeys[i].entry, i);
+    }
+  }
+}
+
+TEST_F(TreeDuplicationTest, CloneUniqueSorted) {
+  std::vector<double> expectedData = {.0, .1, .7, .6, .8};
+  for (auto chunkSize : {1, 2, 4, 100}) {
+    std::unique_ptr<TTree> clone(
+        cloneUniqueSorted(tree, nullptr, "runId", "eventId", false, chunkSize));
+    ASSERT_EQ(clone->GetEntries(), expectedData.size());
+    for (int i = 0; i < clone->GetEntries(); ++i) {
+      clone->GetEntry(i);
+      EXPECT_FLOAT_EQ(data, expectedData[i]);
+    }
+  }
+}
+
+TEST(TreeSortedTest, SequentialCopy) {
+  int runId = 1;
+  int eventId = 0;
+  TTree tree("sorted tree", "sorted tree");
+  tree.Branch("runId", &runId);
+  tree.Branch("eventId", &eventId);
+  for (auto id : {1, 2, 2, 5, 7, 7, 7}) {
+    eventId = id;
+    tree.Fill();
+  }
+  auto keys = readEntryKeys(&tree, "runId", "eventId");
+  EXPECT_TRUE(isSorted(keys));
+  std::unique_ptr<TTree> clone(tree.CloneTree(0));
+  auto uniqueKeys = fillSorted(&tree, clone.get(), keys, true);
+  std::vector<int> expectedIds = {1, 2, 5, 7};
+  ASSERT_EQ(clone->GetEntries(), expectedIds.size());
+  for (int i = 0; i < clone->GetEntries(); ++i) {
+    clone->GetEntry(i);
+    EXPECT_EQ(eventId, expectedIds[i]);
+    EXPECT_EQ(uniqueKeys[i].minor, expectedIds[i]);
+  }
+  SortedKeyRange range(uniqueKeys);
+  EXPECT_THAT(range.range() | element_view<0>(),
+              ::testing::ElementsAreArray({0, 1, 2, 3}));
+}
+
+TEST_F(TreeDuplicationTest, StoredEntryKeys) {
+  auto keys = readEntryKeys(tree, "runId", "eventId");
+  std::sort(keys.begin(), keys.end());
+  TFile file("TTreeOps_tst_index.root", "RECREATE");
+  writeEntryKeys(keys, "index", &file);
+  EXPECT_TRUE(readStoredEntryKeys(&file, "missing").empty());
+  auto storedKeys = readStoredEntryKeys(&file, "index");
+  ASSERT_EQ(storedKeys.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(storedKeys[i].major, keys[i].major);
+    EXPECT_EQ(storedKeys[i].minor, keys[i].minor);
+    EXPECT_EQ(storedKeys[i].entry, keys[i].entry);
+  }
+  file.Close();
+  std::remove("TTreeOps_tst_index.root");
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    auto entry = findEntry(storedKeys, runId, ids[i].first);
+    ASSERT_GE(entry, i);
+    EXPECT_EQ(ids[entry].first, ids[i].first);
+    for (auto j = entry + 1; j < static_cast<Long64_t>(ids.size()); ++j) {
+      EXPECT_NE(ids[j].first, ids[i].first); // the younger duplicate is found
+    }
+  }
+  EXPECT_EQ(findEntry(storedKeys, runId, 100), -1);
+  EXPECT_EQ(findEntry(storedKeys, runId + 1, ids[0].first), -1);
+}
+
 struct DetailCheckMock {
   void operator()(int a, int b) { return invokeHelper(a, b); }
   MOCK_METHOD(void, invokeHelper, (int, int));
@@ -0,0 +1,87 @@
+#include "TPCReco/UniformSplineTable.h"
+#include "gtest/gtest.h"
+#include <TGraph.h>
+#include <TRandom3.h>
+#include <cmath>
+#include <vector>
+
+TEST(UniformSplineTable, Empty) {
+  UniformSplineTable table;
+  EXPECT_FALSE(table.IsOK());
+  EXPECT_EQ(table.eval(1.0), 0.0);
+  EXPECT_FALSE(UniformSplineTable({1.0}, {2.0}).IsOK());
+  EXPECT_FALSE(UniformSplineTable({1.0, 1.0}, {2.0, 3.0}).IsOK());
+}
+
+TEST(UniformSplineTable, Linear) {
+  // unsorted input points on y=2x+1
+  UniformSplineTable table({3.0, 0.0, 1.0, 10.0}, {7.0, 1.0, 3.0, 21.0}, 101);
+  ASSERT_TRUE(table.IsOK());
+  EXPECT_EQ(table.getNumberOfNodes(), 101u);
+  EXPECT_DOUBLE_EQ(table.getMinX(), 0.0);
+  EXPECT_DOUBLE_EQ(table.getMaxX(), 10.0);
+  for (double x = -2.0; x < 12.0; x += 0.37) {
+    EXPECT_NEAR(table.eval(x), 2 * x + 1, 1e-9) << x;
+  }
+}
+
+TEST(UniformSplineTable, SmoothCurve) {
+  // range-like curve sampled on a coarse non-uniform grid
+  std::vector<double> x, y;
+  for (double e = 0.0; e <= 10.0; e += 0.05 + 0.02 * e) {
+    x.push_back(e);
+    y.push_back(std::pow(e, 1.7));
+  }
+  UniformSplineTable table(x, y, 4096);
+  for (double e = 0.1; e < x.back(); e += 0.113) {
+    EXPECT_NEAR(table.eval(e), std::pow(e, 1.7), 2e-2 * std::pow(e, 1.7)) << e;
+  }
+}
+
+TEST(UniformSplineTable, MonotoneWithoutOvershoot) {
+  // step-like curve, a cubic spline would overshoot around the kinks
+  UniformSplineTable table({0.0, 1.0, 1.1, 2.0}, {0.0, 0.0, 1.0, 1.0}, 21);
+  double previous = table.eval(0.0);
+  for (double x = 0.0; x <= 2.0; x += 0.001) {
+    auto value = table.eval(x);
+    EXPECT_GE(value, previous - 1e-12) << x;
+    EXPECT_GE(value, -1e-12) << x;
+    EXPECT_LE(value, 1.0 + 1e-12) << x;
+    previous = value;
+  }
+}
+
+TEST(UniformSplineTable, BatchEvaluation) {
+  UniformSplineTable table({0.0, 1.0, 4.0}, {0.0, 1.0, 2.0}, 64);
+  std::vector<double> x = {-1.0, 0.0, 0.5, 1.7, 3.99, 4.0, 5.0};
+  std::vector<double> result(2, 0.0);
+  table.eval(x, result);
+  ASSERT_EQ(result.size(), x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_EQ(result[i], table.eval(x[i]));
+  }
+}
+
+TEST(UniformSplineTable, SameAsGraphEval) {
+  // unsorted, non-uniform points with repeated X, more points than grid nodes
+  TRandom3 rand(99);
+  std::vector<double> x = {0.0, 10.0}, y = {1.0, -2.0};
+  for (int i = 0; i < 300; ++i) {
+    x.push_back(rand.Uniform(0.01, 9.99));
+    y.push_back(rand.Gaus(0, 1));
+    if (i % 50 == 0) {
+      x.push_back(x.back());
+      y.push_back(rand.Gaus(0, 1));
+    }
+  }
+  TGraph graph(x.size(), x.data(), y.data());
+  UniformSplineTable table(x, y, 64);
+  ASSERT_TRUE(table.IsOK());
+  for (int i = 0; i < 20000; ++i) {
+    const double value = rand.Uniform(-1, 11);
+    EXPECT_NEAR(table.eval(value), graph.Eval(value), 1e-9) << value;
+  }
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(table.eval(x[i]), graph.Eval(x[i]), 1e-12) << x[i];
+  }
+}